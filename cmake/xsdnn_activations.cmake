@@ -3,4 +3,11 @@ set(
         "${XSROOT_SRC}/layers/activations/activation_layer.cc"
         "${XSROOT_SRC}/layers/activations/relu.cc"
         "${XSROOT_SRC}/layers/activations/hard_sigmoid.cc"
+        "${XSROOT_SRC}/layers/activations/sigmoid.cc"
+        "${XSROOT_SRC}/layers/activations/tanh.cc"
+        "${XSROOT_SRC}/layers/activations/gelu.cc"
+        "${XSROOT_SRC}/layers/activations/silu.cc"
+        "${XSROOT_SRC}/layers/activations/leaky_relu.cc"
+        "${XSROOT_SRC}/layers/activations/elu.cc"
+        "${XSROOT_SRC}/layers/activations/softmax.cc"
 )
\ No newline at end of file
@@ -8,6 +8,7 @@ set(
         "${XSROOT_SRC}/core/framework/op_context.cc"
         "${XSROOT_SRC}/core/framework/op_kernel.cc"
         "${XSROOT_SRC}/core/framework/params.cc"
+        "${XSROOT_SRC}/core/framework/conv_algorithm.cc"
         "${XSROOT_SRC}/core/framework/allocator.cc"
         "${XSROOT_SRC}/core/framework/tensor.cc"
         "${XSROOT_SRC}/core/framework/tensor_shape.cc"
@@ -25,8 +26,22 @@ set(
         "${XSROOT_SRC}/core/kernel/batch_norm/bn_fwd_xs_impl.cc"
         "${XSROOT_SRC}/core/kernel/max_pool/mp_fwd_kernel.cc"
         "${XSROOT_SRC}/core/kernel/max_pool/mp_fwd_xs_impl.cc"
+        "${XSROOT_SRC}/core/kernel/max_pool/mp_bwd_kernel.cc"
+        "${XSROOT_SRC}/core/kernel/max_pool/mp_bwd_xs_impl.cc"
         "${XSROOT_SRC}/core/kernel/global_average_pooling/gap_fwd_kernel.cc"
         "${XSROOT_SRC}/core/kernel/global_average_pooling/gap_fwd_xs_impl.cc"
+        "${XSROOT_SRC}/core/kernel/global_average_pooling/gap_bwd_kernel.cc"
+        "${XSROOT_SRC}/core/kernel/global_average_pooling/gap_bwd_xs_impl.cc"
+        "${XSROOT_SRC}/core/kernel/average_pooling/ap_fwd_kernel.cc"
+        "${XSROOT_SRC}/core/kernel/average_pooling/ap_fwd_xs_impl.cc"
+        "${XSROOT_SRC}/core/kernel/average_pooling/ap_bwd_kernel.cc"
+        "${XSROOT_SRC}/core/kernel/average_pooling/ap_bwd_xs_impl.cc"
         "${XSROOT_SRC}/core/kernel/conv/conv_fwd_kernel.cc"
         "${XSROOT_SRC}/core/kernel/conv/conv_fwd_xs_impl.cc"
+        "${XSROOT_SRC}/core/kernel/conv/conv_bwd_kernel.cc"
+        "${XSROOT_SRC}/core/kernel/conv/conv_bwd_xs_impl.cc"
+        "${XSROOT_SRC}/core/kernel/conv_transpose/conv_transpose_fwd_kernel.cc"
+        "${XSROOT_SRC}/core/kernel/conv_transpose/conv_transpose_fwd_xs_impl.cc"
+        "${XSROOT_SRC}/core/kernel/conv_transpose/conv_transpose_bwd_kernel.cc"
+        "${XSROOT_SRC}/core/kernel/conv_transpose/conv_transpose_bwd_xs_impl.cc"
 )
@@ -11,9 +11,17 @@ set(
         "${XSROOT_SRC}/layers/flatten.cc"
         "${XSROOT_SRC}/layers/batch_normalization.cc"
         "${XSROOT_SRC}/layers/max_pooling.cc"
+        "${XSROOT_SRC}/layers/average_pooling.cc"
         "${XSROOT_SRC}/layers/global_average_pooling.cc"
+        "${XSROOT_SRC}/layers/binary_layer.cc"
         "${XSROOT_SRC}/layers/mul.cc"
+        "${XSROOT_SRC}/layers/sub.cc"
+        "${XSROOT_SRC}/layers/div.cc"
+        "${XSROOT_SRC}/layers/min.cc"
+        "${XSROOT_SRC}/layers/max.cc"
+        "${XSROOT_SRC}/layers/pow.cc"
         "${XSROOT_SRC}/layers/reshape.cc"
         "${XSROOT_SRC}/layers/convolution.cc"
+        "${XSROOT_SRC}/layers/conv_transpose.cc"
         "${XSROOT_SRC}/layers/layer_register.cc"
 )
\ No newline at end of file
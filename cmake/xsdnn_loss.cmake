@@ -2,4 +2,5 @@ set(
         xsdnn_loss_src
         "${XSROOT_SRC}/loss/loss_base.cc"
         "${XSROOT_SRC}/loss/mse_loss.cc"
+        "${XSROOT_SRC}/loss/softmax_cross_entropy_loss.cc"
 )
\ No newline at end of file
@@ -5,5 +5,17 @@ set(mmpack_common_src
         ${MMPACK_ROOT}/sdot.cc
         ${MMPACK_ROOT}/smuladd.cc
         ${MMPACK_ROOT}/sconv.cc
+        ${MMPACK_ROOT}/sconvgrad.cc
+        ${MMPACK_ROOT}/sconvpool.cc
+        ${MMPACK_ROOT}/spool.cc
+        ${MMPACK_ROOT}/snorm.cc
+        ${MMPACK_ROOT}/smath.cc
+        ${MMPACK_ROOT}/ssoftmax.cc
+        ${MMPACK_ROOT}/sbinary.cc
         ${MMPACK_ROOT}/sadd.cc
-        )
\ No newline at end of file
+        ${MMPACK_ROOT}/snchwc.cc
+        ${MMPACK_ROOT}/stranspose.cc
+        )
+
+# Редукция аргумента и деления в ядрах smath_.h рассчитаны на точный порядок операций, который -ffast-math не сохраняет
+set_source_files_properties(${MMPACK_ROOT}/smath.cc ${MMPACK_ROOT}/ssoftmax.cc ${MMPACK_ROOT}/sbinary.cc ${MMPACK_ROOT}/activation.cc PROPERTIES COMPILE_OPTIONS "-fno-fast-math")
@@ -35,6 +35,11 @@ AddTest(
         ${XSDNN_TEST_ROOT}/test_muladd.cc
 )
 
+AddTest(
+        mmpack_math_test
+        ${XSDNN_TEST_ROOT}/test_math.cc
+)
+
 AddTest(
         xsdnn_fully_connected_test
         ${XSDNN_TEST_ROOT}/test_fully_connected.cc
@@ -45,6 +50,16 @@ AddTest(
         ${XSDNN_TEST_ROOT}/test_relu.cc
 )
 
+AddTest(
+        xsdnn_activation_test
+        ${XSDNN_TEST_ROOT}/test_activation.cc
+)
+
+AddTest(
+        xsdnn_loss_test
+        ${XSDNN_TEST_ROOT}/test_loss.cc
+)
+
 AddTest(
         xsdnn_network_serialization_test
         ${XSDNN_TEST_ROOT}/test_network_serialization.cc
@@ -95,6 +110,11 @@ AddTest(
         ${XSDNN_TEST_ROOT}/test_max_pooling.cc
 )
 
+AddTest(
+        xsdnn_average_pooling_test
+        ${XSDNN_TEST_ROOT}/test_average_pooling.cc
+)
+
 AddTest(
         xsdnn_global_average_pooling_test
         ${XSDNN_TEST_ROOT}/test_global_average_pooling.cc
@@ -110,6 +130,11 @@ AddTest(
         ${XSDNN_TEST_ROOT}/test_conv.cc
 )
 
+AddTest(
+        xsdnn_conv_transpose_test
+        ${XSDNN_TEST_ROOT}/test_conv_transpose.cc
+)
+
 AddTest(
         xsdnn_broadcast_op_test
         ${XSDNN_TEST_ROOT}/test_broadcast.cc
@@ -123,4 +148,28 @@ AddTest(
 AddTest(
         xsdnn_tensortest
         ${XSDNN_TEST_ROOT}/test_tensor.cc
-)
\ No newline at end of file
+)
+AddTest(
+        mmpack_nchwc_test
+        ${XSDNN_TEST_ROOT}/test_nchwc.cc
+)
+
+AddTest(
+        mmpack_transpose_test
+        ${XSDNN_TEST_ROOT}/test_transpose.cc
+)
+
+AddTest(
+        xsdnn_inference_session_test
+        ${XSDNN_TEST_ROOT}/test_inference_session.cc
+)
+
+AddTest(
+        xsdnn_softmax_test
+        ${XSDNN_TEST_ROOT}/test_softmax.cc
+)
+
+AddTest(
+        xsdnn_binary_test
+        ${XSDNN_TEST_ROOT}/test_binary.cc
+)
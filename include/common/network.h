@@ -40,6 +40,7 @@ public:
             connect(last_node, next_node, data_idx.first, data_idx.second);
         }
         net_.check_connectivity();
+        net_.invalidate_fusion();
         return *this;
     }
 
@@ -49,6 +50,12 @@ public:
 public:
     void init_weight();
     void set_num_threads(size_t num_threads) noexcept;
+
+    /*
+     * Автоматическое слияние слоев в predict (например, conv -> relu -> max_pooling,
+     * см. nodes::fuse). Включено по умолчанию; на обучение не влияет.
+     */
+    void set_layer_fusion(bool enable) noexcept;
     bool empty() const;
 
     mat_t predict(const mat_t& in);
@@ -56,7 +63,8 @@ public:
     std::vector<tensor_t> predict(const std::vector<tensor_t>& in);
 
     /*
-     * For sequency execution
+     * For sequency execution. Если loss->index_labels(), метки передаются функции потерь
+     * номерами классов, иначе разворачиваются в векторы размера выхода (label2vec).
      */
     void train(loss* loss,
                optimizer* opt,
@@ -105,6 +113,11 @@ protected:
     void label2vec(const std::vector<size_t>& label,
                    std::vector<tensor_t>& output);
 
+    void label2index(const std::vector<size_t>& label,
+                     std::vector<tensor_t>& output);
+
+    size_t train_num_threads() const;
+
     friend bool operator == (network<Net>& lhs, network<Net>& rhs) {
         /*
          * Check topological sorted vector
@@ -89,6 +89,7 @@ public:
 
     void clear_grads();
     void add_next_node(node* nd);
+    void remove_next_node(node* nd);
     void accumulate_grads(mat_t* dst);
 
 private:
@@ -43,6 +43,20 @@ public:
 
     void clear_grads();
 
+    /*
+     * Слияние цепочек слоев для inference (см. layer::fuse): каждый слой пробует взять на себя
+     * самую длинную цепочку единственных потребителей своего выхода. enable = false
+     * отменяет слияние. network выключает его перед обучением.
+     */
+    void fuse(bool enable);
+
+    /*
+     * Приводит слияние к layer_fusion_ перед predict. Граф сливается заново, только если
+     * с прошлого вызова fuse изменились layer_fusion_ или слои графа (см. invalidate_fusion).
+     */
+    void update_fusion();
+    void invalidate_fusion();
+
     void save_model(const std::string& filename, const std::string& network_name_);
     void load_model(const std::string& filename);
 
@@ -58,6 +72,7 @@ public:
 
 public:
     size_t user_num_threads_ = 0;
+    bool layer_fusion_ = true;
 
 protected:
     void reorder_input(const std::vector<tensor_t> &input,
@@ -66,6 +81,8 @@ protected:
 protected:
     std::vector<std::shared_ptr<layer>> owner_nodes_; // for r-value impl
     std::vector<layer*> nodes_;
+    bool fused_ = false;
+    bool fusion_dirty_ = true;
 };
 
 class sequential : public nodes {
@@ -107,6 +124,12 @@ public:
     void construct(const std::vector<layer*>& input,
                  const std::vector<layer*>& output);
 
+    /*
+     * forward до слоя last: слои начиная с last не вычисляются, их входы остаются
+     * в ребрах графа. nullptr - весь граф.
+     */
+    void forward_until(const std::vector<tensor_t>& start, const layer* last);
+
     void save_connections(xs::GraphInfo* Graph);
     void load_connections(xs::GraphInfo* Graph);
 
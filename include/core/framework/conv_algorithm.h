@@ -0,0 +1,66 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_CONV_ALGORITHM_H
+#define XSDNN_CONV_ALGORITHM_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "params.h"
+
+namespace xsdnn {
+    namespace core {
+
+enum class conv_algorithm_mode {
+    heuristic,  // только эвристика params::conv::computeAlgorithm и записи таблицы
+    measure     // при первом запуске замерить всех кандидатов и запомнить лучший
+};
+
+/*
+ * Общая для процесса таблица выбранных алгоритмов свертки.
+ * Ключ - геометрия свертки, набор инструкций, с которым собран mmpack, и число потоков,
+ * поэтому таблица, сохраненная на другой машине или сборке, просто не найдет совпадений.
+ */
+class ConvAlgorithmSelector {
+public:
+    static ConvAlgorithmSelector& get_instance();
+
+    void set_mode(conv_algorithm_mode mode);
+    conv_algorithm_mode mode() const;
+
+    /*
+     * Ищет алгоритм для свертки p при nthreads потоках. false - ключа нет в таблице.
+     */
+    bool find(const params::conv& p, size_t nthreads, MM_CONV_PARAMS::MmConvAlgorithm& algorithm) const;
+
+    /*
+     * Замеряет все допустимые для p алгоритмы на случайных данных, записывает лучший в таблицу
+     * и возвращает его. Каждый из nthreads потоков считает свой образец, как при обычном запуске.
+     */
+    MM_CONV_PARAMS::MmConvAlgorithm measure(const params::conv& p, size_t nthreads);
+
+    /*
+     * Текстовый формат: одна строка "ключ алгоритм" на запись. load дополняет таблицу.
+     */
+    void save(const std::string& path) const;
+    void load(const std::string& path);
+    void clear();
+    size_t size() const;
+
+private:
+    ConvAlgorithmSelector() = default;
+    static std::string key(const MM_CONV_PARAMS& p, size_t nthreads);
+
+private:
+    mutable std::mutex mtx_;
+    std::unordered_map<std::string, MM_CONV_PARAMS::MmConvAlgorithm> table_;
+    conv_algorithm_mode mode_ {conv_algorithm_mode::heuristic};
+};
+
+    } // core
+} // xsdnn
+
+#endif //XSDNN_CONV_ALGORITHM_H
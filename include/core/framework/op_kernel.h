@@ -23,6 +23,7 @@ public:
     virtual void compute(core::OpContext& ctx, params::fully& p) {}
     virtual void compute(core::OpContext& ctx, params::bnorm& p) {}
     virtual void compute(core::OpContext& ctx, params::max_pool& p) {}
+    virtual void compute(core::OpContext& ctx, params::avg_pool& p) {}
     virtual void compute(core::OpContext& ctx, params::conv& p) {}
 };
 
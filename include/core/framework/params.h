@@ -18,6 +18,11 @@ struct fully {
     size_t in_size_;
     size_t out_size_;
     bool   has_bias_;
+
+    /*
+     * Активация, которая применяется к выходу GEMM внутри ядра (NotSet - без активации).
+     */
+    MmActivationType activation_type_ {MmActivationType::NotSet};
 };
 
 struct bnorm {
@@ -25,7 +30,28 @@ struct bnorm {
     mm_scalar momentum_;
     mm_scalar eps_;
     op_mode phase_;
-    std::unordered_map<std::string, mat_t> stat_holder;
+    tensor_layout layout_ {tensor_layout::nchw};
+
+    /*
+     * mean_ / stddev_ - скользящие статистики для режима inference,
+     * batch_mean_ / batch_stddev_ - статистики последнего батча в режиме обучения.
+     */
+    mat_t mean_;
+    mat_t stddev_;
+    mat_t batch_mean_;
+    mat_t batch_stddev_;
+
+    /*
+     * Поканальное преобразование inference режима y = scale_[c] * x + shift_[c]:
+     * scale = gamma / stddev, shift = beta - mean * scale. Считается при первом forward
+     * после изменения весов или статистик (загрузка, шаг оптимизатора, set_statistics).
+     */
+    mat_t scale_;
+    mat_t shift_;
+    bool scale_shift_ready_ {false};
+
+    void compute_scale_shift(const mat_t& gamma, const mat_t& beta);
+    void invalidate_scale_shift();
 
     bool statistic_initialized {false};
 };
@@ -38,19 +64,48 @@ struct max_pool {
     size_t stride_x_;
     size_t stride_y_;
     padding_mode pad_type_;
+    tensor_layout layout_ {tensor_layout::nchw};
+
+    /*
+     * Параметры ядра mmpack::MmMaxPool, включая заполнение для padding_mode::same.
+     */
+    MM_POOL_PARAMS _;
+
+    /*
+     * В режиме обучения forward запоминает позиции максимумов окон (mmpack::MmMaxPoolArgmax)
+     * по одному байту на точку выхода для каждого образца, их читает backward.
+     */
+    bool record_argmax_ {false};
+    std::vector<std::vector<uint8_t>> argmax_;
+};
 
-    std::vector<std::vector<size_t>> out2in;
-    std::vector<size_t> in2out;
+struct avg_pool {
+    shape3d in_shape_;
+    shape3d out_shape_;
+    size_t kernel_x_;
+    size_t kernel_y_;
+    size_t stride_x_;
+    size_t stride_y_;
+    padding_mode pad_type_;
+    bool count_include_pad_;
+
+    /*
+     * Параметры ядер mmpack::MmAveragePool / MmAveragePoolBackward.
+     */
+    MM_POOL_PARAMS _;
 };
 
 struct global_avg_pool {
     shape3d in_shape_;
     shape3d out_shape_;
+    tensor_layout layout_ {tensor_layout::nchw};
 };
 
 struct conv {
 public:
     conv();
+    conv(const conv& other);
+    conv& operator=(const conv& other);
 
     void infer_output_requirement_shape(shape3d in, size_t out_channel, size_t group_count, bool has_bias,
                                         std::vector<size_t> kernel_shape,
@@ -60,6 +115,60 @@ public:
                                         std::vector<size_t> pads,
                                         MmActivationType activation_type);
 
+    /*
+     * Принудительно задает алгоритм свертки и пересчитывает размер временного буфера.
+     * Заданный так алгоритм не меняется при автоматическом выборе.
+     */
+    void set_algorithm(MM_CONV_PARAMS::MmConvAlgorithm algorithm);
+
+    /*
+     * Выбирает алгоритм для nthreads потоков при первом запуске: берет его из таблицы
+     * core::ConvAlgorithmSelector, а в режиме измерения замеряет кандидатов, если ключа в таблице нет.
+     * Без записи в таблице и вне режима измерения остается эвристика computeAlgorithm.
+     */
+    void select_algorithm(size_t nthreads);
+
+    /*
+     * Алгоритмы, которые поддерживает геометрия свертки.
+     */
+    std::vector<MM_CONV_PARAMS::MmConvAlgorithm> candidate_algorithms() const;
+
+    /*
+     * Один раз переупорядочивает фильтры под текущий алгоритм и формат (см. MmConvPackFilter).
+     * Упакованные фильтры сбрасываются при смене алгоритма, формата или весов.
+     */
+    void pack_filter(const mat_t& W);
+    void invalidate_packed_filter();
+
+    /*
+     * Задает формат входа и выхода свертки и пересчитывает размер временного буфера.
+     * Форматы различаются только на границе блочной цепочки: свертка в NCHWc сама
+     * переупорядочивает вход из NCHW или выход в NCHW (см. MmConvNchwcLayout).
+     */
+    void set_layout(tensor_layout layout);
+    void set_layout(tensor_layout in_layout, tensor_layout out_layout);
+
+    /*
+     * Свертка считается в блочном формате NCHWc.
+     */
+    bool nchwc() const;
+
+    /*
+     * Потоковый режим доступен для причинной 1D свертки с шагом 1: Padding = ((KW - 1) * d, 0).
+     * Левое заполнение заменяется контекстом из последних (KW - 1) * d входных кадров
+     * предыдущей части, который хранится в state. nullptr выключает потоковый режим.
+     */
+    bool streamable() const;
+    void set_stream_state(tensor_t* state);
+
+    /*
+     * Слияние со следующими слоями для inference (см. conv::fuse_chain): activations применяются
+     * после собственной активации свертки, а при pool != nullptr выход сразу сводится
+     * max pooling'ом (MmConvPool) и выход свертки в полном разрешении не записывается.
+     * Пустой список и nullptr отменяют слияние.
+     */
+    void fuse(const std::vector<MmActivationHolder>& activations, const MM_POOL_PARAMS* pool);
+
 private:
     bool is_init();
 
@@ -70,15 +179,68 @@ private:
              padding_mode pad_type,
              std::vector<size_t> pads);
 
+    void _1D(shape3d in, size_t out_channel,
+             std::vector<size_t> kernel_shape,
+             std::vector<size_t> stride_shape,
+             std::vector<size_t> dilation_shape,
+             padding_mode pad_type,
+             std::vector<size_t> pads);
+
+    void inferSpatial(shape3d in, size_t out_channel,
+                      std::vector<size_t> kernel_shape,
+                      std::vector<size_t> stride_shape,
+                      std::vector<size_t> dilation_shape,
+                      padding_mode pad_type,
+                      std::vector<size_t> pads);
+
     size_t computeOutShape(const size_t in_dim, size_t kernel, size_t stride, size_t dilation, size_t pad_0, size_t pad_1);
     void computePad(const padding_mode pad_type, size_t& pad_0, size_t& pad_1);
     void computeTmpBufferSize();
     void computeAlgorithm();
+    void computeIndirection();
+    void applyAlgorithm(MM_CONV_PARAMS::MmConvAlgorithm algorithm);
 
 public:
     MM_CONV_PARAMS _;
     padding_mode pad_type_;
     MmActivationType activation_type_;
+    tensor_layout layout_;
+    tensor_layout out_layout_;
+    std::vector<uint32_t> indirection_;
+    mat_t packed_filter_;
+    bool filter_packed_;
+    MM_CONV_PARAMS stream_;
+    tensor_t* stream_state_;
+    bool algorithm_fixed_;
+    size_t algorithm_threads_;
+    std::vector<MmActivationHolder> fused_activations_;
+    bool fused_pool_;
+    MM_POOL_PARAMS pool_;
+};
+
+struct conv_transpose {
+public:
+    /*
+     * Выход по каждой оси: (in - 1) * stride - pad_begin - pad_end + dilation * (kernel - 1) + output_padding + 1.
+     * Веса хранятся как в ONNX: [InChannel][OutChannel / GroupCount][KH][KW].
+     */
+    void infer_output_requirement_shape(shape3d in, size_t out_channel, size_t group_count, bool has_bias,
+                                        std::vector<size_t> kernel_shape,
+                                        std::vector<size_t> stride_shape,
+                                        std::vector<size_t> dilation_shape,
+                                        std::vector<size_t> pads,
+                                        std::vector<size_t> output_padding);
+
+public:
+    /*
+     * Эквивалентная свертка: ее вход - выход транспонированной свертки, а выход - вход.
+     * Прямой проход транспонированной свертки - градиент по входу эквивалентной свертки.
+     */
+    conv conv_;
+    std::vector<size_t> output_padding_;
+    shape3d in_shape_;
+    shape3d out_shape_;
+    bool has_bias_;
 };
 
     } // params
@@ -74,7 +74,9 @@ void MultiThreadParallelFor(size_t num_threads, T start, T end, const Func& f) {
         if (blockEnd > end) blockEnd = end;
     }
 
+    // Сначала дожидаемся всех блоков, затем get передает вызывающему исключение из потока
     for (auto& future : futures) future.wait();
+    for (auto& future : futures) future.get();
 }
 #endif
 
@@ -0,0 +1,22 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_AP_FWD_KERNEL_H
+#define XSDNN_AP_FWD_KERNEL_H
+
+#include "../../framework/op_kernel.h"
+
+namespace xsdnn {
+    namespace core {
+
+class AvgPoolingFwdKernel : public OpKernel {
+public:
+    void compute(OpContext& ctx, params::avg_pool& p);
+};
+
+    } // core
+} // xsdnn
+
+#endif //XSDNN_AP_FWD_KERNEL_H
@@ -0,0 +1,24 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_AP_FWD_XS_IMPL_H
+#define XSDNN_AP_FWD_XS_IMPL_H
+
+#include "../../framework/params.h"
+#include "../../../utils/tensor.h"
+
+namespace xsdnn {
+    namespace kernel {
+
+        void avg_pool_fwd_xs_impl(const tensor_t& in,
+                                  tensor_t& out,
+                                  params::avg_pool& p,
+                                  bool parallelize,
+                                  size_t nthreads);
+
+    }
+}
+
+#endif //XSDNN_AP_FWD_XS_IMPL_H
@@ -13,6 +13,7 @@ namespace xsdnn {
     namespace kernel {
 
         void batch_normalization_bwd_xs_impl(const tensor_t& in,
+                                             const mat_t& gamma,
                                              const tensor_t& out,
                                              tensor_t& dx,
                                              tensor_t& dg,
@@ -0,0 +1,30 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_CONV_BWD_XS_IMPL_H
+#define XSDNN_CONV_BWD_XS_IMPL_H
+
+#include "../../framework/params.h"
+#include "../../../utils/tensor.h"
+
+namespace xsdnn {
+    namespace kernel {
+
+        void conv_bwd_xs_impl(const tensor_t& X,
+                              const mat_t& W,
+                              const tensor_t& Y,
+                              const tensor_t* Z,
+                              const tensor_t& dY,
+                              tensor_t& dX,
+                              tensor_t& dW,
+                              tensor_t* dB,
+                              params::conv& p,
+                              bool parallelize,
+                              size_t nthreads);
+
+    }
+}
+
+#endif //XSDNN_CONV_BWD_XS_IMPL_H
@@ -0,0 +1,22 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_CONV_TRANSPOSE_BWD_KERNEL_H
+#define XSDNN_CONV_TRANSPOSE_BWD_KERNEL_H
+
+#include "../../framework/op_kernel.h"
+
+namespace xsdnn {
+    namespace core {
+
+class ConvTransposeBwdKernel : public OpKernel {
+public:
+    void compute(OpContext &ctx, params::conv_transpose &p);
+};
+
+    } // core
+} // xsdnn
+
+#endif //XSDNN_CONV_TRANSPOSE_BWD_KERNEL_H
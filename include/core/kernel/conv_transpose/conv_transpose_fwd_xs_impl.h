@@ -0,0 +1,26 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_CONV_TRANSPOSE_FWD_XS_IMPL_H
+#define XSDNN_CONV_TRANSPOSE_FWD_XS_IMPL_H
+
+#include "../../framework/params.h"
+#include "../../../utils/tensor.h"
+
+namespace xsdnn {
+    namespace kernel {
+
+        void conv_transpose_fwd_xs_impl(const tensor_t& X,
+                                        const mat_t& W,
+                                        const mat_t* B,
+                                        tensor_t& Y,
+                                        const params::conv_transpose& p,
+                                        bool parallelize,
+                                        size_t nthreads);
+
+    }
+}
+
+#endif //XSDNN_CONV_TRANSPOSE_FWD_XS_IMPL_H
@@ -0,0 +1,24 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_GAP_BWD_XS_IMPL_H
+#define XSDNN_GAP_BWD_XS_IMPL_H
+
+#include "../../framework/params.h"
+#include "../../../utils/tensor.h"
+
+namespace xsdnn {
+    namespace kernel {
+
+        void global_average_pool_bwd_xs_impl(const tensor_t& dY,
+                                             tensor_t& dX,
+                                             params::global_avg_pool& p,
+                                             bool parallelize,
+                                             size_t nthreads);
+
+    }
+}
+
+#endif //XSDNN_GAP_BWD_XS_IMPL_H
@@ -15,6 +15,8 @@ namespace xsdnn {
 
 void fully_connected_bwd_xs_impl(const tensor_t& x,
                                  const mat_t& W,
+                                 const tensor_t& y,
+                                 const tensor_t* z,
                                  tensor_t& dx,
                                  tensor_t& dW,
                                  tensor_t& db,
@@ -0,0 +1,22 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_MP_BWD_KERNEL_H
+#define XSDNN_MP_BWD_KERNEL_H
+
+#include "../../framework/op_kernel.h"
+
+namespace xsdnn {
+    namespace core {
+
+class MaxPoolingBwdKernel : public OpKernel {
+public:
+    void compute(OpContext& ctx, params::max_pool& p);
+};
+
+    } // core
+} // xsdnn
+
+#endif //XSDNN_MP_BWD_KERNEL_H
@@ -25,6 +25,8 @@ public:
 
     void set_in_shape(const shape3d in_shape) override;
 
+    bool layout_sensitive() const override;
+
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
                         std::vector<tensor_t*>& out_data) override;
@@ -35,16 +37,28 @@ public:
                      std::vector<tensor_t*>&       out_grad,
                      std::vector<tensor_t*>&       in_grad) override;
 
+    /*
+     * По умолчанию активация считается через MmActivation / MmActivationBackward
+     * с параметрами из activation_holder.
+     */
     virtual
     void
-    forward_activation(const mat_t& in_data, mat_t& out_data) = 0;
+    forward_activation(const mat_t& in_data, mat_t& out_data);
 
     virtual
     void
     back_activation(const mat_t& in_data,
                     const mat_t& out_data,
                     const mat_t& out_grad,
-                    mat_t&       in_grad) = 0;
+                    mat_t&       in_grad);
+
+    /*
+     * Параметры активации для слияния с предыдущим слоем (см. layer::fuse).
+     * false - активацию нельзя выполнить через MmActivation.
+     */
+    virtual
+    bool
+    activation_holder(mmpack::MmActivationHolder* holder) const;
 
     virtual std::pair<mm_scalar, mm_scalar> out_value_range() const override = 0;
 
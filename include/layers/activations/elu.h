@@ -0,0 +1,45 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_ELU_H
+#define XSDNN_ELU_H
+
+#include "activation_layer.h"
+
+namespace xsdnn {
+
+/*
+ * x при x >= 0, alpha * (exp(x) - 1) иначе; alpha > 0.
+ */
+class elu : public activation_layer {
+public:
+    explicit elu(const size_t in_size,
+                 const float alpha = 1.0f)
+            : activation_layer(in_size) {
+        activationHolder_.ActivationType = mmpack::Elu;
+        activationHolder_.Parameters.Elu.alpha = alpha;
+    }
+
+    explicit elu(const float alpha = 1.0f)
+        : activation_layer() {
+        activationHolder_.ActivationType = mmpack::Elu;
+        activationHolder_.Parameters.Elu.alpha = alpha;
+    }
+
+public:
+    bool activation_holder(mmpack::MmActivationHolder* holder) const override;
+
+    std::pair<mm_scalar, mm_scalar> out_value_range() const override;
+
+    std::string layer_type() const override;
+
+private:
+    mmpack::MmActivationHolder activationHolder_;
+    friend struct cerial;
+};
+
+} // xsdnn
+
+#endif //XSDNN_ELU_H
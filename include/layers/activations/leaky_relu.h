@@ -0,0 +1,45 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_LEAKY_RELU_H
+#define XSDNN_LEAKY_RELU_H
+
+#include "activation_layer.h"
+
+namespace xsdnn {
+
+/*
+ * x при x >= 0, alpha * x иначе; alpha > 0.
+ */
+class leaky_relu : public activation_layer {
+public:
+    explicit leaky_relu(const size_t in_size,
+                        const float alpha = 0.01f)
+            : activation_layer(in_size) {
+        activationHolder_.ActivationType = mmpack::LeakyRelu;
+        activationHolder_.Parameters.LeakyRelu.alpha = alpha;
+    }
+
+    explicit leaky_relu(const float alpha = 0.01f)
+        : activation_layer() {
+        activationHolder_.ActivationType = mmpack::LeakyRelu;
+        activationHolder_.Parameters.LeakyRelu.alpha = alpha;
+    }
+
+public:
+    bool activation_holder(mmpack::MmActivationHolder* holder) const override;
+
+    std::pair<mm_scalar, mm_scalar> out_value_range() const override;
+
+    std::string layer_type() const override;
+
+private:
+    mmpack::MmActivationHolder activationHolder_;
+    friend struct cerial;
+};
+
+} // xsdnn
+
+#endif //XSDNN_LEAKY_RELU_H
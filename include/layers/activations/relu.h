@@ -15,12 +15,7 @@ public:
     using activation_layer::activation_layer;
 
 public:
-    void forward_activation(const mat_t& in_data, mat_t& out_data) override;
-
-    void back_activation(const mat_t& in_data,
-                         const mat_t& out_data,
-                         const mat_t& out_grad,
-                         mat_t&       in_grad) override;
+    bool activation_holder(mmpack::MmActivationHolder* holder) const override;
 
     std::pair<mm_scalar, mm_scalar> out_value_range() const override;
 
@@ -0,0 +1,30 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_SILU_H
+#define XSDNN_SILU_H
+
+#include "activation_layer.h"
+
+namespace xsdnn {
+
+/*
+ * x * sigmoid(x).
+ */
+class silu : public activation_layer {
+public:
+    using activation_layer::activation_layer;
+
+public:
+    bool activation_holder(mmpack::MmActivationHolder* holder) const override;
+
+    std::pair<mm_scalar, mm_scalar> out_value_range() const override;
+
+    std::string layer_type() const override;
+};
+
+} // xsdnn
+
+#endif //XSDNN_SILU_H
@@ -0,0 +1,41 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_SOFTMAX_H
+#define XSDNN_SOFTMAX_H
+
+#include "activation_layer.h"
+
+namespace xsdnn {
+
+/*
+ * exp(x) / sum(exp(x)) по всем значениям образца. Не поэлементная активация,
+ * поэтому не сливается с предыдущим слоем.
+ */
+class softmax : public activation_layer {
+public:
+    using activation_layer::activation_layer;
+
+public:
+    void forward_activation(const mat_t& in_data, mat_t& out_data) override;
+
+    void back_activation(const mat_t& in_data,
+                         const mat_t& out_data,
+                         const mat_t& out_grad,
+                         mat_t&       in_grad) override;
+
+    std::pair<mm_scalar, mm_scalar> out_value_range() const override;
+
+    /*
+     * Нормировка по всему образцу не раскладывается на части потока.
+     */
+    bool streamable() const override;
+
+    std::string layer_type() const override;
+};
+
+} // xsdnn
+
+#endif //XSDNN_SOFTMAX_H
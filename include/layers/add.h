@@ -6,7 +6,7 @@
 #ifndef XSDNN_ADD_H
 #define XSDNN_ADD_H
 
-#include "layer.h"
+#include "binary_layer.h"
 
 namespace xsdnn {
 
@@ -17,31 +17,31 @@ public:
      * dim: размерность каждого вектора
      */
     explicit add(size_t n_input, size_t dim)
-        : layer(std::vector<tensor_type>(n_input, tensor_type::data),
-                {tensor_type::data}),
-        n_input_(n_input), shape_(1, 1, dim) {}
+        : add(n_input, shape3d(1, 1, dim)) {}
 
     explicit add(size_t n_input, shape3d shape)
         : layer(std::vector<tensor_type>(n_input, tensor_type::data),
                 {tensor_type::data}),
-          n_input_(n_input), shape_(shape) {}
+          n_input_(n_input), in_shapes_(n_input, shape), shape_(shape), plan_(shape, shape) {}
 
     /*
      * Binary add operator
      */
     explicit add(size_t dim)
-        : layer(std::vector<tensor_type>(2, tensor_type::data),
-                {tensor_type::data}),
-        n_input_(2), shape_(1, 1, dim) {}
+        : add(2, shape3d(1, 1, dim)) {}
 
     explicit add(shape3d shape)
-        : layer(std::vector<tensor_type>(2, tensor_type::data),
-                {tensor_type::data}),
-          n_input_(2), shape_(shape) {}
+        : add(2, shape) {}
+
+    /*
+     * Binary add operator с broadcasting'ом входов (см. broadcast_plan)
+     */
+    explicit add(shape3d in_shape0, shape3d in_shape1);
 
     std::vector<shape3d> in_shape() const;
     std::vector<shape3d> out_shape() const;
     std::string layer_type() const;
+    bool layout_sensitive() const;
 
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
@@ -55,7 +55,9 @@ public:
 
 private:
     size_t n_input_;
+    std::vector<shape3d> in_shapes_;
     shape3d shape_;
+    broadcast_plan plan_;
     friend struct cerial;
 };
 
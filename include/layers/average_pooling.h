@@ -0,0 +1,85 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_AVERAGE_POOLING_H
+#define XSDNN_AVERAGE_POOLING_H
+
+#include "layer.h"
+#include "../core/kernel/average_pooling/ap_fwd_kernel.h"
+#include "../core/kernel/average_pooling/ap_bwd_kernel.h"
+
+namespace xsdnn {
+
+/*
+ * 2D average pooling в формате NCHW. Окна и заполнение для padding_mode::same - как у max_pooling.
+ * count_include_pad - учитывать ли точки заполнения в делителе среднего.
+ */
+class average_pooling : public layer {
+public:
+    explicit average_pooling(shape3d in_shape,
+                             size_t kernel_xy,
+                             size_t stride_xy,
+                             padding_mode pad_type = padding_mode::valid,
+                             bool count_include_pad = false,
+                             core::backend_t engine = core::default_backend_engine())
+        : average_pooling(in_shape, kernel_xy, kernel_xy, stride_xy, stride_xy, pad_type, count_include_pad, engine) {}
+
+    explicit average_pooling(shape3d in_shape,
+                             size_t kernel_x,
+                             size_t kernel_y,
+                             size_t stride_x,
+                             size_t stride_y,
+                             padding_mode pad_type = padding_mode::valid,
+                             bool count_include_pad = false,
+                             core::backend_t engine = core::default_backend_engine())
+        : layer({tensor_type::data}, {tensor_type::data}) {
+        set_params(in_shape.C, in_shape.H, in_shape.W, kernel_x, kernel_y, stride_x, stride_y, pad_type,
+                   count_include_pad);
+        init_backend(engine);
+    }
+
+public:
+    std::vector<shape3d> in_shape() const;
+    std::vector<shape3d> out_shape() const;
+    std::string layer_type() const;
+
+    void
+    forward_propagation(const std::vector<tensor_t*>& in_data,
+                        std::vector<tensor_t*>& out_data);
+
+    void
+    back_propagation(const std::vector<tensor_t*>& in_data,
+                     const std::vector<tensor_t*>& out_data,
+                     std::vector<tensor_t*>&       out_grad,
+                     std::vector<tensor_t*>&       in_grad);
+
+public:
+    const params::avg_pool& get_params() const;
+
+private:
+    void set_params(size_t channels,
+                    size_t height,
+                    size_t width,
+                    size_t kernel_x,
+                    size_t kernel_y,
+                    size_t stride_x,
+                    size_t stride_y,
+                    padding_mode pad_type,
+                    bool count_include_pad);
+
+    void init_backend(core::backend_t engine);
+
+private:
+    params::avg_pool params_;
+    core::OpContext fwd_ctx_;
+    core::OpContext bwd_ctx_;
+    std::shared_ptr<core::AvgPoolingFwdKernel> fwd_kernel_;
+    std::shared_ptr<core::AvgPoolingBwdKernel> bwd_kernel_;
+    friend struct cerial;
+};
+
+} // xsdnn
+
+#endif //XSDNN_AVERAGE_POOLING_H
@@ -27,6 +27,8 @@ public:
     std::vector<shape3d> in_shape() const;
     std::vector<shape3d> out_shape() const;
     std::string layer_type() const;
+    bool set_layout(tensor_layout layout);
+    bool streamable() const;
 
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
@@ -39,6 +41,19 @@ public:
                      std::vector<tensor_t*>&       in_grad);
 
     void post_update();
+    void weights_changed();
+
+    /*
+     * Поканальное преобразование inference режима y = scale[c] * x + shift[c]:
+     * scale = gamma / stddev, shift = beta - mean * scale. Возвращает false в режиме
+     * обучения и до появления статистик.
+     */
+    bool inference_scale_shift(mat_t& scale, mat_t& shift);
+
+    /*
+     * Задает статистики inference режима: среднее и stddev = sqrt(var + eps) по каналам.
+     */
+    void set_statistics(const mat_t& mean, const mat_t& stddev);
 
 private:
     void set_params(mm_scalar momentum, mm_scalar epsilon, op_mode phase);
@@ -50,6 +65,8 @@ private:
     core::OpContext bwd_ctx_;
     std::shared_ptr<core::BatchNormalizationFwdKernel> fwd_kernel_;
     std::shared_ptr<core::BatchNormalizationBwdKernel> bwd_kernel_;
+
+    friend struct cerial;
 };
 
 } // xsdnn
@@ -0,0 +1,74 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_BINARY_LAYER_H
+#define XSDNN_BINARY_LAYER_H
+
+#include "layer.h"
+#include "../utils/broadcaster.h"
+
+namespace xsdnn {
+
+/*
+ * Поэлементная бинарная операция двух входов с broadcasting'ом (см. broadcast_plan):
+ * формы выравниваются по осям (C, H, W), ось размера 1 повторяется вдоль другого входа.
+ */
+class binary_layer : public layer {
+public:
+    explicit binary_layer();
+    explicit binary_layer(size_t dim);
+    explicit binary_layer(shape3d shape);
+    explicit binary_layer(shape3d in_shape0, shape3d in_shape1);
+
+public:
+    /*
+     * Задает одинаковую форму обоих входов.
+     */
+    void set_in_shape(const shape3d in_shape) override;
+
+    std::vector<shape3d> in_shape() const override;
+    std::vector<shape3d> out_shape() const override;
+
+    /*
+     * Broadcasting зависит от порядка осей, поэтому слой чувствителен к формату, если формы
+     * входов различаются и ни один из них не скаляр.
+     */
+    bool layout_sensitive() const override;
+
+    void
+    forward_propagation(const std::vector<tensor_t*>& in_data,
+                        std::vector<tensor_t*>& out_data) override;
+
+    void
+    back_propagation(const std::vector<tensor_t*>& in_data,
+                     const std::vector<tensor_t*>& out_data,
+                     std::vector<tensor_t*>&       out_grad,
+                     std::vector<tensor_t*>&       in_grad) override;
+
+    virtual mmpack::MmBinaryOpType binary_op() const = 0;
+
+    std::string layer_type() const override = 0;
+
+private:
+    shape3d in_shape0_;
+    shape3d in_shape1_;
+    broadcast_plan plan_;
+};
+
+/*
+ * Градиенты op по входам одного образца: градиент повторенного значения - сумма по всем его повторам.
+ */
+void binary_backward(mmpack::MmBinaryOpType op,
+                     const broadcast_plan& plan,
+                     const mat_t& in0,
+                     const mat_t& in1,
+                     const mat_t& out,
+                     const mat_t& out_grad,
+                     mat_t& in_grad0,
+                     mat_t& in_grad1);
+
+} // xsdnn
+
+#endif //XSDNN_BINARY_LAYER_H
@@ -0,0 +1,69 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_CONV_TRANSPOSE_H
+#define XSDNN_CONV_TRANSPOSE_H
+
+#include "layer.h"
+#include "../utils/util.h"
+#include "../core/framework/params.h"
+#include "../core/kernel/conv_transpose/conv_transpose_fwd_kernel.h"
+#include "../core/kernel/conv_transpose/conv_transpose_bwd_kernel.h"
+
+namespace xsdnn {
+
+class conv_transpose : public layer {
+public:
+    explicit conv_transpose (shape3d in_shape,
+                             size_t out_channel,
+                             std::vector<size_t> kernel_shape,
+                             size_t group_count = 1,
+                             bool has_bias = true,
+                             std::vector<size_t> stride_shape = {},
+                             std::vector<size_t> dilation_shape = {},
+                             std::vector<size_t> pads = {},
+                             std::vector<size_t> output_padding = {},
+                             core::backend_t engine = core::default_backend_engine())
+        : layer({define_input_bias_condition(has_bias)}, {tensor_type::data}) {
+        params_.infer_output_requirement_shape(in_shape, out_channel, group_count, has_bias,
+                                               kernel_shape, stride_shape, dilation_shape,
+                                               pads, output_padding);
+        init_backend(engine);
+    }
+
+public:
+    std::vector<shape3d> in_shape() const;
+    std::vector<shape3d> out_shape() const;
+    std::string layer_type() const;
+
+    void
+    forward_propagation(const std::vector<tensor_t*>& in_data,
+                        std::vector<tensor_t*>& out_data);
+
+    void
+    back_propagation(const std::vector<tensor_t*>& in_data,
+                     const std::vector<tensor_t*>& out_data,
+                     std::vector<tensor_t*>&       out_grad,
+                     std::vector<tensor_t*>&       in_grad);
+
+public:
+    params::conv_transpose get_params() const;
+
+private:
+    void init_backend(core::backend_t engine);
+
+private:
+    params::conv_transpose params_;
+    core::OpContext fwd_ctx_;
+    core::OpContext bwd_ctx_;
+    std::shared_ptr<core::ConvTransposeFwdKernel> fwd_kernel_;
+    std::shared_ptr<core::ConvTransposeBwdKernel> bwd_kernel_;
+
+    friend struct cerial;
+};
+
+} // xsdnn
+
+#endif //XSDNN_CONV_TRANSPOSE_H
@@ -10,6 +10,7 @@
 #include "../utils/util.h"
 #include "../core/framework/params.h"
 #include "../core/kernel/conv/conv_fwd_kernel.h"
+#include "../core/kernel/conv/conv_bwd_kernel.h"
 
 namespace xsdnn {
 
@@ -53,6 +54,13 @@ public:
     std::vector<shape3d> in_shape() const;
     std::vector<shape3d> out_shape() const;
     std::string layer_type() const;
+    bool set_layout(tensor_layout layout);
+    bool set_io_layout(tensor_layout in_layout, tensor_layout out_layout);
+    bool streamable() const;
+    void set_stream_state(tensor_t* state);
+    void weights_changed();
+    bool fold_scale_shift(const mat_t& scale, const mat_t& shift);
+    bool reduces_weight_grads() const;
 
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
@@ -67,6 +75,9 @@ public:
 public:
     params::conv get_params() const;
 
+protected:
+    bool fuse_chain(const std::vector<layer*>& chain);
+
 private:
     void set_params(size_t in_channel, size_t in_height, size_t in_width,
                     size_t out_channel, size_t group_count, bool has_bias,
@@ -82,7 +93,9 @@ private:
 private:
     params::conv params_;
     core::OpContext fwd_ctx_;
+    core::OpContext bwd_ctx_;
     std::shared_ptr<core::ConvFwdKernel> fwd_kernel_;
+    std::shared_ptr<core::ConvBwdKernel> bwd_kernel_;
 
     friend struct cerial;
 };
@@ -19,10 +19,11 @@ public:
     fully_connected(size_t in_size,
                     size_t out_size,
                     bool has_bias = true,
+                    MmActivationType activation_type = mmpack::MmActivationType::NotSet,
                     core::backend_t engine = core::default_backend_engine())
             :
             layer(define_input_bias_condition(has_bias), {tensor_type::data}) {
-        set_params(in_size, out_size, has_bias);
+        set_params(in_size, out_size, has_bias, activation_type);
         init_backend(engine);
         layer::set_backend(engine);
     }
@@ -32,6 +33,8 @@ public:
     std::string layer_type() const;
     size_t fan_in_size() const;
     size_t fan_out_size() const;
+    bool fold_scale_shift(const mat_t& scale, const mat_t& shift);
+    bool reduces_weight_grads() const;
 
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
@@ -44,7 +47,7 @@ public:
                      std::vector<tensor_t*>&       in_grad);
 
 private:
-    void set_params(size_t in_size, size_t out_size, bool has_bias);
+    void set_params(size_t in_size, size_t out_size, bool has_bias, MmActivationType activation_type);
     void init_backend(core::backend_t engine);
 
 private:
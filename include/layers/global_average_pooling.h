@@ -8,6 +8,7 @@
 
 #include "layer.h"
 #include "../core/kernel/global_average_pooling/gap_fwd_kernel.h"
+#include "../core/kernel/global_average_pooling/gap_bwd_kernel.h"
 
 namespace xsdnn {
 
@@ -33,6 +34,8 @@ public:
     std::vector<shape3d> in_shape() const;
     std::vector<shape3d> out_shape() const;
     std::string layer_type() const;
+    bool set_layout(tensor_layout layout);
+    bool set_io_layout(tensor_layout in_layout, tensor_layout out_layout);
 
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
@@ -54,7 +57,9 @@ private:
 private:
     params::global_avg_pool params_;
     core::OpContext fwd_ctx_;
+    core::OpContext bwd_ctx_;
     std::shared_ptr<core::GlobalAvgPoolingFwdKernel> fwd_kernel_;
+    std::shared_ptr<core::GlobalAvgPoolingBwdKernel> bwd_kernel_;
     friend struct cerial;
 };
 
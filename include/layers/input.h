@@ -23,6 +23,7 @@ public:
     std::vector<shape3d> in_shape() const;
     std::vector<shape3d> out_shape() const;
     std::string layer_type() const;
+    bool layout_sensitive() const;
 
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
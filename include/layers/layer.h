@@ -80,12 +80,20 @@ public:
             }
         }
         initialized_ = true;
+        weights_changed();
     }
 
     void set_in_data(const std::vector<tensor_t>& data);
     void set_out_grads(const std::vector<tensor_t>& grad);
     void set_trainable(bool trainable);
 
+    /*
+     * Режим обучения включает network::fit. Слои, которым для backward нужны данные
+     * прямого прохода сверх входа и выхода (например, max_pooling), сохраняют их только в нем.
+     */
+    void set_training(bool training);
+    bool training() const;
+
     std::vector<tensor_t> output() const;
 
     std::vector<tensor_type> in_types() const;
@@ -105,6 +113,23 @@ public:
     void
     post_update() {}
 
+    /*
+     * Вызывается после изменения весов: инициализации, загрузки и шага оптимизатора.
+     * Слои, которые хранят веса в формате ядра, сбрасывают его здесь. После записи
+     * весов напрямую через weights() метод нужно вызвать вручную.
+     */
+    virtual
+    void
+    weights_changed() {}
+
+    /*
+     * true, если backward слоя сам суммирует градиенты весов по батчу в первую запись
+     * градиента. Тогда градиенты весов хранятся в одном экземпляре, а не по образцам.
+     */
+    virtual
+    bool
+    reduces_weight_grads() const { return false; }
+
     virtual
     std::vector<shape3d>
     in_shape() const = 0;
@@ -137,6 +162,67 @@ public:
 
     virtual std::pair<mm_scalar, mm_scalar> out_value_range() const;
 
+    /*
+     * Формат данных (NCHW / NHWC / NCHWc), в котором слой принимает и возвращает тензоры.
+     * По умолчанию слой поддерживает только NCHW. Слои, у которых есть NHWC или блочные
+     * ядра, переопределяют set_layout и возвращают true, если формат поддерживается.
+     */
+    virtual
+    bool
+    set_layout(tensor_layout layout);
+
+    /*
+     * Раздельные форматы входа и выхода на границе блочной цепочки NCHWc. По умолчанию
+     * форматы должны совпадать (см. set_layout). Слой, который сам переупорядочивает
+     * вход или выход, переопределяет метод.
+     */
+    virtual
+    bool
+    set_io_layout(tensor_layout in_layout, tensor_layout out_layout);
+
+    /*
+     * Поэлементные слои не зависят от порядка хранения данных и возвращают false.
+     */
+    virtual
+    bool
+    layout_sensitive() const;
+
+    /*
+     * Потоковый режим (см. InfSession::CreateStream): вход подается частями вдоль оси W.
+     * Слой, которому нужен контекст предыдущих частей, хранит его в состоянии потока,
+     * которым владеет InfSession (по одному mat_t на образец). По умолчанию в потоковом
+     * режиме могут работать только поэлементные слои.
+     */
+    virtual
+    bool
+    streamable() const;
+
+    virtual
+    void
+    set_stream_state(tensor_t* state);
+
+    /*
+     * Слияние слоев для inference: слой берет на себя цепочку chain следующих за ним слоев
+     * (каждый - единственный потребитель выхода предыдущего) и пишет результат сразу в выход
+     * последнего из них, а слои цепочки в forward пропускаются. Возвращает false, если слой
+     * не умеет сливаться с такой цепочкой (см. fuse_chain). unfuse отменяет слияние.
+     */
+    bool fuse(const std::vector<layer*>& chain);
+    void unfuse();
+
+    /*
+     * Слой поглощен предыдущим слоем и не выполняется в forward.
+     */
+    bool absorbed() const;
+
+    /*
+     * Сворачивает следующее за слоем поканальное преобразование y = scale[c] * x + shift[c]
+     * (c - канал выхода слоя) в веса и смещение слоя. Возвращает false, если слой так не умеет.
+     */
+    virtual
+    bool
+    fold_scale_shift(const mat_t& scale, const mat_t& shift);
+
     /*
      * Forward \ backward propagation
      */
@@ -169,6 +255,21 @@ public:
     virtual
     void set_sample_count(size_t sample_count);
 
+protected:
+    /*
+     * Переопределяется слоями, у которых есть слитые ядра: настраивает ядро на цепочку chain.
+     * Пустая цепочка возвращает слой к обычному выполнению.
+     */
+    virtual
+    bool
+    fuse_chain(const std::vector<layer*>& chain);
+
+    /*
+     * Добавляет слою без смещения входной концепт смещения, заполненный нулями.
+     * in_shape() слоя к этому моменту уже должен описывать смещение.
+     */
+    void add_bias_concept();
+
 public:
     friend void connection_mismatch(const layer& from,
                                     const layer& to);
@@ -192,6 +293,7 @@ protected:
 
 private:
     bool trainable_;
+    bool training_;
     mat_t weight_diff_helper_;
     core::backend_t engine_;
     std::shared_ptr<weight_init::function> weight_init_;
@@ -204,6 +306,9 @@ private:
     std::vector<tensor_t*> bwd_out_data;
     std::vector<tensor_t*> bwd_out_grad;
 
+    std::vector<layer*> fused_chain_;
+    layer* fused_into_;
+
     friend class GradChecker;
 };
 
@@ -16,14 +16,28 @@
 #include "flatten.h"
 #include "batch_normalization.h"
 #include "max_pooling.h"
+#include "average_pooling.h"
 #include "mul.h"
+#include "sub.h"
+#include "div.h"
+#include "min.h"
+#include "max.h"
+#include "pow.h"
 #include "global_average_pooling.h"
 #include "reshape.h"
 #include "implicit_reshape.h"
 #include "convolution.h"
+#include "conv_transpose.h"
 
 
 #include "activations/relu.h"
 #include "activations/hard_sigmoid.h"
+#include "activations/sigmoid.h"
+#include "activations/tanh.h"
+#include "activations/gelu.h"
+#include "activations/silu.h"
+#include "activations/leaky_relu.h"
+#include "activations/elu.h"
+#include "activations/softmax.h"
 
 #endif //XSDNN_LAYERS_H
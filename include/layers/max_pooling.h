@@ -8,6 +8,7 @@
 
 #include "layer.h"
 #include "../core/kernel/max_pool/mp_fwd_kernel.h"
+#include "../core/kernel/max_pool/mp_bwd_kernel.h"
 
 namespace xsdnn {
 
@@ -60,6 +61,8 @@ public:
     std::vector<shape3d> in_shape() const;
     std::vector<shape3d> out_shape() const;
     std::string layer_type() const;
+    bool set_layout(tensor_layout layout);
+    bool streamable() const;
 
     void
     forward_propagation(const std::vector<tensor_t*>& in_data,
@@ -71,6 +74,9 @@ public:
                      std::vector<tensor_t*>&       out_grad,
                      std::vector<tensor_t*>&       in_grad);
 
+public:
+    const params::max_pool& get_params() const;
+
 private:
     void set_params(size_t channels,
                     size_t height,
@@ -84,16 +90,12 @@ private:
 
     void init_backend(core::backend_t engine);
 
-    /*
-     * Сопоставление индексов входа и выхода, из которых будет браться максимум
-     */
-    void connect_inout_idx(size_t c, size_t y, size_t x);
-    void connect_inout_idx_loop();
-
 private:
-    params::max_pool params_; // TODO: нужен ли in2out???
+    params::max_pool params_;
     core::OpContext fwd_ctx_;
+    core::OpContext bwd_ctx_;
     std::shared_ptr<core::MaxPoolingFwdKernel> fwd_kernel_;
+    std::shared_ptr<core::MaxPoolingBwdKernel> bwd_kernel_;
     friend struct cerial;
 };
 
@@ -0,0 +1,28 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_MIN_H
+#define XSDNN_MIN_H
+
+#include "binary_layer.h"
+
+namespace xsdnn {
+
+/*
+ * min(A, B), при равенстве выбирается A.
+ */
+class min : public binary_layer {
+public:
+    using binary_layer::binary_layer;
+
+public:
+    mmpack::MmBinaryOpType binary_op() const override;
+
+    std::string layer_type() const override;
+};
+
+} // xsdnn
+
+#endif //XSDNN_MIN_H
@@ -6,37 +6,21 @@
 #ifndef XSDNN_MUL_H
 #define XSDNN_MUL_H
 
-#include "layer.h"
+#include "binary_layer.h"
 
 namespace xsdnn {
 
-class mul : public layer {
-    explicit mul()
-        : layer({tensor_type::data, tensor_type::data}, {tensor_type::data}), in_shape_() {}
-
-    explicit mul(size_t dim)
-        : layer({tensor_type::data, tensor_type::data}, {tensor_type::data}), in_shape_(1, 1, dim) {}
-
-    explicit mul(shape3d in_shape)
-        : layer({tensor_type::data, tensor_type::data}, {tensor_type::data}), in_shape_(in_shape) {}
+/*
+ * A * B.
+ */
+class mul : public binary_layer {
+public:
+    using binary_layer::binary_layer;
 
 public:
-    std::vector<shape3d> in_shape() const;
-    std::vector<shape3d> out_shape() const;
-    std::string layer_type() const;
-
-    void
-    forward_propagation(const std::vector<tensor_t*>& in_data,
-                        std::vector<tensor_t*>& out_data);
-
-    void
-    back_propagation(const std::vector<tensor_t*>& in_data,
-                     const std::vector<tensor_t*>& out_data,
-                     std::vector<tensor_t*>&       out_grad,
-                     std::vector<tensor_t*>&       in_grad);
-
-private:
-    shape3d in_shape_;
+    mmpack::MmBinaryOpType binary_op() const override;
+
+    std::string layer_type() const override;
 };
 
 } // xsdnn
@@ -0,0 +1,28 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_POW_H
+#define XSDNN_POW_H
+
+#include "binary_layer.h"
+
+namespace xsdnn {
+
+/*
+ * A в степени B (см. погрешность MmBinary).
+ */
+class pow : public binary_layer {
+public:
+    using binary_layer::binary_layer;
+
+public:
+    mmpack::MmBinaryOpType binary_op() const override;
+
+    std::string layer_type() const override;
+};
+
+} // xsdnn
+
+#endif //XSDNN_POW_H
@@ -20,14 +20,26 @@ public:
 public:
     virtual mm_scalar f(const mat_t& y, const mat_t& a) = 0;
     virtual void df(const mat_t& y, const mat_t& a, mat_t& dst) = 0;
+
+    /*
+     * true - метка a задается номером класса (a = { label }), а не вектором размера выхода,
+     * и network::train не разворачивает метки в one-hot.
+     */
+    virtual bool index_labels() const;
 };
 
 void gradient(loss* l_ptr, const mat_t& y, const mat_t& a, mat_t& dst);
 void gradient(loss* l_ptr, const tensor_t& y, const tensor_t& a, tensor_t& dst);
+
+/*
+ * Градиенты образцов независимы, при parallelize они считаются параллельно.
+ */
 void gradient(loss* l_ptr,
               const std::vector<tensor_t>& y,
               const std::vector<tensor_t>& a,
-              std::vector<tensor_t>& dst);
+              std::vector<tensor_t>& dst,
+              bool parallelize = false,
+              size_t nthreads = 1);
 
 
 } // xsdnn
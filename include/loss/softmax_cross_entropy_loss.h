@@ -0,0 +1,33 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_SOFTMAX_CROSS_ENTROPY_LOSS_H
+#define XSDNN_SOFTMAX_CROSS_ENTROPY_LOSS_H
+
+#include "loss_base.h"
+
+namespace xsdnn {
+
+/*
+ * Кросс-энтропия со встроенным softmax: выход сети - логиты, а метка - номер класса,
+ * записанный одним значением в a (a = { label }). Градиент softmax(y) - onehot(label)
+ * считается вместе со значением потерь без one-hot векторов.
+ */
+class softmax_cross_entropy_loss : public loss {
+public:
+    softmax_cross_entropy_loss();
+    softmax_cross_entropy_loss(const softmax_cross_entropy_loss&);
+    softmax_cross_entropy_loss& operator=(const softmax_cross_entropy_loss&);
+    ~softmax_cross_entropy_loss() override;
+
+public:
+    mm_scalar f(const mat_t& y, const mat_t& a) override;
+    void df(const mat_t& y, const mat_t& a, mat_t& dst) override;
+    bool index_labels() const override;
+};
+
+} // xsdnn
+
+#endif //XSDNN_SOFTMAX_CROSS_ENTROPY_LOSS_H
@@ -99,7 +99,10 @@ namespace mmpack {
 
 struct MM_CONV_PARAMS {
     enum MmConvAlgorithm {
-        Im2ColThenGemm = 0
+        Im2ColThenGemm = 0,
+        Indirect = 1,
+        NchwcDirect = 2,
+        Direct1D = 3
     };
 
     size_t Dimensions;
@@ -118,12 +121,14 @@ struct MM_CONV_PARAMS {
     MmConvAlgorithm Algorithm;
     bool Bias;
     size_t TemproraryBufferSize;
+    const uint32_t* Indirection;
+    const float* PackedFilter;
 };
 /*++
 
 Описание параметров свертки:
 
-    Dimensions - размерность свертки: поддерживается только 2D. 1D будет добавлена позже.
+    Dimensions - размерность свертки: 1D или 2D.
 
     GroupCount - кол-во групп, на которые необходимо разбить связи входных и выходных каналов.
 
@@ -139,7 +144,7 @@ struct MM_CONV_PARAMS {
 
     K - абсолютная длина всех ядер для каждой группы.
 
-    Padding - кол-во заполнений в формате (y_begin, x_begin, y_end, x_end).
+    Padding - кол-во заполнений в формате (y_begin, x_begin, y_end, x_end), для 1D - (x_begin, x_end).
 
     KernelShape - пространственные размеры ядра.
 
@@ -149,11 +154,48 @@ struct MM_CONV_PARAMS {
 
     FilterCount - кол-во ядер в каждой группе.
 
-    Algorithm - алгоритм для выполнения свертки.
+    Algorithm - алгоритм для выполнения свертки:
+        Im2ColThenGemm - упаковка входа в матрицу Im2Col по частям и вызов MmGemm;
+        Indirect - чтение входа через таблицу косвенной адресации без построения матрицы Im2Col, только 2D;
+        NchwcDirect - прямая свертка в блочном формате NCHWc (см. MmConvNchwc), только 2D;
+        Direct1D - прямая одномерная свертка без временного буфера, только 1D с шагом 1.
 
     Bias - наличие смещения.
 
-    TemprorayBufferSize - размер временного буфера для упаковки результатов Im2Col.
+    TemprorayBufferSize - размер временного буфера: для Im2ColThenGemm - под упаковку результатов Im2Col,
+        для Indirect - под панель входных точек (см. MmConvIndirectBufferSize),
+        для NchwcDirect - под вход, фильтры и выход в формате NCHWc (см. MmConvNchwcBufferSize),
+        для Direct1D буфер не используется.
+
+    Indirection - таблица косвенной адресации для алгоритма Indirect (см. MmConvIndirectionBuffer).
+        Зависит только от формы слоя, поэтому строится один раз владельцем параметров.
+
+    PackedFilter - опциональные фильтры, заранее переупорядоченные MmConvPackFilter под алгоритм
+        (или под MmConvNhwc). nullptr - ядро переупорядочивает фильтры при каждом вызове.
+--*/
+
+struct MM_POOL_PARAMS {
+    size_t InShape[2];
+    size_t KernelShape[2];
+    size_t StrideShape[2];
+    size_t Padding[4];
+    size_t OutShape[2];
+};
+/*++
+
+Описание параметров max pooling'а (2D, формат NCHW):
+
+    InShape - пространственные размеры входа [Hin, Win].
+
+    KernelShape - пространственные размеры окна [KH, KW].
+
+    StrideShape - пространственные размеры шага [SH, SW].
+
+    Padding - кол-во заполнений в формате (y_begin, x_begin, y_end, x_end). Заполненные точки
+        не участвуют в максимуме.
+
+    OutShape - пространственные размеры выхода [Hout, Wout]. Окно (y, x) начинается в точке
+        (y * SH - y_begin, x * SW - x_begin) и обрезается по границе входа.
 --*/
 
 #if !defined(MM_USE_DOUBLE)
@@ -294,6 +336,39 @@ MmMulAdd(
 #error NotImplementedYet
 #endif
 
+void
+MmTranspose(
+        const float* A,
+        float* B,
+        size_t M,
+        size_t N
+);
+/*++
+
+Описание процедуры:
+
+    B := A^T, где A - матрица M x N, B - матрица N x M.
+
+    Используется для смены формата изображений на границах модели:
+        NCHW -> NHWC: MmTranspose(Source, Destination, C, H * W);
+        NHWC -> NCHW: MmTranspose(Source, Destination, H * W, C).
+
+Аргументы:
+
+    A - указатель на исходную матрицу.
+
+    B - указатель на результирующую матрицу. Не должен пересекаться с A.
+
+    M - кол-во строк матрицы A.
+
+    N - кол-во столбцов матрицы A.
+
+Return Value:
+
+    None.
+
+--*/
+
 /*
  * Convolution routines
  */
@@ -311,8 +386,7 @@ MmConv(
 
 Описание процедуры:
 
-    Процедура выполняет свертку последовательности. Поддерживается только 2D операция.
-    1D операция будет добавлена в следующих версиях.
+    Процедура выполняет 1D или 2D свертку последовательности. 1D вход имеет форму [C][Win].
 
 Аргументы:
 
@@ -324,7 +398,8 @@ MmConv(
 
     Bias - опциональное смещение к результату свертки.
 
-    TemporaryBuffer - буфер для результата выполнения алгоритма Im2Col.
+    TemporaryBuffer - временный буфер размера Parameters->TemproraryBufferSize.
+        Для алгоритма Indirect также должна быть построена таблица Parameters->Indirection.
 
     Output - буфер для результата свертки.
 
@@ -334,56 +409,305 @@ Return Value:
 
 --*/
 
-/*
- * Activation Routines
- */
+size_t
+MmConvIndirectionBufferSize(
+        const MM_CONV_PARAMS* Parameters
+);
+/*++
 
-enum MmActivationType {
-    NotSet,
-    Relu,
-    HardSigmoid
-};
+Описание процедуры:
 
-struct MmActivationHolder {
-    MmActivationType ActivationType;
-    union {
-        struct {
-            float alpha;
-            float beta;
-        } HardSigmoid;
-    } Parameters;
-};
+    Возвращает кол-во элементов таблицы косвенной адресации: KernelHeight * KernelWidth * OutSize.
+
+--*/
 
 void
-MmSetDefaultActivationParameters(
-        MmActivationHolder* Holder
+MmConvIndirectionBuffer(
+        const MM_CONV_PARAMS* Parameters,
+        uint32_t* Indirection
+);
+/*++
+
+Описание процедуры:
+
+    Строит таблицу косвенной адресации для алгоритма Indirect. Для каждой
+    позиции ядра (ky, kx) и каждой выходной точки n таблица хранит смещение
+    соответствующего входного пикселя внутри одного канала. Точки, попадающие
+    в область заполнения, указывают на нулевую строку, которая читается с шагом 0
+    по каналам. Таблица одинакова для всех каналов, групп и изображений.
+
+Аргументы:
+
+    Parameters - контейнер параметров свертки.
+
+    Indirection - буфер размера MmConvIndirectionBufferSize(Parameters).
+
+Return Value:
+
+    None.
+
+--*/
+
+size_t
+MmConvIndirectBufferSize(
+        const MM_CONV_PARAMS* Parameters
 );
+/*++
+
+Описание процедуры:
+
+    Возвращает размер временного буфера (в элементах float) для алгоритма Indirect:
+    панель из K строк по 8 выходных точек.
+
+--*/
 
 void
-MmActivation(
-    MmActivationHolder* Activation,
-    float* C,
-    size_t M,
-    size_t N,
-    size_t ldc
+MmConvNhwc(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weight,
+        const float* Bias,
+        float* TemporaryBuffer,
+        float* Output
 );
 /*++
 
 Описание процедуры:
 
-    Применяет In-Place функцию активации в входному буферу C.
+    Свертка изображения в формате NHWC. Строки матрицы Im2Col в этом формате
+    состоят из непрерывных векторов каналов, поэтому упаковка сводится к копированию
+    строк, а точечная свертка (1x1, шаг 1, без заполнения) выполняется одним вызовом MmGemm
+    прямо по входу.
 
 Аргументы:
 
-    Activation - набор параметров для выполнения активации.
+    Parameters - контейнер параметров свертки.
 
-    C - входной буффер.
+    Input - вход в формате [H][W][C].
 
-    M - кол-во строк во входном буффере С.
+    Weight - фильтры в обычном формате [GroupCount * FilterCount][InChannel][KH][KW].
 
-    N - кол-во столбцов во входном буффере С.
+    Bias - опциональное смещение.
 
-    ldc - лидирующее измерение входного буффера С.
+    TemporaryBuffer - временный буфер размера MmConvNhwcBufferSize(Parameters).
+
+    Output - выход в формате [Hout][Wout][GroupCount * FilterCount].
+
+Return Value:
+
+    None.
+
+--*/
+
+size_t
+MmConvNhwcBufferSize(
+        const MM_CONV_PARAMS* Parameters
+);
+/*++
+
+Описание процедуры:
+
+    Возвращает размер временного буфера (в элементах float) для MmConvNhwc:
+    переупорядоченные фильтры одной группы и часть строк матрицы Im2Col.
+
+--*/
+
+size_t
+MmConvPackedFilterSize(
+        const MM_CONV_PARAMS* Parameters,
+        bool Nhwc
+);
+/*++
+
+Описание процедуры:
+
+    Возвращает размер (в элементах float) фильтров всех групп в формате, который читает ядро:
+    блочный формат MmReorderFilterNchwc для NchwcDirect или [FilterCount][KH][KW][InChannel]
+    для MmConvNhwc (Nhwc = true). 0 - алгоритм читает фильтры в исходном формате.
+
+--*/
+
+void
+MmConvPackFilter(
+        const MM_CONV_PARAMS* Parameters,
+        bool Nhwc,
+        const float* Weight,
+        float* PackedFilter
+);
+/*++
+
+Описание процедуры:
+
+    Переупорядочивает фильтры всех групп для ядра один раз. Результат передается в
+    Parameters->PackedFilter и действителен, пока не изменятся веса, алгоритм или формат.
+
+Аргументы:
+
+    Parameters - контейнер параметров свертки.
+
+    Nhwc - фильтры для MmConvNhwc.
+
+    Weight - фильтры [GroupCount * FilterCount][InChannel][KH][KW].
+
+    PackedFilter - буфер размера MmConvPackedFilterSize(Parameters, Nhwc).
+
+Return Value:
+
+    None.
+
+--*/
+
+void
+MmConvBackward(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weight,
+        const float* OutputGrad,
+        float* InputGrad,
+        float* WeightGrad,
+        float* BiasGrad,
+        float* TemporaryBuffer,
+        size_t Group
+);
+/*++
+
+Описание процедуры:
+
+    Обратный проход 1D / 2D свертки в формате NCHW для одной группы одного изображения.
+    Выход обрабатывается частями по столбцам матрицы Im2Col:
+        dW += dY * Im2Col(X)^T,
+        dX += Col2Im(W^T * dY),
+        dB += сумма dY по пространственным точкам.
+    Группы пишут в непересекающиеся части градиентов, поэтому их можно считать параллельно.
+
+Аргументы:
+
+    Parameters - контейнер параметров свертки.
+
+    Input - вход прямого прохода (все группы).
+
+    Weight - фильтры (все группы).
+
+    OutputGrad - градиент по выходу свертки (все группы).
+
+    InputGrad - градиент по входу, результат прибавляется. nullptr - не считать.
+
+    WeightGrad - градиент по фильтрам, результат прибавляется. nullptr - не считать.
+
+    BiasGrad - градиент по смещению, результат прибавляется. nullptr - не считать.
+
+    TemporaryBuffer - временный буфер размера MmConvBackwardBufferSize(Parameters).
+
+    Group - номер группы.
+
+Return Value:
+
+    None.
+
+--*/
+
+size_t
+MmConvBackwardBufferSize(
+        const MM_CONV_PARAMS* Parameters
+);
+/*++
+
+Описание процедуры:
+
+    Возвращает размер временного буфера (в элементах float) для MmConvBackward:
+    часть матрицы Im2Col из K строк.
+
+--*/
+
+void
+MmConvTranspose(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weight,
+        const float* Bias,
+        float* TemporaryBuffer,
+        float* Output
+);
+/*++
+
+Описание процедуры:
+
+    Транспонированная свертка (деконволюция) одного изображения: Output = Col2Im(W^T * Input) + Bias.
+    Совпадает с градиентом по входу обычной свертки, поэтому Parameters описывают
+    эквивалентную свертку, у которой вход - выход транспонированной свертки, и наоборот.
+    Шаг 2 по ширине обрабатывается отдельной векторной веткой Col2Im.
+
+Аргументы:
+
+    Parameters - параметры эквивалентной свертки (InChannel * GroupCount - выходные каналы,
+        FilterCount * GroupCount - входные каналы).
+
+    Input - вход [GroupCount * FilterCount][OutShape].
+
+    Weight - фильтры [GroupCount * FilterCount][InChannel][KH][KW].
+
+    Bias - опциональное смещение по выходным каналам.
+
+    TemporaryBuffer - временный буфер размера MmConvBackwardBufferSize(Parameters).
+
+    Output - выход [GroupCount * InChannel][InShape].
+
+Return Value:
+
+    None.
+
+--*/
+
+/*
+ * NCHWc routines
+ */
+
+size_t
+MmNchwcGetBlockSize();
+/*++
+
+Описание процедуры:
+
+    Возвращает размер блока каналов формата NCHWc. Блок равен ширине
+    SIMD вектора: 4 для SSE.
+
+--*/
+
+size_t
+MmNchwcBlockedChannels(
+        size_t Channels
+);
+/*++
+
+Описание процедуры:
+
+    Возвращает кол-во каналов, округленное вверх до кратного размеру блока NCHWc.
+
+--*/
+
+void
+MmReorderInputNchw(
+        const float* Source,
+        float* Destination,
+        size_t Channels,
+        size_t Size
+);
+/*++
+
+Описание процедуры:
+
+    Переупорядочивает тензор из формата NCHW в NCHWc: [C / B][H][W][B].
+    Недостающие каналы последнего блока заполняются нулями.
+
+Аргументы:
+
+    Source - тензор в формате NCHW.
+
+    Destination - буфер размера MmNchwcBlockedChannels(Channels) * Size.
+
+    Channels - кол-во каналов.
+
+    Size - пространственный размер одного канала (H * W).
 
 Return Value:
 
@@ -391,6 +715,940 @@ Return Value:
 
 --*/
 
+void
+MmReorderOutputNchw(
+        const float* Source,
+        float* Destination,
+        size_t Channels,
+        size_t Size
+);
+/*++
+
+Описание процедуры:
+
+    Обратное к MmReorderInputNchw преобразование: NCHWc -> NCHW.
+    Каналы, добавленные для выравнивания блока, отбрасываются.
+
+--*/
+
+void
+MmReorderFilterNchwc(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Filter,
+        float* Destination
+);
+/*++
+
+Описание процедуры:
+
+    Переупорядочивает фильтры одной группы из формата [FilterCount][InChannel][KH][KW]
+    в блочный формат [FilterCount / B][InChannel / B][KH][KW][B in][B out].
+
+--*/
+
+void
+MmConvNchwc(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Output
+);
+/*++
+
+Описание процедуры:
+
+    Прямая свертка одной группы в блочном формате NCHWc. Векторизация выполняется
+    по блоку выходных каналов, поэтому ядру не нужно собирать значения между каналами.
+    Цепочка сверток может работать в этом формате без промежуточных переупорядочиваний.
+
+Аргументы:
+
+    Parameters - контейнер параметров свертки.
+
+    Input - вход в формате NCHWc (см. MmReorderInputNchw).
+
+    Filter - фильтры в формате MmReorderFilterNchwc.
+
+    Bias - опциональное смещение.
+
+    Output - выход в формате NCHWc.
+
+Return Value:
+
+    None.
+
+--*/
+
+size_t
+MmConvNchwcBufferSize(
+        const MM_CONV_PARAMS* Parameters
+);
+/*++
+
+Описание процедуры:
+
+    Возвращает размер временного буфера (в элементах float) для алгоритма NchwcDirect.
+
+--*/
+
+void
+MmConvNchwcLayout(
+        const MM_CONV_PARAMS* Parameters,
+        bool InputBlocked,
+        bool OutputBlocked,
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Buffer,
+        float* Output
+);
+/*++
+
+Описание процедуры:
+
+    Свертка всех групп для модели, которая хранит промежуточные тензоры в формате NCHWc
+    (tensor_layout::nchwc). Вход и выход переупорядочиваются только на границах блочной
+    цепочки, а фильтры берутся из Parameters->PackedFilter (см. MmConvPackFilter для NchwcDirect).
+
+Аргументы:
+
+    Parameters - контейнер параметров свертки.
+
+    InputBlocked - вход уже в формате NCHWc, иначе в NCHW. Блочный вход требует
+        InChannel, кратного размеру блока.
+
+    OutputBlocked - выход записывается в формате NCHWc, иначе в NCHW. Блочный выход
+        требует FilterCount, кратного размеру блока.
+
+    Input - вход.
+
+    Filter - фильтры в формате [FilterCount][InChannel][KH][KW], используются,
+        только если Parameters->PackedFilter = nullptr.
+
+    Bias - опциональное смещение.
+
+    Buffer - временный буфер размера MmConvNchwcLayoutBufferSize.
+
+    Output - выход.
+
+Return Value:
+
+    None.
+
+--*/
+
+size_t
+MmConvNchwcLayoutBufferSize(
+        const MM_CONV_PARAMS* Parameters,
+        bool InputBlocked,
+        bool OutputBlocked
+);
+/*++
+
+Описание процедуры:
+
+    Возвращает размер временного буфера (в элементах float) для MmConvNchwcLayout.
+
+--*/
+
+/*
+ * Math Routines
+ *
+ * Поэлементные функции Output[i] = f(Input[i]) для N значений, Input и Output могут
+ * совпадать. Ядра написаны на векторных обертках Mm_Float32x4 (SSE), без SSE используется
+ * libm. Погрешность указана относительно точного значения в ULP результата и проверяется
+ * тестом mmpack_math_test. Денормализованные аргументы и результаты зависят от режима FTZ/DAZ
+ * процесса (сборка с -ffast-math их обнуляет).
+ */
+
+void
+MmExp(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    exp(x), погрешность не более 1.5 ULP. x > 88.72 дает +inf, x < -103.97 дает 0.
+
+--*/
+
+void
+MmLog(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    Натуральный логарифм, погрешность не более 1 ULP. log(0) = -inf, log(+inf) = +inf,
+    log(x < 0) = NaN.
+
+--*/
+
+void
+MmTanh(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    tanh(x), погрешность не более 1.5 ULP.
+
+--*/
+
+void
+MmSigmoid(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    1 / (1 + exp(-x)), погрешность не более 3.5 ULP. При x < -87 результат
+    денормализован или равен 0.
+
+--*/
+
+void
+MmErf(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    Функция ошибок erf(x), погрешность не более 1.5 ULP.
+
+--*/
+
+void
+MmAcos(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    acos(x) для x из [-1, 1], погрешность не более 1.5 ULP. Вне отрезка - NaN.
+
+--*/
+
+void
+MmSqrt(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    Квадратный корень, округление корректное (0.5 ULP).
+
+--*/
+
+void
+MmRsqrt(const float* Input, float* Output, size_t N);
+/*++
+
+Описание процедуры:
+
+    1 / sqrt(x), погрешность не более 1.5 ULP. Считается делением, а не приближенной
+    инструкцией rsqrtps, чтобы точность не зависела от процессора.
+
+--*/
+
+/*
+ * Binary Routines
+ *
+ * Поэлементные операции C[i] = A[i] op B[i] для N значений, C может совпадать с A или B.
+ * Broadcasting входов разных форм строится поверх этих ядер (см. xsdnn::broadcast_plan).
+ */
+
+enum MmBinaryOpType {
+    MmBinaryAdd,
+    MmBinarySub,
+    MmBinaryMul,
+    MmBinaryDiv,
+    MmBinaryMin,
+    MmBinaryMax,
+    MmBinaryPow
+};
+
+void
+MmBinary(
+        MmBinaryOpType Op,
+        const float* A,
+        const float* B,
+        float* C,
+        size_t N
+);
+/*++
+
+Описание процедуры:
+
+    C[i] = A[i] op B[i]. Add, Sub, Mul, Div, Min и Max считаются точно. Pow для конечных
+    A > 0 считается как exp(B * log(A)), относительная погрешность растет с |B * log(A)|
+    примерно как |B * log(A)| * 2^-23; остальные основания считаются через libm.
+    При равенстве Min и Max возвращают A.
+
+Аргументы:
+
+    Op - операция.
+
+    A, B - входы, N значений.
+
+    C - результат, N значений.
+
+    N - размер векторов.
+
+--*/
+
+void
+MmBinaryScalarA(
+        MmBinaryOpType Op,
+        float A,
+        const float* B,
+        float* C,
+        size_t N
+);
+/*++
+
+Описание процедуры:
+
+    C[i] = A op B[i].
+
+--*/
+
+void
+MmBinaryScalarB(
+        MmBinaryOpType Op,
+        const float* A,
+        float B,
+        float* C,
+        size_t N
+);
+/*++
+
+Описание процедуры:
+
+    C[i] = A[i] op B.
+
+--*/
+
+/*
+ * Loss Routines
+ */
+
+float
+MmSoftmaxCrossEntropy(
+        const float* Input,
+        size_t Label,
+        size_t N,
+        float* Gradient
+);
+/*++
+
+Описание процедуры:
+
+    Кросс-энтропия softmax'а логитов Input с меткой класса Label: -log(softmax(Input)[Label]).
+    log-sum-exp считается со сдвигом на максимум, поэтому результат конечен при любых
+    конечных логитах.
+
+Аргументы:
+
+    Input - логиты, N значений.
+
+    Label - номер верного класса, Label < N.
+
+    N - кол-во классов.
+
+    Gradient - если не nullptr, сюда пишется градиент по логитам softmax(Input) - onehot(Label).
+
+Return Value:
+
+    Значение функции потерь.
+
+--*/
+
+void
+MmSoftmax(
+        const float* Input,
+        float* Output,
+        size_t N
+);
+/*++
+
+Описание процедуры:
+
+    Output = exp(Input - logsumexp(Input)). Сумма экспонент считается со сдвигом на максимум,
+    поэтому результат конечен при любых конечных входах. Допускается Input == Output.
+
+Аргументы:
+
+    Input - вектор из N значений.
+
+    Output - результат, N значений.
+
+    N - размер вектора.
+
+--*/
+
+size_t
+MmTopK(
+        const float* Input,
+        size_t N,
+        size_t K,
+        size_t* Indices,
+        float* Values
+);
+/*++
+
+Описание процедуры:
+
+    Выбор K наибольших значений вектора без его сортировки: O(N log K), блоки из 4 значений,
+    не превышающие текущий порог, отбрасываются одним векторным сравнением.
+    Результат упорядочен по убыванию значения, при равенстве - по возрастанию индекса.
+
+Аргументы:
+
+    Input - вектор из N значений.
+
+    N - размер вектора.
+
+    K - кол-во выбираемых элементов.
+
+    Indices - индексы выбранных элементов, min(K, N) значений.
+
+    Values - значения выбранных элементов, min(K, N) значений.
+
+Return Value:
+
+    Кол-во выбранных элементов min(K, N).
+
+--*/
+
+size_t
+MmSoftmaxTopK(
+        const float* Input,
+        size_t N,
+        size_t K,
+        size_t* Indices,
+        float* Probabilities
+);
+/*++
+
+Описание процедуры:
+
+    K наибольших вероятностей softmax(Input) без записи всего вектора вероятностей:
+    выбор идет по логитам (см. MmTopK), экспонента считается только для K выбранных.
+
+Аргументы:
+
+    Input - логиты, N значений.
+
+    N - кол-во классов.
+
+    K - кол-во выбираемых классов.
+
+    Indices - номера выбранных классов, min(K, N) значений.
+
+    Probabilities - их вероятности, min(K, N) значений.
+
+Return Value:
+
+    Кол-во выбранных классов min(K, N).
+
+--*/
+
+/*
+ * Activation Routines
+ */
+
+/*
+ * Номера типов сохраняются в модели (атрибут activation_type), новые типы добавляются в конец.
+ */
+enum MmActivationType {
+    NotSet,
+    Relu,
+    HardSigmoid,
+    Sigmoid,
+    Tanh,
+    Gelu,
+    Silu,
+    LeakyRelu,
+    Elu
+};
+
+struct MmActivationHolder {
+    MmActivationType ActivationType;
+    union {
+        struct {
+            float alpha;
+            float beta;
+        } HardSigmoid;
+        struct {
+            float alpha;
+        } LeakyRelu;
+        struct {
+            float alpha;
+        } Elu;
+    } Parameters;
+};
+
+void
+MmSetDefaultActivationParameters(
+        MmActivationHolder* Holder
+);
+/*++
+
+Описание процедуры:
+
+    Заполняет параметры по умолчанию для Holder->ActivationType: HardSigmoid alpha = 0.2,
+    beta = 0.5; LeakyRelu alpha = 0.01; Elu alpha = 1.
+
+--*/
+
+void
+MmActivation(
+    MmActivationHolder* Activation,
+    float* C,
+    size_t M,
+    size_t N,
+    size_t ldc
+);
+/*++
+
+Описание процедуры:
+
+    Применяет In-Place функцию активации в входному буферу C.
+
+Аргументы:
+
+    Activation - набор параметров для выполнения активации.
+
+    C - входной буффер.
+
+    M - кол-во строк во входном буффере С.
+
+    N - кол-во столбцов во входном буффере С.
+
+    ldc - лидирующее измерение входного буффера С.
+
+Return Value:
+
+    None.
+
+--*/
+
+bool
+MmActivationNeedsInput(
+    MmActivationType ActivationType
+);
+/*++
+
+Описание процедуры:
+
+    true, если производная активации не выражается через ее выход (Gelu, Silu) и
+    MmActivationBackward нужен вход активации.
+
+--*/
+
+void
+MmActivationBackward(
+    const MmActivationHolder* Activation,
+    const float* Input,
+    const float* Output,
+    const float* OutputGrad,
+    float* InputGrad,
+    size_t Count
+);
+/*++
+
+Описание процедуры:
+
+    Градиент по входу активации: InputGrad = OutputGrad * f'(x). Для большинства активаций
+    производная выражается через выход Output, и Input может быть nullptr; вход нужен,
+    только если MmActivationNeedsInput. InputGrad может совпадать с OutputGrad.
+
+--*/
+
+void
+MmMaxPool(
+        const MM_POOL_PARAMS* Parameters,
+        const float* Input,
+        float* Output,
+        size_t ChannelCount
+);
+/*++
+
+Описание процедуры:
+
+    Выполняет 2D max pooling в формате NCHW скользящим окном по строкам входа.
+    Внутренние точки выхода считаются векторно по 4 соседним столбцам; для окон 2x2 и
+    3x3 с шагом 2 столбцы окна разбираются перестановкой векторов. Точки у границ
+    (с заполнением или обрезанным окном) считаются скалярно.
+
+Аргументы:
+
+    Parameters - параметры max pooling'а.
+
+    Input - входные данные [C][Hin][Win].
+
+    Output - буфер для результата [C][Hout][Wout].
+
+    ChannelCount - кол-во каналов.
+
+Return Value:
+
+    None.
+
+--*/
+
+void
+MmMaxPoolArgmax(
+        const MM_POOL_PARAMS* Parameters,
+        const float* Input,
+        float* Output,
+        uint8_t* Argmax,
+        size_t ChannelCount
+);
+/*++
+
+Описание процедуры:
+
+    Выполняет 2D max pooling в формате NCHW и запоминает для каждой точки выхода
+    позицию максимума внутри окна: dy * KW + dx относительно начала окна с учетом
+    заполнения. При равных значениях берется первая позиция. Окно должно содержать
+    не больше 256 точек.
+
+Аргументы:
+
+    Parameters - параметры max pooling'а.
+
+    Input - входные данные [C][Hin][Win].
+
+    Output - буфер для результата [C][Hout][Wout].
+
+    Argmax - буфер для позиций максимумов [C][Hout][Wout].
+
+    ChannelCount - кол-во каналов.
+
+Return Value:
+
+    None.
+
+--*/
+
+void
+MmMaxPoolBackward(
+        const MM_POOL_PARAMS* Parameters,
+        const float* OutputGrad,
+        const uint8_t* Argmax,
+        float* InputGrad,
+        size_t ChannelCount
+);
+/*++
+
+Описание процедуры:
+
+    Градиент 2D max pooling'а в формате NCHW: градиент каждой точки выхода
+    прибавляется к точке входа, в которой был максимум (см. MmMaxPoolArgmax).
+    Точки входа, которые не были максимумом ни одного окна, получают ноль.
+
+Аргументы:
+
+    Parameters - параметры max pooling'а.
+
+    OutputGrad - градиент по выходу [C][Hout][Wout].
+
+    Argmax - позиции максимумов, записанные MmMaxPoolArgmax.
+
+    InputGrad - буфер для градиента по входу [C][Hin][Win], перезаписывается.
+
+    ChannelCount - кол-во каналов.
+
+Return Value:
+
+    None.
+
+--*/
+
+void
+MmAveragePool(
+        const MM_POOL_PARAMS* Parameters,
+        bool CountIncludePad,
+        const float* Input,
+        float* Output,
+        size_t ChannelCount,
+        float* TemporaryBuffer
+);
+/*++
+
+Описание процедуры:
+
+    Выполняет 2D average pooling в формате NCHW. Для каждой строки выхода строки окна
+    сначала векторно суммируются по столбцам, затем окно скользит по суммам столбцов;
+    внутренние точки выхода для окон шириной 2 с шагом 2 и для шага 1 считаются
+    векторно по 4 соседним столбцам.
+
+Аргументы:
+
+    Parameters - параметры pooling'а.
+
+    CountIncludePad - учитывать ли точки заполнения в делителе среднего. Точки окна за
+        пределами заполнения (обрезанные окна) не учитываются никогда.
+
+    Input - входные данные [C][Hin][Win].
+
+    Output - буфер для результата [C][Hout][Wout].
+
+    ChannelCount - кол-во каналов.
+
+    TemporaryBuffer - временный буфер размера Win под суммы столбцов.
+
+Return Value:
+
+    None.
+
+--*/
+
+void
+MmAveragePoolBackward(
+        const MM_POOL_PARAMS* Parameters,
+        bool CountIncludePad,
+        const float* OutputGrad,
+        float* InputGrad,
+        size_t ChannelCount
+);
+/*++
+
+Описание процедуры:
+
+    Градиент 2D average pooling'а в формате NCHW: градиент точки выхода, деленный на
+    делитель ее окна, прибавляется ко всем точкам входа окна.
+
+Аргументы:
+
+    Parameters - параметры pooling'а.
+
+    CountIncludePad - см. MmAveragePool.
+
+    OutputGrad - градиент по выходу [C][Hout][Wout].
+
+    InputGrad - буфер для градиента по входу [C][Hin][Win], перезаписывается.
+
+    ChannelCount - кол-во каналов.
+
+Return Value:
+
+    None.
+
+--*/
+
+void
+MmGlobalAveragePool(
+        const float* Input,
+        float* Output,
+        size_t ChannelCount,
+        size_t SpatialSize
+);
+/*++
+
+Описание процедуры:
+
+    Записывает в Output[c] среднее SpatialSize подряд идущих значений канала c (формат NCHW).
+
+--*/
+
+void
+MmGlobalAveragePoolNhwc(
+        const float* Input,
+        float* Output,
+        size_t ChannelCount,
+        size_t SpatialSize
+);
+/*++
+
+Описание процедуры:
+
+    Записывает в Output[c] среднее канала c по SpatialSize точкам входа в формате NHWC.
+    Суммирование векторизовано по каналам.
+
+--*/
+
+/*
+ * Normalization Routines
+ */
+
+void
+MmMoments(
+        const float* Input,
+        size_t Count,
+        size_t* AccumulatedCount,
+        float* Mean,
+        float* SumSquares
+);
+/*++
+
+Описание процедуры:
+
+    Добавляет Count подряд идущих значений Input к накопленным статистикам: кол-ву
+    значений (AccumulatedCount), среднему (Mean) и сумме квадратов отклонений от
+    среднего (SumSquares). Данные читаются блоками, помещающимися в L1 кэш: для блока
+    SIMD вычисляются среднее и сумма квадратов отклонений, после чего статистики блока
+    объединяются с накопленными (Chan et al.). В отличие от E[x^2] - E[x]^2 не теряет
+    точность при большом среднем.
+
+    Перед первым вызовом AccumulatedCount, Mean и SumSquares должны быть равны 0.
+    Несмещенная дисперсия равна SumSquares / (AccumulatedCount - 1).
+
+--*/
+
+void
+MmMomentsMerge(
+        size_t* Count,
+        float* Mean,
+        float* SumSquares,
+        size_t OtherCount,
+        float OtherMean,
+        float OtherSumSquares
+);
+/*++
+
+Описание процедуры:
+
+    Объединяет статистики (Count, Mean, SumSquares) со статистиками другого
+    непересекающегося набора значений, см. MmMoments.
+
+--*/
+
+void
+MmBatchNormBackwardReduce(
+        const float* OutputGrad,
+        const float* Input,
+        size_t Count,
+        float Mean,
+        float* SumGrad,
+        float* SumGradCentered
+);
+/*++
+
+Описание процедуры:
+
+    Одним проходом считает суммы, нужные обратному проходу batch normalization:
+    SumGrad = sum(OutputGrad[i]) и SumGradCentered = sum(OutputGrad[i] * (Input[i] - Mean)).
+
+--*/
+
+void
+MmBatchNormBackwardApply(
+        const float* OutputGrad,
+        const float* Input,
+        float* InputGrad,
+        size_t Count,
+        float GradScale,
+        float InputScale,
+        float Shift
+);
+/*++
+
+Описание процедуры:
+
+    Записывает InputGrad[i] = GradScale * OutputGrad[i] + InputScale * Input[i] + Shift.
+    Градиент batch normalization по входу канала приводится к этому виду после
+    подсчета сумм MmBatchNormBackwardReduce.
+
+--*/
+
+void
+MmScaleShift(
+        const float* Input,
+        float* Output,
+        size_t Count,
+        float Scale,
+        float Shift
+);
+/*++
+
+Описание процедуры:
+
+    Output[i] = Input[i] * Scale + Shift. Применяет batch normalization в режиме inference
+    к одной плоскости канала в формате NCHW. Input и Output могут совпадать.
+
+--*/
+
+void
+MmScaleShiftNhwc(
+        const float* Input,
+        float* Output,
+        const float* Scale,
+        const float* Shift,
+        size_t ChannelCount,
+        size_t SpatialSize
+);
+/*++
+
+Описание процедуры:
+
+    Output[d][c] = Input[d][c] * Scale[c] + Shift[c] для SpatialSize точек в формате NHWC.
+    Input и Output могут совпадать.
+
+--*/
+
+/*
+ * Fused Routines
+ */
+
+void
+MmConvPool(
+        const MM_CONV_PARAMS* Parameters,
+        const MM_POOL_PARAMS* PoolParameters,
+        MmActivationHolder* Activations,
+        size_t ActivationCount,
+        const float* Input,
+        const float* Weight,
+        const float* Bias,
+        float* TemporaryBuffer,
+        float* Output
+);
+/*++
+
+Описание процедуры:
+
+    Слитые 2D свертка (NCHW), активации и max pooling: выход свертки считается тайлами
+    по строкам, к тайлу применяются активации и он сразу сводится max pooling'ом, пока
+    находится в кэше. В память пишется только результат max pooling'а. Строки свертки на
+    стыке тайлов, которые нужны перекрывающимся окнам, пересчитываются. Свертка всегда
+    выполняется алгоритмом Im2ColThenGemm, Parameters->Algorithm не учитывается.
+
+Аргументы:
+
+    Parameters - контейнер параметров свертки.
+
+    PoolParameters - параметры max pooling'а, вход которого - выход свертки.
+
+    Activations - активации, которые применяются к выходу свертки по порядку.
+
+    ActivationCount - кол-во активаций.
+
+    Input - входные данные: одно изображение содержащее C каналов.
+
+    Weight - фильтры для выполнения свертки.
+
+    Bias - опциональное смещение к результату свертки.
+
+    TemporaryBuffer - временный буфер размера MmConvPoolBufferSize.
+
+    Output - буфер для результата max pooling'а [Cout][Hout][Wout].
+
+Return Value:
+
+    None.
+
+--*/
+
+size_t
+MmConvPoolBufferSize(
+        const MM_CONV_PARAMS* Parameters,
+        const MM_POOL_PARAMS* PoolParameters
+);
+/*++
+
+Описание процедуры:
+
+    Возвращает размер временного буфера (в элементах float) для MmConvPool:
+    часть матрицы Im2Col и тайл выхода свертки.
+
+--*/
+
 template<typename T, std::size_t alignment>
 class aligned_allocator {
 public:
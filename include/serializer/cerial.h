@@ -50,6 +50,11 @@ struct cerial {
         has_bias->set_type(xs::AttributeInfo_AttributeType_INT);
         has_bias->set_i(layer->params_.has_bias_);
 
+        xs::AttributeInfo* activation = node->add_attribute();
+        activation->set_name("activation_type");
+        activation->set_type(xs::AttributeInfo_AttributeType_INT);
+        activation->set_i(static_cast<int64_t>(layer->params_.activation_type_));
+
         std::vector<const mat_t*> wb = layer->weights();
         tensor->set_name("w&b fully_connected");
 #ifdef XS_USE_DOUBLE
@@ -135,6 +140,57 @@ struct cerial {
         W->set_name("width");
         W->set_type(xs::AttributeInfo_AttributeType_INT);
         W->set_i(layer->shape_.W);
+
+        // Формы входов сохраняются только для broadcasting'а, иначе они совпадают с формой выхода
+        if (layer->plan_.get_kind() != broadcast_plan::kind::same_shape) {
+            serialize_shapes(node, layer->in_shapes_);
+        }
+    }
+
+    /*
+     * Sub, Mul, Div, Min, Max, Pow
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const binary_layer* layer) {
+        node->set_name(layer->layer_type());
+        serialize_shapes(node, layer->in_shape());
+    }
+
+    inline
+    static
+    void serialize_shapes(xs::NodeInfo* node, const std::vector<shape3d>& shapes) {
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            xs::AttributeInfo* C = node->add_attribute();
+            xs::AttributeInfo* H = node->add_attribute();
+            xs::AttributeInfo* W = node->add_attribute();
+
+            C->set_name("channel" + std::to_string(i));
+            C->set_type(xs::AttributeInfo_AttributeType_INT);
+            C->set_i(shapes[i].C);
+
+            H->set_name("height" + std::to_string(i));
+            H->set_type(xs::AttributeInfo_AttributeType_INT);
+            H->set_i(shapes[i].H);
+
+            W->set_name("width" + std::to_string(i));
+            W->set_type(xs::AttributeInfo_AttributeType_INT);
+            W->set_i(shapes[i].W);
+        }
+    }
+
+    inline
+    static
+    shape3d deserialize_shape(const xs::NodeInfo* node, size_t first_attribute) {
+        return shape3d(node->attribute(first_attribute).i(),
+                       node->attribute(first_attribute + 1).i(),
+                       node->attribute(first_attribute + 2).i());
+    }
+
+    template<typename T>
+    inline
+    std::shared_ptr<T> deserialize_binary(const xs::NodeInfo* node) {
+        return std::make_shared<T>(deserialize_shape(node, 0), deserialize_shape(node, 3));
     }
 
     /*
@@ -165,6 +221,79 @@ struct cerial {
         beta->set_f(layer->activationHolder_.Parameters.HardSigmoid.beta);
     }
 
+    /*
+     * Sigmoid
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const xsdnn::sigmoid* layer) {
+        node->set_name("sigmoid");
+    }
+
+    /*
+     * Tanh
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const xsdnn::tanh* layer) {
+        node->set_name("tanh");
+    }
+
+    /*
+     * GELU
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const xsdnn::gelu* layer) {
+        node->set_name("gelu");
+    }
+
+    /*
+     * SiLU
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const xsdnn::silu* layer) {
+        node->set_name("silu");
+    }
+
+    /*
+     * Leaky Relu
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const leaky_relu* layer) {
+        node->set_name("leaky_relu");
+        xs::AttributeInfo* alpha = node->add_attribute();
+
+        alpha->set_name("alpha");
+        alpha->set_type(xs::AttributeInfo_AttributeType_FLOAT);
+        alpha->set_f(layer->activationHolder_.Parameters.LeakyRelu.alpha);
+    }
+
+    /*
+     * ELU
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const elu* layer) {
+        node->set_name("elu");
+        xs::AttributeInfo* alpha = node->add_attribute();
+
+        alpha->set_name("alpha");
+        alpha->set_type(xs::AttributeInfo_AttributeType_FLOAT);
+        alpha->set_f(layer->activationHolder_.Parameters.Elu.alpha);
+    }
+
+    /*
+     * Softmax
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const xsdnn::softmax* layer) {
+        node->set_name("softmax");
+    }
+
     /*
     * Abs
     */
@@ -247,7 +376,61 @@ struct cerial {
 
         pad_type->set_name("pad_type");
         pad_type->set_type(xs::AttributeInfo_AttributeType_STRING);
-        pad_type->set_name((layer->params_.pad_type_ == padding_mode::same) ? "same" : "valid");
+        pad_type->set_s((layer->params_.pad_type_ == padding_mode::same) ? "same" : "valid");
+    }
+
+    /*
+    * Average Pooling
+    */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const xsdnn::average_pooling* layer) {
+        node->set_name("average_pooling");
+        xs::AttributeInfo* C = node->add_attribute();
+        xs::AttributeInfo* H = node->add_attribute();
+        xs::AttributeInfo* W = node->add_attribute();
+        xs::AttributeInfo* kernel_x = node->add_attribute();
+        xs::AttributeInfo* kernel_y = node->add_attribute();
+        xs::AttributeInfo* stride_x = node->add_attribute();
+        xs::AttributeInfo* stride_y = node->add_attribute();
+        xs::AttributeInfo* pad_type = node->add_attribute();
+        xs::AttributeInfo* count_include_pad = node->add_attribute();
+
+        C->set_name("channel");
+        C->set_type(xs::AttributeInfo_AttributeType_INT);
+        C->set_i(layer->params_.in_shape_.C);
+
+        H->set_name("height");
+        H->set_type(xs::AttributeInfo_AttributeType_INT);
+        H->set_i(layer->params_.in_shape_.H);
+
+        W->set_name("width");
+        W->set_type(xs::AttributeInfo_AttributeType_INT);
+        W->set_i(layer->params_.in_shape_.W);
+
+        kernel_x->set_name("kernel_x");
+        kernel_x->set_type(xs::AttributeInfo_AttributeType_INT);
+        kernel_x->set_i(layer->params_.kernel_x_);
+
+        kernel_y->set_name("kernel_y");
+        kernel_y->set_type(xs::AttributeInfo_AttributeType_INT);
+        kernel_y->set_i(layer->params_.kernel_y_);
+
+        stride_x->set_name("stride_x");
+        stride_x->set_type(xs::AttributeInfo_AttributeType_INT);
+        stride_x->set_i(layer->params_.stride_x_);
+
+        stride_y->set_name("stride_y");
+        stride_y->set_type(xs::AttributeInfo_AttributeType_INT);
+        stride_y->set_i(layer->params_.stride_y_);
+
+        pad_type->set_name("pad_type");
+        pad_type->set_type(xs::AttributeInfo_AttributeType_STRING);
+        pad_type->set_s((layer->params_.pad_type_ == padding_mode::same) ? "same" : "valid");
+
+        count_include_pad->set_name("count_include_pad");
+        count_include_pad->set_type(xs::AttributeInfo_AttributeType_INT);
+        count_include_pad->set_i(layer->params_.count_include_pad_ ? 1 : 0);
     }
 
     /*
@@ -322,89 +505,263 @@ struct cerial {
         xs::AttributeInfo* PadLeftWidth = node->add_attribute();
         xs::AttributeInfo* PadRightHeight = node->add_attribute();
         xs::AttributeInfo* PadRightWidth = node->add_attribute();
+        xs::AttributeInfo* Dimensions = node->add_attribute();
+        xs::AttributeInfo* Activation = node->add_attribute();
 
         mmpack::MM_CONV_PARAMS Parameters = layer->get_params()._;
 
+        //
+        // 1D свертка хранится как 2D с единичными размерами по высоте: [C, 1, W], ядро [1, KW].
+        //
+
+        size_t InHeight, InWidth, KernelHeight, KernelWidth, StrideHeight, StrideWidth, DilationHeight, DilationWidth;
+        size_t Pads[4];
+
         if (Parameters.Dimensions == 2) {
-            C->set_name("channel");
-            C->set_type(xs::AttributeInfo_AttributeType_INT);
-            C->set_i(Parameters.InChannel * Parameters.GroupCount);
+            InHeight = Parameters.InShape[0];
+            InWidth = Parameters.InShape[1];
+            KernelHeight = Parameters.KernelShape[0];
+            KernelWidth = Parameters.KernelShape[1];
+            StrideHeight = Parameters.StrideShape[0];
+            StrideWidth = Parameters.StrideShape[1];
+            DilationHeight = Parameters.DilationShape[0];
+            DilationWidth = Parameters.DilationShape[1];
+            for (size_t i = 0; i < 4; ++i) Pads[i] = Parameters.Padding[i];
+        } else if (Parameters.Dimensions == 1) {
+            InHeight = 1;
+            InWidth = Parameters.InShape[0];
+            KernelHeight = 1;
+            KernelWidth = Parameters.KernelShape[0];
+            StrideHeight = 1;
+            StrideWidth = Parameters.StrideShape[0];
+            DilationHeight = 1;
+            DilationWidth = Parameters.DilationShape[0];
+            Pads[0] = 0;
+            Pads[1] = Parameters.Padding[0];
+            Pads[2] = 0;
+            Pads[3] = Parameters.Padding[1];
+        } else {
+            throw xs_error("[conv serialization] Unsupported dimensions");
+        }
 
-            H->set_name("height");
-            H->set_type(xs::AttributeInfo_AttributeType_INT);
-            H->set_i(Parameters.InShape[0]);
+        C->set_name("channel");
+        C->set_type(xs::AttributeInfo_AttributeType_INT);
+        C->set_i(Parameters.InChannel * Parameters.GroupCount);
 
-            W->set_name("width");
-            W->set_type(xs::AttributeInfo_AttributeType_INT);
-            W->set_i(Parameters.InShape[1]);
+        H->set_name("height");
+        H->set_type(xs::AttributeInfo_AttributeType_INT);
+        H->set_i(InHeight);
+
+        W->set_name("width");
+        W->set_type(xs::AttributeInfo_AttributeType_INT);
+        W->set_i(InWidth);
+
+        OutChannel->set_name("out_channel");
+        OutChannel->set_type(xs::AttributeInfo_AttributeType_INT);
+        OutChannel->set_i(Parameters.FilterCount * Parameters.GroupCount);
 
-            OutChannel->set_name("out_channel");
-            OutChannel->set_type(xs::AttributeInfo_AttributeType_INT);
-            OutChannel->set_i(Parameters.FilterCount * Parameters.GroupCount);
+        Kernel_H->set_name("kernel_h");
+        Kernel_H->set_type(xs::AttributeInfo_AttributeType_INT);
+        Kernel_H->set_i(KernelHeight);
 
-            Kernel_H->set_name("kernel_h");
-            Kernel_H->set_type(xs::AttributeInfo_AttributeType_INT);
-            Kernel_H->set_i(Parameters.KernelShape[0]);
+        Kernel_W->set_name("kernel_w");
+        Kernel_W->set_type(xs::AttributeInfo_AttributeType_INT);
+        Kernel_W->set_i(KernelWidth);
 
-            Kernel_W->set_name("kernel_w");
-            Kernel_W->set_type(xs::AttributeInfo_AttributeType_INT);
-            Kernel_W->set_i(Parameters.KernelShape[1]);
+        GroupCount->set_name("group_count");
+        GroupCount->set_type(xs::AttributeInfo_AttributeType_INT);
+        GroupCount->set_i(Parameters.GroupCount);
 
-            GroupCount->set_name("group_count");
-            GroupCount->set_type(xs::AttributeInfo_AttributeType_INT);
-            GroupCount->set_i(Parameters.GroupCount);
+        Bias->set_name("bias");
+        Bias->set_type(xs::AttributeInfo_AttributeType_INT);
+        Bias->set_i(Parameters.Bias);
 
-            Bias->set_name("bias");
-            Bias->set_type(xs::AttributeInfo_AttributeType_INT);
-            Bias->set_i(Parameters.Bias);
+        Stride_H->set_name("stride_h");
+        Stride_H->set_type(xs::AttributeInfo_AttributeType_INT);
+        Stride_H->set_i(StrideHeight);
 
-            Stride_H->set_name("stride_h");
-            Stride_H->set_type(xs::AttributeInfo_AttributeType_INT);
-            Stride_H->set_i(Parameters.StrideShape[0]);
+        Stride_W->set_name("stride_w");
+        Stride_W->set_type(xs::AttributeInfo_AttributeType_INT);
+        Stride_W->set_i(StrideWidth);
 
-            Stride_W->set_name("stride_w");
-            Stride_W->set_type(xs::AttributeInfo_AttributeType_INT);
-            Stride_W->set_i(Parameters.StrideShape[1]);
+        Dilation_H->set_name("dilation_h");
+        Dilation_H->set_type(xs::AttributeInfo_AttributeType_INT);
+        Dilation_H->set_i(DilationHeight);
 
-            Dilation_H->set_name("dilation_h");
-            Dilation_H->set_type(xs::AttributeInfo_AttributeType_INT);
-            Dilation_H->set_i(Parameters.DilationShape[0]);
+        Dilation_W->set_name("dilation_w");
+        Dilation_W->set_type(xs::AttributeInfo_AttributeType_INT);
+        Dilation_W->set_i(DilationWidth);
 
-            Dilation_W->set_name("dilation_w");
-            Dilation_W->set_type(xs::AttributeInfo_AttributeType_INT);
-            Dilation_W->set_i(Parameters.DilationShape[1]);
+        PadType->set_name("pad_type");
+        PadType->set_type(xs::AttributeInfo_AttributeType_STRING);
+        PadType->set_s(convert_pad_to_string(layer->params_.pad_type_));
 
-            PadType->set_name("pad_type");
-            PadType->set_type(xs::AttributeInfo_AttributeType_STRING);
-            PadType->set_s(convert_pad_to_string(layer->params_.pad_type_));
+        PadLeftHeight->set_name("PadLeftHeight");
+        PadLeftHeight->set_type(xs::AttributeInfo_AttributeType_INT);
+        PadLeftHeight->set_i(Pads[0]);
 
-            PadLeftHeight->set_name("PadLeftHeight");
-            PadLeftHeight->set_type(xs::AttributeInfo_AttributeType_INT);
-            PadLeftHeight->set_i(Parameters.Padding[0]);
+        PadLeftWidth->set_name("PadLeftWidth");
+        PadLeftWidth->set_type(xs::AttributeInfo_AttributeType_INT);
+        PadLeftWidth->set_i(Pads[1]);
 
-            PadLeftWidth->set_name("PadLeftWidth");
-            PadLeftWidth->set_type(xs::AttributeInfo_AttributeType_INT);
-            PadLeftWidth->set_i(Parameters.Padding[1]);
+        PadRightHeight->set_name("PadRightHeight");
+        PadRightHeight->set_type(xs::AttributeInfo_AttributeType_INT);
+        PadRightHeight->set_i(Pads[2]);
 
-            PadRightHeight->set_name("PadRightHeight");
-            PadRightHeight->set_type(xs::AttributeInfo_AttributeType_INT);
-            PadRightHeight->set_i(Parameters.Padding[2]);
+        PadRightWidth->set_name("PadRightWidth");
+        PadRightWidth->set_type(xs::AttributeInfo_AttributeType_INT);
+        PadRightWidth->set_i(Pads[3]);
 
-            PadRightWidth->set_name("PadRightWidth");
-            PadRightWidth->set_type(xs::AttributeInfo_AttributeType_INT);
-            PadRightWidth->set_i(Parameters.Padding[3]);
+        Dimensions->set_name("dimensions");
+        Dimensions->set_type(xs::AttributeInfo_AttributeType_INT);
+        Dimensions->set_i(Parameters.Dimensions);
 
-            std::vector<const mat_t*> wb = layer->weights();
-            tensor->set_name("w&b conv");
+        Activation->set_name("activation_type");
+        Activation->set_type(xs::AttributeInfo_AttributeType_INT);
+        Activation->set_i(static_cast<int64_t>(layer->params_.activation_type_));
+
+        std::vector<const mat_t*> wb = layer->weights();
+        tensor->set_name("w&b conv");
 #ifdef XS_USE_DOUBLE
 #error NotImplementedYet
 #else
-            tensor->set_type(xs::TensorInfo_TensorType_FLOAT);
+        tensor->set_type(xs::TensorInfo_TensorType_FLOAT);
 #endif
-            layer->save(tensor);
+        layer->save(tensor);
+    }
+
+    /*
+    * ConvTranspose
+    */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const xsdnn::conv_transpose* layer) {
+        node->set_name("conv_transpose");
+
+        const params::conv_transpose& P = layer->params_;
+        const mmpack::MM_CONV_PARAMS& Parameters = P.conv_._;
+
+        //
+        // Как и у conv, 1D хранится как 2D с единичными размерами по высоте.
+        //
+
+        size_t Kernel[2], Stride[2], Dilation[2], Pads[4], OutputPadding[2];
+
+        if (Parameters.Dimensions == 2) {
+            for (size_t i = 0; i < 2; ++i) {
+                Kernel[i] = Parameters.KernelShape[i];
+                Stride[i] = Parameters.StrideShape[i];
+                Dilation[i] = Parameters.DilationShape[i];
+                OutputPadding[i] = P.output_padding_[i];
+            }
+            for (size_t i = 0; i < 4; ++i) Pads[i] = Parameters.Padding[i];
+        } else if (Parameters.Dimensions == 1) {
+            Kernel[0] = 1; Kernel[1] = Parameters.KernelShape[0];
+            Stride[0] = 1; Stride[1] = Parameters.StrideShape[0];
+            Dilation[0] = 1; Dilation[1] = Parameters.DilationShape[0];
+            OutputPadding[0] = 0; OutputPadding[1] = P.output_padding_[0];
+            Pads[0] = 0; Pads[1] = Parameters.Padding[0];
+            Pads[2] = 0; Pads[3] = Parameters.Padding[1];
         } else {
-            throw xs_error("[conv serialization] Unsupported dimensions");
+            throw xs_error("[conv_transpose serialization] Unsupported dimensions");
+        }
+
+        const std::pair<std::string, size_t> Attributes[] = {
+                {"channel", P.in_shape_.C},
+                {"height", P.in_shape_.H},
+                {"width", P.in_shape_.W},
+                {"out_channel", P.out_shape_.C},
+                {"kernel_h", Kernel[0]},
+                {"kernel_w", Kernel[1]},
+                {"group_count", Parameters.GroupCount},
+                {"bias", P.has_bias_},
+                {"stride_h", Stride[0]},
+                {"stride_w", Stride[1]},
+                {"dilation_h", Dilation[0]},
+                {"dilation_w", Dilation[1]},
+                {"PadLeftHeight", Pads[0]},
+                {"PadLeftWidth", Pads[1]},
+                {"PadRightHeight", Pads[2]},
+                {"PadRightWidth", Pads[3]},
+                {"output_padding_h", OutputPadding[0]},
+                {"output_padding_w", OutputPadding[1]},
+                {"dimensions", Parameters.Dimensions},
+        };
+
+        for (const auto& Attribute : Attributes) {
+            xs::AttributeInfo* A = node->add_attribute();
+            A->set_name(Attribute.first);
+            A->set_type(xs::AttributeInfo_AttributeType_INT);
+            A->set_i(Attribute.second);
+        }
+
+        tensor->set_name("w&b conv_transpose");
+#ifdef XS_USE_DOUBLE
+#error NotImplementedYet
+#else
+        tensor->set_type(xs::TensorInfo_TensorType_FLOAT);
+#endif
+        layer->save(tensor);
+    }
+
+    /*
+     * Batch Normalization
+     */
+    inline
+    static
+    void serialize(xs::NodeInfo* node, xs::TensorInfo* tensor, const batch_norm* layer) {
+        node->set_name("batch_norm");
+        const params::bnorm& p = layer->params_;
+
+        const std::pair<std::string, int64_t> Shape[] = {
+                {"channel", p.in_shape_.C},
+                {"height", p.in_shape_.H},
+                {"width", p.in_shape_.W},
+        };
+
+        for (const auto& Attribute : Shape) {
+            xs::AttributeInfo* A = node->add_attribute();
+            A->set_name(Attribute.first);
+            A->set_type(xs::AttributeInfo_AttributeType_INT);
+            A->set_i(Attribute.second);
+        }
+
+        xs::AttributeInfo* momentum = node->add_attribute();
+        momentum->set_name("momentum");
+        momentum->set_type(xs::AttributeInfo_AttributeType_FLOAT);
+        momentum->set_f(p.momentum_);
+
+        xs::AttributeInfo* eps = node->add_attribute();
+        eps->set_name("epsilon");
+        eps->set_type(xs::AttributeInfo_AttributeType_FLOAT);
+        eps->set_f(p.eps_);
+
+        xs::AttributeInfo* phase = node->add_attribute();
+        phase->set_name("phase");
+        phase->set_type(xs::AttributeInfo_AttributeType_INT);
+        phase->set_i(static_cast<int64_t>(p.phase_));
+
+        // Статистики inference режима; пустые, если слой еще не выполнялся
+        const std::pair<const char*, const mat_t*> stats[] = {{"mean_", &p.mean_}, {"stddev_", &p.stddev_}};
+        for (const auto& s : stats) {
+            xs::AttributeInfo* stat = node->add_attribute();
+            stat->set_name(s.first);
+            stat->set_type(xs::AttributeInfo_AttributeType_FLOAT);
+
+            if (p.statistic_initialized) {
+                for (mm_scalar v : *s.second) {
+                    stat->add_floats(v);
+                }
+            }
         }
+
+        tensor->set_name("gamma&beta batch_norm");
+#ifdef XS_USE_DOUBLE
+#error NotImplementedYet
+#else
+        tensor->set_type(xs::TensorInfo_TensorType_FLOAT);
+#endif
+        layer->save(tensor);
     }
 
 };
@@ -416,7 +773,11 @@ struct cerial {
         size_t in_size = node->attribute(0).i();
         size_t out_size = node->attribute(1).i();
         bool has_bias = node->attribute(2).i();
-        std::shared_ptr<fully_connected> l = std::make_shared<fully_connected>(in_size, out_size, has_bias);
+        // Модели, сохраненные до появления встроенной активации, содержат 3 атрибута
+        MmActivationType activation_type = node->attribute_size() > 3
+                ? static_cast<MmActivationType>(node->attribute(3).i()) : MmActivationType::NotSet;
+        std::shared_ptr<fully_connected> l = std::make_shared<fully_connected>(in_size, out_size, has_bias,
+                                                                               activation_type);
         l->load(tensor);
         return l;
     }
@@ -451,10 +812,57 @@ struct cerial {
         size_t C = node->attribute(1).i();
         size_t H = node->attribute(2).i();
         size_t W = node->attribute(3).i();
+
+        if (node->attribute_size() > 4) {
+            return std::make_shared<add>(deserialize_shape(node, 4), deserialize_shape(node, 7));
+        }
+
         std::shared_ptr<add> l = std::make_shared<add>(n_input, shape3d(C, H, W));
         return l;
     }
 
+    template<>
+    inline
+    std::shared_ptr<xsdnn::sub> cerial::deserialize(const xs::NodeInfo* node,
+                                                const xs::TensorInfo* tensor) {
+        return deserialize_binary<xsdnn::sub>(node);
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::mul> cerial::deserialize(const xs::NodeInfo* node,
+                                                const xs::TensorInfo* tensor) {
+        return deserialize_binary<xsdnn::mul>(node);
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::div> cerial::deserialize(const xs::NodeInfo* node,
+                                                const xs::TensorInfo* tensor) {
+        return deserialize_binary<xsdnn::div>(node);
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::min> cerial::deserialize(const xs::NodeInfo* node,
+                                                const xs::TensorInfo* tensor) {
+        return deserialize_binary<xsdnn::min>(node);
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::max> cerial::deserialize(const xs::NodeInfo* node,
+                                                const xs::TensorInfo* tensor) {
+        return deserialize_binary<xsdnn::max>(node);
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::pow> cerial::deserialize(const xs::NodeInfo* node,
+                                                const xs::TensorInfo* tensor) {
+        return deserialize_binary<xsdnn::pow>(node);
+    }
+
     template<>
     inline
     std::shared_ptr<relu> cerial::deserialize(const xs::NodeInfo* node,
@@ -474,6 +882,66 @@ struct cerial {
         return l;
     }
 
+    template<>
+    inline
+    std::shared_ptr<xsdnn::sigmoid> cerial::deserialize(const xs::NodeInfo* node,
+                                                 const xs::TensorInfo* tensor) {
+        std::shared_ptr<xsdnn::sigmoid> l = std::make_shared<xsdnn::sigmoid>();
+        return l;
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::tanh> cerial::deserialize(const xs::NodeInfo* node,
+                                                 const xs::TensorInfo* tensor) {
+        std::shared_ptr<xsdnn::tanh> l = std::make_shared<xsdnn::tanh>();
+        return l;
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::gelu> cerial::deserialize(const xs::NodeInfo* node,
+                                                 const xs::TensorInfo* tensor) {
+        std::shared_ptr<xsdnn::gelu> l = std::make_shared<xsdnn::gelu>();
+        return l;
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::silu> cerial::deserialize(const xs::NodeInfo* node,
+                                                 const xs::TensorInfo* tensor) {
+        std::shared_ptr<xsdnn::silu> l = std::make_shared<xsdnn::silu>();
+        return l;
+    }
+
+    template<>
+    inline
+    std::shared_ptr<leaky_relu> cerial::deserialize(const xs::NodeInfo* node,
+                                            const xs::TensorInfo* tensor) {
+        float alpha = node->attribute(0).f();
+
+        std::shared_ptr<leaky_relu> l = std::make_shared<leaky_relu>(alpha);
+        return l;
+    }
+
+    template<>
+    inline
+    std::shared_ptr<elu> cerial::deserialize(const xs::NodeInfo* node,
+                                            const xs::TensorInfo* tensor) {
+        float alpha = node->attribute(0).f();
+
+        std::shared_ptr<elu> l = std::make_shared<elu>(alpha);
+        return l;
+    }
+
+    template<>
+    inline
+    std::shared_ptr<xsdnn::softmax> cerial::deserialize(const xs::NodeInfo* node,
+                                                    const xs::TensorInfo* tensor) {
+        std::shared_ptr<xsdnn::softmax> l = std::make_shared<xsdnn::softmax>();
+        return l;
+    }
+
     template<>
     inline
     std::shared_ptr<xsdnn::abs> cerial::deserialize(const xs::NodeInfo* node,
@@ -517,7 +985,7 @@ struct cerial {
         size_t kernel_y = node->attribute(4).i();
         size_t stride_x = node->attribute(5).i();
         size_t stride_y = node->attribute(6).i();
-        padding_mode pad_type = node->attribute(0).s() == "same"
+        padding_mode pad_type = node->attribute(7).s() == "same"
                             ? padding_mode::same : padding_mode::valid;
 
         std::shared_ptr<xsdnn::max_pooling> l = std::make_shared<xsdnn::max_pooling>(
@@ -526,6 +994,27 @@ struct cerial {
         return l;
     }
 
+    template<>
+    inline
+    std::shared_ptr<xsdnn::average_pooling> cerial::deserialize(const xs::NodeInfo *node,
+                                                                const xs::TensorInfo *tensor) {
+        size_t C = node->attribute(0).i();
+        size_t H = node->attribute(1).i();
+        size_t W = node->attribute(2).i();
+        size_t kernel_x = node->attribute(3).i();
+        size_t kernel_y = node->attribute(4).i();
+        size_t stride_x = node->attribute(5).i();
+        size_t stride_y = node->attribute(6).i();
+        padding_mode pad_type = node->attribute(7).s() == "same"
+                                ? padding_mode::same : padding_mode::valid;
+        bool count_include_pad = node->attribute(8).i() != 0;
+
+        std::shared_ptr<xsdnn::average_pooling> l = std::make_shared<xsdnn::average_pooling>(
+                shape3d(C, H, W), kernel_x, kernel_y, stride_x, stride_y, pad_type, count_include_pad
+                );
+        return l;
+    }
+
     template<>
     inline
     std::shared_ptr<xsdnn::global_average_pooling> cerial::deserialize(const xs::NodeInfo *node,
@@ -570,18 +1059,83 @@ struct cerial {
         size_t PadRightHeight = node->attribute(15).i();
         size_t PadRightWidth = node->attribute(16).i();
 
+        size_t Dimensions = node->attribute_size() > 17 ? node->attribute(17).i() : 2;
+        // Модели, сохраненные до появления встроенной активации, содержат 18 атрибутов
+        MmActivationType ActivationType = node->attribute_size() > 18
+                ? static_cast<MmActivationType>(node->attribute(18).i()) : MmActivationType::NotSet;
+
         shape3d in_shape(C, H, W);
         std::vector<size_t> kernel_shape = {Kernel_H, Kernel_W};
         std::vector<size_t> stride_shape = {Stride_H, Stride_W};
         std::vector<size_t> dilation_shape = {Dilation_H, Dilation_W};
         std::vector<size_t> pads = {PadLeftHeight, PadLeftWidth, PadRightHeight, PadRightWidth};
 
+        if (Dimensions == 1) {
+            kernel_shape = {Kernel_W};
+            stride_shape = {Stride_W};
+            dilation_shape = {Dilation_W};
+            pads = {PadLeftWidth, PadRightWidth};
+        }
+
         std::shared_ptr<conv> l = std::make_shared<conv>(in_shape, OutChannel, kernel_shape, GroupCount,
-                                                         Bias, stride_shape, dilation_shape, PadType, pads);
+                                                         Bias, stride_shape, dilation_shape, PadType, pads,
+                                                         ActivationType);
         l->load(tensor);
         return l;
     }
 
+    template<>
+    inline
+    std::shared_ptr<xsdnn::conv_transpose> cerial::deserialize(const xs::NodeInfo *node,
+                                                                  const xs::TensorInfo *tensor) {
+        size_t A[19];
+        for (size_t i = 0; i < 19; ++i) A[i] = node->attribute(i).i();
+
+        const size_t C = A[0], H = A[1], W = A[2], OutChannel = A[3];
+        const size_t GroupCount = A[6];
+        const bool Bias = A[7];
+        const size_t Dimensions = A[18];
+
+        std::shared_ptr<conv_transpose> l;
+        if (Dimensions == 1) {
+            l = std::make_shared<conv_transpose>(shape3d(C, H, W), OutChannel,
+                                                 std::vector<size_t>{A[5]}, GroupCount, Bias,
+                                                 std::vector<size_t>{A[9]}, std::vector<size_t>{A[11]},
+                                                 std::vector<size_t>{A[13], A[15]},
+                                                 std::vector<size_t>{A[17]});
+        } else {
+            l = std::make_shared<conv_transpose>(shape3d(C, H, W), OutChannel,
+                                                 std::vector<size_t>{A[4], A[5]}, GroupCount, Bias,
+                                                 std::vector<size_t>{A[8], A[9]}, std::vector<size_t>{A[10], A[11]},
+                                                 std::vector<size_t>{A[12], A[13], A[14], A[15]},
+                                                 std::vector<size_t>{A[16], A[17]});
+        }
+        l->load(tensor);
+        return l;
+    }
+
+    template<>
+    inline
+    std::shared_ptr<batch_norm> cerial::deserialize(const xs::NodeInfo* node,
+                                                    const xs::TensorInfo* tensor) {
+        const shape3d in_shape(node->attribute(0).i(), node->attribute(1).i(), node->attribute(2).i());
+        const mm_scalar momentum = node->attribute(3).f();
+        const mm_scalar eps = node->attribute(4).f();
+        const op_mode phase = static_cast<op_mode>(node->attribute(5).i());
+
+        std::shared_ptr<batch_norm> l = std::make_shared<batch_norm>(momentum, eps, phase);
+        l->set_in_shape(in_shape);
+        l->load(tensor);
+
+        const xs::AttributeInfo& mean = node->attribute(6);
+        const xs::AttributeInfo& stddev = node->attribute(7);
+        if (mean.floats_size() > 0) {
+            l->set_statistics(mat_t(mean.floats().begin(), mean.floats().end()),
+                              mat_t(stddev.floats().begin(), stddev.floats().end()));
+        }
+        return l;
+    }
+
 
 
 
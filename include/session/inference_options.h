@@ -8,6 +8,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include "../utils/util.h"
 
 namespace xsdnn {
 
@@ -18,7 +19,7 @@ namespace xsdnn {
 
 class InfOptions {
 public:
-    explicit InfOptions() {}
+    explicit InfOptions() : layout_(tensor_layout::nchw), top_k_(0) {}
 
 public:
     void SetNumThreads(size_t num_threads) {
@@ -33,12 +34,34 @@ public:
         batch_size_ = batch_size;
     }
 
+    /*
+     * Формат входных изображений и промежуточных тензоров модели.
+     * В режиме NHWC вход подается в формате [H][W][C], а слои conv, max_pooling,
+     * global_average_pooling и batch_norm выполняются NHWC ядрами.
+     * В режиме NCHWc вход и выходы модели остаются в NCHW: цепочки из 2D conv, max_pooling,
+     * batch_norm, global_average_pooling и поэлементных слоев передают друг другу блочные
+     * тензоры, а переупорядочивает данные только свертка на границе цепочки.
+     */
+    void SetLayout(tensor_layout layout) {
+        layout_ = layout;
+    }
+
+    /*
+     * Кол-во лучших классов, которые возвращает InfSession::Run с результатом InfTopK.
+     * 0 - top-k не используется.
+     */
+    void SetTopK(size_t k) {
+        top_k_ = k;
+    }
+
     friend std::ostream& operator<<(std::ostream& out, const InfOptions& opt);
 
 private:
     size_t num_threads_;
     size_t batch_size_;
     net_type net_type_;
+    tensor_layout layout_;
+    size_t top_k_;
 
     friend class InfSession;
 };
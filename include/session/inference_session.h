@@ -11,6 +11,23 @@
 
 namespace xsdnn {
 
+class softmax;
+
+/*
+ * Состояние одного потока: контекст слоев модели (по индексу слоя),
+ * накопленный по предыдущим частям входа.
+ */
+struct InfStreamState {
+    std::vector<tensor_t> layers_;
+};
+
+typedef std::shared_ptr<InfStreamState> InfStream;
+
+/*
+ * Лучшие классы одного образца: пары (номер класса, оценка) по убыванию оценки.
+ */
+typedef std::vector<std::pair<size_t, mm_scalar>> InfTopK;
+
 class InfSession {
 public:
     explicit InfSession(const InfOptions& opt);
@@ -21,9 +38,46 @@ public:
 public:
     void Load(std::string model_path);
     void Run(const std::vector<tensor_t>& input, std::vector<tensor_t>& output);
+
+    /*
+     * Run с выбором InfOptions::SetTopK лучших классов единственного выхода модели.
+     * Если выход модели - softmax, он не вычисляется: классы выбираются по логитам,
+     * а вероятности считаются только для выбранных (см. MmSoftmaxTopK).
+     * Иначе оценка - значение выхода модели.
+     */
+    void Run(const std::vector<tensor_t>& input, std::vector<InfTopK>& output);
+
+    /*
+     * Потоковый режим для моделей, у которых ось W - время. Вход подается частями
+     * формы входа модели, причинные свертки берут недостающие кадры из состояния потока,
+     * поэтому результат совпадает с обработкой всей последовательности целиком.
+     * Каждый образец в пакете - отдельная последовательность потока.
+     * Run с одним потоком не должен вызываться параллельно с другим Run этой сессии.
+     */
+    InfStream CreateStream();
+    void Run(const std::vector<tensor_t>& input, std::vector<tensor_t>& output, InfStream& stream);
     network<graph> GetModel();
 
 private:
+    void apply_layout();
+
+    /*
+     * Переводит в формат NCHWc цепочки слоев, которые умеют его обрабатывать,
+     * и расставляет переупорядочивания в NCHW на их границах (см. layer::set_io_layout).
+     */
+    void apply_nchwc_layout();
+
+    /*
+     * Выход модели, если это softmax, иначе nullptr.
+     */
+    softmax* output_softmax();
+
+    /*
+     * Сворачивает batch_norm режима inference в веса предшествующих conv / fully_connected
+     * (см. layer::fold_scale_shift) и удаляет его узлы из графа.
+     */
+    void fold_batch_norm();
+
     template<typename T>
     void load_and_verify_model(T& model, std::string path) {
         if (model.empty()) {
@@ -34,23 +34,23 @@ private:
     size_t index_{};
 };
 
+/*
+ * Итераторы двух входов по выходу с broadcasting'ом форм произвольного ранга.
+ * Формы выравниваются по последним осям, недостающие оси считаются равными 1.
+ */
 class broadcaster {
 public:
     explicit broadcaster(shape3d s1, shape3d s2);
+    explicit broadcaster(std::vector<size_t> shape1, std::vector<size_t> shape2);
     size_t get_span_size() const;
 
 private:
-    std::vector<size_t> shape2vector(shape3d s);
-    void vector2shape(std::vector<size_t> v);
-
-    size_t num_dimensions(std::vector<size_t> v);
-
-private:
-    static constexpr size_t dimension_size = 3;
+    static std::vector<size_t> shape2vector(shape3d s);
 
 public:
     broadcast_iterator it1_;
     broadcast_iterator it2_;
+    std::vector<size_t> output_dims_;
     shape3d output_shape_;
 };
 
@@ -174,6 +174,79 @@ private:
     size_t output_num_elements_{inputBroadcaster.get_span_size()};
 };
 
+/*
+ * План поэлементной бинарной операции с broadcasting'ом форм произвольного ранга.
+ * Оси, вдоль которых оба входа ведут себя одинаково (идут подряд или повторяются),
+ * склеиваются. После этого выход - rows() строк длины row_size(): строка считается
+ * одним SIMD ядром MmBinary / MmBinaryScalarA / MmBinaryScalarB, строки независимы.
+ */
+class broadcast_plan {
+public:
+    enum class kind {
+        same_shape,     // формы входов совпадают
+        scalar,         // один из входов - скаляр
+        trailing_row,   // один из входов - строка, повторяемая по внешним осям: [N, C] op [C]
+        channel,        // один из входов постоянен вдоль строки: [C, H * W] op [C, 1]
+        general
+    };
+
+public:
+    explicit broadcast_plan(const std::vector<size_t>& shape0, const std::vector<size_t>& shape1);
+    explicit broadcast_plan(shape3d shape0, shape3d shape1);
+
+public:
+    kind get_kind() const;
+    const std::vector<size_t>& output_dims() const;
+    size_t output_size() const;
+
+    size_t rows() const;
+    size_t row_size() const;
+
+    /*
+     * Вход постоянен вдоль строки и передается ядру одним значением.
+     */
+    bool row_scalar0() const;
+    bool row_scalar1() const;
+
+    /*
+     * Смещение начала строки row во входах.
+     */
+    size_t row_offset0(size_t row) const;
+    size_t row_offset1(size_t row) const;
+
+    /*
+     * Выход делится на task_count() частей примерно по task_size значений: группы строк,
+     * либо отрезки единственной строки. Части можно считать параллельно.
+     */
+    size_t task_count() const;
+
+    void run(mmpack::MmBinaryOpType op,
+             const mm_scalar* in0,
+             const mm_scalar* in1,
+             mm_scalar* out,
+             size_t task) const;
+
+private:
+    size_t row_offset(const std::vector<size_t>& strides, size_t row) const;
+
+private:
+    static constexpr size_t task_size = 16384;
+
+    kind kind_;
+    std::vector<size_t> output_dims_;
+
+    // Внешние склеенные оси (без строки) и шаги входов по ним, 0 - вход повторяется
+    std::vector<size_t> outer_dims_;
+    std::vector<size_t> outer_strides0_;
+    std::vector<size_t> outer_strides1_;
+
+    size_t rows_;
+    size_t row_size_;
+    bool row_scalar0_;
+    bool row_scalar1_;
+    size_t rows_per_task_;
+};
+
 using broadcast_func = void (*)(broadcast&);
 struct BroadcastFuncHolder {
     broadcast_func input0scalar;
@@ -39,6 +39,16 @@ enum class op_mode {
     train = 1
 };
 
+/*
+ * Порядок хранения данных в тензоре изображения. nchwc - блочный формат
+ * [C / B][H][W][B] с блоком каналов B = mmpack::MmNchwcGetBlockSize().
+ */
+enum class tensor_layout {
+    nchw = 0,
+    nhwc = 1,
+    nchwc = 2
+};
+
 enum class padding_mode {
     same = 0,
     same_lower = 1,
@@ -53,6 +63,18 @@ size_t calc_pool_shape(size_t in_size,
                        padding_mode pad_type,
                        bool   ceil);
 
+/*
+ * Заполнение окон pooling'а как в TensorFlow: для padding_mode::same недостающие до out_size
+ * точки делятся пополам, остаток - в конец; для valid заполнения нет, окна у конца обрезаются.
+ */
+void calc_pool_padding(size_t in_size,
+                       size_t out_size,
+                       size_t kernel,
+                       size_t stride,
+                       padding_mode pad_type,
+                       size_t* pad_begin,
+                       size_t* pad_end);
+
 size_t calc_conv_padding_shape();
 
 bool is_1D_tensor(shape3d in);
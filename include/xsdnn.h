@@ -11,6 +11,7 @@
 
 #include "common/network.h"
 #include "utils/tensor.h"
+#include "core/framework/conv_algorithm.h"
 #include "utils/xs_visualizer.h"
 
 #include "layers/layer.h"
@@ -19,6 +20,7 @@
 
 #include "loss/loss_base.h"
 #include "loss/mse_loss.h"
+#include "loss/softmax_cross_entropy_loss.h"
 
 #include "optimizers/optimizer_base.h"
 #include "optimizers/sgd.h"
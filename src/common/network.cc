@@ -18,6 +18,11 @@ void network<Net>::set_num_threads(size_t num_threads) noexcept {
     net_.user_num_threads_ = num_threads;
 }
 
+template<typename Net>
+void network<Net>::set_layer_fusion(bool enable) noexcept {
+    net_.layer_fusion_ = enable;
+}
+
 template<typename Net>
 bool network<Net>::empty() const {
     return net_.nodes_.empty();
@@ -25,16 +30,19 @@ bool network<Net>::empty() const {
 
 template<typename Net>
 mat_t network<Net>::predict(const mat_t &in) {
+    net_.update_fusion();
     return fprop(in);
 }
 
 template<typename Net>
 tensor_t network<Net>::predict(const tensor_t &in) {
+    net_.update_fusion();
     return fprop(in);
 }
 
 template<typename Net>
 std::vector<tensor_t> network<Net>::predict(const std::vector<tensor_t> &in) {
+    net_.update_fusion();
     return fprop(in);
 }
 
@@ -59,7 +67,11 @@ void network<Net>::train(loss *loss, optimizer *opt, const tensor_t &input,
                     const std::vector<size_t> &label, size_t batch_size, size_t epoch) {
     std::vector<tensor_t> input_tensor, output_tensor;
     newaxis(input, input_tensor);
-    label2vec(label, output_tensor);
+    if (loss->index_labels()) {
+        label2index(label, output_tensor);
+    } else {
+        label2vec(label, output_tensor);
+    }
 
     fit(loss, opt, input_tensor, output_tensor, batch_size, epoch);
 }
@@ -75,13 +87,14 @@ void network<Net>::train(xsdnn::loss *loss, xsdnn::optimizer *opt, const std::ve
 template<typename Net>
 void network<Net>::fit(loss *l_ptr, optimizer *opt_ptr, std::vector<tensor_t> &input,
                   std::vector<tensor_t> &label, size_t batch_size, size_t epoch) {
+    // Обучению нужны выходы всех слоев, поэтому слитые для inference слои разделяются
+    net_.fuse(false);
     net_.setup(false);
-    size_t num_threads = net_.user_num_threads_ > 0
-                                                ? net_.user_num_threads_
-                                                : std::thread::hardware_concurrency() / 2;
+    size_t num_threads = train_num_threads();
     for (auto l : net_) {
         l->set_parallelize(true);
         l->set_num_threads(num_threads);
+        l->set_training(true);
     }
     opt_ptr->reset();
     for (size_t e = 0; e < epoch; ++e) {
@@ -92,6 +105,9 @@ void network<Net>::fit(loss *l_ptr, optimizer *opt_ptr, std::vector<tensor_t> &i
                       std::min(batch_size, input.size() - b));
         }
     }
+    for (auto l : net_) {
+        l->set_training(false);
+    }
 }
 
 template<typename Net>
@@ -121,7 +137,7 @@ void network<Net>::bprop(loss* l_ptr,
                     const std::vector<tensor_t> &label) {
     std::vector<tensor_t> delta; // grad(loss)
     delta.resize(net_out.size());
-    gradient(l_ptr, net_out, label, delta);
+    gradient(l_ptr, net_out, label, delta, true, train_num_threads());
     net_.backward(delta);
     net_.update_weights(opt_ptr);
 }
@@ -153,6 +169,28 @@ void network<Net>::label2vec(const std::vector<size_t> &label,
     newaxis(predef_vec, output);
 }
 
+template<typename Net>
+void network<Net>::label2index(const std::vector<size_t> &label,
+                               std::vector<tensor_t>& output) {
+    const size_t outdim = net_.out_data_size();
+
+    tensor_t predef_vec;
+    predef_vec.reserve(label.size());
+    for (size_t i = 0; i < label.size(); ++i) {
+        if (label[i] >= outdim) {
+            throw xs_error("[network::label2index] label must be less than output size");
+        }
+        predef_vec.emplace_back(1, mm_scalar(label[i]));
+    }
+
+    newaxis(predef_vec, output);
+}
+
+template<typename Net>
+size_t network<Net>::train_num_threads() const {
+    return net_.user_num_threads_ > 0 ? net_.user_num_threads_ : std::thread::hardware_concurrency() / 2;
+}
+
 template<typename Net>
 void network<Net>::save(const std::string filename) {
     net_.save_model(filename, network_name_);
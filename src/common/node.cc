@@ -96,6 +96,10 @@ namespace xsdnn {
         next_.push_back(nd);
     }
 
+    void edge::remove_next_node(node *nd) {
+        next_.erase(std::remove(next_.begin(), next_.end(), nd), next_.end());
+    }
+
     void edge::accumulate_grads(mat_t* dst) {
         assert(!grad_.empty());
         size_t sample_count = grad_.size();
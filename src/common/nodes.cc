@@ -34,6 +34,65 @@ namespace xsdnn {
         }
     }
 
+    /*
+     * Максимальная длина цепочки слоев, которую может поглотить один слой.
+     */
+    static constexpr size_t max_fused_chain = 3;
+
+    /*
+     * Единственный слой, который читает выход l, или nullptr.
+     */
+    static layer* single_consumer(layer* l) {
+        if (l->next().size() != 1 || !l->next()[0] || l->next()[0]->next().size() != 1) {
+            return nullptr;
+        }
+
+        layer* consumer = dynamic_cast<layer*>(l->next()[0]->next()[0]);
+        if (consumer == nullptr || consumer->in_concept() != 1 || consumer->absorbed()) {
+            return nullptr;
+        }
+        return consumer;
+    }
+
+    void nodes::fuse(bool enable) {
+        for (auto l : nodes_) {
+            l->unfuse();
+        }
+
+        fused_ = enable;
+        fusion_dirty_ = false;
+        if (!enable) {
+            return;
+        }
+
+        for (auto l : nodes_) {
+            if (l->absorbed()) {
+                continue;
+            }
+
+            std::vector<layer*> chain;
+            for (layer* consumer = single_consumer(l);
+                 consumer != nullptr && chain.size() < max_fused_chain;
+                 consumer = single_consumer(consumer)) {
+                chain.push_back(consumer);
+            }
+
+            while (!chain.empty() && !l->fuse(chain)) {
+                chain.pop_back();
+            }
+        }
+    }
+
+    void nodes::update_fusion() {
+        if (fusion_dirty_ || fused_ != layer_fusion_) {
+            fuse(layer_fusion_);
+        }
+    }
+
+    void nodes::invalidate_fusion() {
+        fusion_dirty_ = true;
+    }
+
     size_t nodes::size() const {
         return nodes_.size();
     }
@@ -113,6 +172,7 @@ namespace xsdnn {
 
         xs::GraphInfo model_graph = model.graph();
 
+        fuse(false);
         nodes_.clear();
         owner_nodes_.clear();
 
@@ -130,6 +190,7 @@ namespace xsdnn {
         } else {
             dynamic_cast<graph *>(this)->load_connections(&model_graph);
         }
+        invalidate_fusion();
     }
 
     void nodes::reorder_input(const std::vector<tensor_t> &input,
@@ -169,7 +230,9 @@ namespace xsdnn {
         nodes_.front()->set_in_data(reorder_data);
 
         for (auto l = nodes_.begin(); l != nodes_.end(); ++l) {
-            (*l)->forward();
+            if (!(*l)->absorbed()) {
+                (*l)->forward();
+            }
         }
 
         std::vector<tensor_t> output;
@@ -225,6 +288,13 @@ namespace xsdnn {
     graph::~graph() {}
 
     std::vector<tensor_t> graph::forward(const std::vector<tensor_t> &start) {
+        forward_until(start, nullptr);
+        std::vector<tensor_t> out;
+        reorder_output(out);
+        return out;
+    }
+
+    void graph::forward_until(const std::vector<tensor_t> &start, const layer* last) {
         size_t input_data_concept_count = start[0].size();
 
         if (input_data_concept_count != input_layers_.size()) {
@@ -240,11 +310,13 @@ namespace xsdnn {
         }
 
         for (auto l : nodes_) {
-            l->forward();
+            if (l == last) {
+                break;
+            }
+            if (!l->absorbed()) {
+                l->forward();
+            }
         }
-        std::vector<tensor_t> out;
-        reorder_output(out);
-        return out;
     }
 
     void graph::backward(const std::vector<tensor_t> &start) {
@@ -304,6 +376,7 @@ namespace xsdnn {
 
         input_layers_ = input;
         output_layers_ = output;
+        invalidate_fusion();
 
         setup(false);
     }
@@ -0,0 +1,168 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/framework/conv_algorithm.h>
+#include <core/framework/threading.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace xsdnn {
+    namespace core {
+
+ConvAlgorithmSelector& ConvAlgorithmSelector::get_instance() {
+    static ConvAlgorithmSelector instance;
+    return instance;
+}
+
+void ConvAlgorithmSelector::set_mode(conv_algorithm_mode mode) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    mode_ = mode;
+}
+
+conv_algorithm_mode ConvAlgorithmSelector::mode() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return mode_;
+}
+
+std::string ConvAlgorithmSelector::key(const MM_CONV_PARAMS& p, size_t nthreads) {
+    std::ostringstream s;
+
+#if defined(MM_USE_AVX)
+    s << "avx";
+#elif defined(MM_USE_SSE)
+    s << "sse";
+#else
+    s << "scalar";
+#endif
+    s << SSE_INSTR_SET << ':' << nthreads << ':' << p.Dimensions << ':' << p.GroupCount
+      << ':' << p.InChannel << ':' << p.FilterCount << ':' << p.Bias;
+
+    for (size_t i = 0; i < p.Dimensions; ++i) {
+        s << ':' << p.InShape[i] << ',' << p.KernelShape[i] << ',' << p.StrideShape[i]
+          << ',' << p.DilationShape[i] << ',' << p.Padding[i] << ',' << p.Padding[i + p.Dimensions];
+    }
+
+    return s.str();
+}
+
+bool ConvAlgorithmSelector::find(const params::conv& p, size_t nthreads,
+                                 MM_CONV_PARAMS::MmConvAlgorithm& algorithm) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = table_.find(key(p._, nthreads));
+    if (it == table_.end()) {
+        return false;
+    }
+
+    // Запись из чужого файла может оказаться недопустимой для этой геометрии
+    const auto candidates = p.candidate_algorithms();
+    if (std::find(candidates.begin(), candidates.end(), it->second) == candidates.end()) {
+        return false;
+    }
+
+    algorithm = it->second;
+    return true;
+}
+
+MM_CONV_PARAMS::MmConvAlgorithm ConvAlgorithmSelector::measure(const params::conv& p, size_t nthreads) {
+    const size_t SampleCount = std::max<size_t>(nthreads, 1);
+    const size_t InputSize = p._.InChannel * p._.GroupCount * p._.InSize;
+    const size_t OutputSize = p._.FilterCount * p._.GroupCount * p._.OutSize;
+
+    // Время ядер не зависит от значений, важно лишь не попасть в денормализованные числа
+    auto fill = [](mat_t& m) {
+        for (size_t i = 0; i < m.size(); ++i) {
+            m[i] = static_cast<mm_scalar>(i % 13) * 0.1f - 0.6f;
+        }
+    };
+
+    mat_t W(p._.FilterCount * p._.GroupCount * p._.K), B(p._.FilterCount * p._.GroupCount);
+    tensor_t X(SampleCount, mat_t(InputSize)), Y(SampleCount, mat_t(OutputSize));
+    fill(W);
+    fill(B);
+    for (auto& x : X) {
+        fill(x);
+    }
+
+    MM_CONV_PARAMS::MmConvAlgorithm best = p._.Algorithm;
+    double best_time = std::numeric_limits<double>::max();
+
+    for (MM_CONV_PARAMS::MmConvAlgorithm algorithm : p.candidate_algorithms()) {
+        params::conv candidate = p;
+        candidate.set_algorithm(algorithm);
+        candidate.pack_filter(W);
+
+        auto run = [&]() {
+            concurrency::TryParallelFor(SampleCount > 1, SampleCount, SampleCount, [&](size_t sample) {
+                mat_t TemporaryBuffer(candidate._.TemproraryBufferSize);
+                mmpack::MmConv(&candidate._, X[sample].data(), W.data(), p._.Bias ? B.data() : nullptr,
+                               TemporaryBuffer.data(), Y[sample].data());
+            });
+        };
+
+        // Первый запуск прогревает кэши, дальше берется лучшее время из нескольких
+        run();
+        double time = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < 3; ++i) {
+            auto begin = std::chrono::steady_clock::now();
+            run();
+            auto end = std::chrono::steady_clock::now();
+            time = std::min(time, std::chrono::duration<double>(end - begin).count());
+        }
+
+        if (time < best_time) {
+            best_time = time;
+            best = algorithm;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    table_[key(p._, nthreads)] = best;
+    return best;
+}
+
+void ConvAlgorithmSelector::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw xs_error("[conv algorithm] can't open file " + path);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (const auto& entry : table_) {
+        out << entry.first << ' ' << static_cast<int>(entry.second) << '\n';
+    }
+}
+
+void ConvAlgorithmSelector::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw xs_error("[conv algorithm] can't open file " + path);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::string key;
+    int algorithm;
+    while (in >> key >> algorithm) {
+        if (algorithm < MM_CONV_PARAMS::Im2ColThenGemm || algorithm > MM_CONV_PARAMS::Direct1D) {
+            throw xs_error("[conv algorithm] unknown algorithm in " + path);
+        }
+        table_[key] = static_cast<MM_CONV_PARAMS::MmConvAlgorithm>(algorithm);
+    }
+}
+
+void ConvAlgorithmSelector::clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    table_.clear();
+}
+
+size_t ConvAlgorithmSelector::size() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return table_.size();
+}
+
+    } // core
+} // xsdnn
@@ -4,11 +4,70 @@
 //
 
 #include <core/framework/params.h>
+#include <core/framework/conv_algorithm.h>
 
 namespace xsdnn {
     namespace params {
 
-conv::conv() {}
+void bnorm::compute_scale_shift(const mat_t& gamma, const mat_t& beta) {
+    const size_t channels = in_shape_.C;
+
+    scale_.resize(channels);
+    shift_.resize(channels);
+    for (size_t c = 0; c < channels; ++c) {
+        scale_[c] = gamma[c] / stddev_[c];
+        shift_[c] = beta[c] - mean_[c] * scale_[c];
+    }
+    scale_shift_ready_ = true;
+}
+
+void bnorm::invalidate_scale_shift() {
+    scale_shift_ready_ = false;
+}
+
+conv::conv() : _(), layout_(tensor_layout::nchw), out_layout_(tensor_layout::nchw), filter_packed_(false), stream_(), stream_state_(nullptr),
+               algorithm_fixed_(false), algorithm_threads_(0), fused_pool_(false), pool_() {}
+
+conv::conv(const conv& other) : _(other._), pad_type_(other.pad_type_),
+                                activation_type_(other.activation_type_),
+                                layout_(other.layout_),
+                                out_layout_(other.out_layout_),
+                                indirection_(other.indirection_),
+                                packed_filter_(other.packed_filter_),
+                                filter_packed_(other.filter_packed_),
+                                stream_(other.stream_),
+                                stream_state_(other.stream_state_),
+                                algorithm_fixed_(other.algorithm_fixed_),
+                                algorithm_threads_(other.algorithm_threads_),
+                                fused_activations_(other.fused_activations_),
+                                fused_pool_(other.fused_pool_),
+                                pool_(other.pool_) {
+    _.Indirection = indirection_.empty() ? nullptr : indirection_.data();
+    _.PackedFilter = filter_packed_ && !packed_filter_.empty() ? packed_filter_.data() : nullptr;
+}
+
+conv& conv::operator=(const conv& other) {
+    if (this != &other) {
+        _ = other._;
+        pad_type_ = other.pad_type_;
+        activation_type_ = other.activation_type_;
+        layout_ = other.layout_;
+        out_layout_ = other.out_layout_;
+        indirection_ = other.indirection_;
+        packed_filter_ = other.packed_filter_;
+        filter_packed_ = other.filter_packed_;
+        stream_ = other.stream_;
+        stream_state_ = other.stream_state_;
+        algorithm_fixed_ = other.algorithm_fixed_;
+        algorithm_threads_ = other.algorithm_threads_;
+        fused_activations_ = other.fused_activations_;
+        fused_pool_ = other.fused_pool_;
+        pool_ = other.pool_;
+        _.Indirection = indirection_.empty() ? nullptr : indirection_.data();
+        _.PackedFilter = filter_packed_ && !packed_filter_.empty() ? packed_filter_.data() : nullptr;
+    }
+    return *this;
+}
 
 void
 conv::infer_output_requirement_shape(xsdnn::shape3d in, size_t out_channel, size_t group_count,
@@ -28,7 +87,7 @@ conv::infer_output_requirement_shape(xsdnn::shape3d in, size_t out_channel, size
     if (_.Dimensions == 2) {
         this->_2D(in, out_channel, kernel_shape, stride_shape, dilation_shape, pad_type, pads);
     } else if (_.Dimensions == 1) {
-        throw xs_error("conv param for 1D not implemented yet");
+        this->_1D(in, out_channel, kernel_shape, stride_shape, dilation_shape, pad_type, pads);
     } else {
         throw xs_error("[conv] unsupported dimensions in input data");
     }
@@ -41,33 +100,51 @@ bool conv::is_init() {
 void conv::_2D(xsdnn::shape3d in, size_t out_channel, std::vector<size_t> kernel_shape,
                std::vector<size_t> stride_shape, std::vector<size_t> dilation_shape,
                xsdnn::padding_mode pad_type, std::vector<size_t> pads) {
+    _.InChannel = static_cast<size_t>(in.C / _.GroupCount);
+    _.InShape[0] = in.H;
+    _.InShape[1] = in.W;
+
+    this->inferSpatial(in, out_channel, kernel_shape, stride_shape, dilation_shape, pad_type, pads);
+}
+
+void conv::_1D(xsdnn::shape3d in, size_t out_channel, std::vector<size_t> kernel_shape,
+               std::vector<size_t> stride_shape, std::vector<size_t> dilation_shape,
+               xsdnn::padding_mode pad_type, std::vector<size_t> pads) {
+    if (in.H != 1) throw xs_error("[conv] 1D conv expects input shape (C, 1, W)");
+
+    _.InChannel = static_cast<size_t>(in.C / _.GroupCount);
+    _.InShape[0] = in.W;
+    _.InShape[1] = 0;
+
+    this->inferSpatial(in, out_channel, kernel_shape, stride_shape, dilation_shape, pad_type, pads);
+}
+
+void conv::inferSpatial(xsdnn::shape3d in, size_t out_channel, std::vector<size_t> kernel_shape,
+                        std::vector<size_t> stride_shape, std::vector<size_t> dilation_shape,
+                        xsdnn::padding_mode pad_type, std::vector<size_t> pads) {
     size_t rank = _.Dimensions;
-    if (kernel_shape.size() != rank) throw xs_error("[conv] kernel_shape rank must be equal 2"); // TODO: здесь должна быть более полная проверка
+    const std::string rank_str = std::to_string(rank);
+    if (kernel_shape.size() != rank) throw xs_error("[conv] kernel_shape rank must be equal " + rank_str); // TODO: здесь должна быть более полная проверка
     if (stride_shape.empty()) {
         stride_shape.resize(rank, 1);
     } else if (stride_shape.size() != rank){
-        throw xs_error("[conv] stride_shape rank must be equal 2");
+        throw xs_error("[conv] stride_shape rank must be equal " + rank_str);
     }
     if (dilation_shape.empty()) {
         dilation_shape.resize(rank, 1);
     } else if (dilation_shape.size() != rank){
-        throw xs_error("[conv] dilation_shape rank must be equal 2");
+        throw xs_error("[conv] dilation_shape rank must be equal " + rank_str);
     }
 
     if (pads.empty()) {
         pads.resize(rank * 2, 0);
     } else if (pads.size() != 2 * rank) {
-        throw xs_error("[conv] pads_shape rank must be equal 4");
+        throw xs_error("[conv] pads_shape rank must be equal " + std::to_string(2 * rank));
     }
 
     assert(in.C % _.GroupCount == 0);
     assert(out_channel % _.GroupCount == 0);
 
-    _.InChannel = static_cast<size_t>(in.C / _.GroupCount);
-    _.InShape[0] = in.H;
-    _.InShape[1] = in.W;
-
-
     size_t in_size = 1;
     size_t out_size = 1;
     size_t k = _.InChannel;
@@ -94,8 +171,12 @@ void conv::_2D(xsdnn::shape3d in, size_t out_channel, std::vector<size_t> kernel
     _.OutSize = out_size;
     _.K = k;
 
+    algorithm_fixed_ = false;
+    algorithm_threads_ = 0;
+
     this->computeAlgorithm();
     this->computeTmpBufferSize();
+    this->computeIndirection();
 }
 
 size_t conv::computeOutShape(const size_t in_dim, size_t kernel, size_t stride, size_t dilation, size_t pad_0,
@@ -118,11 +199,260 @@ void conv::computePad(const xsdnn::padding_mode pad_type, size_t &pad_0, size_t
 }
 
 void conv::computeAlgorithm() {
+    // Для 2D ни один алгоритм не выигрывает на всех формах, поэтому без измерений остается Im2Col + GEMM.
+    // Прямое 1D ядро выигрывает у Im2Col + GEMM, только пока K мало и GEMM не загружен
+    if (_.Dimensions == 1 && _.StrideShape[0] == 1 && _.K <= 16) {
+        _.Algorithm = _.Direct1D;
+        return;
+    }
     _.Algorithm = _.Im2ColThenGemm;
 }
 
 void conv::computeTmpBufferSize() {
-    _.TemproraryBufferSize = 16384;
+    // Буфер и упакованные фильтры зависят от алгоритма и формата, поэтому сбрасываются вместе
+    this->invalidate_packed_filter();
+
+    if (layout_ == tensor_layout::nhwc) {
+        _.TemproraryBufferSize = MmConvNhwcBufferSize(&_);
+        return;
+    }
+
+    if (nchwc()) {
+        _.TemproraryBufferSize = MmConvNchwcLayoutBufferSize(&_, layout_ == tensor_layout::nchwc,
+                                                             out_layout_ == tensor_layout::nchwc);
+        return;
+    }
+
+    switch (_.Algorithm) {
+        case MM_CONV_PARAMS::Im2ColThenGemm:
+            _.TemproraryBufferSize = 16384;
+            break;
+        case MM_CONV_PARAMS::Indirect:
+            _.TemproraryBufferSize = MmConvIndirectBufferSize(&_);
+            break;
+        case MM_CONV_PARAMS::NchwcDirect:
+            _.TemproraryBufferSize = MmConvNchwcBufferSize(&_);
+            break;
+        case MM_CONV_PARAMS::Direct1D:
+            _.TemproraryBufferSize = 0;
+            break;
+        default:
+            throw xs_error("[conv] unsupported algorithm");
+    }
+}
+
+void conv::computeIndirection() {
+    if (_.Algorithm != MM_CONV_PARAMS::Indirect) {
+        indirection_.clear();
+        _.Indirection = nullptr;
+        return;
+    }
+
+    indirection_.resize(MmConvIndirectionBufferSize(&_));
+    MmConvIndirectionBuffer(&_, indirection_.data());
+    _.Indirection = indirection_.data();
+}
+
+void conv::set_layout(tensor_layout layout) {
+    this->set_layout(layout, layout);
+}
+
+void conv::set_layout(tensor_layout in_layout, tensor_layout out_layout) {
+    if (_.Dimensions == 1 && (in_layout != tensor_layout::nchw || out_layout != tensor_layout::nchw)) {
+        throw xs_error("[conv] 1D conv supports only nchw layout");
+    }
+    if (in_layout != out_layout &&
+        (in_layout == tensor_layout::nhwc || out_layout == tensor_layout::nhwc)) {
+        throw xs_error("[conv] input and output layouts may differ only at nchwc boundary");
+    }
+
+    const size_t block = MmNchwcGetBlockSize();
+    if ((in_layout == tensor_layout::nchwc && _.InChannel % block != 0) ||
+        (out_layout == tensor_layout::nchwc && _.FilterCount % block != 0)) {
+        throw xs_error("[conv] nchwc tensor requires channels divisible by block size");
+    }
+
+    layout_ = in_layout;
+    out_layout_ = out_layout;
+
+    /*
+     * В NCHWc работает только прямое блочное ядро. При возврате из NCHWc алгоритм
+     * снова выбирается эвристикой и измерениями, если он не был задан явно.
+     */
+    if (nchwc()) {
+        _.Algorithm = MM_CONV_PARAMS::NchwcDirect;
+    } else if (_.Algorithm == MM_CONV_PARAMS::NchwcDirect && !algorithm_fixed_) {
+        this->computeAlgorithm();
+        algorithm_threads_ = 0;
+    }
+
+    this->computeTmpBufferSize();
+    this->computeIndirection();
+}
+
+bool conv::nchwc() const {
+    return layout_ == tensor_layout::nchwc || out_layout_ == tensor_layout::nchwc;
+}
+
+void conv::set_algorithm(MM_CONV_PARAMS::MmConvAlgorithm algorithm) {
+    if (_.Dimensions == 1) {
+        if (algorithm != MM_CONV_PARAMS::Im2ColThenGemm && algorithm != MM_CONV_PARAMS::Direct1D) {
+            throw xs_error("[conv] algorithm is not supported for 1D conv");
+        }
+        if (algorithm == MM_CONV_PARAMS::Direct1D && _.StrideShape[0] != 1) {
+            throw xs_error("[conv] Direct1D supports only unit stride");
+        }
+    } else if (algorithm == MM_CONV_PARAMS::Direct1D) {
+        throw xs_error("[conv] Direct1D supports only 1D conv");
+    }
+    if (nchwc() && algorithm != MM_CONV_PARAMS::NchwcDirect) {
+        throw xs_error("[conv] nchwc layout supports only NchwcDirect");
+    }
+
+    this->applyAlgorithm(algorithm);
+    algorithm_fixed_ = true;
+}
+
+void conv::applyAlgorithm(MM_CONV_PARAMS::MmConvAlgorithm algorithm) {
+    _.Algorithm = algorithm;
+    this->computeTmpBufferSize();
+    this->computeIndirection();
+}
+
+std::vector<MM_CONV_PARAMS::MmConvAlgorithm> conv::candidate_algorithms() const {
+    if (_.Dimensions == 1) {
+        if (_.StrideShape[0] == 1) {
+            return { MM_CONV_PARAMS::Im2ColThenGemm, MM_CONV_PARAMS::Direct1D };
+        }
+        return { MM_CONV_PARAMS::Im2ColThenGemm };
+    }
+    return { MM_CONV_PARAMS::Im2ColThenGemm, MM_CONV_PARAMS::Indirect, MM_CONV_PARAMS::NchwcDirect };
+}
+
+void conv::pack_filter(const mat_t& W) {
+    if (filter_packed_) {
+        return;
+    }
+
+    const bool Nhwc = layout_ == tensor_layout::nhwc;
+    const size_t size = MmConvPackedFilterSize(&_, Nhwc);
+
+    if (size == 0) {
+        packed_filter_.clear();
+        _.PackedFilter = nullptr;
+    } else {
+        packed_filter_.resize(size);
+        MmConvPackFilter(&_, Nhwc, W.data(), packed_filter_.data());
+        _.PackedFilter = packed_filter_.data();
+    }
+
+    filter_packed_ = true;
+}
+
+void conv::invalidate_packed_filter() {
+    filter_packed_ = false;
+    _.PackedFilter = nullptr;
+}
+
+void conv::select_algorithm(size_t nthreads) {
+    // NHWC, NCHWc и потоковый режим используют свои ядра, а явно заданный алгоритм не переопределяется
+    if (algorithm_fixed_ || algorithm_threads_ == nthreads || layout_ != tensor_layout::nchw ||
+        out_layout_ != tensor_layout::nchw || stream_state_ != nullptr) {
+        return;
+    }
+
+    core::ConvAlgorithmSelector& selector = core::ConvAlgorithmSelector::get_instance();
+    MM_CONV_PARAMS::MmConvAlgorithm algorithm;
+
+    if (selector.find(*this, nthreads, algorithm)) {
+        this->applyAlgorithm(algorithm);
+    } else if (selector.mode() == core::conv_algorithm_mode::measure) {
+        this->applyAlgorithm(selector.measure(*this, nthreads));
+    }
+
+    algorithm_threads_ = nthreads;
+}
+
+bool conv::streamable() const {
+    return _.Dimensions == 1 && layout_ == tensor_layout::nchw && _.StrideShape[0] == 1 &&
+           _.Padding[0] == (_.KernelShape[0] - 1) * _.DilationShape[0] && _.Padding[1] == 0;
+}
+
+void conv::set_stream_state(tensor_t* state) {
+    stream_state_ = state;
+    if (state == nullptr) {
+        return;
+    }
+
+    if (!streamable()) {
+        throw xs_error("[conv] streaming requires causal 1D conv with unit stride");
+    }
+
+    // Свертка над [контекст | часть] без заполнения дает столько же кадров, сколько во входной части
+    conv stream;
+    stream._.Dimensions = 1;
+    stream.infer_output_requirement_shape(shape3d(_.InChannel * _.GroupCount, 1, _.InShape[0] + _.Padding[0]),
+                                          _.FilterCount * _.GroupCount, _.GroupCount, _.Bias,
+                                          {_.KernelShape[0]}, {1}, {_.DilationShape[0]},
+                                          padding_mode::notset, {0, 0}, activation_type_);
+    stream_ = stream._;
+}
+
+void conv::fuse(const std::vector<MmActivationHolder>& activations, const MM_POOL_PARAMS* pool) {
+    fused_activations_ = activations;
+    fused_pool_ = pool != nullptr;
+    pool_ = fused_pool_ ? *pool : MM_POOL_PARAMS();
+}
+
+void conv_transpose::infer_output_requirement_shape(shape3d in, size_t out_channel, size_t group_count,
+                                                    bool has_bias, std::vector<size_t> kernel_shape,
+                                                    std::vector<size_t> stride_shape,
+                                                    std::vector<size_t> dilation_shape,
+                                                    std::vector<size_t> pads,
+                                                    std::vector<size_t> output_padding) {
+    const size_t rank = kernel_shape.size();
+    if (rank != 1 && rank != 2) throw xs_error("[conv_transpose] kernel_shape rank must be 1 or 2");
+    if (rank == 1 && in.H != 1) throw xs_error("[conv_transpose] 1D conv_transpose expects input shape (C, 1, W)");
+    if (group_count == 0 || in.C % group_count != 0 || out_channel % group_count != 0) {
+        throw xs_error("[conv_transpose] channels must be divisible by group_count");
+    }
+
+    if (stride_shape.empty()) stride_shape.resize(rank, 1);
+    if (dilation_shape.empty()) dilation_shape.resize(rank, 1);
+    if (pads.empty()) pads.resize(2 * rank, 0);
+    if (output_padding.empty()) output_padding.resize(rank, 0);
+
+    if (stride_shape.size() != rank || dilation_shape.size() != rank ||
+        pads.size() != 2 * rank || output_padding.size() != rank) {
+        throw xs_error("[conv_transpose] stride, dilation, pads and output_padding must match kernel rank");
+    }
+
+    const size_t in_dims[2] = {rank == 2 ? in.H : in.W, in.W};
+    size_t out_dims[2] = {1, 1};
+
+    for (size_t i = 0; i < rank; ++i) {
+        if (output_padding[i] >= stride_shape[i]) {
+            throw xs_error("[conv_transpose] output_padding must be less than stride");
+        }
+
+        const size_t full = (in_dims[i] - 1) * stride_shape[i] + dilation_shape[i] * (kernel_shape[i] - 1)
+                            + output_padding[i] + 1;
+        if (full <= pads[i] + pads[i + rank]) {
+            throw xs_error("[conv_transpose] pads are larger than output");
+        }
+        out_dims[i] = full - pads[i] - pads[i + rank];
+    }
+
+    in_shape_ = in;
+    out_shape_ = rank == 2 ? shape3d(out_channel, out_dims[0], out_dims[1])
+                           : shape3d(out_channel, 1, out_dims[0]);
+    output_padding_ = output_padding;
+    has_bias_ = has_bias;
+
+    conv_._.Dimensions = rank;
+    conv_.infer_output_requirement_shape(out_shape_, in.C, group_count, false,
+                                         kernel_shape, stride_shape, dilation_shape,
+                                         padding_mode::notset, pads, MmActivationType::NotSet);
 }
 
     } // params
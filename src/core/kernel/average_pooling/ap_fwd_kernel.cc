@@ -0,0 +1,26 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/average_pooling/ap_fwd_kernel.h>
+#include <core/kernel/average_pooling/ap_fwd_xs_impl.h>
+
+namespace xsdnn {
+    namespace core {
+
+void AvgPoolingFwdKernel::compute(xsdnn::core::OpContext &ctx, params::avg_pool &p) {
+    const tensor_t& in_data = ctx.input_data(0);
+    tensor_t& out_data = ctx.output_data(0);
+
+    backend_t engine = ctx.engine();
+
+    if (engine == backend_t::xs) {
+        kernel::avg_pool_fwd_xs_impl(in_data, out_data, p, ctx.parallelize(), ctx.num_threads());
+    } else {
+        throw xs_error("[avg_pool forward] unsupported engine type");
+    }
+}
+
+    } // core
+} // xsdnn
@@ -0,0 +1,36 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/average_pooling/ap_fwd_xs_impl.h>
+#include <core/framework/threading.h>
+
+namespace xsdnn {
+    namespace kernel {
+
+void avg_pool_fwd_xs_impl(const tensor_t& in_data,
+                          tensor_t& out_data,
+                          params::avg_pool& p,
+                          bool parallelize,
+                          size_t nthreads) {
+    const size_t SampleCount = in_data.size();
+    const size_t ChannelCount = p.in_shape_.C;
+    const size_t InputSize = p.in_shape_.area();
+    const size_t OutputSize = p.out_shape_.area();
+
+    // Параллельно по (образец, канал): при одном образце работу делят каналы
+    concurrency::TryParallelFor(parallelize, nthreads, SampleCount * ChannelCount, [&](size_t task) {
+        const size_t sample = task / ChannelCount;
+        const size_t c = task % ChannelCount;
+
+        mat_t ColumnBuffer(p.in_shape_.W);
+        mmpack::MmAveragePool(&p._, p.count_include_pad_,
+                              in_data[sample].data() + c * InputSize,
+                              out_data[sample].data() + c * OutputSize,
+                              1, ColumnBuffer.data());
+    });
+}
+
+    } // kernel
+} // xsdnn
@@ -4,22 +4,146 @@
 //
 
 #include <core/kernel/batch_norm/bn_bwd_xs_impl.h>
+#include <core/framework/threading.h>
+#include <algorithm>
 
 namespace xsdnn {
     namespace kernel {
 
-    void batch_normalization_bwd_xs_impl(const tensor_t& in,
-                                         const tensor_t& out,
-                                         tensor_t& dx,
-                                         tensor_t& dg,
-                                         tensor_t& db,
-                                         const tensor_t& dlz,
-                                         params::bnorm& p,
-                                         bool parallelize,
-                                         size_t nthreads) {
-        // TODO: make it
-        throw xs_error("[batch_norm backward xs engine] Not Implemented Yet");
+/*
+ * Коэффициенты dx = grad_scale * dy + input_scale * x + shift для канала.
+ *
+ * В режиме обучения y = gamma * (x - mean) / stddev + beta, где mean и stddev зависят от
+ * всех count значений канала, а дисперсия несмещенная (делитель count - 1):
+ * dx = gamma / stddev * (dy - sum(dy) / count - (x - mean) / stddev^2 * sum(dy * (x - mean)) / (count - 1)).
+ * В режиме inference статистики - константы и dx = gamma / stddev * dy.
+ */
+struct bn_bwd_coefficients {
+    mm_scalar grad_scale;
+    mm_scalar input_scale;
+    mm_scalar shift;
+};
+
+static bn_bwd_coefficients bn_bwd_coeff(mm_scalar gamma, mm_scalar mean, mm_scalar stddev,
+                                        mm_scalar sum_grad, mm_scalar sum_grad_centered,
+                                        size_t count, bool train) {
+    const mm_scalar inv_stddev = mm_scalar(1) / stddev;
+
+    bn_bwd_coefficients k;
+    k.grad_scale = gamma * inv_stddev;
+    k.input_scale = mm_scalar(0);
+    k.shift = mm_scalar(0);
+
+    if (train) {
+        const mm_scalar denominator = std::max(mm_scalar(1), mm_scalar(count) - mm_scalar(1));
+        k.input_scale = -k.grad_scale * inv_stddev * inv_stddev * sum_grad_centered / denominator;
+        k.shift = -k.grad_scale * sum_grad / mm_scalar(count) - k.input_scale * mean;
+    }
+    return k;
+}
+
+void batch_normalization_bwd_xs_impl(const tensor_t& in,
+                                     const mat_t& gamma,
+                                     const tensor_t& out,
+                                     tensor_t& dx,
+                                     tensor_t& dg,
+                                     tensor_t& db,
+                                     const tensor_t& dlz,
+                                     params::bnorm& p,
+                                     bool parallelize,
+                                     size_t nthreads) {
+    if (!p.statistic_initialized) {
+        throw xs_error("[batch_norm backward] forward must be called before backward");
+    }
+    if (p.layout_ == tensor_layout::nchwc) {
+        throw xs_error("[batch_norm backward] nchwc layout is supported only for inference");
     }
 
+    const bool train = p.phase_ == op_mode::train;
+    const mat_t& mean = train ? p.batch_mean_ : p.mean_;
+    const mat_t& stddev = train ? p.batch_stddev_ : p.stddev_;
+
+    const size_t samples = in.size();
+    const size_t channels = p.in_shape_.C;
+    const size_t spatial_size = p.in_shape_.area();
+    const size_t count = samples * spatial_size;
+
+    /*
+     * dg[sample] и db[sample] - вклад образца в градиенты gamma и beta, их сумма по
+     * образцам считается при обновлении весов.
+     */
+    if (p.layout_ == tensor_layout::nhwc) {
+        concurrency::TryParallelFor(parallelize, nthreads, samples, [&](size_t sample) {
+            mm_scalar* sum_grad = db[sample].data();
+            mm_scalar* sum_grad_centered = dg[sample].data();
+            const mm_scalar* x = in[sample].data();
+            const mm_scalar* dy = dlz[sample].data();
+
+            std::fill(sum_grad, sum_grad + channels, mm_scalar(0));
+            std::fill(sum_grad_centered, sum_grad_centered + channels, mm_scalar(0));
+
+            for (size_t d = 0; d < spatial_size; ++d, x += channels, dy += channels) {
+                for (size_t c = 0; c < channels; ++c) {
+                    sum_grad[c] += dy[c];
+                    sum_grad_centered[c] += dy[c] * (x[c] - mean[c]);
+                }
+            }
+        });
+
+        std::vector<bn_bwd_coefficients> k(channels);
+        for (size_t c = 0; c < channels; ++c) {
+            mm_scalar sum_grad = 0, sum_grad_centered = 0;
+            for (size_t sample = 0; sample < samples; ++sample) {
+                sum_grad += db[sample][c];
+                sum_grad_centered += dg[sample][c];
+            }
+            k[c] = bn_bwd_coeff(gamma[c], mean[c], stddev[c], sum_grad, sum_grad_centered, count, train);
+        }
+
+        concurrency::TryParallelFor(parallelize, nthreads, samples, [&](size_t sample) {
+            const mm_scalar* x = in[sample].data();
+            const mm_scalar* dy = dlz[sample].data();
+            mm_scalar* dst = dx[sample].data();
+
+            for (size_t c = 0; c < channels; ++c) {
+                dg[sample][c] /= stddev[c];
+            }
+
+            for (size_t d = 0; d < spatial_size; ++d, x += channels, dy += channels, dst += channels) {
+                for (size_t c = 0; c < channels; ++c) {
+                    dst[c] = k[c].grad_scale * dy[c] + k[c].input_scale * x[c] + k[c].shift;
+                }
+            }
+        });
+        return;
+    }
+
+    concurrency::TryParallelFor(parallelize, nthreads, channels, [&](size_t c) {
+        const size_t offset = c * spatial_size;
+        mm_scalar sum_grad = 0, sum_grad_centered = 0;
+
+        for (size_t sample = 0; sample < samples; ++sample) {
+            float sample_sum_grad, sample_sum_grad_centered;
+            mmpack::MmBatchNormBackwardReduce(dlz[sample].data() + offset, in[sample].data() + offset,
+                                              spatial_size, mean[c],
+                                              &sample_sum_grad, &sample_sum_grad_centered);
+
+            db[sample][c] = sample_sum_grad;
+            dg[sample][c] = sample_sum_grad_centered / stddev[c];
+            sum_grad += sample_sum_grad;
+            sum_grad_centered += sample_sum_grad_centered;
+        }
+
+        const bn_bwd_coefficients k = bn_bwd_coeff(gamma[c], mean[c], stddev[c],
+                                                   sum_grad, sum_grad_centered, count, train);
+
+        for (size_t sample = 0; sample < samples; ++sample) {
+            mmpack::MmBatchNormBackwardApply(dlz[sample].data() + offset, in[sample].data() + offset,
+                                             dx[sample].data() + offset, spatial_size,
+                                             k.grad_scale, k.input_scale, k.shift);
+        }
+    });
+}
+
     } // kernel
-} // xsdnn
\ No newline at end of file
+} // xsdnn
@@ -6,53 +6,91 @@
 #include <core/kernel/batch_norm/bn_fwd_xs_impl.h>
 #include <core/framework/threading.h>
 #include <algorithm>
-#include <numeric>
 #include <cmath>
 
 namespace xsdnn {
     namespace kernel {
 
-void compute_mean(const tensor_t& in, size_t channels, size_t spatial_size, mat_t& mean) {
-    for (size_t sample = 0; sample < in.size(); ++sample) {
-        for (size_t c = 0; c < channels; ++c) {
-            mm_scalar& m = mean.at(c);
-            const auto start = in[sample].begin() + (c * spatial_size);
-            m = std::accumulate(start, start + spatial_size, m);
-        }
-    }
-    std::transform(mean.begin(), mean.end(), mean.begin(),
-                   [=](mm_scalar x) { return x / ( in.size() * spatial_size ) ; });
+mm_scalar unbiased_stddev(size_t count, mm_scalar sum_squares, mm_scalar eps) {
+    return std::sqrt(sum_squares / std::max(mm_scalar(1), mm_scalar(count) - mm_scalar(1)) + eps);
 }
 
-void compute_stddev(const tensor_t& in, size_t channels, size_t spatial_size,
-                    mat_t& mean, mat_t& stddev, mm_scalar eps) {
-    for (size_t i = 0; i < in.size(); i++) {
-        for (size_t j = 0; j < channels; j++) {
-            mm_scalar &rstddev    = stddev[j];
-            const auto it    = in[i].begin() + (j * spatial_size);
-            const mm_scalar ex = mean[j];
-            rstddev             = std::accumulate(it, it + spatial_size, rstddev,
-                                               [ex](mm_scalar current, mm_scalar x) {
-                                                   return current + std::pow(x - ex, mm_scalar{2.0f});
-                                               });
+/*
+ * Среднее и стандартное отклонение каждого канала за один проход по данным:
+ * каналы обрабатываются параллельно, статистики плоскостей образцов считает
+ * mmpack::MmMoments и объединяет по формуле Чана.
+ */
+void compute_moments(const tensor_t& in, shape3d& shape, mat_t& mean, mat_t& stddev, mm_scalar eps,
+                     bool parallelize, size_t nthreads) {
+    const size_t channels = shape.C;
+    const size_t spatial_size = shape.area();
+
+    concurrency::TryParallelFor(parallelize, nthreads, channels, [&](size_t c) {
+        size_t count = 0;
+        float m = 0.0f;
+        float sum_squares = 0.0f;
+
+        for (size_t sample = 0; sample < in.size(); ++sample) {
+            mmpack::MmMoments(in[sample].data() + c * spatial_size, spatial_size, &count, &m, &sum_squares);
         }
-    }
-    std::transform(stddev.begin(), stddev.end(), stddev.begin(),
-                   [=](mm_scalar x) { return x / (std::max(float_t{1.0f},
-                                                           static_cast<float_t>(in.size() * spatial_size) - float_t{1.0f}));
-                   });
 
-    for (size_t i = 0; i < channels; i++) {
-        stddev[i] = sqrt(stddev[i] + eps);
-    }
+        mean[c] = m;
+        stddev[c] = unbiased_stddev(count, sum_squares, eps);
+    });
 }
 
-void compute_moments(const tensor_t& in, shape3d& shape, mat_t& mean, mat_t& stddev, mm_scalar eps) {
-    size_t channels = shape.C;
-    size_t spatial_size = shape.area();
+/*
+ * В формате NHWC каналы лежат подряд, поэтому статистики образца считаются двумя
+ * проходами по его данным с внутренним циклом по каналам (образцы параллельно),
+ * после чего статистики образцов объединяются по формуле Чана.
+ */
+void compute_moments_nhwc(const tensor_t& in, shape3d& shape, mat_t& mean, mat_t& stddev, mm_scalar eps,
+                          bool parallelize, size_t nthreads) {
+    const size_t channels = shape.C;
+    const size_t spatial_size = shape.area();
+
+    std::vector<mat_t> sample_mean(in.size(), mat_t(channels));
+    std::vector<mat_t> sample_squares(in.size(), mat_t(channels));
+
+    concurrency::TryParallelFor(parallelize, nthreads, in.size(), [&](size_t sample) {
+        mm_scalar* m = sample_mean[sample].data();
+        mm_scalar* sq = sample_squares[sample].data();
+        const mm_scalar* x = in[sample].data();
+
+        std::fill(m, m + channels, mm_scalar(0));
+        std::fill(sq, sq + channels, mm_scalar(0));
+
+        for (size_t d = 0; d < spatial_size; ++d, x += channels) {
+            for (size_t c = 0; c < channels; ++c) {
+                m[c] += x[c];
+            }
+        }
+        for (size_t c = 0; c < channels; ++c) {
+            m[c] /= mm_scalar(spatial_size);
+        }
+
+        x = in[sample].data();
+        for (size_t d = 0; d < spatial_size; ++d, x += channels) {
+            for (size_t c = 0; c < channels; ++c) {
+                const mm_scalar diff = x[c] - m[c];
+                sq[c] += diff * diff;
+            }
+        }
+    });
+
+    for (size_t c = 0; c < channels; ++c) {
+        size_t count = 0;
+        float m = 0.0f;
+        float sum_squares = 0.0f;
 
-    compute_mean(in, channels, spatial_size, mean);
-    compute_stddev(in, channels, spatial_size, mean, stddev, eps);
+        for (size_t sample = 0; sample < in.size(); ++sample) {
+            mmpack::MmMomentsMerge(&count, &m, &sum_squares,
+                                   spatial_size, sample_mean[sample][c], sample_squares[sample][c]);
+        }
+
+        mean[c] = m;
+        stddev[c] = unbiased_stddev(count, sum_squares, eps);
+    }
 }
 
 void batch_normalization_fwd_xs_impl(const tensor_t& in,
@@ -62,29 +100,79 @@ void batch_normalization_fwd_xs_impl(const tensor_t& in,
                                      params::bnorm& p,
                                      bool parallelize,
                                      size_t nthreads) {
-    mat_t& mean = (p.phase_ == op_mode::train) ? p.stat_holder["mean_running_"] : p.stat_holder["mean_"];
-    mat_t& stddev = (p.phase_ == op_mode::train) ? p.stat_holder["stddev_running_"] : p.stat_holder["stddev_"];
+    const size_t channel = p.in_shape_.C;
+    const size_t spatial_size = p.in_shape_.area();
+
+    /*
+     * Нормализация сводится к поканальному y = scale[c] * x + shift[c]. В режиме обучения
+     * коэффициенты считаются по статистикам батча, в режиме inference берутся из params
+     * и пересчитываются только после изменения весов или статистик.
+     */
+    mat_t train_scale, train_shift;
+    const mat_t* scale = &p.scale_;
+    const mat_t* shift = &p.shift_;
 
     if (p.phase_ == op_mode::train) {
-        compute_moments(in, p.in_shape_, mean, stddev, p.eps_);
+        if (p.layout_ == tensor_layout::nchwc) {
+            throw xs_error("[batch_norm fwd] training is supported only for nchw and nhwc layouts");
+        }
+        if (p.layout_ == tensor_layout::nhwc) {
+            compute_moments_nhwc(in, p.in_shape_, p.batch_mean_, p.batch_stddev_, p.eps_, parallelize, nthreads);
+        } else {
+            compute_moments(in, p.in_shape_, p.batch_mean_, p.batch_stddev_, p.eps_, parallelize, nthreads);
+        }
+
+        train_scale.resize(channel);
+        train_shift.resize(channel);
+        for (size_t c = 0; c < channel; ++c) {
+            train_scale[c] = gamma[c] / p.batch_stddev_[c];
+            train_shift[c] = beta[c] - p.batch_mean_[c] * train_scale[c];
+        }
+        scale = &train_scale;
+        shift = &train_shift;
+    } else if (!p.scale_shift_ready_) {
+        p.compute_scale_shift(gamma, beta);
     }
 
-    size_t channel = p.in_shape_.C;
-    size_t spatial_size = p.in_shape_.area();
+    if (p.layout_ == tensor_layout::nhwc) {
+        // Образец делится по строкам, чтобы при batch 1 работали все потоки
+        const size_t rows = p.in_shape_.H;
+        const size_t row_size = spatial_size / rows;
 
-    concurrency::TryParallelFor(parallelize, nthreads, in.size(), [&](size_t sample) {
-        const mm_scalar* in_ptr = in[sample].data();
-        mm_scalar* out_ptr = out[sample].data();
+        concurrency::TryParallelFor(parallelize, nthreads, in.size() * rows, [&](size_t task) {
+            const size_t sample = task / rows;
+            const size_t offset = (task % rows) * row_size * channel;
 
-        for (size_t c = 0; c < channel; ++c) {
-            mm_scalar& m = mean[c];
-            mm_scalar& s = stddev[c];
-            for (size_t k = 0; k < spatial_size; ++k) {
-                *out_ptr++ = gamma[c] * (*in_ptr++ - m) / s + beta[c];
-            }
-        }
-    });
+            mmpack::MmScaleShiftNhwc(in[sample].data() + offset, out[sample].data() + offset,
+                                     scale->data(), shift->data(), channel, row_size);
+        });
+        return;
+    }
+
+    if (p.layout_ == tensor_layout::nchwc) {
+        // Блок каналов NCHWc - NHWC тензор с размером блока вместо кол-ва каналов
+        const size_t block = mmpack::MmNchwcGetBlockSize();
+        const size_t blocks = channel / block;
 
+        concurrency::TryParallelFor(parallelize, nthreads, in.size() * blocks, [&](size_t task) {
+            const size_t sample = task / blocks;
+            const size_t c = (task % blocks) * block;
+            const size_t offset = c * spatial_size;
+
+            mmpack::MmScaleShiftNhwc(in[sample].data() + offset, out[sample].data() + offset,
+                                     scale->data() + c, shift->data() + c, block, spatial_size);
+        });
+        return;
+    }
+
+    concurrency::TryParallelFor(parallelize, nthreads, in.size() * channel, [&](size_t task) {
+        const size_t sample = task / channel;
+        const size_t c = task % channel;
+        const size_t offset = c * spatial_size;
+
+        mmpack::MmScaleShift(in[sample].data() + offset, out[sample].data() + offset,
+                             spatial_size, (*scale)[c], (*shift)[c]);
+    });
 }
 
     } // kernel
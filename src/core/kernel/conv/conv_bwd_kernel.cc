@@ -0,0 +1,47 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/conv/conv_bwd_kernel.h>
+#include <core/kernel/conv/conv_bwd_xs_impl.h>
+#include <core/kernel/conv/conv_fwd_xs_impl.h>
+
+namespace xsdnn {
+    namespace core {
+
+void ConvBwdKernel::compute(xsdnn::core::OpContext &ctx, params::conv &p) {
+    const tensor_t& X = ctx.input_data(0);
+    const tensor_t& W = ctx.input_data(1);
+    const tensor_t& Y = ctx.output_data(0);
+    const tensor_t& dY = ctx.output_grad(0);
+
+    tensor_t& dX = ctx.input_grad(0);
+    tensor_t& dW = ctx.input_grad(1);
+    tensor_t* dB = p._.Bias ? &ctx.input_grad(2) : nullptr;
+
+    backend_t engine = ctx.engine();
+
+    if (engine == backend_t::xs) {
+        /*
+         * Производная Gelu / Silu не выражается через выход, поэтому вход встроенной
+         * активации пересчитывается сверткой без активации.
+         */
+        tensor_t Z;
+        if (MmActivationNeedsInput(p.activation_type_)) {
+            params::conv Linear = p;
+            Linear.activation_type_ = MmActivationType::NotSet;
+            Z.resize(X.size(), mat_t(Y[0].size()));
+            kernel::conv_fwd_xs_impl(X, W[0], p._.Bias ? &ctx.input_data(2)[0] : nullptr, Z, Linear,
+                                     ctx.parallelize(), ctx.num_threads());
+        }
+
+        kernel::conv_bwd_xs_impl(X, W[0], Y, Z.empty() ? nullptr : &Z, dY, dX, dW, dB, p,
+                                 ctx.parallelize(), ctx.num_threads());
+    } else {
+        throw xs_error("[conv backward] unsupported engine type");
+    }
+}
+
+    } // core
+} // xsdnn
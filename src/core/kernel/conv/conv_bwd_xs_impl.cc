@@ -0,0 +1,99 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/conv/conv_bwd_xs_impl.h>
+#include <core/framework/threading.h>
+#include <algorithm>
+
+namespace xsdnn {
+    namespace kernel {
+
+void conv_bwd_xs_impl(const tensor_t& X,
+                      const mat_t& W,
+                      const tensor_t& Y,
+                      const tensor_t* Z,
+                      const tensor_t& dY,
+                      tensor_t& dX,
+                      tensor_t& dW,
+                      tensor_t* dB,
+                      params::conv& p,
+                      bool parallelize,
+                      size_t nthreads) {
+    if (p.layout_ != tensor_layout::nchw || p.out_layout_ != tensor_layout::nchw) {
+        throw xs_error("[conv bwd] only nchw layout is supported");
+    }
+
+    const size_t SampleCount = X.size();
+    const size_t GroupCount = p._.GroupCount;
+
+    const tensor_t* OutputGrad = &dY;
+    tensor_t dZ;
+
+    // Градиент по выходу свертки до встроенной активации: dZ = dY * f'(Y)
+    if (p.activation_type_ != MmActivationType::NotSet) {
+        MmActivationHolder ActHolder;
+        ActHolder.ActivationType = p.activation_type_;
+        MmSetDefaultActivationParameters(&ActHolder);
+
+        dZ.resize(SampleCount, mat_t(dY[0].size()));
+        concurrency::TryParallelFor(parallelize, nthreads, SampleCount, [&](size_t sample) {
+            MmActivationBackward(&ActHolder, Z != nullptr ? (*Z)[sample].data() : nullptr,
+                                 Y[sample].data(), dY[sample].data(), dZ[sample].data(), dY[sample].size());
+        });
+        OutputGrad = &dZ;
+    }
+
+    /*
+     * Образцы делятся на непрерывные блоки по одному на поток. Блок суммирует градиенты весов
+     * своих образцов в свой буфер (блок 0 - сразу в dW[0] и dB[0]), группы одного блока пишут
+     * в непересекающиеся части буфера. Затем буферы складываются в dW[0] и dB[0] по порядку
+     * блоков, поэтому при заданном числе потоков результат не зависит от планирования задач.
+     */
+    const size_t BlockCount = std::max<size_t>(1, std::min(parallelize ? nthreads : 1, SampleCount));
+    const size_t BlockSize = (SampleCount + BlockCount - 1) / BlockCount;
+    const size_t BiasSize = dB != nullptr ? (*dB)[0].size() : 0;
+
+    tensor_t WeightGrad(BlockCount - 1, mat_t(W.size(), 0));
+    tensor_t BiasGrad(BlockCount - 1, mat_t(BiasSize, 0));
+    std::fill(dW[0].begin(), dW[0].end(), mm_scalar(0));
+    if (dB != nullptr) {
+        std::fill((*dB)[0].begin(), (*dB)[0].end(), mm_scalar(0));
+    }
+
+    concurrency::TryParallelFor(parallelize, nthreads, BlockCount * GroupCount, [&](size_t task) {
+        const size_t block = task / GroupCount;
+        const size_t group = task % GroupCount;
+
+        mm_scalar* dWBlock = block == 0 ? dW[0].data() : WeightGrad[block - 1].data();
+        mm_scalar* dBBlock = dB == nullptr ? nullptr : block == 0 ? (*dB)[0].data() : BiasGrad[block - 1].data();
+        mat_t TemporaryBuffer(mmpack::MmConvBackwardBufferSize(&p._));
+
+        const size_t SampleEnd = std::min(SampleCount, (block + 1) * BlockSize);
+        for (size_t sample = block * BlockSize; sample < SampleEnd; ++sample) {
+            mmpack::MmConvBackward(&p._,
+                                   X[sample].data(), W.data(), (*OutputGrad)[sample].data(),
+                                   dX[sample].data(), dWBlock, dBBlock,
+                                   TemporaryBuffer.data(), group);
+        }
+    });
+
+    for (size_t block = 0; block + 1 < BlockCount; ++block) {
+        mmpack::MmBinary(mmpack::MmBinaryAdd, dW[0].data(), WeightGrad[block].data(), dW[0].data(), W.size());
+        if (dB != nullptr) {
+            mmpack::MmBinary(mmpack::MmBinaryAdd, (*dB)[0].data(), BiasGrad[block].data(), (*dB)[0].data(), BiasSize);
+        }
+    }
+
+    // Градиенты весов суммируются по образцам при обновлении, поэтому остальные записи нулевые
+    for (size_t sample = 1; sample < dW.size(); ++sample) {
+        std::fill(dW[sample].begin(), dW[sample].end(), mm_scalar(0));
+    }
+    for (size_t sample = 1; dB != nullptr && sample < dB->size(); ++sample) {
+        std::fill((*dB)[sample].begin(), (*dB)[sample].end(), mm_scalar(0));
+    }
+}
+
+    } // kernel
+} // xsdnn
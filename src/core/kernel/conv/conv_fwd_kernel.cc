@@ -19,6 +19,11 @@ void ConvFwdKernel::compute(xsdnn::core::OpContext &ctx, params::conv &p) {
     backend_t engine = ctx.engine();
 
     if (engine == backend_t::xs) {
+        // Слитая с max pooling свертка идет через Im2Col, выбранный при слиянии (см. conv::fuse_chain)
+        if (!p.fused_pool_) {
+            p.select_algorithm(ctx.parallelize() ? ctx.num_threads() : 1);
+            p.pack_filter(W[0]);
+        }
         kernel::conv_fwd_xs_impl(X, W[0], B, Y, p, ctx.parallelize(), ctx.num_threads());
     } else {
         xs_error("[conv forward] unsupported engine type");
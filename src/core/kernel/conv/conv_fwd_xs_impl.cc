@@ -5,6 +5,7 @@
 
 #include <core/kernel/conv/conv_fwd_xs_impl.h>
 #include <core/framework/threading.h>
+#include <algorithm>
 
 namespace xsdnn {
     namespace kernel {
@@ -16,26 +17,80 @@ void conv_fwd_xs_impl(const tensor_t& X,
                       params::conv& p,
                       bool parallelize,
                       size_t nthreads) {
+    const size_t InChannel = p._.InChannel * p._.GroupCount;
+    const size_t Context = p._.Padding[0];
+
+    if (p.stream_state_ != nullptr && p.stream_state_->size() != X.size()) {
+        p.stream_state_->assign(X.size(), mat_t(InChannel * Context, 0));
+    }
+
+    /*
+     * Собственная активация свертки, затем активации слитых с ней слоев.
+     */
+    std::vector<MmActivationHolder> Activations;
+    if (p.activation_type_ != MmActivationType::NotSet) {
+        MmActivationHolder ActHolder;
+        ActHolder.ActivationType = p.activation_type_;
+        MmSetDefaultActivationParameters(&ActHolder);
+        Activations.push_back(ActHolder);
+    }
+    Activations.insert(Activations.end(), p.fused_activations_.begin(), p.fused_activations_.end());
+
     concurrency::TryParallelFor(parallelize, nthreads, X.size(), [&](size_t sample) {
-        mat_t TemporaryBuffer(p._.TemproraryBufferSize);
+        const mm_scalar* Bias = B != nullptr ? B->data() : nullptr;
 
-        if (B != nullptr) {
-            mmpack::MmConv(&p._,
-                           X[sample].data(), W.data(), B->data(),
+        if (p.stream_state_ != nullptr) {
+            /*
+             * Потоковый режим: каждый канал дополняется слева контекстом предыдущей части,
+             * после свертки контекст сдвигается на последние Context кадров.
+             */
+            const size_t Width = p._.InShape[0];
+            const size_t ExtendedWidth = Context + Width;
+            mat_t& State = (*p.stream_state_)[sample];
+            mat_t Extended(InChannel * ExtendedWidth);
+            mat_t TemporaryBuffer(p.stream_.TemproraryBufferSize);
+
+            for (size_t c = 0; c < InChannel; ++c) {
+                std::copy_n(State.data() + c * Context, Context, Extended.data() + c * ExtendedWidth);
+                std::copy_n(X[sample].data() + c * Width, Width, Extended.data() + c * ExtendedWidth + Context);
+            }
+
+            mmpack::MmConv(&p.stream_,
+                           Extended.data(), W.data(), Bias,
                            TemporaryBuffer.data(), Y[sample].data());
+
+            for (size_t c = 0; c < InChannel; ++c) {
+                std::copy_n(Extended.data() + c * ExtendedWidth + Width, Context, State.data() + c * Context);
+            }
+        } else if (p.fused_pool_) {
+            mat_t TemporaryBuffer(mmpack::MmConvPoolBufferSize(&p._, &p.pool_));
+            mmpack::MmConvPool(&p._, &p.pool_,
+                               Activations.data(), Activations.size(),
+                               X[sample].data(), W.data(), Bias,
+                               TemporaryBuffer.data(), Y[sample].data());
+            return;
+        } else if (p.nchwc()) {
+            mat_t TemporaryBuffer(p._.TemproraryBufferSize);
+            mmpack::MmConvNchwcLayout(&p._,
+                                      p.layout_ == tensor_layout::nchwc, p.out_layout_ == tensor_layout::nchwc,
+                                      X[sample].data(), W.data(), Bias,
+                                      TemporaryBuffer.data(), Y[sample].data());
+        } else if (p.layout_ == tensor_layout::nhwc) {
+            mat_t TemporaryBuffer(p._.TemproraryBufferSize);
+            mmpack::MmConvNhwc(&p._,
+                               X[sample].data(), W.data(), Bias,
+                               TemporaryBuffer.data(), Y[sample].data());
         } else {
+            mat_t TemporaryBuffer(p._.TemproraryBufferSize);
             mmpack::MmConv(&p._,
-                           X[sample].data(), W.data(), nullptr,
+                           X[sample].data(), W.data(), Bias,
                            TemporaryBuffer.data(), Y[sample].data());
         }
 
         // Compute activation if there is
-        if (p.activation_type_ != MmActivationType::NotSet) {
-            MmActivationHolder ActHolder;
-            ActHolder.ActivationType = p.activation_type_;
-            MmSetDefaultActivationParameters(&ActHolder);
-
-            MmActivation(&ActHolder, Y[sample].data(), p._.OutShape[0], p._.OutShape[1], p._.OutShape[1]);
+        const size_t OutChannel = p._.FilterCount * p._.GroupCount;
+        for (MmActivationHolder& ActHolder : Activations) {
+            MmActivation(&ActHolder, Y[sample].data(), OutChannel, p._.OutSize, p._.OutSize);
         }
     });
 }
@@ -0,0 +1,31 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/conv_transpose/conv_transpose_bwd_kernel.h>
+#include <core/kernel/conv_transpose/conv_transpose_bwd_xs_impl.h>
+
+namespace xsdnn {
+    namespace core {
+
+void ConvTransposeBwdKernel::compute(xsdnn::core::OpContext &ctx, params::conv_transpose &p) {
+    const tensor_t& X = ctx.input_data(0);
+    const tensor_t& W = ctx.input_data(1);
+    const tensor_t& dY = ctx.output_grad(0);
+
+    tensor_t& dX = ctx.input_grad(0);
+    tensor_t& dW = ctx.input_grad(1);
+    tensor_t* dB = p.has_bias_ ? &ctx.input_grad(2) : nullptr;
+
+    backend_t engine = ctx.engine();
+
+    if (engine == backend_t::xs) {
+        kernel::conv_transpose_bwd_xs_impl(X, W[0], dY, dX, dW, dB, p, ctx.parallelize(), ctx.num_threads());
+    } else {
+        throw xs_error("[conv_transpose backward] unsupported engine type");
+    }
+}
+
+    } // core
+} // xsdnn
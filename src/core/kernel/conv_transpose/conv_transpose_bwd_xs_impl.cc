@@ -0,0 +1,52 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/conv_transpose/conv_transpose_bwd_xs_impl.h>
+#include <core/framework/threading.h>
+
+namespace xsdnn {
+    namespace kernel {
+
+void conv_transpose_bwd_xs_impl(const tensor_t& X,
+                                const mat_t& W,
+                                const tensor_t& dY,
+                                tensor_t& dX,
+                                tensor_t& dW,
+                                tensor_t* dB,
+                                const params::conv_transpose& p,
+                                bool parallelize,
+                                size_t nthreads) {
+    const MM_CONV_PARAMS& Conv = p.conv_._;
+    const size_t OutChannel = Conv.InChannel * Conv.GroupCount;
+
+    concurrency::TryParallelFor(parallelize, nthreads, X.size(), [&](size_t sample) {
+        /*
+         * Транспонированная свертка - градиент по входу эквивалентной свертки, поэтому
+         * dX = Conv(dY), а dW считается как градиент весов свертки с входом dY и градиентом выхода X.
+         */
+        mat_t ConvBuffer(Conv.TemproraryBufferSize);
+        mmpack::MmConv(&Conv, dY[sample].data(), W.data(), nullptr, ConvBuffer.data(), dX[sample].data());
+
+        mat_t TemporaryBuffer(mmpack::MmConvBackwardBufferSize(&Conv));
+        for (size_t group = 0; group < Conv.GroupCount; ++group) {
+            mmpack::MmConvBackward(&Conv, dY[sample].data(), W.data(), X[sample].data(),
+                                   nullptr, dW[sample].data(), nullptr,
+                                   TemporaryBuffer.data(), group);
+        }
+
+        if (dB != nullptr) {
+            const mm_scalar* dYPtr = dY[sample].data();
+            mm_scalar* dBPtr = (*dB)[sample].data();
+            for (size_t c = 0; c < OutChannel; ++c) {
+                for (size_t i = 0; i < Conv.InSize; ++i) {
+                    dBPtr[c] += dYPtr[c * Conv.InSize + i];
+                }
+            }
+        }
+    });
+}
+
+    } // kernel
+} // xsdnn
@@ -0,0 +1,29 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/conv_transpose/conv_transpose_fwd_kernel.h>
+#include <core/kernel/conv_transpose/conv_transpose_fwd_xs_impl.h>
+
+namespace xsdnn {
+    namespace core {
+
+void ConvTransposeFwdKernel::compute(xsdnn::core::OpContext &ctx, params::conv_transpose &p) {
+    const tensor_t& X = ctx.input_data(0);
+    const tensor_t& W = ctx.input_data(1);
+    const mat_t* B = p.has_bias_ ? &ctx.input_data(2).at(0) : nullptr;
+
+    tensor_t& Y = ctx.output_data(0);
+
+    backend_t engine = ctx.engine();
+
+    if (engine == backend_t::xs) {
+        kernel::conv_transpose_fwd_xs_impl(X, W[0], B, Y, p, ctx.parallelize(), ctx.num_threads());
+    } else {
+        throw xs_error("[conv_transpose forward] unsupported engine type");
+    }
+}
+
+    } // core
+} // xsdnn
@@ -0,0 +1,30 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/conv_transpose/conv_transpose_fwd_xs_impl.h>
+#include <core/framework/threading.h>
+
+namespace xsdnn {
+    namespace kernel {
+
+void conv_transpose_fwd_xs_impl(const tensor_t& X,
+                                const mat_t& W,
+                                const mat_t* B,
+                                tensor_t& Y,
+                                const params::conv_transpose& p,
+                                bool parallelize,
+                                size_t nthreads) {
+    concurrency::TryParallelFor(parallelize, nthreads, X.size(), [&](size_t sample) {
+        mat_t TemporaryBuffer(mmpack::MmConvBackwardBufferSize(&p.conv_._));
+
+        mmpack::MmConvTranspose(&p.conv_._,
+                                X[sample].data(), W.data(),
+                                B != nullptr ? B->data() : nullptr,
+                                TemporaryBuffer.data(), Y[sample].data());
+    });
+}
+
+    } // kernel
+} // xsdnn
@@ -0,0 +1,26 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/global_average_pooling/gap_bwd_kernel.h>
+#include <core/kernel/global_average_pooling/gap_bwd_xs_impl.h>
+
+namespace xsdnn {
+    namespace core {
+
+void GlobalAvgPoolingBwdKernel::compute(xsdnn::core::OpContext &ctx, params::global_avg_pool &p) {
+    const tensor_t& dY = ctx.output_grad(0);
+    tensor_t& dX = ctx.input_grad(0);
+
+    backend_t engine = ctx.engine();
+
+    if (engine == backend_t::xs) {
+        kernel::global_average_pool_bwd_xs_impl(dY, dX, p, ctx.parallelize(), ctx.num_threads());
+    } else {
+        throw xs_error("[global_average_pool backward] unsupported engine type");
+    }
+}
+
+    } // core
+} // xsdnn
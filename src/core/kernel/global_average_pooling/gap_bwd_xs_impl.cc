@@ -0,0 +1,46 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/global_average_pooling/gap_bwd_xs_impl.h>
+#include <core/framework/threading.h>
+
+namespace xsdnn {
+    namespace kernel {
+
+void global_average_pool_bwd_xs_impl(const tensor_t& dY,
+                                     tensor_t& dX,
+                                     params::global_avg_pool& p,
+                                     bool parallelize,
+                                     size_t nthreads) {
+    if (p.layout_ == tensor_layout::nchwc) {
+        throw xs_error("[global_average_pooling backward] nchwc layout is supported only for inference");
+    }
+
+    const size_t channels = p.in_shape_.C;
+    const size_t spatial_size = p.in_shape_.area();
+    const mm_scalar scale = mm_scalar(1) / mm_scalar(spatial_size);
+
+    // Градиент среднего поровну распределяется по всем точкам канала
+    concurrency::TryParallelFor(parallelize, nthreads, dY.size(), [&](size_t sample) {
+        const mm_scalar* grad = dY[sample].data();
+        mm_scalar* out = dX[sample].data();
+
+        if (p.layout_ == tensor_layout::nhwc) {
+            for (size_t d = 0; d < spatial_size; ++d) {
+                for (size_t c = 0; c < channels; ++c) {
+                    out[c] = grad[c] * scale;
+                }
+                out += channels;
+            }
+        } else {
+            for (size_t c = 0; c < channels; ++c) {
+                std::fill_n(out + c * spatial_size, spatial_size, grad[c] * scale);
+            }
+        }
+    });
+}
+
+    } // kernel
+} // xsdnn
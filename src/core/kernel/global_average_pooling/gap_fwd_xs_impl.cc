@@ -14,19 +14,23 @@ void global_average_pool_fwd_xs_impl(const tensor_t& in_data,
                                      params::global_avg_pool& p,
                                      bool parallelize,
                                      size_t nthreads) {
-    // TODO: make it for sse / avx
-    concurrency::TryParallelFor(parallelize, nthreads, in_data.size(), [&](size_t sample) {
-       const mat_t& in = in_data[sample];
-       mat_t& out = out_data[sample];
-
-       size_t spatial_size =  p.in_shape_.H * p.in_shape_.W;
-       for (size_t c = 0; c < p.in_shape_.C; ++c) {
-           for (size_t d = 0; d < spatial_size; ++d) {
-                out[c] += in[c * spatial_size + d];
-           }
-           out[c] /= spatial_size;
-       }
+    const size_t channels = p.in_shape_.C;
+    const size_t spatial_size = p.in_shape_.area();
 
+    // Ядра перезаписывают выход, поэтому повторный forward не накапливает старые значения
+    concurrency::TryParallelFor(parallelize, nthreads, in_data.size(), [&](size_t sample) {
+        if (p.layout_ == tensor_layout::nhwc) {
+            mmpack::MmGlobalAveragePoolNhwc(in_data[sample].data(), out_data[sample].data(), channels, spatial_size);
+        } else if (p.layout_ == tensor_layout::nchwc) {
+            // Блоки NCHWc усредняются как NHWC тензоры, выход C x 1 x 1 совпадает с NCHW
+            const size_t block = mmpack::MmNchwcGetBlockSize();
+            for (size_t c = 0; c < channels; c += block) {
+                mmpack::MmGlobalAveragePoolNhwc(in_data[sample].data() + c * spatial_size,
+                                                out_data[sample].data() + c, block, spatial_size);
+            }
+        } else {
+            mmpack::MmGlobalAveragePool(in_data[sample].data(), out_data[sample].data(), channels, spatial_size);
+        }
     });
 }
 
@@ -5,6 +5,7 @@
 
 #include <core/kernel/linear/fully_connected_bwd_kernel.h>
 #include <core/kernel/linear/fully_connected_bwd_xs_impl.h>
+#include <core/kernel/linear/fully_connected_fwd_xs_impl.h>
 #include <utils/xs_error.h>
 
 namespace xsdnn {
@@ -13,6 +14,7 @@ namespace xsdnn {
 void FullyConnectedBwdKernel::compute(xsdnn::core::OpContext &ctx, params::fully &p) {
     const tensor_t& x = ctx.input_data(0);
     const tensor_t& W = ctx.input_data(1);
+    const tensor_t& y = ctx.output_data(0);
     tensor_t& dW = ctx.input_grad(1);
     tensor_t* db = p.has_bias_ ? &ctx.input_grad(2) : nullptr;
     tensor_t& dx = ctx.input_grad(0);
@@ -23,8 +25,23 @@ void FullyConnectedBwdKernel::compute(xsdnn::core::OpContext &ctx, params::fully
     core::backend_t engine = ctx.engine();
 
     if (engine == core::backend_t::xs) {
+        /*
+         * Производная Gelu / Silu не выражается через выход, поэтому вход встроенной
+         * активации пересчитывается одним GEMM без активации.
+         */
+        tensor_t z;
+        if (MmActivationNeedsInput(p.activation_type_)) {
+            params::fully linear = p;
+            linear.activation_type_ = MmActivationType::NotSet;
+            z.resize(x.size(), mat_t(p.out_size_));
+            kernel::fully_connected_fwd_xs_impl(x, W[0], p.has_bias_ ? ctx.input_data(2)[0] : mat_t(), z, linear,
+                                                paralellize, ctx.num_threads());
+        }
+
         kernel::fully_connected_bwd_xs_impl(x,
                                             W[0],
+                                            y,
+                                            z.empty() ? nullptr : &z,
                                             dx,
                                             dW,
                                             p.has_bias_ ? *db : fake_tensor,
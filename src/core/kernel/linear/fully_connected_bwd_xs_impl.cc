@@ -5,12 +5,31 @@
 
 #include <core/kernel/linear/fully_connected_bwd_xs_impl.h>
 #include <core/framework/threading.h>
+#include <algorithm>
+#include <cstring>
 
 namespace xsdnn {
     namespace kernel {
 
+/*
+ * Собирает образцы tensor_t в непрерывную матрицу [batch][size].
+ */
+static const mm_scalar* fc_stage(const tensor_t& t, size_t size, mat_t& block,
+                                 bool parallelize, size_t nthreads) {
+    if (t.size() == 1) {
+        return t[0].data();
+    }
+    block.resize(t.size() * size);
+    concurrency::TryParallelFor(parallelize, nthreads, t.size(), [&](size_t sample) {
+        memcpy(block.data() + sample * size, t[sample].data(), sizeof(mm_scalar) * size);
+    });
+    return block.data();
+}
+
 void fully_connected_bwd_xs_impl(const tensor_t& x,
                                  const mat_t& W,
+                                 const tensor_t& y,
+                                 const tensor_t* z,
                                  tensor_t& dx,
                                  tensor_t& dW,
                                  tensor_t& db,
@@ -18,55 +37,102 @@ void fully_connected_bwd_xs_impl(const tensor_t& x,
                                  const params::fully& p,
                                  bool parallelize,
                                  size_t nthreads) {
-    size_t sample_count = x.size();
-    size_t in_size = p.in_size_;
-    size_t out_size = p.out_size_;
+    const size_t batch = x.size();
+    const size_t in_size = p.in_size_;
+    const size_t out_size = p.out_size_;
+    const size_t tasks = parallelize ? std::max<size_t>(nthreads, 1) : 1;
 
-    mm_scalar alpha = 1.0f;
-    mm_scalar beta  = 0.0f;
+    mat_t x_block, dLz_block, dx_block;
+    const mm_scalar* X = fc_stage(x, in_size, x_block, parallelize, nthreads);
+    const mm_scalar* dY;
 
-    concurrency::TryParallelFor(parallelize, nthreads, sample_count, [&](size_t sample) {
+    if (p.activation_type_ != MmActivationType::NotSet) {
         /*
-         * grad(x) = dLz * W.T [for each elem in batch]
+         * Градиент по выходу GEMM до встроенной активации: dZ = dLz * f'(y).
          */
-        mm_scalar* dLz_ptr = dLz[sample].data(); // A
-        const mm_scalar* W_ptr = W.data();       // B
-        mm_scalar* dx_ptr = dx[sample].data();   // C
+        MmActivationHolder ActHolder;
+        ActHolder.ActivationType = p.activation_type_;
+        MmSetDefaultActivationParameters(&ActHolder);
 
-        for (size_t i = 0; i < in_size; ++i) {
-            dx_ptr[i] = mmpack::MmDot(dLz_ptr,
-                                      &W_ptr[i * out_size],
-                                      out_size);
-        }
+        dLz_block.resize(batch * out_size);
+        concurrency::TryParallelFor(parallelize, nthreads, batch, [&](size_t sample) {
+            MmActivationBackward(&ActHolder, z != nullptr ? (*z)[sample].data() : nullptr,
+                                 y[sample].data(), dLz[sample].data(),
+                                 dLz_block.data() + sample * out_size, out_size);
+        });
+        dY = dLz_block.data();
+    } else {
+        dY = fc_stage(dLz, out_size, dLz_block, parallelize, nthreads);
+    }
 
-        /*
-         * grad(W) = x.T * dLz [for each elem in batch]
-         */
+    mm_scalar* dX = dx[0].data();
+    if (batch > 1) {
+        dx_block.resize(batch * in_size);
+        dX = dx_block.data();
+    }
+
+    /*
+     * grad(x) = dLz * W.T: [batch x out] * [out x in], потоки делят столбцы dx.
+     */
+    const size_t in_block = (in_size + tasks - 1) / tasks;
+    concurrency::TryParallelFor(parallelize, nthreads, (in_size + in_block - 1) / in_block, [&](size_t task) {
+        const size_t i = task * in_block;
+        mmpack::MmGemm(mmpack::CblasNoTrans,
+                       mmpack::CblasTrans,
+                       batch, std::min(in_block, in_size - i), out_size,
+                       1.0f,
+                       dY, out_size,
+                       W.data() + i * out_size, out_size,
+                       0.0f,
+                       dX + i, in_size);
+    });
 
-        dLz_ptr = dLz[sample].data();
-        const mm_scalar* x_ptr = x[sample].data();
-        mm_scalar* dW_ptr = dW[sample].data();
+    if (batch > 1) {
+        concurrency::TryParallelFor(parallelize, nthreads, batch, [&](size_t sample) {
+            memcpy(dx[sample].data(), dx_block.data() + sample * in_size, sizeof(mm_scalar) * in_size);
+        });
+    }
 
-        mmpack::MmGemm(
-                mmpack::CblasNoTrans,
-                mmpack::CblasNoTrans,
-                in_size, out_size, 1,
-                alpha,
-                x_ptr, 1,
-                dLz_ptr, out_size,
-                beta,
-                dW_ptr, out_size
-        );
+    /*
+     * grad(W) = x.T * dLz: [in x batch] * [batch x out], свертка по батчу идет внутри GEMM,
+     * и результат пишется в dW[0]. Потоки делят столбцы dW.
+     */
+    const size_t out_block = (out_size + tasks - 1) / tasks;
+    concurrency::TryParallelFor(parallelize, nthreads, (out_size + out_block - 1) / out_block, [&](size_t task) {
+        const size_t n = task * out_block;
+        const size_t count_n = std::min(out_block, out_size - n);
+
+        mmpack::MmGemm(mmpack::CblasTrans,
+                       mmpack::CblasNoTrans,
+                       in_size, count_n, batch,
+                       1.0f,
+                       X, in_size,
+                       dY + n, out_size,
+                       0.0f,
+                       dW[0].data() + n, out_size);
 
         /*
-         * grad(b) = dLz [for each elem in batch]
+         * grad(b) = sum(dLz) по батчу
          */
         if (!db.empty()) {
-            for (size_t i = 0; i < out_size; ++i) {
-                db[sample][i] += dLz[sample][i];
+            mm_scalar* db_ptr = db[0].data() + n;
+            std::fill(db_ptr, db_ptr + count_n, mm_scalar(0));
+            for (size_t sample = 0; sample < batch; ++sample) {
+                const mm_scalar* dy = dY + sample * out_size + n;
+                for (size_t j = 0; j < count_n; ++j) {
+                    db_ptr[j] += dy[j];
+                }
             }
         }
     });
+
+    // Градиенты весов суммируются по образцам при обновлении, поэтому остальные записи нулевые
+    for (size_t sample = 1; sample < dW.size(); ++sample) {
+        std::fill(dW[sample].begin(), dW[sample].end(), mm_scalar(0));
+    }
+    for (size_t sample = 1; sample < db.size(); ++sample) {
+        std::fill(db[sample].begin(), db[sample].end(), mm_scalar(0));
+    }
 }
 
     } // kernel
@@ -5,11 +5,24 @@
 
 #include <core/kernel/linear/fully_connected_fwd_xs_impl.h>
 #include <core/framework/threading.h>
+#include <algorithm>
 #include <cstring>
 
 namespace xsdnn {
     namespace kernel {
 
+/*
+ * Ширина части столбцов выхода, которую считает один поток: кратна 16, чтобы
+ * границы частей не разрезали векторы ядра MmGemm.
+ */
+static size_t fc_column_block(size_t out_size, bool parallelize, size_t nthreads) {
+    if (!parallelize || nthreads <= 1) {
+        return out_size;
+    }
+    const size_t block = (out_size + nthreads - 1) / nthreads;
+    return std::min(out_size, (block + 15) / 16 * 16);
+}
+
 void fully_connected_fwd_xs_impl(const tensor_t& in,
                                  const mat_t& W,
                                  const mat_t& b,
@@ -17,31 +30,69 @@ void fully_connected_fwd_xs_impl(const tensor_t& in,
                                  const params::fully& p,
                                  bool parallelize,
                                  size_t nthreads) {
-    size_t in_size = p.in_size_;
-    size_t out_size = p.out_size_;
-    mm_scalar alpha = 1.0;
-    mm_scalar beta = 1.0;
+    const size_t in_size = p.in_size_;
+    const size_t out_size = p.out_size_;
+    const size_t batch = in.size();
 
-    concurrency::TryParallelFor(parallelize, nthreads, in.size(), [&](size_t sample) {
-        const mm_scalar* in_ptr = in[sample].data();
-        const mm_scalar* w_ptr = W.data();
-        mm_scalar* out_ptr = out[sample].data();
+    /*
+     * Образцы tensor_t лежат в разных буферах, поэтому батч собирается в непрерывную
+     * матрицу [batch][in_size] и считается одним GEMM [batch x in] * [in x out]: так
+     * матрица весов читается из памяти один раз на батч, а не на каждый образец.
+     */
+    mat_t in_block;
+    mat_t out_block;
+    const mm_scalar* A = in[0].data();
+    mm_scalar* C = out[0].data();
 
+    if (batch > 1) {
+        in_block.resize(batch * in_size);
+        out_block.resize(batch * out_size);
+        concurrency::TryParallelFor(parallelize, nthreads, batch, [&](size_t sample) {
+            memcpy(in_block.data() + sample * in_size, in[sample].data(), sizeof(mm_scalar) * in_size);
+        });
+        A = in_block.data();
+        C = out_block.data();
+    }
+
+    for (size_t sample = 0; sample < batch; ++sample) {
+        mm_scalar* c_row = C + sample * out_size;
         if (b.empty()) {
-            memset(out_ptr, 0, sizeof(mm_scalar) * out_size);
+            memset(c_row, 0, sizeof(mm_scalar) * out_size);
         } else {
-            memcpy(out_ptr, b.data(), sizeof(mm_scalar) * out_size);
+            memcpy(c_row, b.data(), sizeof(mm_scalar) * out_size);
         }
+    }
+
+    MmActivationHolder ActHolder;
+    ActHolder.ActivationType = p.activation_type_;
+    MmSetDefaultActivationParameters(&ActHolder);
+
+    // Потоки делят столбцы выхода, и каждая часть весов читается одним потоком
+    const size_t block = fc_column_block(out_size, parallelize, nthreads);
+    const size_t block_count = (out_size + block - 1) / block;
+
+    concurrency::TryParallelFor(parallelize, nthreads, block_count, [&](size_t task) {
+        const size_t n = task * block;
+        const size_t count_n = std::min(block, out_size - n);
 
         mmpack::MmGemm(mmpack::CblasNoTrans,
                        mmpack::CblasNoTrans,
-                       1, out_size, in_size,
-                       alpha,
-                       in_ptr, in_size,
-                       w_ptr, out_size,
-                       beta,
-                       out_ptr, out_size);
+                       batch, count_n, in_size,
+                       1.0f,
+                       A, in_size,
+                       W.data() + n, out_size,
+                       1.0f,
+                       C + n, out_size);
+
+        // Встроенная активация применяется к части выхода, пока она в кэше
+        MmActivation(&ActHolder, C + n, batch, count_n, out_size);
     });
+
+    if (batch > 1) {
+        concurrency::TryParallelFor(parallelize, nthreads, batch, [&](size_t sample) {
+            memcpy(out[sample].data(), out_block.data() + sample * out_size, sizeof(mm_scalar) * out_size);
+        });
+    }
 }
 
     } // kernel
@@ -0,0 +1,40 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <core/kernel/max_pool/mp_bwd_xs_impl.h>
+#include <core/framework/threading.h>
+
+namespace xsdnn {
+    namespace kernel {
+
+void max_pool_bwd_xs_impl(const tensor_t& dY,
+                          tensor_t& dX,
+                          params::max_pool& p,
+                          bool parallelize,
+                          size_t nthreads) {
+    const size_t SampleCount = dY.size();
+    const size_t ChannelCount = p.in_shape_.C;
+    const size_t InputSize = p.in_shape_.area();
+    const size_t OutputSize = p.out_shape_.area();
+
+    if (p.argmax_.size() != SampleCount) {
+        throw xs_error("[max_pool bwd] forward must be run in training mode before backward");
+    }
+
+    // Каждая пара (образец, канал) пишет только в свою плоскость dX
+    concurrency::TryParallelFor(parallelize, nthreads, SampleCount * ChannelCount, [&](size_t task) {
+        const size_t sample = task / ChannelCount;
+        const size_t c = task % ChannelCount;
+
+        mmpack::MmMaxPoolBackward(&p._,
+                                  dY[sample].data() + c * OutputSize,
+                                  p.argmax_[sample].data() + c * OutputSize,
+                                  dX[sample].data() + c * InputSize,
+                                  1);
+    });
+}
+
+    } // kernel
+} // xsdnn
@@ -9,23 +9,105 @@
 namespace xsdnn {
     namespace kernel {
 
+/*
+ * Max pooling одного тензора [H][W][channels]. Блок формата NCHWc хранится так же,
+ * как NHWC тензор с channels = размеру блока.
+ */
+void max_pool_nhwc_plane(const mm_scalar* in,
+                         mm_scalar* out,
+                         size_t channels,
+                         const params::max_pool& p) {
+    const size_t in_width = p.in_shape_.W;
+
+    for (size_t y = 0; y < p.out_shape_.H; ++y) {
+        // Окно сдвинуто на начальное заполнение, заполненные точки пропускаются
+        const ptrdiff_t y_origin = ptrdiff_t(y * p.stride_y_) - ptrdiff_t(p._.Padding[0]);
+        const size_t y_begin = size_t(std::max<ptrdiff_t>(y_origin, 0));
+        const size_t y_end = size_t(std::min<ptrdiff_t>(y_origin + ptrdiff_t(p.kernel_y_), ptrdiff_t(p.in_shape_.H)));
+
+        for (size_t x = 0; x < p.out_shape_.W; ++x) {
+            const ptrdiff_t x_origin = ptrdiff_t(x * p.stride_x_) - ptrdiff_t(p._.Padding[1]);
+            const size_t x_begin = size_t(std::max<ptrdiff_t>(x_origin, 0));
+            const size_t x_end = size_t(std::min<ptrdiff_t>(x_origin + ptrdiff_t(p.kernel_x_), ptrdiff_t(in_width)));
+
+            std::fill(out, out + channels, std::numeric_limits<mm_scalar>::lowest());
+
+            // В NHWC окно состоит из непрерывных векторов каналов
+            for (size_t iy = y_begin; iy < y_end; ++iy) {
+                const mm_scalar* row = in + (iy * in_width + x_begin) * channels;
+                for (size_t dx = 0; dx < x_end - x_begin; ++dx) {
+                    const mm_scalar* pixel = row + dx * channels;
+                    for (size_t c = 0; c < channels; ++c) {
+                        out[c] = std::max(out[c], pixel[c]);
+                    }
+                }
+            }
+
+            out += channels;
+        }
+    }
+}
+
+void max_pool_fwd_nhwc_xs_impl(const tensor_t& in_data,
+                               tensor_t& out_data,
+                               params::max_pool& p,
+                               bool parallelize,
+                               size_t nthreads) {
+    concurrency::TryParallelFor(parallelize, nthreads, in_data.size(), [&](size_t sample) {
+        max_pool_nhwc_plane(in_data[sample].data(), out_data[sample].data(), p.in_shape_.C, p);
+    });
+}
+
+void max_pool_fwd_nchwc_xs_impl(const tensor_t& in_data,
+                                tensor_t& out_data,
+                                params::max_pool& p,
+                                bool parallelize,
+                                size_t nthreads) {
+    const size_t block = mmpack::MmNchwcGetBlockSize();
+    const size_t blocks = p.in_shape_.C / block;
+
+    concurrency::TryParallelFor(parallelize, nthreads, in_data.size() * blocks, [&](size_t task) {
+        const size_t sample = task / blocks;
+        const size_t b = task % blocks;
+
+        max_pool_nhwc_plane(in_data[sample].data() + b * block * p.in_shape_.area(),
+                            out_data[sample].data() + b * block * p.out_shape_.area(), block, p);
+    });
+}
+
 void max_pool_fwd_xs_impl(const tensor_t& in_data,
                           tensor_t& out_data,
                           params::max_pool& p,
                           bool parallelize,
                           size_t nthreads) {
-    concurrency::TryParallelFor(parallelize, nthreads, in_data.size(), [&](size_t sample){
-        const mat_t& in = in_data[sample];
-        mat_t& out = out_data[sample];
-
-        for (size_t i = 0; i < p.out2in.size(); ++i) {
-            const auto& in_idx = p.out2in[i];
-            mm_scalar max_value = std::numeric_limits<mm_scalar>::lowest();
-            for (const auto& j : in_idx) {
-                max_value = std::max(max_value, in[j]);
-            }
-            out[i] = max_value;
+    if (p.layout_ != tensor_layout::nchw) {
+        if (p.record_argmax_) {
+            throw xs_error("[max_pool fwd] training is supported only for nchw layout");
         }
+        if (p.layout_ == tensor_layout::nchwc) {
+            max_pool_fwd_nchwc_xs_impl(in_data, out_data, p, parallelize, nthreads);
+        } else {
+            max_pool_fwd_nhwc_xs_impl(in_data, out_data, p, parallelize, nthreads);
+        }
+        return;
+    }
+
+    if (p.record_argmax_) {
+        if (p.kernel_x_ * p.kernel_y_ > 256) {
+            throw xs_error("[max_pool fwd] training supports windows up to 256 points");
+        }
+
+        p.argmax_.resize(in_data.size());
+        concurrency::TryParallelFor(parallelize, nthreads, in_data.size(), [&](size_t sample){
+            p.argmax_[sample].resize(p.out_shape_.size());
+            mmpack::MmMaxPoolArgmax(&p._, in_data[sample].data(), out_data[sample].data(),
+                                    p.argmax_[sample].data(), p.in_shape_.C);
+        });
+        return;
+    }
+
+    concurrency::TryParallelFor(parallelize, nthreads, in_data.size(), [&](size_t sample){
+        mmpack::MmMaxPool(&p._, in_data[sample].data(), out_data[sample].data(), p.in_shape_.C);
     });
 }
 
@@ -21,6 +21,10 @@ namespace xsdnn {
         return {shape_};
     }
 
+    bool abs::layout_sensitive() const {
+        return false;
+    }
+
     std::string abs::layer_type() const {
         return "abs";
     }
@@ -21,6 +21,10 @@ namespace xsdnn {
         return {shape_};
     }
 
+    bool acos::layout_sensitive() const {
+        return false;
+    }
+
     std::string acos::layer_type() const {
         return "acos";
     }
@@ -31,9 +35,7 @@ namespace xsdnn {
         tensor_t& out = *out_data[0];
 
         concurrency::TryParallelFor(this->parallelize_, this->num_threads_, in.size(), [&](size_t sample) {
-            for (size_t j = 0; j < in[sample].size(); ++j) {
-                out[sample][j] = std::acos(in[sample][j]);
-            }
+            mmpack::MmAcos(in[sample].data(), out[sample].data(), in[sample].size());
         });
     }
 
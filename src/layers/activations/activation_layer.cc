@@ -41,6 +41,37 @@ void activation_layer::set_in_shape(const xsdnn::shape3d in_shape) {
     in_shape_ = in_shape;
 }
 
+bool activation_layer::layout_sensitive() const {
+    return false;
+}
+
+bool activation_layer::activation_holder(mmpack::MmActivationHolder* holder) const {
+    return false;
+}
+
+void activation_layer::forward_activation(const mat_t& in_data, mat_t& out_data) {
+    mmpack::MmActivationHolder holder;
+    if (!activation_holder(&holder)) {
+        throw xs_error("[" + layer_type() + " fwd] NotImplementedYet");
+    }
+
+    std::copy(in_data.begin(), in_data.end(), out_data.begin());
+    mmpack::MmActivation(&holder, out_data.data(), 1, out_data.size(), out_data.size());
+}
+
+void activation_layer::back_activation(const mat_t& in_data,
+                                       const mat_t& out_data,
+                                       const mat_t& out_grad,
+                                       mat_t& in_grad) {
+    mmpack::MmActivationHolder holder;
+    if (!activation_holder(&holder)) {
+        throw xs_error("[" + layer_type() + " bwd] NotImplementedYet");
+    }
+
+    mmpack::MmActivationBackward(&holder, in_data.data(), out_data.data(), out_grad.data(),
+                                 in_grad.data(), in_grad.size());
+}
+
 void
 activation_layer::forward_propagation(const std::vector<tensor_t *> &in_data,
                                       std::vector<tensor_t *> &out_data) {
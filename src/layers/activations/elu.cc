@@ -0,0 +1,23 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/activations/elu.h>
+
+namespace xsdnn {
+
+bool elu::activation_holder(mmpack::MmActivationHolder* holder) const {
+    *holder = activationHolder_;
+    return true;
+}
+
+std::pair<mm_scalar, mm_scalar> elu::out_value_range() const {
+    return {(mm_scalar) 0.1f, (mm_scalar) 0.9f};
+}
+
+std::string elu::layer_type() const {
+    return "elu";
+}
+
+} // xsdnn
@@ -0,0 +1,23 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/activations/sigmoid.h>
+
+namespace xsdnn {
+
+bool sigmoid::activation_holder(mmpack::MmActivationHolder* holder) const {
+    holder->ActivationType = mmpack::Sigmoid;
+    return true;
+}
+
+std::pair<mm_scalar, mm_scalar> sigmoid::out_value_range() const {
+    return {(mm_scalar) 0.1f, (mm_scalar) 0.9f};
+}
+
+std::string sigmoid::layer_type() const {
+    return "sigmoid";
+}
+
+} // xsdnn
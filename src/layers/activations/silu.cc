@@ -0,0 +1,23 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/activations/silu.h>
+
+namespace xsdnn {
+
+bool silu::activation_holder(mmpack::MmActivationHolder* holder) const {
+    holder->ActivationType = mmpack::Silu;
+    return true;
+}
+
+std::pair<mm_scalar, mm_scalar> silu::out_value_range() const {
+    return {(mm_scalar) 0.1f, (mm_scalar) 0.9f};
+}
+
+std::string silu::layer_type() const {
+    return "silu";
+}
+
+} // xsdnn
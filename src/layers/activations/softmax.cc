@@ -0,0 +1,37 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/activations/softmax.h>
+
+namespace xsdnn {
+
+void softmax::forward_activation(const mat_t& in_data, mat_t& out_data) {
+    mmpack::MmSoftmax(in_data.data(), out_data.data(), in_data.size());
+}
+
+void softmax::back_activation(const mat_t& in_data,
+                              const mat_t& out_data,
+                              const mat_t& out_grad,
+                              mat_t& in_grad) {
+    // dx = y * (dy - <dy, y>)
+    const mm_scalar dot = mmpack::MmDot(out_grad.data(), out_data.data(), out_data.size());
+    for (size_t i = 0; i < in_grad.size(); ++i) {
+        in_grad[i] = out_data[i] * (out_grad[i] - dot);
+    }
+}
+
+std::pair<mm_scalar, mm_scalar> softmax::out_value_range() const {
+    return {(mm_scalar) 0.0f, (mm_scalar) 1.0f};
+}
+
+bool softmax::streamable() const {
+    return false;
+}
+
+std::string softmax::layer_type() const {
+    return "softmax";
+}
+
+} // xsdnn
@@ -0,0 +1,23 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/activations/tanh.h>
+
+namespace xsdnn {
+
+bool tanh::activation_holder(mmpack::MmActivationHolder* holder) const {
+    holder->ActivationType = mmpack::Tanh;
+    return true;
+}
+
+std::pair<mm_scalar, mm_scalar> tanh::out_value_range() const {
+    return {(mm_scalar) -0.8f, (mm_scalar) 0.8f};
+}
+
+std::string tanh::layer_type() const {
+    return "tanh";
+}
+
+} // xsdnn
@@ -6,17 +6,29 @@
 #include <layers/add.h>
 #include <algorithm>
 #include <utils/macro.h>
+#include <core/framework/threading.h>
 
 namespace xsdnn {
 
+add::add(shape3d in_shape0, shape3d in_shape1)
+    : layer({tensor_type::data, tensor_type::data}, {tensor_type::data}),
+      n_input_(2), in_shapes_({in_shape0, in_shape1}), plan_(in_shape0, in_shape1) {
+    const std::vector<size_t>& dims = plan_.output_dims();
+    shape_ = shape3d(dims[0], dims[1], dims[2]);
+}
+
 std::vector<shape3d> add::in_shape() const {
-    return std::vector<shape3d>(n_input_, shape_);
+    return in_shapes_;
 }
 
 std::vector<shape3d> add::out_shape() const {
     return {shape_};
 }
 
+bool add::layout_sensitive() const {
+    return plan_.get_kind() != broadcast_plan::kind::same_shape && plan_.get_kind() != broadcast_plan::kind::scalar;
+}
+
 std::string add::layer_type() const {
     return "add";
 }
@@ -25,27 +37,55 @@ void add::forward_propagation(const std::vector<tensor_t *> &in_data,
                               std::vector<tensor_t *> &out_data) {
     const tensor_t& in = *in_data[0];
     tensor_t& out = *out_data[0];
-    out = in;
-
-    for (size_t sample = 0; sample < in.size(); ++sample) {
-        for (size_t i = 1; i < n_input_; i++) {
-            std::transform((*in_data[i])[sample].begin(),
-                           (*in_data[i])[sample].end(),
-                           out[sample].begin(),
-                           out[sample].begin(),
-                           [](float_t x, float_t y){ return x + y; });
-        }
+
+    if (n_input_ < 2) {
+        out = in;
+        return;
     }
+
+    /*
+     * Первые два входа складываются через broadcast_plan. Broadcasting допустим только
+     * для двух входов, поэтому остальные входы имеют форму выхода и прибавляются к тем же
+     * частям выхода тем же планом.
+     */
+    const size_t tasks = plan_.task_count();
+    concurrency::TryParallelFor(layer::parallelize_,
+                                layer::num_threads_,
+                                in.size() * tasks,
+                                [&](size_t i) {
+        const size_t sample = i / tasks;
+        const size_t task = i % tasks;
+        mm_scalar* dst = out[sample].data();
+
+        plan_.run(mmpack::MmBinaryAdd, in[sample].data(), (*in_data[1])[sample].data(), dst, task);
+        for (size_t k = 2; k < n_input_; ++k) {
+            plan_.run(mmpack::MmBinaryAdd, dst, (*in_data[k])[sample].data(), dst, task);
+        }
+    });
 }
 
 void add::back_propagation(const std::vector<tensor_t *> &in_data, const std::vector<tensor_t *> &out_data,
                            std::vector<tensor_t *> &out_grad, std::vector<tensor_t *> &in_grad) {
-    XS_UNUSED_PARAMETER(in_data);
-    XS_UNUSED_PARAMETER(out_data);
-    for (size_t i = 0; i < n_input_; i++)
-        *in_grad[i] = *out_grad[0];
-}
+    if (n_input_ != 2 || plan_.get_kind() == broadcast_plan::kind::same_shape) {
+        for (size_t i = 0; i < n_input_; i++)
+            *in_grad[i] = *out_grad[0];
+        return;
+    }
 
+    const tensor_t& in0 = *in_data[0];
+    const tensor_t& in1 = *in_data[1];
+    const tensor_t& out = *out_data[0];
+    const tensor_t& dy = *out_grad[0];
+    tensor_t& dx0 = *in_grad[0];
+    tensor_t& dx1 = *in_grad[1];
 
+    concurrency::TryParallelFor(layer::parallelize_,
+                                layer::num_threads_,
+                                in0.size(),
+                                [&](size_t sample) {
+        binary_backward(mmpack::MmBinaryAdd, plan_, in0[sample], in1[sample], out[sample], dy[sample],
+                        dx0[sample], dx1[sample]);
+    });
+}
 
-} // xsdnn
\ No newline at end of file
+} // xsdnn
@@ -21,6 +21,10 @@ namespace xsdnn {
         return {shape_};
     }
 
+    bool and_layer::layout_sensitive() const {
+        return false;
+    }
+
     std::string and_layer::layer_type() const {
         return "and_layer";
     }
@@ -0,0 +1,81 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/average_pooling.h>
+
+namespace xsdnn {
+
+    std::vector<shape3d> average_pooling::in_shape() const {
+        return { params_.in_shape_ };
+    }
+
+    std::vector<shape3d> average_pooling::out_shape() const {
+        return { params_.out_shape_ };
+    }
+
+    void average_pooling::set_params(size_t channels, size_t height, size_t width, size_t kernel_x, size_t kernel_y,
+                                     size_t stride_x, size_t stride_y, padding_mode pad_type, bool count_include_pad) {
+        params_.in_shape_ = shape3d(channels, height, width);
+        size_t h_out = calc_pool_shape(height, kernel_y, stride_y, pad_type, false);
+        size_t w_out = calc_pool_shape(width, kernel_x, stride_x, pad_type, false);
+        params_.out_shape_ = shape3d(channels, h_out, w_out);
+
+        params_.kernel_y_ = kernel_y;
+        params_.kernel_x_ = kernel_x;
+        params_.stride_y_ = stride_y;
+        params_.stride_x_ = stride_x;
+        params_.pad_type_ = pad_type;
+        params_.count_include_pad_ = count_include_pad;
+
+        MM_POOL_PARAMS& mp = params_._;
+        mp.InShape[0] = height;
+        mp.InShape[1] = width;
+        mp.KernelShape[0] = kernel_y;
+        mp.KernelShape[1] = kernel_x;
+        mp.StrideShape[0] = stride_y;
+        mp.StrideShape[1] = stride_x;
+        mp.OutShape[0] = h_out;
+        mp.OutShape[1] = w_out;
+        calc_pool_padding(height, h_out, kernel_y, stride_y, pad_type, &mp.Padding[0], &mp.Padding[2]);
+        calc_pool_padding(width, w_out, kernel_x, stride_x, pad_type, &mp.Padding[1], &mp.Padding[3]);
+    }
+
+    void average_pooling::init_backend(core::backend_t engine) {
+        fwd_kernel_.reset(new core::AvgPoolingFwdKernel);
+        bwd_kernel_.reset(new core::AvgPoolingBwdKernel);
+        set_backend(engine);
+    }
+
+    const params::avg_pool& average_pooling::get_params() const {
+        return params_;
+    }
+
+    std::string average_pooling::layer_type() const {
+        return "average_pooling";
+    }
+
+    void average_pooling::forward_propagation(const std::vector<tensor_t *> &in_data,
+                                              std::vector<tensor_t *> &out_data) {
+        fwd_ctx_.set_in_out(in_data, out_data);
+        fwd_ctx_.set_engine(this->engine());
+        fwd_ctx_.set_parallelize(this->parallelize());
+        fwd_ctx_.set_num_threads(this->num_threads_);
+
+        fwd_kernel_->compute(fwd_ctx_, params_);
+    }
+
+    void average_pooling::back_propagation(const std::vector<tensor_t *> &in_data,
+                                           const std::vector<tensor_t *> &out_data,
+                                           std::vector<tensor_t *> &out_grad,
+                                           std::vector<tensor_t *> &in_grad) {
+        bwd_ctx_.set_in_out(in_data, out_data, out_grad, in_grad);
+        bwd_ctx_.set_parallelize(this->parallelize());
+        bwd_ctx_.set_engine(this->engine());
+        bwd_ctx_.set_num_threads(this->num_threads_);
+
+        bwd_kernel_->compute(bwd_ctx_, params_);
+    }
+
+} // xsdnn
@@ -27,6 +27,18 @@ std::string batch_norm::layer_type() const {
     return "batch_norm";
 }
 
+bool batch_norm::set_layout(tensor_layout layout) {
+    if (layout == tensor_layout::nchwc && params_.in_shape_.C % mmpack::MmNchwcGetBlockSize() != 0) {
+        return false;
+    }
+    params_.layout_ = layout;
+    return true;
+}
+
+bool batch_norm::streamable() const {
+    return params_.phase_ == op_mode::inference;
+}
+
 void batch_norm::set_params(mmpack::mm_scalar momentum,
                             mmpack::mm_scalar epsilon, xsdnn::op_mode phase) {
     params_.in_shape_ = shape3d(0, 0, 0);
@@ -63,17 +75,53 @@ void batch_norm::back_propagation(const std::vector<tensor_t *> &in_data, const
     bwd_kernel_->compute(bwd_ctx_, params_);
 }
 
+void batch_norm::weights_changed() {
+    params_.invalidate_scale_shift();
+}
+
 void batch_norm::post_update() {
-    mat_t& mean_ = params_.stat_holder["mean_"];
-    mat_t& stddev_ = params_.stat_holder["stddev_"];
-    mat_t& mean_running_ = params_.stat_holder["mean_running_"];
-    mat_t& stddev_running_ = params_.stat_holder["stddev_running_"];
-    mm_scalar momentum_ = params_.momentum_;
-
-    for (size_t i = 0; i < mean_.size(); i++) {
-        mean_[i] = momentum_ * mean_[i] + (1 - momentum_) * mean_running_[i];
-        stddev_[i] = momentum_ * stddev_[i] + (1 - momentum_) * stddev_running_[i];
+    if (!params_.statistic_initialized) {
+        return;
+    }
+
+    mm_scalar* mean = params_.mean_.data();
+    mm_scalar* stddev = params_.stddev_.data();
+    const mm_scalar* batch_mean = params_.batch_mean_.data();
+    const mm_scalar* batch_stddev = params_.batch_stddev_.data();
+    const mm_scalar momentum = params_.momentum_;
+
+    for (size_t i = 0; i < params_.mean_.size(); i++) {
+        mean[i] = momentum * mean[i] + (1 - momentum) * batch_mean[i];
+        stddev[i] = momentum * stddev[i] + (1 - momentum) * batch_stddev[i];
     }
+    params_.invalidate_scale_shift();
+}
+
+void batch_norm::set_statistics(const mat_t& mean, const mat_t& stddev) {
+    if (mean.size() != params_.in_shape_.C || stddev.size() != params_.in_shape_.C) {
+        throw xs_error("[batch_norm] statistics size mismatch");
+    }
+
+    params_.batch_mean_ = mat_t(mean.size());
+    params_.batch_stddev_ = mat_t(stddev.size());
+    params_.mean_ = mean;
+    params_.stddev_ = stddev;
+    params_.invalidate_scale_shift();
+    params_.statistic_initialized = true;
+}
+
+bool batch_norm::inference_scale_shift(mat_t& scale, mat_t& shift) {
+    if (params_.phase_ != op_mode::inference || !params_.statistic_initialized) {
+        return false;
+    }
+
+    if (!params_.scale_shift_ready_) {
+        params_.compute_scale_shift(*weights()[0], *weights()[1]);
+    }
+
+    scale = params_.scale_;
+    shift = params_.shift_;
+    return true;
 }
 
-} // xsdnn
\ No newline at end of file
+} // xsdnn
@@ -0,0 +1,209 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/binary_layer.h>
+#include <core/framework/threading.h>
+#include <cmath>
+
+namespace xsdnn {
+
+namespace {
+
+template<mmpack::MmBinaryOpType Op>
+struct binary_grad;
+
+template<>
+struct binary_grad<mmpack::MmBinaryAdd> {
+    static void apply(mm_scalar a, mm_scalar b, mm_scalar y, mm_scalar dy, mm_scalar& da, mm_scalar& db) {
+        da += dy;
+        db += dy;
+    }
+};
+
+template<>
+struct binary_grad<mmpack::MmBinarySub> {
+    static void apply(mm_scalar a, mm_scalar b, mm_scalar y, mm_scalar dy, mm_scalar& da, mm_scalar& db) {
+        da += dy;
+        db -= dy;
+    }
+};
+
+template<>
+struct binary_grad<mmpack::MmBinaryMul> {
+    static void apply(mm_scalar a, mm_scalar b, mm_scalar y, mm_scalar dy, mm_scalar& da, mm_scalar& db) {
+        da += dy * b;
+        db += dy * a;
+    }
+};
+
+template<>
+struct binary_grad<mmpack::MmBinaryDiv> {
+    static void apply(mm_scalar a, mm_scalar b, mm_scalar y, mm_scalar dy, mm_scalar& da, mm_scalar& db) {
+        da += dy / b;
+        db -= dy * y / b;
+    }
+};
+
+// Градиент уходит тому входу, значение которого выбрано прямым проходом (при равенстве - A)
+template<>
+struct binary_grad<mmpack::MmBinaryMin> {
+    static void apply(mm_scalar a, mm_scalar b, mm_scalar y, mm_scalar dy, mm_scalar& da, mm_scalar& db) {
+        (b < a ? db : da) += dy;
+    }
+};
+
+template<>
+struct binary_grad<mmpack::MmBinaryMax> {
+    static void apply(mm_scalar a, mm_scalar b, mm_scalar y, mm_scalar dy, mm_scalar& da, mm_scalar& db) {
+        (b > a ? db : da) += dy;
+    }
+};
+
+template<>
+struct binary_grad<mmpack::MmBinaryPow> {
+    static void apply(mm_scalar a, mm_scalar b, mm_scalar y, mm_scalar dy, mm_scalar& da, mm_scalar& db) {
+        da += dy * b * std::pow(a, b - 1.0f);
+        if (a > 0.0f) {
+            db += dy * y * std::log(a);
+        }
+    }
+};
+
+template<mmpack::MmBinaryOpType Op>
+void binary_backward_kernel(const broadcast_plan& plan,
+                            const mat_t& in0,
+                            const mat_t& in1,
+                            const mat_t& out,
+                            const mat_t& out_grad,
+                            mat_t& in_grad0,
+                            mat_t& in_grad1) {
+    const size_t row_size = plan.row_size();
+    const size_t step0 = plan.row_scalar0() ? 0 : 1;
+    const size_t step1 = plan.row_scalar1() ? 0 : 1;
+
+    for (size_t row = 0; row < plan.rows(); ++row) {
+        const size_t offset0 = plan.row_offset0(row);
+        const size_t offset1 = plan.row_offset1(row);
+        const size_t offset = row * row_size;
+
+        for (size_t i = 0; i < row_size; ++i) {
+            binary_grad<Op>::apply(in0[offset0 + i * step0], in1[offset1 + i * step1],
+                                   out[offset + i], out_grad[offset + i],
+                                   in_grad0[offset0 + i * step0], in_grad1[offset1 + i * step1]);
+        }
+    }
+}
+
+} // namespace
+
+void binary_backward(mmpack::MmBinaryOpType op,
+                     const broadcast_plan& plan,
+                     const mat_t& in0,
+                     const mat_t& in1,
+                     const mat_t& out,
+                     const mat_t& out_grad,
+                     mat_t& in_grad0,
+                     mat_t& in_grad1) {
+    std::fill(in_grad0.begin(), in_grad0.end(), mm_scalar(0));
+    std::fill(in_grad1.begin(), in_grad1.end(), mm_scalar(0));
+
+    switch (op) {
+        case (mmpack::MmBinaryAdd):
+            binary_backward_kernel<mmpack::MmBinaryAdd>(plan, in0, in1, out, out_grad, in_grad0, in_grad1);
+            break;
+        case (mmpack::MmBinarySub):
+            binary_backward_kernel<mmpack::MmBinarySub>(plan, in0, in1, out, out_grad, in_grad0, in_grad1);
+            break;
+        case (mmpack::MmBinaryMul):
+            binary_backward_kernel<mmpack::MmBinaryMul>(plan, in0, in1, out, out_grad, in_grad0, in_grad1);
+            break;
+        case (mmpack::MmBinaryDiv):
+            binary_backward_kernel<mmpack::MmBinaryDiv>(plan, in0, in1, out, out_grad, in_grad0, in_grad1);
+            break;
+        case (mmpack::MmBinaryMin):
+            binary_backward_kernel<mmpack::MmBinaryMin>(plan, in0, in1, out, out_grad, in_grad0, in_grad1);
+            break;
+        case (mmpack::MmBinaryMax):
+            binary_backward_kernel<mmpack::MmBinaryMax>(plan, in0, in1, out, out_grad, in_grad0, in_grad1);
+            break;
+        case (mmpack::MmBinaryPow):
+            binary_backward_kernel<mmpack::MmBinaryPow>(plan, in0, in1, out, out_grad, in_grad0, in_grad1);
+            break;
+    }
+}
+
+binary_layer::binary_layer()
+    : layer({tensor_type::data, tensor_type::data}, {tensor_type::data}),
+      in_shape0_(), in_shape1_(), plan_(in_shape0_, in_shape1_) {}
+
+binary_layer::binary_layer(size_t dim)
+    : binary_layer(shape3d(1, 1, dim)) {}
+
+binary_layer::binary_layer(shape3d shape)
+    : binary_layer(shape, shape) {}
+
+binary_layer::binary_layer(shape3d in_shape0, shape3d in_shape1)
+    : layer({tensor_type::data, tensor_type::data}, {tensor_type::data}),
+      in_shape0_(in_shape0), in_shape1_(in_shape1), plan_(in_shape0, in_shape1) {}
+
+void binary_layer::set_in_shape(const shape3d in_shape) {
+    in_shape0_ = in_shape;
+    in_shape1_ = in_shape;
+    plan_ = broadcast_plan(in_shape0_, in_shape1_);
+}
+
+std::vector<shape3d> binary_layer::in_shape() const {
+    return {in_shape0_, in_shape1_};
+}
+
+std::vector<shape3d> binary_layer::out_shape() const {
+    const std::vector<size_t>& dims = plan_.output_dims();
+    return {shape3d(dims[0], dims[1], dims[2])};
+}
+
+bool binary_layer::layout_sensitive() const {
+    return plan_.get_kind() != broadcast_plan::kind::same_shape && plan_.get_kind() != broadcast_plan::kind::scalar;
+}
+
+void binary_layer::forward_propagation(const std::vector<tensor_t*>& in_data,
+                                       std::vector<tensor_t*>& out_data) {
+    const tensor_t& in0 = *in_data[0];
+    const tensor_t& in1 = *in_data[1];
+    tensor_t& out = *out_data[0];
+
+    const mmpack::MmBinaryOpType op = binary_op();
+    const size_t tasks = plan_.task_count();
+
+    concurrency::TryParallelFor(layer::parallelize_,
+                                layer::num_threads_,
+                                in0.size() * tasks,
+                                [&](size_t i) {
+        const size_t sample = i / tasks;
+        plan_.run(op, in0[sample].data(), in1[sample].data(), out[sample].data(), i % tasks);
+    });
+}
+
+void binary_layer::back_propagation(const std::vector<tensor_t*>& in_data,
+                                    const std::vector<tensor_t*>& out_data,
+                                    std::vector<tensor_t*>& out_grad,
+                                    std::vector<tensor_t*>& in_grad) {
+    const tensor_t& in0 = *in_data[0];
+    const tensor_t& in1 = *in_data[1];
+    const tensor_t& out = *out_data[0];
+    const tensor_t& dy = *out_grad[0];
+    tensor_t& dx0 = *in_grad[0];
+    tensor_t& dx1 = *in_grad[1];
+
+    const mmpack::MmBinaryOpType op = binary_op();
+
+    concurrency::TryParallelFor(layer::parallelize_,
+                                layer::num_threads_,
+                                in0.size(),
+                                [&](size_t sample) {
+        binary_backward(op, plan_, in0[sample], in1[sample], out[sample], dy[sample], dx0[sample], dx1[sample]);
+    });
+}
+
+} // xsdnn
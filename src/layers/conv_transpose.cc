@@ -0,0 +1,64 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/conv_transpose.h>
+
+namespace xsdnn {
+
+void conv_transpose::init_backend(core::backend_t engine) {
+    fwd_kernel_.reset(new core::ConvTransposeFwdKernel);
+    bwd_kernel_.reset(new core::ConvTransposeBwdKernel);
+    set_backend(engine);
+}
+
+std::vector<shape3d> conv_transpose::in_shape() const {
+    const MM_CONV_PARAMS& P = params_.conv_._;
+    const size_t out_channel = params_.out_shape_.C;
+
+    // Веса [InChannel][OutChannel / GroupCount][KH][KW]
+    shape3d weight = P.Dimensions == 2
+            ? shape3d(params_.in_shape_.C * P.InChannel, P.KernelShape[0], P.KernelShape[1])
+            : shape3d(params_.in_shape_.C * P.InChannel, 1, P.KernelShape[0]);
+
+    if (params_.has_bias_) {
+        return { params_.in_shape_, weight, shape3d(out_channel, 1, 1) };
+    } else {
+        return { params_.in_shape_, weight };
+    }
+}
+
+std::vector<shape3d> conv_transpose::out_shape() const {
+    return { params_.out_shape_ };
+}
+
+params::conv_transpose conv_transpose::get_params() const {
+    return params_;
+}
+
+std::string conv_transpose::layer_type() const {
+    return "conv_transpose";
+}
+
+void conv_transpose::forward_propagation(const std::vector<tensor_t *> &in_data,
+                                         std::vector<tensor_t *> &out_data) {
+    fwd_ctx_.set_in_out(in_data, out_data);
+    fwd_ctx_.set_parallelize(this->parallelize());
+    fwd_ctx_.set_engine(this->engine());
+    fwd_ctx_.set_num_threads(this->num_threads_);
+
+    fwd_kernel_->compute(fwd_ctx_, params_);
+}
+
+void conv_transpose::back_propagation(const std::vector<tensor_t *> &in_data, const std::vector<tensor_t *> &out_data,
+                                      std::vector<tensor_t *> &out_grad, std::vector<tensor_t *> &in_grad) {
+    bwd_ctx_.set_in_out(in_data, out_data, out_grad, in_grad);
+    bwd_ctx_.set_parallelize(this->parallelize());
+    bwd_ctx_.set_engine(this->engine());
+    bwd_ctx_.set_num_threads(this->num_threads_);
+
+    bwd_kernel_->compute(bwd_ctx_, params_);
+}
+
+} // xsdnn
@@ -4,6 +4,8 @@
 //
 
 #include <layers/convolution.h>
+#include <layers/max_pooling.h>
+#include <layers/activations/activation_layer.h>
 
 namespace xsdnn {
 
@@ -14,12 +16,16 @@ void conv::set_params(size_t in_channel, size_t in_height, size_t in_width, size
                       padding_mode pad_type,
                       std::vector<size_t> pads,
                       MmActivationType activation_type) {
-    if (is_1D_tensor(shape3d(in_channel, in_height, in_width))) {
+    if (kernel_shape.size() == 1) {
+        params_._.Dimensions = 1;
+    } else if (kernel_shape.size() == 2) {
+        params_._.Dimensions = 2;
+    } else if (is_1D_tensor(shape3d(in_channel, in_height, in_width))) {
         params_._.Dimensions = 1;
     } else if (is_2D_tensor(shape3d(in_channel, in_height, in_width))) {
         params_._.Dimensions = 2;
     } else {
-        xs_error("Unsupported dimensions in input data of conv layer");
+        throw xs_error("Unsupported dimensions in input data of conv layer");
     }
     params_.infer_output_requirement_shape(shape3d(in_channel, in_height, in_width),
                                            out_channel, group_count, has_bias,
@@ -29,40 +35,37 @@ void conv::set_params(size_t in_channel, size_t in_height, size_t in_width, size
 
 void conv::init_backend(core::backend_t engine) {
     fwd_kernel_.reset(new core::ConvFwdKernel);
+    bwd_kernel_.reset(new core::ConvBwdKernel);
     set_backend(engine);
 }
 
 std::vector<shape3d> conv::in_shape() const {
+    size_t in_channel = params_._.InChannel * params_._.GroupCount;
+    size_t f_count = params_._.FilterCount;
+    size_t out_channel = f_count * params_._.GroupCount;
+
+    shape3d in, weight;
     if (params_._.Dimensions == 2) {
-        size_t in_channel = params_._.InChannel * params_._.GroupCount;
-        size_t in_height = params_._.InShape[0];
-        size_t in_width = params_._.InShape[1];
-        size_t f_count = params_._.FilterCount;
-        size_t out_channel = f_count * params_._.GroupCount;
-        if (params_._.Bias) {
-            return {
-                    shape3d(in_channel, in_height, in_width),
-                    shape3d(out_channel * params_._.InChannel, params_._.KernelShape[0], params_._.KernelShape[1]),
-                    shape3d(out_channel, 1, 1)
-            };
-        } else {
-            return {
-                    shape3d(in_channel, in_height, in_width),
-                    shape3d(out_channel * params_._.InChannel, params_._.KernelShape[0], params_._.KernelShape[1]),
-            };
-        }
+        in = shape3d(in_channel, params_._.InShape[0], params_._.InShape[1]);
+        weight = shape3d(out_channel * params_._.InChannel, params_._.KernelShape[0], params_._.KernelShape[1]);
     } else {
-        throw xs_error("conv in_shape for 1D not implemented yet");
+        in = shape3d(in_channel, 1, params_._.InShape[0]);
+        weight = shape3d(out_channel * params_._.InChannel, 1, params_._.KernelShape[0]);
     }
 
+    if (params_._.Bias) {
+        return { in, weight, shape3d(out_channel, 1, 1) };
+    } else {
+        return { in, weight };
+    }
 }
 
 std::vector<shape3d> conv::out_shape() const {
+    size_t out_channel = params_._.FilterCount * params_._.GroupCount;
     if (params_._.Dimensions == 2) {
-        size_t out_channel = params_._.FilterCount * params_._.GroupCount;
         return { shape3d(out_channel, params_._.OutShape[0], params_._.OutShape[1]) };
     } else {
-        throw xs_error("conv out_shape for 1D not implemented yet");
+        return { shape3d(out_channel, 1, params_._.OutShape[0]) };
     }
 }
 
@@ -74,6 +77,125 @@ std::string conv::layer_type() const {
     return "conv";
 }
 
+bool conv::set_layout(tensor_layout layout) {
+    return set_io_layout(layout, layout);
+}
+
+bool conv::set_io_layout(tensor_layout in_layout, tensor_layout out_layout) {
+    /*
+     * Свертка в NCHWc сама переупорядочивает вход из NCHW и выход в NCHW, поэтому
+     * начинает и заканчивает блочную цепочку. Блочный тензор требует кол-ва каналов
+     * группы, кратного размеру блока.
+     */
+    if (params_._.Dimensions == 1) {
+        return in_layout == tensor_layout::nchw && out_layout == tensor_layout::nchw;
+    }
+    if (in_layout != out_layout &&
+        (in_layout == tensor_layout::nhwc || out_layout == tensor_layout::nhwc)) {
+        return false;
+    }
+
+    const size_t block = mmpack::MmNchwcGetBlockSize();
+    if ((in_layout == tensor_layout::nchwc && params_._.InChannel % block != 0) ||
+        (out_layout == tensor_layout::nchwc && params_._.FilterCount % block != 0)) {
+        return false;
+    }
+
+    params_.set_layout(in_layout, out_layout);
+    return true;
+}
+
+bool conv::streamable() const {
+    return params_.streamable();
+}
+
+void conv::set_stream_state(tensor_t* state) {
+    params_.set_stream_state(state);
+}
+
+void conv::weights_changed() {
+    params_.invalidate_packed_filter();
+}
+
+bool conv::reduces_weight_grads() const {
+    return true;
+}
+
+bool conv::fold_scale_shift(const mat_t& scale, const mat_t& shift) {
+    // После встроенной активации преобразование уже не линейно по весам
+    const size_t out_channel = params_._.FilterCount * params_._.GroupCount;
+    if (params_.activation_type_ != MmActivationType::NotSet || scale.size() != out_channel) {
+        return false;
+    }
+
+    if (!params_._.Bias) {
+        params_._.Bias = true;
+        add_bias_concept();
+    }
+
+    mat_t& W = *weights()[0];
+    mat_t& B = *weights()[1];
+    const size_t filter_size = W.size() / out_channel;
+
+    for (size_t c = 0; c < out_channel; ++c) {
+        mm_scalar* filter = W.data() + c * filter_size;
+        for (size_t k = 0; k < filter_size; ++k) {
+            filter[k] *= scale[c];
+        }
+        B[c] = B[c] * scale[c] + shift[c];
+    }
+
+    weights_changed();
+    return true;
+}
+
+bool conv::fuse_chain(const std::vector<layer*>& chain) {
+    /*
+     * Сливаются только 2D NCHW и NCHWc свертки вне потокового режима с цепочкой
+     * активаций, за которыми для NCHW может идти max pooling в формате NCHW.
+     */
+    std::vector<MmActivationHolder> activations;
+    MM_POOL_PARAMS pool;
+    bool has_pool = false;
+
+    if (!chain.empty()) {
+        if (engine() != core::backend_t::xs || params_._.Dimensions != 2 ||
+            params_.layout_ == tensor_layout::nhwc || params_.stream_state_ != nullptr) {
+            return false;
+        }
+
+        for (size_t i = 0; i < chain.size(); ++i) {
+            MmActivationHolder holder;
+            auto* act = dynamic_cast<activation_layer*>(chain[i]);
+            auto* mp = dynamic_cast<max_pooling*>(chain[i]);
+
+            if (act != nullptr && act->activation_holder(&holder)) {
+                activations.push_back(holder);
+            } else if (mp != nullptr && i + 1 == chain.size() && mp->engine() == core::backend_t::xs &&
+                       !params_.nchwc() && mp->get_params().layout_ == tensor_layout::nchw) {
+                pool = mp->get_params()._;
+                has_pool = true;
+            } else {
+                return false;
+            }
+        }
+    }
+
+    /*
+     * MmConvPool считает свертку только через Im2Col, поэтому max pooling сливается,
+     * если для этой формы выбран именно он. Выбор делается здесь, до первого forward.
+     */
+    if (has_pool) {
+        params_.select_algorithm(parallelize() ? num_threads_ : 1);
+        if (params_._.Algorithm != MM_CONV_PARAMS::Im2ColThenGemm) {
+            return false;
+        }
+    }
+
+    params_.fuse(activations, has_pool ? &pool : nullptr);
+    return true;
+}
+
 void conv::forward_propagation(const std::vector<tensor_t *> &in_data,
                                    std::vector<tensor_t *> &out_data) {
     fwd_ctx_.set_in_out(in_data, out_data);
@@ -86,7 +208,12 @@ void conv::forward_propagation(const std::vector<tensor_t *> &in_data,
 
 void conv::back_propagation(const std::vector<tensor_t *> &in_data, const std::vector<tensor_t *> &out_data,
                             std::vector<tensor_t *> &out_grad, std::vector<tensor_t *> &in_grad) {
-    throw xs_error("[conv bwd] Not Impl Yet");
+    bwd_ctx_.set_in_out(in_data, out_data, out_grad, in_grad);
+    bwd_ctx_.set_parallelize(this->parallelize());
+    bwd_ctx_.set_engine(this->engine());
+    bwd_ctx_.set_num_threads(this->num_threads_);
+
+    bwd_kernel_->compute(bwd_ctx_, params_);
 }
 
 } // xsdnn
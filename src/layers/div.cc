@@ -0,0 +1,18 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/div.h>
+
+namespace xsdnn {
+
+mmpack::MmBinaryOpType div::binary_op() const {
+    return mmpack::MmBinaryDiv;
+}
+
+std::string div::layer_type() const {
+    return "div";
+}
+
+} // xsdnn
@@ -40,6 +40,39 @@ size_t fully_connected::fan_out_size() const {
     return params_.out_size_;
 }
 
+bool fully_connected::reduces_weight_grads() const {
+    return true;
+}
+
+bool fully_connected::fold_scale_shift(const mat_t& scale, const mat_t& shift) {
+    // Выход [1][1][out_size]: канал c охватывает out_size / C подряд идущих нейронов.
+    // После встроенной активации преобразование уже не линейно по весам
+    if (params_.activation_type_ != MmActivationType::NotSet ||
+        scale.empty() || params_.out_size_ % scale.size() != 0) {
+        return false;
+    }
+
+    if (!params_.has_bias_) {
+        params_.has_bias_ = true;
+        add_bias_concept();
+    }
+
+    mat_t& W = *weights()[0];
+    mat_t& b = *weights()[1];
+    const size_t channel_size = params_.out_size_ / scale.size();
+
+    for (size_t j = 0; j < params_.out_size_; ++j) {
+        const size_t c = j / channel_size;
+        for (size_t i = 0; i < params_.in_size_; ++i) {
+            W[i * params_.out_size_ + j] *= scale[c];
+        }
+        b[j] = b[j] * scale[c] + shift[c];
+    }
+
+    weights_changed();
+    return true;
+}
+
 void fully_connected::forward_propagation(
         const std::vector<tensor_t *> &in_data,
         std::vector<tensor_t *> &out_data) {
@@ -67,10 +100,12 @@ void fully_connected::back_propagation(
 
 void fully_connected::set_params(size_t in_size,
                                  size_t out_size,
-                                 bool has_bias) {
+                                 bool has_bias,
+                                 MmActivationType activation_type) {
     params_.in_size_ = in_size;
     params_.out_size_ = out_size;
     params_.has_bias_ = has_bias;
+    params_.activation_type_ = activation_type;
 }
 
 void fully_connected::init_backend(core::backend_t engine) {
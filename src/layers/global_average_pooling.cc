@@ -14,6 +14,7 @@ namespace xsdnn {
 
     void global_average_pooling::init_backend(core::backend_t engine) {
         fwd_kernel_.reset(new core::GlobalAvgPoolingFwdKernel);
+        bwd_kernel_.reset(new core::GlobalAvgPoolingBwdKernel);
         set_backend(engine);
     }
 
@@ -29,6 +30,19 @@ namespace xsdnn {
         return "global_average_pooling";
     }
 
+    bool global_average_pooling::set_layout(tensor_layout layout) {
+        if (layout == tensor_layout::nchwc && params_.in_shape_.C % mmpack::MmNchwcGetBlockSize() != 0) {
+            return false;
+        }
+        params_.layout_ = layout;
+        return true;
+    }
+
+    bool global_average_pooling::set_io_layout(tensor_layout in_layout, tensor_layout out_layout) {
+        // Выход C x 1 x 1 хранится одинаково во всех форматах
+        return set_layout(in_layout);
+    }
+
     void global_average_pooling::forward_propagation(const std::vector<tensor_t *> &in_data,
                                                      std::vector<tensor_t *> &out_data) {
         fwd_ctx_.set_in_out(in_data, out_data);
@@ -42,7 +56,12 @@ namespace xsdnn {
     void global_average_pooling::back_propagation(const std::vector<tensor_t *> &in_data,
                                                   const std::vector<tensor_t *> &out_data,
                                                   std::vector<tensor_t *> &out_grad, std::vector<tensor_t *> &in_grad) {
-        throw xs_error("[global_average_pooling bwd] NotImplementedYet");
+        bwd_ctx_.set_in_out(in_data, out_data, out_grad, in_grad);
+        bwd_ctx_.set_parallelize(this->parallelize());
+        bwd_ctx_.set_engine(this->engine());
+        bwd_ctx_.set_num_threads(this->num_threads_);
+
+        bwd_kernel_->compute(bwd_ctx_, params_);
     }
 
 } // xsdnn
@@ -16,6 +16,10 @@ std::vector<shape3d> Input::out_shape() const {
     return {shape_};
 }
 
+bool Input::layout_sensitive() const {
+    return false;
+}
+
 std::string Input::layer_type() const {
     return "Input";
 }
@@ -15,7 +15,9 @@ namespace xsdnn {
                 in_concept_(in_type.size()),
                 out_concept_(out_type.size()),
                 in_type_(in_type),
-                out_type_(out_type) {
+                out_type_(out_type),
+                training_(false),
+                fused_into_(nullptr) {
             weight_init_ = std::make_shared<weight_init::xavier>();
             bias_init_ = std::make_shared<weight_init::xavier>();
             trainable_ = true;
@@ -201,7 +203,17 @@ namespace xsdnn {
         return trainable_;
     }
 
+    void layer::set_training(bool training) {
+        training_ = training;
+    }
+
+    bool layer::training() const {
+        return training_;
+    }
+
     void layer::forward() {
+        fwd_in_data.clear();
+        fwd_out_data.clear();
         fwd_in_data.reserve(in_concept_);
         fwd_out_data.reserve(out_concept_);
 
@@ -221,9 +233,15 @@ namespace xsdnn {
             set_sample_count(fwd_in_data[(size_t) data_idx]->size());
         }
 
+        // Слитый слой пишет сразу в выход последнего слоя цепочки
+        layer* tail = fused_chain_.empty() ? this : fused_chain_.back();
+        if (tail != this) {
+            tail->set_sample_count(fwd_in_data[(size_t) data_idx]->size());
+        }
+
         for (size_t i = 0; i < out_concept_; ++i) {
-            fwd_out_data.emplace_back(ith_out_node(i)->get_data());
-            ith_out_node(i)->clear_grads();
+            fwd_out_data.emplace_back(tail->ith_out_node(i)->get_data());
+            tail->ith_out_node(i)->clear_grads();
         }
 
         forward_propagation(fwd_in_data, fwd_out_data);
@@ -292,6 +310,7 @@ namespace xsdnn {
         }
 
         initialized_ = true;
+        weights_changed();
     }
 
     void layer::clear_grads() {
@@ -317,6 +336,7 @@ namespace xsdnn {
             }
         }
         clear_grads();
+        weights_changed();
         post_update();
     }
 
@@ -328,8 +348,12 @@ namespace xsdnn {
         for (size_t i = 0; i < in_concept_; ++i) {
             if (!is_trainable_concept(in_type_[i])) {
                 resize(ith_in_node(i)->get_data());
+                resize(ith_in_node(i)->get_gradient());
+            } else if (reduces_weight_grads()) {
+                ith_in_node(i)->get_gradient()->resize(1);
+            } else {
+                resize(ith_in_node(i)->get_gradient());
             }
-            resize(ith_in_node(i)->get_gradient());
         }
 
         for (size_t i = 0; i < out_concept_; ++i) {
@@ -372,6 +396,67 @@ namespace xsdnn {
         return { mm_scalar(0.0f), mm_scalar(1.0f) };
     }
 
+    bool layer::set_layout(tensor_layout layout) {
+        return layout == tensor_layout::nchw;
+    }
+
+    bool layer::set_io_layout(tensor_layout in_layout, tensor_layout out_layout) {
+        return in_layout == out_layout && set_layout(in_layout);
+    }
+
+    bool layer::layout_sensitive() const {
+        return true;
+    }
+
+    bool layer::streamable() const {
+        return !layout_sensitive();
+    }
+
+    void layer::set_stream_state(tensor_t* state) {}
+
+    bool layer::fuse(const std::vector<layer*>& chain) {
+        unfuse();
+        if (chain.empty() || !fuse_chain(chain)) {
+            return false;
+        }
+
+        fused_chain_ = chain;
+        for (layer* l : fused_chain_) {
+            l->fused_into_ = this;
+        }
+        return true;
+    }
+
+    void layer::unfuse() {
+        if (fused_chain_.empty()) {
+            return;
+        }
+
+        fuse_chain({});
+        for (layer* l : fused_chain_) {
+            l->fused_into_ = nullptr;
+        }
+        fused_chain_.clear();
+    }
+
+    bool layer::absorbed() const {
+        return fused_into_ != nullptr;
+    }
+
+    bool layer::fuse_chain(const std::vector<layer*>& chain) {
+        return chain.empty();
+    }
+
+    bool layer::fold_scale_shift(const mat_t& scale, const mat_t& shift) {
+        return false;
+    }
+
+    void layer::add_bias_concept() {
+        in_type_.push_back(tensor_type::bias);
+        in_concept_ = in_type_.size();
+        prev_.resize(in_concept_);
+    }
+
     void connect(layer* last_node,
                         layer* next_node,
                         size_t last_node_data_concept_idx = 0,
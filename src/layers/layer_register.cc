@@ -20,10 +20,26 @@ XS_LAYER_SAVE_INTERNAL_REGISTER(and_layer)                      \
 XS_LAYER_SAVE_INTERNAL_REGISTER(flatten)                        \
 XS_LAYER_SAVE_INTERNAL_REGISTER(relu)                           \
 XS_LAYER_SAVE_INTERNAL_REGISTER(max_pooling)                    \
+XS_LAYER_SAVE_INTERNAL_REGISTER(average_pooling)                \
 XS_LAYER_SAVE_INTERNAL_REGISTER(global_average_pooling)         \
 XS_LAYER_SAVE_INTERNAL_REGISTER(reshape)                        \
 XS_LAYER_SAVE_INTERNAL_REGISTER(conv)                           \
-XS_LAYER_SAVE_INTERNAL_REGISTER(hard_sigmoid)
+XS_LAYER_SAVE_INTERNAL_REGISTER(conv_transpose)                 \
+XS_LAYER_SAVE_INTERNAL_REGISTER(batch_norm)                     \
+XS_LAYER_SAVE_INTERNAL_REGISTER(hard_sigmoid)                   \
+XS_LAYER_SAVE_INTERNAL_REGISTER(sigmoid)                        \
+XS_LAYER_SAVE_INTERNAL_REGISTER(tanh)                           \
+XS_LAYER_SAVE_INTERNAL_REGISTER(gelu)                           \
+XS_LAYER_SAVE_INTERNAL_REGISTER(silu)                           \
+XS_LAYER_SAVE_INTERNAL_REGISTER(leaky_relu)                     \
+XS_LAYER_SAVE_INTERNAL_REGISTER(elu)                            \
+XS_LAYER_SAVE_INTERNAL_REGISTER(softmax)                        \
+XS_LAYER_SAVE_INTERNAL_REGISTER(sub)                            \
+XS_LAYER_SAVE_INTERNAL_REGISTER(mul)                            \
+XS_LAYER_SAVE_INTERNAL_REGISTER(div)                            \
+XS_LAYER_SAVE_INTERNAL_REGISTER(min)                            \
+XS_LAYER_SAVE_INTERNAL_REGISTER(max)                            \
+XS_LAYER_SAVE_INTERNAL_REGISTER(pow)
 
 
 
@@ -42,10 +58,26 @@ XS_LAYER_LOAD_INTERNAL_REGISTER(and_layer)                      \
 XS_LAYER_LOAD_INTERNAL_REGISTER(flatten)                        \
 XS_LAYER_LOAD_INTERNAL_REGISTER(relu)                           \
 XS_LAYER_LOAD_INTERNAL_REGISTER(max_pooling)                    \
+XS_LAYER_LOAD_INTERNAL_REGISTER(average_pooling)                \
 XS_LAYER_LOAD_INTERNAL_REGISTER(global_average_pooling)         \
 XS_LAYER_LOAD_INTERNAL_REGISTER(reshape)                        \
 XS_LAYER_LOAD_INTERNAL_REGISTER(conv)                           \
-XS_LAYER_LOAD_INTERNAL_REGISTER(hard_sigmoid)
+XS_LAYER_LOAD_INTERNAL_REGISTER(conv_transpose)                 \
+XS_LAYER_LOAD_INTERNAL_REGISTER(batch_norm)                     \
+XS_LAYER_LOAD_INTERNAL_REGISTER(hard_sigmoid)                   \
+XS_LAYER_LOAD_INTERNAL_REGISTER(sigmoid)                        \
+XS_LAYER_LOAD_INTERNAL_REGISTER(tanh)                           \
+XS_LAYER_LOAD_INTERNAL_REGISTER(gelu)                           \
+XS_LAYER_LOAD_INTERNAL_REGISTER(silu)                           \
+XS_LAYER_LOAD_INTERNAL_REGISTER(leaky_relu)                     \
+XS_LAYER_LOAD_INTERNAL_REGISTER(elu)                            \
+XS_LAYER_LOAD_INTERNAL_REGISTER(softmax)                        \
+XS_LAYER_LOAD_INTERNAL_REGISTER(sub)                            \
+XS_LAYER_LOAD_INTERNAL_REGISTER(mul)                            \
+XS_LAYER_LOAD_INTERNAL_REGISTER(div)                            \
+XS_LAYER_LOAD_INTERNAL_REGISTER(min)                            \
+XS_LAYER_LOAD_INTERNAL_REGISTER(max)                            \
+XS_LAYER_LOAD_INTERNAL_REGISTER(pow)
 
 
 
@@ -0,0 +1,18 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/max.h>
+
+namespace xsdnn {
+
+mmpack::MmBinaryOpType max::binary_op() const {
+    return mmpack::MmBinaryMax;
+}
+
+std::string max::layer_type() const {
+    return "max";
+}
+
+} // xsdnn
@@ -27,48 +27,47 @@ namespace xsdnn {
         params_.stride_y_ = stride_y;
         params_.stride_x_ = stride_x;
         params_.pad_type_ = pad_type;
+
+        MM_POOL_PARAMS& mp = params_._;
+        mp.InShape[0] = height;
+        mp.InShape[1] = width;
+        mp.KernelShape[0] = kernel_y;
+        mp.KernelShape[1] = kernel_x;
+        mp.StrideShape[0] = stride_y;
+        mp.StrideShape[1] = stride_x;
+        mp.OutShape[0] = h_out;
+        mp.OutShape[1] = w_out;
+        calc_pool_padding(height, h_out, kernel_y, stride_y, pad_type, &mp.Padding[0], &mp.Padding[2]);
+        calc_pool_padding(width, w_out, kernel_x, stride_x, pad_type, &mp.Padding[1], &mp.Padding[3]);
     }
 
     void max_pooling::init_backend(core::backend_t engine) {
         fwd_kernel_.reset(new core::MaxPoolingFwdKernel);
-        connect_inout_idx_loop();
+        bwd_kernel_.reset(new core::MaxPoolingBwdKernel);
         set_backend(engine);
     }
 
+    const params::max_pool& max_pooling::get_params() const {
+        return params_;
+    }
+
     std::string max_pooling::layer_type() const {
         return "max_pooling";
     }
 
-    void max_pooling::connect_inout_idx(size_t c, size_t y, size_t x) {
-        size_t y_offset_max = std::min(params_.kernel_y_, params_.in_shape_.H - y * params_.stride_y_);
-        size_t x_offset_max = std::min(params_.kernel_x_, params_.in_shape_.W - x * params_.stride_x_);
-
-        for (size_t dy = 0; dy < y_offset_max; ++dy) {
-            for (size_t dx = 0; dx < x_offset_max; ++dx) {
-                size_t in_idx = params_.in_shape_(c, y * params_.stride_y_ + dy, x * params_.stride_x_ + dx);
-                size_t out_idx = params_.out_shape_(c, y, x);
-
-                assert(in_idx < params_.in_shape_.size());
-                assert(out_idx < params_.out_shape_.size());
-
-                params_.in2out[in_idx] = out_idx;
-                params_.out2in[out_idx].push_back(in_idx);
-            }
+    bool max_pooling::set_layout(tensor_layout layout) {
+        if (layout == tensor_layout::nchwc && params_.in_shape_.C % mmpack::MmNchwcGetBlockSize() != 0) {
+            return false;
         }
+        params_.layout_ = layout;
+        return true;
     }
 
-    void max_pooling::connect_inout_idx_loop() {
-        params_.in2out.resize(params_.in_shape_.size());
-        params_.out2in.resize(params_.out_shape_.size());
-
-        for (size_t c = 0; c < params_.out_shape_.C; ++c) {
-            for (size_t h = 0; h < params_.out_shape_.H; ++h) {
-                for (size_t w = 0; w < params_.out_shape_.W; ++w) {
-                    connect_inout_idx(c, h, w);
-                }
-            }
-        }
-
+    bool max_pooling::streamable() const {
+        // Окна по времени не перекрываются и не пересекают границу части - контекст не нужен
+        return params_.in_shape_.H == 1 && params_.out_shape_.H == 1 &&
+               params_.kernel_x_ == params_.stride_x_ &&
+               params_.in_shape_.W % params_.stride_x_ == 0;
     }
 
     void max_pooling::forward_propagation(const std::vector<tensor_t *> &in_data, std::vector<tensor_t *> &out_data) {
@@ -77,12 +76,18 @@ namespace xsdnn {
         fwd_ctx_.set_parallelize(this->parallelize());
         fwd_ctx_.set_num_threads(this->num_threads_);
 
+        params_.record_argmax_ = training();
         fwd_kernel_->compute(fwd_ctx_, params_);
     }
 
     void max_pooling::back_propagation(const std::vector<tensor_t *> &in_data, const std::vector<tensor_t *> &out_data,
                                        std::vector<tensor_t *> &out_grad, std::vector<tensor_t *> &in_grad) {
-        throw xs_error("[max_pooling bwd] NotImplementedYet");
+        bwd_ctx_.set_in_out(in_data, out_data, out_grad, in_grad);
+        bwd_ctx_.set_parallelize(this->parallelize());
+        bwd_ctx_.set_engine(this->engine());
+        bwd_ctx_.set_num_threads(this->num_threads_);
+
+        bwd_kernel_->compute(bwd_ctx_, params_);
     }
 
 } // xsdnn
\ No newline at end of file
@@ -0,0 +1,18 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/min.h>
+
+namespace xsdnn {
+
+mmpack::MmBinaryOpType min::binary_op() const {
+    return mmpack::MmBinaryMin;
+}
+
+std::string min::layer_type() const {
+    return "min";
+}
+
+} // xsdnn
@@ -7,26 +7,12 @@
 
 namespace xsdnn {
 
-    std::vector<shape3d> mul::in_shape() const {
-        return {in_shape_, in_shape_};
-    }
+mmpack::MmBinaryOpType mul::binary_op() const {
+    return mmpack::MmBinaryMul;
+}
 
-    std::vector<shape3d> mul::out_shape() const {
-        return { in_shape_ };
-    }
+std::string mul::layer_type() const {
+    return "mul";
+}
 
-    std::string mul::layer_type() const {
-        return "mul";
-    }
-
-    void mul::forward_propagation(const std::vector<tensor_t *> &in_data,
-                                  std::vector<tensor_t *> &out_data) {
-        throw xs_error("[mul fwd] Not Implemented Yet");
-    }
-
-    void mul::back_propagation(const std::vector<tensor_t *> &in_data, const std::vector<tensor_t *> &out_data,
-                               std::vector<tensor_t *> &out_grad, std::vector<tensor_t *> &in_grad) {
-        throw xs_error("[mul bwd] Not Implemented Yet");
-    }
-
-} // xsdnn
\ No newline at end of file
+} // xsdnn
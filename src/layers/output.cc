@@ -20,6 +20,10 @@ std::vector<shape3d> Output::out_shape() const {
     return {shape_};
 }
 
+bool Output::layout_sensitive() const {
+    return false;
+}
+
 std::string Output::layer_type() const {
     return "Output";
 }
@@ -0,0 +1,18 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/pow.h>
+
+namespace xsdnn {
+
+mmpack::MmBinaryOpType pow::binary_op() const {
+    return mmpack::MmBinaryPow;
+}
+
+std::string pow::layer_type() const {
+    return "pow";
+}
+
+} // xsdnn
@@ -0,0 +1,18 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <layers/sub.h>
+
+namespace xsdnn {
+
+mmpack::MmBinaryOpType sub::binary_op() const {
+    return mmpack::MmBinarySub;
+}
+
+std::string sub::layer_type() const {
+    return "sub";
+}
+
+} // xsdnn
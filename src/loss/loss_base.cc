@@ -4,6 +4,7 @@
 //
 
 #include <loss/loss_base.h>
+#include <core/framework/threading.h>
 #include <cassert>
 
 namespace xsdnn {
@@ -13,6 +14,10 @@ namespace xsdnn {
     loss &loss::operator=(const xsdnn::loss &) = default;
     loss::~loss() {}
 
+bool loss::index_labels() const {
+    return false;
+}
+
 void gradient(loss* l_ptr, const mat_t& y, const mat_t& a, mat_t& dst) {
     l_ptr->df(y, a, dst);
 }
@@ -29,20 +34,22 @@ void gradient(loss* l_ptr, const tensor_t& y, const tensor_t& a, tensor_t& dst)
 void gradient(loss* l_ptr,
               const std::vector<tensor_t>& y,
               const std::vector<tensor_t>& a,
-              std::vector<tensor_t>& dst) {
+              std::vector<tensor_t>& dst,
+              bool parallelize,
+              size_t nthreads) {
     size_t sample_count = y.size();
     size_t channel_count = y[0].size();
 
     assert(y.size() == dst.size());
 
-    for (size_t i = 0; i < sample_count; ++i) {
+    concurrency::TryParallelFor(parallelize, nthreads, sample_count, [&](size_t i) {
         assert(y[i].size() == channel_count);
         assert(a[i].size() == channel_count);
 
         dst[i].resize(channel_count);
 
         gradient(l_ptr, y[i], a[i], dst[i]);
-    }
+    });
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include <loss/softmax_cross_entropy_loss.h>
+#include <utils/xs_error.h>
+#include <cmath>
+
+namespace xsdnn {
+
+softmax_cross_entropy_loss::softmax_cross_entropy_loss() = default;
+softmax_cross_entropy_loss::softmax_cross_entropy_loss(const softmax_cross_entropy_loss &) = default;
+softmax_cross_entropy_loss &softmax_cross_entropy_loss::operator=(const softmax_cross_entropy_loss &) = default;
+softmax_cross_entropy_loss::~softmax_cross_entropy_loss() = default;
+
+static size_t label_index(const mat_t& y, const mat_t& a) {
+    if (a.size() != 1 || a[0] < 0 || a[0] != std::floor(a[0]) || size_t(a[0]) >= y.size()) {
+        throw xs_error("[softmax_cross_entropy_loss] label must be a single class index less than output size");
+    }
+    return size_t(a[0]);
+}
+
+mm_scalar softmax_cross_entropy_loss::f(const mat_t &y, const mat_t &a) {
+    return mmpack::MmSoftmaxCrossEntropy(y.data(), label_index(y, a), y.size(), nullptr);
+}
+
+void softmax_cross_entropy_loss::df(const mat_t &y, const mat_t &a, mat_t &dst) {
+    mmpack::MmSoftmaxCrossEntropy(y.data(), label_index(y, a), y.size(), dst.data());
+}
+
+bool softmax_cross_entropy_loss::index_labels() const {
+    return true;
+}
+
+} // xsdnn
@@ -4,15 +4,23 @@
 //
 
 #include <algorithm>
-#include "mmpack_.h"
+#include <cmath>
+#include <cstring>
+#include "smath_.h"
 
 namespace mmpack {
 
+/*
+ * Каждая активация задает прямой проход Activate и производную Backward, которая
+ * возвращает OutputGrad * f'(x). NeedsInput - производная не выражается через выход
+ * и требует вход активации.
+ */
 template<MmActivationType ActivationType>
 struct MmActivationMain;
 
 template<>
 struct MmActivationMain<Relu> {
+    static constexpr bool NeedsInput = false;
     Mm_Float32x4 ZeroFloat = MmSetZeroFloat32x4();
 
     MmActivationMain(const MmActivationHolder* ActivationHolder) {
@@ -30,10 +38,15 @@ struct MmActivationMain<Relu> {
         return std::max(Scalar, 0.0f);
 #endif // MM_USE_SSE
     }
+
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        return MmAndFloat32x4(MmGreaterThanFloat32x4(Output, ZeroFloat), OutputGrad);
+    }
 };
 
 template<>
 struct MmActivationMain<HardSigmoid> {
+    static constexpr bool NeedsInput = false;
     Mm_Float32x4 Alpha;
     Mm_Float32x4 Beta;
     Mm_Float32x4 Minimum;
@@ -63,6 +76,192 @@ struct MmActivationMain<HardSigmoid> {
         return Scalar;
 #endif
     }
+
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        const Mm_Float32x4 Linear = MmAndFloat32x4(MmGreaterThanFloat32x4(Output, Minimum),
+                                                   MmLessThanFloat32x4(Output, Maximum));
+        return MmAndFloat32x4(Linear, MmMultiplyFloat32x4(OutputGrad, Alpha));
+    }
+};
+
+template<>
+struct MmActivationMain<Sigmoid> {
+    static constexpr bool NeedsInput = false;
+    Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+
+    MmActivationMain(const MmActivationHolder* ActivationHolder) {
+        MM_UNUSED_PARAMETER(ActivationHolder);
+    }
+
+    Mm_Float32x4 Activate(Mm_Float32x4 Vector) {
+        return MmSigmoidFloat32x4(Vector);
+    }
+
+    float Activate(float Scalar) {
+#if defined(MM_USE_SSE)
+        return _mm_cvtss_f32(Activate(_mm_set_ss(Scalar)));
+#else
+        return 1.0f / (1.0f + std::exp(-Scalar));
+#endif
+    }
+
+    // f'(x) = y * (1 - y)
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        return MmMultiplyFloat32x4(OutputGrad, MmMultiplyFloat32x4(Output, MmSubtractFloat32x4(One, Output)));
+    }
+};
+
+template<>
+struct MmActivationMain<Tanh> {
+    static constexpr bool NeedsInput = false;
+    Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+
+    MmActivationMain(const MmActivationHolder* ActivationHolder) {
+        MM_UNUSED_PARAMETER(ActivationHolder);
+    }
+
+    Mm_Float32x4 Activate(Mm_Float32x4 Vector) {
+        return MmTanhFloat32x4(Vector);
+    }
+
+    float Activate(float Scalar) {
+#if defined(MM_USE_SSE)
+        return _mm_cvtss_f32(Activate(_mm_set_ss(Scalar)));
+#else
+        return std::tanh(Scalar);
+#endif
+    }
+
+    // f'(x) = 1 - y^2
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        return MmMultiplyFloat32x4(OutputGrad, MmSubtractFloat32x4(One, MmMultiplyFloat32x4(Output, Output)));
+    }
+};
+
+template<>
+struct MmActivationMain<Gelu> {
+    static constexpr bool NeedsInput = true;
+    Mm_Float32x4 Half = MmBroadcastFloat32x4(0.5f);
+    Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+    Mm_Float32x4 Sqrt1_2 = MmBroadcastFloat32x4(0.707106781186547524f);
+    Mm_Float32x4 RcpSqrt2Pi = MmBroadcastFloat32x4(0.398942280401432678f);
+
+    MmActivationMain(const MmActivationHolder* ActivationHolder) {
+        MM_UNUSED_PARAMETER(ActivationHolder);
+    }
+
+    // Phi(x) = (1 + erf(x / sqrt(2))) / 2
+    Mm_Float32x4 Cdf(Mm_Float32x4 Vector) {
+        return MmMultiplyFloat32x4(Half, MmAddFloat32x4(One, MmErfFloat32x4(MmMultiplyFloat32x4(Vector, Sqrt1_2))));
+    }
+
+    // Точная форма x * Phi(x), а не приближение через tanh
+    Mm_Float32x4 Activate(Mm_Float32x4 Vector) {
+        return MmMultiplyFloat32x4(Vector, Cdf(Vector));
+    }
+
+    float Activate(float Scalar) {
+#if defined(MM_USE_SSE)
+        return _mm_cvtss_f32(Activate(_mm_set_ss(Scalar)));
+#else
+        return 0.5f * Scalar * (1.0f + std::erf(Scalar * 0.707106781186547524f));
+#endif
+    }
+
+    // f'(x) = Phi(x) + x * phi(x), phi(x) = exp(-x^2 / 2) / sqrt(2 * pi)
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        const Mm_Float32x4 Pdf = MmMultiplyFloat32x4(
+                RcpSqrt2Pi, MmExpFloat32x4(MmMultiplyFloat32x4(MmMultiplyFloat32x4(Input, Input), MmBroadcastFloat32x4(-0.5f))));
+        return MmMultiplyFloat32x4(OutputGrad, MmMultiplyAddFloat32x4(Input, Pdf, Cdf(Input)));
+    }
+};
+
+template<>
+struct MmActivationMain<Silu> {
+    static constexpr bool NeedsInput = true;
+    Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+
+    MmActivationMain(const MmActivationHolder* ActivationHolder) {
+        MM_UNUSED_PARAMETER(ActivationHolder);
+    }
+
+    Mm_Float32x4 Activate(Mm_Float32x4 Vector) {
+        return MmMultiplyFloat32x4(Vector, MmSigmoidFloat32x4(Vector));
+    }
+
+    float Activate(float Scalar) {
+#if defined(MM_USE_SSE)
+        return _mm_cvtss_f32(Activate(_mm_set_ss(Scalar)));
+#else
+        return Scalar / (1.0f + std::exp(-Scalar));
+#endif
+    }
+
+    // f'(x) = s + y * (1 - s), s = sigmoid(x)
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        const Mm_Float32x4 S = MmSigmoidFloat32x4(Input);
+        return MmMultiplyFloat32x4(OutputGrad, MmMultiplyAddFloat32x4(Output, MmSubtractFloat32x4(One, S), S));
+    }
+};
+
+template<>
+struct MmActivationMain<LeakyRelu> {
+    static constexpr bool NeedsInput = false;
+    Mm_Float32x4 Alpha;
+    Mm_Float32x4 ZeroFloat = MmSetZeroFloat32x4();
+
+    MmActivationMain(const MmActivationHolder* ActivationHolder) {
+        Alpha = MmBroadcastFloat32x4(ActivationHolder->Parameters.LeakyRelu.alpha);
+    }
+
+    Mm_Float32x4 Activate(Mm_Float32x4 Vector) {
+        return MmBlendFloat32x4(Vector, MmMultiplyFloat32x4(Vector, Alpha), MmLessThanFloat32x4(Vector, ZeroFloat));
+    }
+
+    float Activate(float Scalar) {
+#if defined(MM_USE_SSE)
+        return _mm_cvtss_f32(Activate(_mm_set_ss(Scalar)));
+#else
+        return Scalar < 0.0f ? Scalar * MmExtractPosFloat32x4<0>(Alpha) : Scalar;
+#endif
+    }
+
+    // Знак выхода совпадает со знаком входа при alpha > 0
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        return MmBlendFloat32x4(MmMultiplyFloat32x4(OutputGrad, Alpha), OutputGrad,
+                                MmGreaterThanFloat32x4(Output, ZeroFloat));
+    }
+};
+
+template<>
+struct MmActivationMain<Elu> {
+    static constexpr bool NeedsInput = false;
+    Mm_Float32x4 Alpha;
+    Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+    Mm_Float32x4 ZeroFloat = MmSetZeroFloat32x4();
+
+    MmActivationMain(const MmActivationHolder* ActivationHolder) {
+        Alpha = MmBroadcastFloat32x4(ActivationHolder->Parameters.Elu.alpha);
+    }
+
+    Mm_Float32x4 Activate(Mm_Float32x4 Vector) {
+        const Mm_Float32x4 Negative = MmMultiplyFloat32x4(Alpha, MmSubtractFloat32x4(MmExpFloat32x4(Vector), One));
+        return MmBlendFloat32x4(Vector, Negative, MmLessThanFloat32x4(Vector, ZeroFloat));
+    }
+
+    float Activate(float Scalar) {
+#if defined(MM_USE_SSE)
+        return _mm_cvtss_f32(Activate(_mm_set_ss(Scalar)));
+#else
+        return Scalar < 0.0f ? MmExtractPosFloat32x4<0>(Alpha) * (std::exp(Scalar) - 1.0f) : Scalar;
+#endif
+    }
+
+    // f'(x) = y + alpha при x < 0
+    Mm_Float32x4 Backward(Mm_Float32x4 Input, Mm_Float32x4 Output, Mm_Float32x4 OutputGrad) {
+        return MmBlendFloat32x4(MmMultiplyFloat32x4(OutputGrad, MmAddFloat32x4(Output, Alpha)), OutputGrad,
+                                MmGreaterThanFloat32x4(Output, ZeroFloat));
+    }
 };
 
 template<MmActivationType ActivationType>
@@ -97,7 +296,8 @@ MmActivationKernel(
         }
 
         while (n > 0) {
-            *buffer++ = ActivationFunc.Activate(*buffer);
+            *buffer = ActivationFunc.Activate(*buffer);
+            buffer++;
             n -= 1;
         }
         C += ldc;
@@ -105,6 +305,53 @@ MmActivationKernel(
     }
 }
 
+template<MmActivationType ActivationType>
+void
+MmActivationBackwardKernel(
+        const MmActivationHolder* Activation,
+        const float* Input,
+        const float* Output,
+        const float* OutputGrad,
+        float* InputGrad,
+        size_t Count
+) {
+    MmActivationMain<ActivationType> ActivationFunc(Activation);
+    const Mm_Float32x4 Zero = MmSetZeroFloat32x4();
+
+    while (Count >= 4) {
+        const Mm_Float32x4 X = ActivationFunc.NeedsInput ? MmLoadFloat32x4<std::false_type>(Input) : Zero;
+        MmStoreFloat32x4<std::false_type>(InputGrad,
+                                          ActivationFunc.Backward(X,
+                                                                  MmLoadFloat32x4<std::false_type>(Output),
+                                                                  MmLoadFloat32x4<std::false_type>(OutputGrad)));
+        if (ActivationFunc.NeedsInput) {
+            Input += 4;
+        }
+        Output += 4;
+        OutputGrad += 4;
+        InputGrad += 4;
+        Count -= 4;
+    }
+
+    if (Count > 0) {
+        float InputBuffer[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float OutputBuffer[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float GradBuffer[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+        if (ActivationFunc.NeedsInput) {
+            memcpy(InputBuffer, Input, Count * sizeof(float));
+        }
+        memcpy(OutputBuffer, Output, Count * sizeof(float));
+        memcpy(GradBuffer, OutputGrad, Count * sizeof(float));
+
+        MmStoreFloat32x4<std::false_type>(GradBuffer,
+                                          ActivationFunc.Backward(MmLoadFloat32x4<std::false_type>(InputBuffer),
+                                                                  MmLoadFloat32x4<std::false_type>(OutputBuffer),
+                                                                  MmLoadFloat32x4<std::false_type>(GradBuffer)));
+        memcpy(InputGrad, GradBuffer, Count * sizeof(float));
+    }
+}
+
 void
 MmActivation(
         MmActivationHolder* Activation,
@@ -120,15 +367,99 @@ MmActivation(
         case (MmActivationType::HardSigmoid):
             MmActivationKernel<HardSigmoid>(Activation, C, M, N, ldc);
             break;
+        case (MmActivationType::Sigmoid):
+            MmActivationKernel<Sigmoid>(Activation, C, M, N, ldc);
+            break;
+        case (MmActivationType::Tanh):
+            MmActivationKernel<Tanh>(Activation, C, M, N, ldc);
+            break;
+        case (MmActivationType::Gelu):
+            MmActivationKernel<Gelu>(Activation, C, M, N, ldc);
+            break;
+        case (MmActivationType::Silu):
+            MmActivationKernel<Silu>(Activation, C, M, N, ldc);
+            break;
+        case (MmActivationType::LeakyRelu):
+            MmActivationKernel<LeakyRelu>(Activation, C, M, N, ldc);
+            break;
+        case (MmActivationType::Elu):
+            MmActivationKernel<Elu>(Activation, C, M, N, ldc);
+            break;
+        case (NotSet):
+            break;
+    }
+}
+
+bool
+MmActivationNeedsInput(
+        MmActivationType ActivationType
+) {
+    switch (ActivationType) {
+        case (MmActivationType::Gelu):
+            return MmActivationMain<Gelu>::NeedsInput;
+        case (MmActivationType::Silu):
+            return MmActivationMain<Silu>::NeedsInput;
+        default:
+            return false;
+    }
+}
+
+void
+MmActivationBackward(
+        const MmActivationHolder* Activation,
+        const float* Input,
+        const float* Output,
+        const float* OutputGrad,
+        float* InputGrad,
+        size_t Count
+) {
+    switch (Activation->ActivationType) {
+        case (MmActivationType::Relu):
+            MmActivationBackwardKernel<Relu>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
+        case (MmActivationType::HardSigmoid):
+            MmActivationBackwardKernel<HardSigmoid>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
+        case (MmActivationType::Sigmoid):
+            MmActivationBackwardKernel<Sigmoid>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
+        case (MmActivationType::Tanh):
+            MmActivationBackwardKernel<Tanh>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
+        case (MmActivationType::Gelu):
+            MmActivationBackwardKernel<Gelu>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
+        case (MmActivationType::Silu):
+            MmActivationBackwardKernel<Silu>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
+        case (MmActivationType::LeakyRelu):
+            MmActivationBackwardKernel<LeakyRelu>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
+        case (MmActivationType::Elu):
+            MmActivationBackwardKernel<Elu>(Activation, Input, Output, OutputGrad, InputGrad, Count);
+            break;
         case (NotSet):
+            std::copy(OutputGrad, OutputGrad + Count, InputGrad);
             break;
     }
 }
 
 void
 MmSetDefaultActivationParameters(MmActivationHolder* Holder) {
-    Holder->Parameters.HardSigmoid.alpha = 0.2f;
-    Holder->Parameters.HardSigmoid.beta = 0.5f;
+    switch (Holder->ActivationType) {
+        case (MmActivationType::HardSigmoid):
+            Holder->Parameters.HardSigmoid.alpha = 0.2f;
+            Holder->Parameters.HardSigmoid.beta = 0.5f;
+            break;
+        case (MmActivationType::LeakyRelu):
+            Holder->Parameters.LeakyRelu.alpha = 0.01f;
+            break;
+        case (MmActivationType::Elu):
+            Holder->Parameters.Elu.alpha = 1.0f;
+            break;
+        default:
+            break;
+    }
 }
 
-} // mmpack
\ No newline at end of file
+} // mmpack
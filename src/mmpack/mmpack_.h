@@ -24,6 +24,37 @@
 #define MM_SGEMM_STRIDE_N       128
 #define MM_SGEMM_TRANSA_ROWS    12
 
+/*
+ * Ширина панели и маркер нулевой строки для алгоритма свертки Indirect
+ */
+
+#define MM_CONV_INDIRECT_TILE_N      8
+#define MM_CONV_INDIRECT_ZERO_ROW    0xFFFFFFFFu
+
+/*
+ * Размер блока каналов для блочного формата NCHWc: равен ширине вектора Mm_Float32x4
+ */
+
+#define MM_NCHWC_BLOCK_SIZE     4
+
+/*
+ * Размер части матрицы Im2Col (в элементах float) для свертки в формате NHWC
+ */
+
+#define MM_CONV_NHWC_COLUMN_ELEMENTS    16384
+
+/*
+ * Размер части матрицы Im2Col (в элементах float) для обратного прохода свертки
+ */
+
+#define MM_CONV_BACKWARD_COLUMN_ELEMENTS    16384
+
+/*
+ * Размер тайла выхода свертки (в элементах float) для слияния свертки с max pooling
+ */
+
+#define MM_CONV_POOL_TILE_ELEMENTS    16384
+
 namespace mmpack {
 
 void
@@ -43,6 +74,71 @@ MmGemm(
         size_t ldc
 );
 
+void
+MmConvAddBias(
+        const float* Bias,
+        float* Output,
+        size_t M,
+        size_t N,
+        size_t ldc
+);
+
+void
+MmConvOp(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weights,
+        const float* Bias,
+        float* Buffer,
+        float* Output,
+        size_t ldc,
+        size_t SegmentStartN,
+        size_t SegmentCountN
+);
+
+void
+MmMaxPoolRows(
+        const MM_POOL_PARAMS* Parameters,
+        const float* Input,
+        size_t InputStartRow,
+        float* Output,
+        size_t StartY,
+        size_t CountY
+);
+
+void
+MmConvIm2Col(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        float* ColumnBuffer,
+        size_t k,
+        size_t CountK,
+        size_t n,
+        size_t CountN
+);
+
+void
+MmConvIm2Col1D(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        float* ColumnBuffer,
+        size_t k,
+        size_t CountK,
+        size_t n,
+        size_t CountN
+);
+
+void
+MmConvNchwcOp(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Filter,
+        const float* PackedFilter,
+        const float* Bias,
+        float* Buffer,
+        float* Output
+);
+
 #if defined(MM_USE_SSE)
 
 #if !defined(MM_USE_DOUBLE)
@@ -136,6 +232,16 @@ MmUnpackValue(const Mm_Float32x4& Vector) {
     return Vector[0] + Vector[1] + Vector[2] + Vector[3];
 }
 
+/*
+* Максимум по позициям вектора
+*/
+MM_STRONG_INLINE
+float
+MmReduceMaximumFloat32x4(const Mm_Float32x4& Vector) {
+    const Mm_Float32x4 Maximum = _mm_max_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    return _mm_cvtss_f32(_mm_max_ss(Maximum, _mm_shuffle_ps(Maximum, Maximum, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
 template<>
 MM_STRONG_INLINE
 float
@@ -162,6 +268,12 @@ MmAddFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
     return _mm_add_ps(Vector1, Vector2);
 }
 
+MM_STRONG_INLINE
+Mm_Float32x4
+MmSubtractFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_sub_ps(Vector1, Vector2);
+}
+
 /*
 * Multiply Add
 */
@@ -196,6 +308,52 @@ MmUnpackInterleaveHighFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4&
     return _mm_unpackhi_ps(Vector1, Vector2);
 }
 
+/*
+* Четные (0, 2 из Vector1 и Vector2) и нечетные (1, 3) элементы пары векторов.
+*/
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmPackEvenFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_shuffle_ps(Vector1, Vector2, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmPackOddFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_shuffle_ps(Vector1, Vector2, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmMoveLowHighFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_movelh_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmMoveHighLowFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_movehl_ps(Vector1, Vector2);
+}
+
+/*
+* Транспонирование блока 4x4: строки Row0..Row3 заменяются столбцами.
+*/
+
+MM_STRONG_INLINE
+void
+MmTransposeFloat32x4x4(Mm_Float32x4& Row0, Mm_Float32x4& Row1, Mm_Float32x4& Row2, Mm_Float32x4& Row3) {
+    Mm_Float32x4 t0 = MmUnpackInterleaveLowFloat32x4(Row0, Row1);
+    Mm_Float32x4 t1 = MmUnpackInterleaveLowFloat32x4(Row2, Row3);
+    Mm_Float32x4 t2 = MmUnpackInterleaveHighFloat32x4(Row0, Row1);
+    Mm_Float32x4 t3 = MmUnpackInterleaveHighFloat32x4(Row2, Row3);
+
+    Row0 = MmMoveLowHighFloat32x4(t0, t1);
+    Row1 = MmMoveHighLowFloat32x4(t1, t0);
+    Row2 = MmMoveLowHighFloat32x4(t2, t3);
+    Row3 = MmMoveHighLowFloat32x4(t3, t2);
+}
+
 MM_STRONG_INLINE
 Mm_Float32x4
 MmMaximumFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
@@ -208,6 +366,165 @@ MmMinimumFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
     return _mm_min_ps(Vector1, Vector2);
 }
 
+MM_STRONG_INLINE
+Mm_Float32x4
+MmDivideFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_div_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmSqrtFloat32x4(const Mm_Float32x4& Vector) {
+    return _mm_sqrt_ps(Vector);
+}
+
+/*
+* Битовые операции и сравнения. Результат сравнения - маска из всех единиц или нулей в каждой позиции.
+*/
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmAndFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_and_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmAndNotFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_andnot_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmOrFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_or_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmXorFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_xor_ps(Vector1, Vector2);
+}
+
+/*
+* Выбирает Vector2 там, где Selector - единицы, и Vector1 в остальных позициях.
+*/
+MM_STRONG_INLINE
+Mm_Float32x4
+MmBlendFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2, const Mm_Float32x4& Selector) {
+    return _mm_or_ps(_mm_and_ps(Selector, Vector2), _mm_andnot_ps(Selector, Vector1));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmGreaterThanFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_cmpgt_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmLessThanFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_cmplt_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmEqualFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_cmpeq_ps(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmUnorderedFloat32x4(const Mm_Float32x4& Vector1, const Mm_Float32x4& Vector2) {
+    return _mm_cmpunord_ps(Vector1, Vector2);
+}
+
+/*
+* Маска результата сравнения: бит i выставлен, если позиция i - единицы.
+*/
+MM_STRONG_INLINE
+int
+MmMoveMaskFloat32x4(const Mm_Float32x4& Vector) {
+    return _mm_movemask_ps(Vector);
+}
+
+/*
+* Целочисленные векторы для работы с полями порядка и мантиссы.
+*/
+
+typedef __m128i Mm_Int32x4;
+
+MM_STRONG_INLINE
+Mm_Int32x4
+MmBroadcastInt32x4(int32_t x) {
+    return _mm_set1_epi32(x);
+}
+
+MM_STRONG_INLINE
+Mm_Int32x4
+MmAddInt32x4(const Mm_Int32x4& Vector1, const Mm_Int32x4& Vector2) {
+    return _mm_add_epi32(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Int32x4
+MmSubtractInt32x4(const Mm_Int32x4& Vector1, const Mm_Int32x4& Vector2) {
+    return _mm_sub_epi32(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Int32x4
+MmAndInt32x4(const Mm_Int32x4& Vector1, const Mm_Int32x4& Vector2) {
+    return _mm_and_si128(Vector1, Vector2);
+}
+
+MM_STRONG_INLINE
+Mm_Int32x4
+MmOrInt32x4(const Mm_Int32x4& Vector1, const Mm_Int32x4& Vector2) {
+    return _mm_or_si128(Vector1, Vector2);
+}
+
+template<int Count>
+MM_STRONG_INLINE
+Mm_Int32x4
+MmShiftLeftInt32x4(const Mm_Int32x4& Vector) {
+    return _mm_slli_epi32(Vector, Count);
+}
+
+template<int Count>
+MM_STRONG_INLINE
+Mm_Int32x4
+MmShiftRightInt32x4(const Mm_Int32x4& Vector) {
+    return _mm_srai_epi32(Vector, Count);
+}
+
+/*
+* Преобразование с округлением к ближайшему целому.
+*/
+MM_STRONG_INLINE
+Mm_Int32x4
+MmConvertFloat32x4ToInt32x4(const Mm_Float32x4& Vector) {
+    return _mm_cvtps_epi32(Vector);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmConvertInt32x4ToFloat32x4(const Mm_Int32x4& Vector) {
+    return _mm_cvtepi32_ps(Vector);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmCastToFloat32x4(const Mm_Int32x4& Vector) {
+    return _mm_castsi128_ps(Vector);
+}
+
+MM_STRONG_INLINE
+Mm_Int32x4
+MmCastToInt32x4(const Mm_Float32x4& Vector) {
+    return _mm_castps_si128(Vector);
+}
+
 #else
 #error SSE for double type NotImplementedYet
 #endif
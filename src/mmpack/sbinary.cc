@@ -0,0 +1,241 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "smath_.h"
+#include <algorithm>
+#include <cstring>
+
+namespace mmpack {
+
+template<MmBinaryOpType Op>
+struct MmBinaryMain;
+
+template<>
+struct MmBinaryMain<MmBinaryAdd> {
+    static float Apply(float a, float b) { return a + b; }
+
+#if defined(MM_USE_SSE)
+    static Mm_Float32x4 Apply(const Mm_Float32x4& a, const Mm_Float32x4& b) {
+        return MmAddFloat32x4(a, b);
+    }
+#endif
+};
+
+template<>
+struct MmBinaryMain<MmBinarySub> {
+    static float Apply(float a, float b) { return a - b; }
+
+#if defined(MM_USE_SSE)
+    static Mm_Float32x4 Apply(const Mm_Float32x4& a, const Mm_Float32x4& b) {
+        return MmSubtractFloat32x4(a, b);
+    }
+#endif
+};
+
+template<>
+struct MmBinaryMain<MmBinaryMul> {
+    static float Apply(float a, float b) { return a * b; }
+
+#if defined(MM_USE_SSE)
+    static Mm_Float32x4 Apply(const Mm_Float32x4& a, const Mm_Float32x4& b) {
+        return MmMultiplyFloat32x4(a, b);
+    }
+#endif
+};
+
+template<>
+struct MmBinaryMain<MmBinaryDiv> {
+    static float Apply(float a, float b) { return a / b; }
+
+#if defined(MM_USE_SSE)
+    static Mm_Float32x4 Apply(const Mm_Float32x4& a, const Mm_Float32x4& b) {
+        return MmDivideFloat32x4(a, b);
+    }
+#endif
+};
+
+template<>
+struct MmBinaryMain<MmBinaryMin> {
+    static float Apply(float a, float b) { return b < a ? b : a; }
+
+#if defined(MM_USE_SSE)
+    static Mm_Float32x4 Apply(const Mm_Float32x4& a, const Mm_Float32x4& b) {
+        return MmMinimumFloat32x4(b, a);
+    }
+#endif
+};
+
+template<>
+struct MmBinaryMain<MmBinaryMax> {
+    static float Apply(float a, float b) { return b > a ? b : a; }
+
+#if defined(MM_USE_SSE)
+    static Mm_Float32x4 Apply(const Mm_Float32x4& a, const Mm_Float32x4& b) {
+        return MmMaximumFloat32x4(b, a);
+    }
+#endif
+};
+
+template<>
+struct MmBinaryMain<MmBinaryPow> {
+    static float Apply(float a, float b) { return std::pow(a, b); }
+
+#if defined(MM_USE_SSE)
+    static Mm_Float32x4 Apply(const Mm_Float32x4& a, const Mm_Float32x4& b) {
+        /*
+         * a^b = exp(b * log(a)) для конечных a > 0. Отрицательное основание, ноль и
+         * бесконечности встречаются редко и считаются через libm.
+         */
+        const Mm_Float32x4 Regular = MmAndFloat32x4(
+            MmGreaterThanFloat32x4(a, MmSetZeroFloat32x4()),
+            MmLessThanFloat32x4(a, MmBroadcastFloat32x4(INFINITY)));
+
+        if (MmMoveMaskFloat32x4(Regular) == 0xF) {
+            return MmExpFloat32x4(MmMultiplyFloat32x4(b, MmLogFloat32x4(a)));
+        }
+
+        float Base[4], Exponent[4];
+        MmStoreFloat32x4<std::false_type>(Base, a);
+        MmStoreFloat32x4<std::false_type>(Exponent, b);
+        for (size_t i = 0; i < 4; ++i) {
+            Base[i] = std::pow(Base[i], Exponent[i]);
+        }
+        return MmLoadFloat32x4<std::false_type>(Base);
+    }
+#endif
+};
+
+template<MmBinaryOpType Op, bool ScalarA, bool ScalarB>
+void
+MmBinaryKernel(
+        const float* A,
+        const float* B,
+        float* C,
+        size_t N
+)
+/*++
+
+Описание процедуры:
+
+    C[i] = A[i] op B[i]. ScalarA / ScalarB - соответствующий вход задан одним значением.
+
+--*/
+{
+#if defined(MM_USE_SSE)
+    const Mm_Float32x4 BroadcastA = MmBroadcastFloat32x4(ScalarA ? A[0] : 0.0f);
+    const Mm_Float32x4 BroadcastB = MmBroadcastFloat32x4(ScalarB ? B[0] : 0.0f);
+    size_t i = 0;
+
+    for (; i + 8 <= N; i += 8) {
+        const Mm_Float32x4 A0 = ScalarA ? BroadcastA : MmLoadFloat32x4<std::false_type>(A + i);
+        const Mm_Float32x4 A1 = ScalarA ? BroadcastA : MmLoadFloat32x4<std::false_type>(A + i + 4);
+        const Mm_Float32x4 B0 = ScalarB ? BroadcastB : MmLoadFloat32x4<std::false_type>(B + i);
+        const Mm_Float32x4 B1 = ScalarB ? BroadcastB : MmLoadFloat32x4<std::false_type>(B + i + 4);
+
+        MmStoreFloat32x4<std::false_type>(C + i, MmBinaryMain<Op>::Apply(A0, B0));
+        MmStoreFloat32x4<std::false_type>(C + i + 4, MmBinaryMain<Op>::Apply(A1, B1));
+    }
+
+    for (; i + 4 <= N; i += 4) {
+        const Mm_Float32x4 A0 = ScalarA ? BroadcastA : MmLoadFloat32x4<std::false_type>(A + i);
+        const Mm_Float32x4 B0 = ScalarB ? BroadcastB : MmLoadFloat32x4<std::false_type>(B + i);
+
+        MmStoreFloat32x4<std::false_type>(C + i, MmBinaryMain<Op>::Apply(A0, B0));
+    }
+
+    // Хвост считается тем же векторным ядром, чтобы результат не зависел от позиции элемента
+    if (i < N) {
+        const size_t Tail = N - i;
+        float BufferA[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        float BufferB[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        float BufferC[4];
+
+        if (!ScalarA) {
+            memcpy(BufferA, A + i, Tail * sizeof(float));
+        }
+        if (!ScalarB) {
+            memcpy(BufferB, B + i, Tail * sizeof(float));
+        }
+
+        const Mm_Float32x4 A0 = ScalarA ? BroadcastA : MmLoadFloat32x4<std::false_type>(BufferA);
+        const Mm_Float32x4 B0 = ScalarB ? BroadcastB : MmLoadFloat32x4<std::false_type>(BufferB);
+        MmStoreFloat32x4<std::false_type>(BufferC, MmBinaryMain<Op>::Apply(A0, B0));
+        memcpy(C + i, BufferC, Tail * sizeof(float));
+    }
+#else
+    for (size_t i = 0; i < N; ++i) {
+        C[i] = MmBinaryMain<Op>::Apply(A[ScalarA ? 0 : i], B[ScalarB ? 0 : i]);
+    }
+#endif
+}
+
+template<bool ScalarA, bool ScalarB>
+void
+MmBinaryDispatch(
+        MmBinaryOpType Op,
+        const float* A,
+        const float* B,
+        float* C,
+        size_t N
+) {
+    switch (Op) {
+        case (MmBinaryOpType::MmBinaryAdd):
+            MmBinaryKernel<MmBinaryAdd, ScalarA, ScalarB>(A, B, C, N);
+            break;
+        case (MmBinaryOpType::MmBinarySub):
+            MmBinaryKernel<MmBinarySub, ScalarA, ScalarB>(A, B, C, N);
+            break;
+        case (MmBinaryOpType::MmBinaryMul):
+            MmBinaryKernel<MmBinaryMul, ScalarA, ScalarB>(A, B, C, N);
+            break;
+        case (MmBinaryOpType::MmBinaryDiv):
+            MmBinaryKernel<MmBinaryDiv, ScalarA, ScalarB>(A, B, C, N);
+            break;
+        case (MmBinaryOpType::MmBinaryMin):
+            MmBinaryKernel<MmBinaryMin, ScalarA, ScalarB>(A, B, C, N);
+            break;
+        case (MmBinaryOpType::MmBinaryMax):
+            MmBinaryKernel<MmBinaryMax, ScalarA, ScalarB>(A, B, C, N);
+            break;
+        case (MmBinaryOpType::MmBinaryPow):
+            MmBinaryKernel<MmBinaryPow, ScalarA, ScalarB>(A, B, C, N);
+            break;
+    }
+}
+
+void
+MmBinary(
+        MmBinaryOpType Op,
+        const float* A,
+        const float* B,
+        float* C,
+        size_t N
+) {
+    MmBinaryDispatch<false, false>(Op, A, B, C, N);
+}
+
+void
+MmBinaryScalarA(
+        MmBinaryOpType Op,
+        float A,
+        const float* B,
+        float* C,
+        size_t N
+) {
+    MmBinaryDispatch<true, false>(Op, &A, B, C, N);
+}
+
+void
+MmBinaryScalarB(
+        MmBinaryOpType Op,
+        const float* A,
+        float B,
+        float* C,
+        size_t N
+) {
+    MmBinaryDispatch<false, true>(Op, A, &B, C, N);
+}
+
+} // mmpack
@@ -205,6 +205,106 @@ MmConvIm2Col(
     }
 }
 
+void
+MmConvIm2Col1D(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        float* ColumnBuffer,
+        size_t k,
+        size_t CountK,
+        size_t n,
+        size_t CountN
+)
+/*++
+
+Описание процедуры:
+
+    Упаковывает строки [k, k + CountK) и столбцы [n, n + CountN) матрицы Im2Col
+    для одномерной свертки. Строка k соответствует каналу k / KW и смещению ядра k % KW.
+
+--*/
+{
+    const size_t InputWidth = Parameters->InShape[0];
+    const size_t InputSize = Parameters->InSize;
+    const size_t KernelWidth = Parameters->KernelShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[0];
+    const size_t PaddingLeftX = Parameters->Padding[0];
+
+    size_t kx = k % KernelWidth;
+
+    Input = Input + (k / KernelWidth) * InputSize;
+
+    for (size_t EndingK = k + CountK; k < EndingK; k++) {
+
+        size_t InputX = n * StrideWidth + kx * DilationWidth - PaddingLeftX;
+        size_t CountX = CountN;
+
+        if (StrideWidth == 1) {
+
+            //
+            // Левая граница заполнения (InputX < 0 после переполнения), затем
+            // непрерывная копия входа, затем правая граница.
+            //
+
+            const size_t OriginX = n + kx * DilationWidth;
+
+            if (OriginX < PaddingLeftX) {
+                size_t CountPadX = PaddingLeftX - OriginX;
+
+                if (CountPadX > CountX) {
+                    CountPadX = CountX;
+                }
+
+                CountX -= CountPadX;
+                InputX += CountPadX;
+
+                while (CountPadX-- > 0) {
+                    *ColumnBuffer++ = 0;
+                }
+            }
+
+            size_t CountCopyX = (InputX < InputWidth) ? InputWidth - InputX : 0;
+
+            if (CountCopyX > CountX) {
+                CountCopyX = CountX;
+            }
+
+            CountX -= CountCopyX;
+
+            while (CountCopyX >= 4) {
+                MmStoreFloat32x4<std::false_type>(ColumnBuffer, MmLoadFloat32x4<std::false_type>(&Input[InputX]));
+                ColumnBuffer += 4;
+                InputX += 4;
+                CountCopyX -= 4;
+            }
+
+            while (CountCopyX > 0) {
+                *ColumnBuffer++ = Input[InputX++];
+                CountCopyX--;
+            }
+
+            while (CountX > 0) {
+                *ColumnBuffer++ = 0;
+                CountX--;
+            }
+
+        } else {
+
+            while (CountX > 0) {
+                *ColumnBuffer++ = (InputX < InputWidth) ? Input[InputX] : 0;
+                InputX += StrideWidth;
+                CountX--;
+            }
+        }
+
+        if (++kx == KernelWidth) {
+            Input += InputSize;
+            kx = 0;
+        }
+    }
+}
+
 void
 MmConvOp(
         const MM_CONV_PARAMS* Parameters,
@@ -213,11 +313,21 @@ MmConvOp(
         const float* Bias,
         float* Buffer,
         float* Output,
+        size_t ldc,
         size_t SegmentStartN,
         size_t SegmentCountN
-) {
+)
+/*++
+
+Описание процедуры:
+
+    Вычисляет столбцы [SegmentStartN, SegmentStartN + SegmentCountN) выхода одной группы
+    свертки через Im2Col и MmGemm. Output указывает на столбец SegmentStartN первого фильтра,
+    ldc - лидирующее измерение выхода (OutSize для всего выхода, меньше - для тайла).
+
+--*/
+{
     const size_t FilterCount = Parameters->FilterCount;
-    const size_t OutputSize = Parameters->OutSize;
     const size_t K = Parameters->K;
 
     uint32_t StrideN = MM_SGEMM_STRIDE_N;
@@ -250,7 +360,7 @@ MmConvOp(
 
         size_t CountK;
         float beta = 0.0f;
-        float *SegmentOutput = Output + SegmentStartN + n;
+        float *SegmentOutput = Output + n;
 
         for (size_t k = 0; k < K; k += CountK) {
 
@@ -260,18 +370,665 @@ MmConvOp(
                 CountK = StrideK;
             }
 
-            MmConvIm2Col(Parameters, Input, Buffer, k, CountK,
-                         SegmentStartN + n, CountN);
+            if (Parameters->Dimensions == 1) {
+                MmConvIm2Col1D(Parameters, Input, Buffer, k, CountK,
+                               SegmentStartN + n, CountN);
+            } else {
+                MmConvIm2Col(Parameters, Input, Buffer, k, CountK,
+                             SegmentStartN + n, CountN);
+            }
 
             MmGemm(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
                    CountK, 1.0f, Weights + k, K, Buffer, CountN, beta,
-                   SegmentOutput, OutputSize);
+                   SegmentOutput, ldc);
 
             beta = 1.0f;
         }
 
         if (Bias != nullptr) {
-            MmConvAddBias(Bias, SegmentOutput, FilterCount, CountN, OutputSize);
+            MmConvAddBias(Bias, SegmentOutput, FilterCount, CountN, ldc);
+        }
+    }
+}
+
+float
+MmConvDirect1DPoint(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Filter,
+        size_t n
+)
+/*++
+
+Описание процедуры:
+
+    Вычисляет одну выходную точку одномерной свертки для одного фильтра с проверкой границ входа.
+
+--*/
+{
+    const size_t InputWidth = Parameters->InShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[0];
+    const size_t PaddingLeftX = Parameters->Padding[0];
+
+    float Accumulator = 0.0f;
+
+    for (size_t c = 0; c < Parameters->InChannel; ++c) {
+        for (size_t kx = 0; kx < KernelWidth; ++kx) {
+            const size_t InputX = n + kx * DilationWidth - PaddingLeftX;
+
+            if (InputX < InputWidth) {
+                Accumulator += Filter[kx] * Input[InputX];
+            }
+        }
+
+        Input += InputWidth;
+        Filter += KernelWidth;
+    }
+
+    return Accumulator;
+}
+
+template<size_t FilterRows>
+void
+MmConvDirect1DKernel(
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Output,
+        size_t InputChannel,
+        size_t InputWidth,
+        size_t KernelWidth,
+        size_t DilationWidth,
+        size_t K,
+        size_t OutputWidth
+)
+/*++
+
+Описание процедуры:
+
+    Считает 8 соседних выходных точек для FilterRows фильтров. Каждая загрузка входа
+    используется всеми FilterRows фильтрами, аккумуляторы хранятся в регистрах.
+
+--*/
+{
+    Mm_Float32x4 Accumulators[FilterRows][2];
+
+    for (size_t f = 0; f < FilterRows; ++f) {
+        Accumulators[f][0] = MmBroadcastFloat32x4(Bias != nullptr ? Bias[f] : 0.0f);
+        Accumulators[f][1] = Accumulators[f][0];
+    }
+
+    for (size_t c = 0; c < InputChannel; ++c) {
+        for (size_t kx = 0; kx < KernelWidth; ++kx) {
+            const float* InputPoint = Input + kx * DilationWidth;
+            const Mm_Float32x4 Input0 = MmLoadFloat32x4<std::false_type>(InputPoint);
+            const Mm_Float32x4 Input1 = MmLoadFloat32x4<std::false_type>(InputPoint + 4);
+
+            for (size_t f = 0; f < FilterRows; ++f) {
+                const Mm_Float32x4 FilterValue = MmBroadcastFloat32x4(Filter[f * K + kx]);
+                Accumulators[f][0] = MmMultiplyAddFloat32x4(Input0, FilterValue, Accumulators[f][0]);
+                Accumulators[f][1] = MmMultiplyAddFloat32x4(Input1, FilterValue, Accumulators[f][1]);
+            }
+        }
+
+        Input += InputWidth;
+        Filter += KernelWidth;
+    }
+
+    for (size_t f = 0; f < FilterRows; ++f) {
+        MmStoreFloat32x4<std::false_type>(Output + f * OutputWidth, Accumulators[f][0]);
+        MmStoreFloat32x4<std::false_type>(Output + f * OutputWidth + 4, Accumulators[f][1]);
+    }
+}
+
+void
+MmConvDirect1DOp(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weights,
+        const float* Bias,
+        float* Output
+)
+/*++
+
+Описание процедуры:
+
+    Выполняет прямую одномерную свертку одной группы с шагом 1 без временного буфера.
+    Внутренняя область выхода, в которой все отсчеты ядра попадают во вход, считается
+    блоками 4 фильтра x 8 точек (см. MmConvDirect1DKernel); края считаются поточечно.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannel = Parameters->InChannel;
+    const size_t InputWidth = Parameters->InShape[0];
+    const size_t OutputWidth = Parameters->OutShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[0];
+    const size_t PaddingLeftX = Parameters->Padding[0];
+    const size_t K = Parameters->K;
+
+    //
+    // Внутренняя область: n >= PaddingLeft и n + (KW - 1) * d - PaddingLeft < InputWidth.
+    //
+
+    const size_t KernelExtent = (KernelWidth - 1) * DilationWidth;
+    size_t InteriorStart = PaddingLeftX < OutputWidth ? PaddingLeftX : OutputWidth;
+    size_t InteriorEnd = InputWidth + PaddingLeftX > KernelExtent ? InputWidth + PaddingLeftX - KernelExtent : 0;
+
+    if (InteriorEnd > OutputWidth) {
+        InteriorEnd = OutputWidth;
+    }
+
+    if (InteriorEnd < InteriorStart) {
+        InteriorEnd = InteriorStart;
+    }
+
+    const size_t InteriorCount = (InteriorEnd - InteriorStart) / 8 * 8;
+    InteriorEnd = InteriorStart + InteriorCount;
+
+    for (size_t f = 0; f < FilterCount; ++f) {
+
+        const float* Filter = Weights + f * K;
+        float* OutputRow = Output + f * OutputWidth;
+        const float BiasValue = (Bias != nullptr) ? Bias[f] : 0.0f;
+
+        for (size_t n = 0; n < InteriorStart; ++n) {
+            OutputRow[n] = MmConvDirect1DPoint(Parameters, Input, Filter, n) + BiasValue;
+        }
+
+        for (size_t n = InteriorEnd; n < OutputWidth; ++n) {
+            OutputRow[n] = MmConvDirect1DPoint(Parameters, Input, Filter, n) + BiasValue;
+        }
+    }
+
+    for (size_t n = InteriorStart; n < InteriorEnd; n += 8) {
+
+        const float* InputRow = Input + n - PaddingLeftX;
+        size_t f = 0;
+
+        for (; f + 4 <= FilterCount; f += 4) {
+            MmConvDirect1DKernel<4>(InputRow, Weights + f * K, Bias != nullptr ? Bias + f : nullptr,
+                                    Output + f * OutputWidth + n, InputChannel, InputWidth,
+                                    KernelWidth, DilationWidth, K, OutputWidth);
+        }
+
+        for (; f < FilterCount; ++f) {
+            MmConvDirect1DKernel<1>(InputRow, Weights + f * K, Bias != nullptr ? Bias + f : nullptr,
+                                    Output + f * OutputWidth + n, InputChannel, InputWidth,
+                                    KernelWidth, DilationWidth, K, OutputWidth);
+        }
+    }
+}
+
+size_t
+MmConvIndirectionBufferSize(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    return Parameters->KernelShape[0] * Parameters->KernelShape[1] * Parameters->OutSize;
+}
+
+size_t
+MmConvIndirectBufferSize(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    return Parameters->K * MM_CONV_INDIRECT_TILE_N;
+}
+
+void
+MmConvIndirectionBuffer(
+        const MM_CONV_PARAMS* Parameters,
+        uint32_t* Indirection
+)
+{
+    constexpr size_t HeightShapeIndex = 0;
+    constexpr size_t WidthShapeIndex = 1;
+
+    const size_t InputHeight = Parameters->InShape[HeightShapeIndex];
+    const size_t InputWidth = Parameters->InShape[WidthShapeIndex];
+
+    const size_t OutputHeight = Parameters->OutShape[HeightShapeIndex];
+    const size_t OutputWidth = Parameters->OutShape[WidthShapeIndex];
+
+    const size_t KernelHeight = Parameters->KernelShape[HeightShapeIndex];
+    const size_t KernelWidth = Parameters->KernelShape[WidthShapeIndex];
+
+    const size_t DilationHeight = Parameters->DilationShape[HeightShapeIndex];
+    const size_t DilationWidth = Parameters->DilationShape[WidthShapeIndex];
+
+    const size_t StrideHeight = Parameters->StrideShape[HeightShapeIndex];
+    const size_t StrideWidth = Parameters->StrideShape[WidthShapeIndex];
+
+    const size_t PaddingLeftY = Parameters->Padding[HeightShapeIndex];
+    const size_t PaddingLeftX = Parameters->Padding[WidthShapeIndex];
+
+    for (size_t ky = 0; ky < KernelHeight; ky++) {
+        for (size_t kx = 0; kx < KernelWidth; kx++) {
+            for (size_t oy = 0; oy < OutputHeight; oy++) {
+
+                const size_t InputY = oy * StrideHeight + ky * DilationHeight - PaddingLeftY;
+
+                for (size_t ox = 0; ox < OutputWidth; ox++) {
+
+                    const size_t InputX = ox * StrideWidth + kx * DilationWidth - PaddingLeftX;
+
+                    if (InputY < InputHeight && InputX < InputWidth) {
+                        *Indirection++ = static_cast<uint32_t>(InputY * InputWidth + InputX);
+                    } else {
+                        *Indirection++ = MM_CONV_INDIRECT_ZERO_ROW;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MmConvIndirectGather(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const uint32_t* Indirection,
+        float* Panel,
+        size_t n,
+        size_t CountN
+)
+/*++
+
+Описание процедуры:
+
+    Собирает панель размера K x MM_CONV_INDIRECT_TILE_N для выходных точек
+    [n, n + CountN) через таблицу косвенной адресации. Недостающие столбцы
+    панели заполняются нулями.
+
+    Нулевая строка читается с шагом 0 по каналам, поэтому одного нулевого
+    элемента достаточно для любого кол-ва входных каналов.
+
+--*/
+{
+    static const float ZeroRow[1] = { 0.0f };
+
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+    const size_t InputChannels = Parameters->InChannel;
+    const size_t InputSize = Parameters->InSize;
+    const size_t OutputSize = Parameters->OutSize;
+
+    const size_t PanelChannelStride = KernelSize * MM_CONV_INDIRECT_TILE_N;
+
+    const float* Rows[MM_CONV_INDIRECT_TILE_N];
+    size_t RowStrides[MM_CONV_INDIRECT_TILE_N];
+
+    for (size_t kpos = 0; kpos < KernelSize; kpos++) {
+
+        const uint32_t* IndirectionRow = Indirection + kpos * OutputSize + n;
+
+        for (size_t j = 0; j < CountN; j++) {
+            if (IndirectionRow[j] == MM_CONV_INDIRECT_ZERO_ROW) {
+                Rows[j] = ZeroRow;
+                RowStrides[j] = 0;
+            } else {
+                Rows[j] = Input + IndirectionRow[j];
+                RowStrides[j] = InputSize;
+            }
+        }
+
+        float* PanelRow = Panel + kpos * MM_CONV_INDIRECT_TILE_N;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            size_t j = 0;
+
+            for (; j < CountN; j++) {
+                PanelRow[j] = Rows[j][c * RowStrides[j]];
+            }
+
+            for (; j < MM_CONV_INDIRECT_TILE_N; j++) {
+                PanelRow[j] = 0.0f;
+            }
+
+            PanelRow += PanelChannelStride;
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MmConvIndirectKernel(
+        const float* Panel,
+        const float* Weights,
+        const float* Bias,
+        float* Output,
+        size_t K,
+        size_t CountN,
+        size_t ldc
+)
+/*++
+
+Описание процедуры:
+
+    Микроядро алгоритма Indirect: вычисляет блок RowCount x MM_CONV_INDIRECT_TILE_N
+    выходного буфера по собранной панели и RowCount строкам фильтров.
+
+--*/
+{
+    Mm_Float32x4 Accumulators[RowCount][2];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = MmSetZeroFloat32x4();
+        Accumulators[r][1] = MmSetZeroFloat32x4();
+    }
+
+    for (size_t k = 0; k < K; k++) {
+
+        Mm_Float32x4 B0 = MmLoadFloat32x4<std::false_type>(Panel);
+        Mm_Float32x4 B1 = MmLoadFloat32x4<std::false_type>(Panel + 4);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Mm_Float32x4 A = MmBroadcastFloat32x4(Weights[r * K + k]);
+            Accumulators[r][0] = MmMultiplyAddFloat32x4(A, B0, Accumulators[r][0]);
+            Accumulators[r][1] = MmMultiplyAddFloat32x4(A, B1, Accumulators[r][1]);
+        }
+
+        Panel += MM_CONV_INDIRECT_TILE_N;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        if (Bias != nullptr) {
+            Mm_Float32x4 BiasVector = MmBroadcastFloat32x4(Bias[r]);
+            Accumulators[r][0] = MmAddFloat32x4(Accumulators[r][0], BiasVector);
+            Accumulators[r][1] = MmAddFloat32x4(Accumulators[r][1], BiasVector);
+        }
+
+        float* OutputRow = Output + r * ldc;
+
+        if (CountN == MM_CONV_INDIRECT_TILE_N) {
+            MmStoreFloat32x4<std::false_type>(OutputRow, Accumulators[r][0]);
+            MmStoreFloat32x4<std::false_type>(OutputRow + 4, Accumulators[r][1]);
+        } else {
+            MM_MAKE_ALIGN(float Tail[MM_CONV_INDIRECT_TILE_N], 16);
+            MmStoreFloat32x4<std::true_type>(Tail, Accumulators[r][0]);
+            MmStoreFloat32x4<std::true_type>(Tail + 4, Accumulators[r][1]);
+
+            for (size_t j = 0; j < CountN; j++) {
+                OutputRow[j] = Tail[j];
+            }
+        }
+    }
+}
+
+void
+MmConvIndirectOp(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weights,
+        const float* Bias,
+        const uint32_t* Indirection,
+        float* Panel,
+        float* Output
+)
+/*++
+
+Описание процедуры:
+
+    Выполняет свертку одной группы без построения матрицы Im2Col. Входные
+    пиксели читаются через таблицу косвенной адресации в панель шириной
+    MM_CONV_INDIRECT_TILE_N точек, после чего панель умножается на все фильтры группы.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutSize;
+    const size_t K = Parameters->K;
+
+    for (size_t n = 0; n < OutputSize; n += MM_CONV_INDIRECT_TILE_N) {
+
+        size_t CountN = OutputSize - n;
+
+        if (CountN > MM_CONV_INDIRECT_TILE_N) {
+            CountN = MM_CONV_INDIRECT_TILE_N;
+        }
+
+        MmConvIndirectGather(Parameters, Input, Indirection, Panel, n, CountN);
+
+        size_t m = 0;
+
+        for (; m + 6 <= FilterCount; m += 6) {
+            MmConvIndirectKernel<6>(Panel, Weights + m * K, Bias != nullptr ? Bias + m : nullptr,
+                                    Output + m * OutputSize + n, K, CountN, OutputSize);
+        }
+
+        const float* bias = Bias != nullptr ? Bias + m : nullptr;
+
+        switch (FilterCount - m) {
+            case 5:
+                MmConvIndirectKernel<5>(Panel, Weights + m * K, bias, Output + m * OutputSize + n, K, CountN, OutputSize);
+                break;
+            case 4:
+                MmConvIndirectKernel<4>(Panel, Weights + m * K, bias, Output + m * OutputSize + n, K, CountN, OutputSize);
+                break;
+            case 3:
+                MmConvIndirectKernel<3>(Panel, Weights + m * K, bias, Output + m * OutputSize + n, K, CountN, OutputSize);
+                break;
+            case 2:
+                MmConvIndirectKernel<2>(Panel, Weights + m * K, bias, Output + m * OutputSize + n, K, CountN, OutputSize);
+                break;
+            case 1:
+                MmConvIndirectKernel<1>(Panel, Weights + m * K, bias, Output + m * OutputSize + n, K, CountN, OutputSize);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+size_t
+MmConvNhwcRows(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    size_t Rows = MM_CONV_NHWC_COLUMN_ELEMENTS / Parameters->K;
+
+    if (Rows == 0) {
+        Rows = 1;
+    }
+
+    if (Rows > Parameters->OutSize) {
+        Rows = Parameters->OutSize;
+    }
+
+    return Rows;
+}
+
+size_t
+MmConvNhwcBufferSize(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    return Parameters->FilterCount * Parameters->K + MmConvNhwcRows(Parameters) * Parameters->K;
+}
+
+bool
+MmConvNhwcIsPointwise(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    return Parameters->KernelShape[0] == 1 && Parameters->KernelShape[1] == 1 &&
+           Parameters->StrideShape[0] == 1 && Parameters->StrideShape[1] == 1 &&
+           Parameters->Padding[0] == 0 && Parameters->Padding[1] == 0 &&
+           Parameters->Padding[2] == 0 && Parameters->Padding[3] == 0;
+}
+
+void
+MmConvNhwcReorderFilter(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Filter,
+        float* Destination
+)
+/*++
+
+Описание процедуры:
+
+    Переупорядочивает фильтры одной группы из [FilterCount][InChannel][KH][KW]
+    в [FilterCount][KH][KW][InChannel], чтобы порядок K совпадал со строками Im2Col в формате NHWC.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InChannel;
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+
+    for (size_t f = 0; f < Parameters->FilterCount; f++) {
+        for (size_t kpos = 0; kpos < KernelSize; kpos++) {
+            for (size_t c = 0; c < InputChannels; c++) {
+                *Destination++ = Filter[c * KernelSize + kpos];
+            }
+        }
+
+        Filter += Parameters->K;
+    }
+}
+
+void
+MmConvNhwcIm2Col(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        float* ColumnBuffer,
+        size_t InputChannelStride,
+        size_t n,
+        size_t CountN
+)
+/*++
+
+Описание процедуры:
+
+    Упаковывает строки [n, n + CountN) матрицы Im2Col для входа в формате NHWC.
+    Каждая позиция ядра дает непрерывный вектор из InChannel значений.
+
+--*/
+{
+    const size_t InputHeight = Parameters->InShape[0];
+    const size_t InputWidth = Parameters->InShape[1];
+    const size_t OutputWidth = Parameters->OutShape[1];
+
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+
+    const size_t InputChannels = Parameters->InChannel;
+
+    for (size_t EndingN = n + CountN; n < EndingN; n++) {
+
+        const size_t OriginInputY = (n / OutputWidth) * Parameters->StrideShape[0] - Parameters->Padding[0];
+        const size_t OriginInputX = (n % OutputWidth) * Parameters->StrideShape[1] - Parameters->Padding[1];
+
+        for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+            const size_t InputY = OriginInputY + ky * Parameters->DilationShape[0];
+
+            for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                const size_t InputX = OriginInputX + kx * Parameters->DilationShape[1];
+
+                if (InputY < InputHeight && InputX < InputWidth) {
+                    const float* Pixel = Input + (InputY * InputWidth + InputX) * InputChannelStride;
+
+                    for (size_t c = 0; c < InputChannels; c++) {
+                        ColumnBuffer[c] = Pixel[c];
+                    }
+                } else {
+                    for (size_t c = 0; c < InputChannels; c++) {
+                        ColumnBuffer[c] = 0.0f;
+                    }
+                }
+
+                ColumnBuffer += InputChannels;
+            }
+        }
+    }
+}
+
+void
+MmConvNhwc(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weight,
+        const float* Bias,
+        float* TemporaryBuffer,
+        float* Output
+)
+{
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutSize;
+    const size_t K = Parameters->K;
+
+    const size_t InputChannelStride = Parameters->InChannel * GroupCount;
+    const size_t OutputChannelStride = FilterCount * GroupCount;
+
+    const bool Pointwise = MmConvNhwcIsPointwise(Parameters);
+    const size_t StrideN = MmConvNhwcRows(Parameters);
+
+    float* FilterBuffer = TemporaryBuffer;
+    float* ColumnBuffer = TemporaryBuffer + FilterCount * K;
+
+    for (size_t group = 0; group < GroupCount; ++group) {
+
+        const float* GroupInput = Input + group * Parameters->InChannel;
+        float* GroupOutput = Output + group * FilterCount;
+
+        //
+        // Для точечной свертки порядок [InChannel][1][1] совпадает с [1][1][InChannel],
+        // поэтому фильтры используются без переупорядочивания.
+        //
+
+        const float* Filter = Weight + group * FilterCount * K;
+
+        if (Parameters->PackedFilter != nullptr) {
+            Filter = Parameters->PackedFilter + group * FilterCount * K;
+        } else if (!Pointwise) {
+            MmConvNhwcReorderFilter(Parameters, Filter, FilterBuffer);
+            Filter = FilterBuffer;
+        }
+
+        size_t CountN;
+
+        for (size_t n = 0; n < OutputSize; n += CountN) {
+
+            CountN = OutputSize - n;
+
+            if (CountN > StrideN) {
+                CountN = StrideN;
+            }
+
+            const float* A;
+            size_t lda;
+
+            if (Pointwise) {
+                A = GroupInput + n * InputChannelStride;
+                lda = InputChannelStride;
+            } else {
+                MmConvNhwcIm2Col(Parameters, GroupInput, ColumnBuffer, InputChannelStride, n, CountN);
+                A = ColumnBuffer;
+                lda = K;
+            }
+
+            float* SegmentOutput = GroupOutput + n * OutputChannelStride;
+
+            MmGemm(CblasNoTrans, CblasTrans, CountN, FilterCount, K, 1.0f,
+                   A, lda, Filter, K, 0.0f, SegmentOutput, OutputChannelStride);
+
+            if (Bias != nullptr) {
+                const float* GroupBias = Bias + group * FilterCount;
+
+                for (size_t row = 0; row < CountN; row++) {
+                    float* OutputRow = SegmentOutput + row * OutputChannelStride;
+
+                    for (size_t f = 0; f < FilterCount; f++) {
+                        OutputRow[f] += GroupBias[f];
+                    }
+                }
+            }
         }
     }
 }
@@ -296,13 +1053,36 @@ MmConv(
         const size_t GroupCount = Parameters->GroupCount;
 
         const float* filter = Weight;
+        const float* packed = Parameters->PackedFilter;
+        const size_t PackedGroupSize = MmConvPackedFilterSize(Parameters, false) / GroupCount;
         const float* bias = Bias;
 
         for (size_t group = 0; group < GroupCount; ++group) {
             switch (Parameters->Algorithm) {
                 case(MM_CONV_PARAMS::Im2ColThenGemm) : {
 
-                    MmConvOp(Parameters, Input, filter, bias, TemporaryBuffer, Output, 0, OutputSize);
+                    MmConvOp(Parameters, Input, filter, bias, TemporaryBuffer, Output, OutputSize, 0, OutputSize);
+
+                    break;
+                }
+
+                case(MM_CONV_PARAMS::Indirect) : {
+
+                    MmConvIndirectOp(Parameters, Input, filter, bias, Parameters->Indirection, TemporaryBuffer, Output);
+
+                    break;
+                }
+
+                case(MM_CONV_PARAMS::NchwcDirect) : {
+
+                    MmConvNchwcOp(Parameters, Input, filter, packed, bias, TemporaryBuffer, Output);
+
+                    break;
+                }
+
+                case(MM_CONV_PARAMS::Direct1D) : {
+
+                    MmConvDirect1DOp(Parameters, Input, filter, bias, Output);
 
                     break;
                 }
@@ -313,9 +1093,54 @@ MmConv(
             }
 
             filter += FilterGroupSize;
+            if (packed != nullptr) {
+                packed += PackedGroupSize;
+            }
             Input += SpatialInputGroupSize;
             Output += SpatialOutputGroupSize;
         }
 }
 
-}
\ No newline at end of file
+size_t
+MmConvPackedFilterSize(
+        const MM_CONV_PARAMS* Parameters,
+        bool Nhwc
+)
+{
+    if (Nhwc) {
+        return MmConvNhwcIsPointwise(Parameters) ? 0 : Parameters->GroupCount * Parameters->FilterCount * Parameters->K;
+    }
+
+    if (Parameters->Algorithm == MM_CONV_PARAMS::NchwcDirect) {
+        const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+        return Parameters->GroupCount * MmNchwcBlockedChannels(Parameters->FilterCount) *
+               MmNchwcBlockedChannels(Parameters->InChannel) * KernelSize;
+    }
+
+    return 0;
+}
+
+void
+MmConvPackFilter(
+        const MM_CONV_PARAMS* Parameters,
+        bool Nhwc,
+        const float* Weight,
+        float* PackedFilter
+)
+{
+    const size_t PackedGroupSize = MmConvPackedFilterSize(Parameters, Nhwc) / Parameters->GroupCount;
+    const size_t FilterGroupSize = Parameters->FilterCount * Parameters->K;
+
+    for (size_t group = 0; group < Parameters->GroupCount; ++group) {
+        if (Nhwc) {
+            MmConvNhwcReorderFilter(Parameters, Weight, PackedFilter);
+        } else {
+            MmReorderFilterNchwc(Parameters, Weight, PackedFilter);
+        }
+
+        Weight += FilterGroupSize;
+        PackedFilter += PackedGroupSize;
+    }
+}
+
+}
@@ -0,0 +1,399 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "mmpack_.h"
+#include <algorithm>
+
+namespace mmpack {
+
+struct MM_CONV_GEOMETRY {
+    size_t InputHeight;
+    size_t InputWidth;
+    size_t OutputWidth;
+    size_t KernelHeight;
+    size_t KernelWidth;
+    size_t StrideHeight;
+    size_t StrideWidth;
+    size_t DilationHeight;
+    size_t DilationWidth;
+    size_t PaddingTop;
+    size_t PaddingLeft;
+};
+
+MM_CONV_GEOMETRY
+MmConvGeometry(
+        const MM_CONV_PARAMS* Parameters
+)
+/*++
+
+Описание процедуры:
+
+    Приводит параметры 1D и 2D свертки к общему 2D виду: 1D свертка - это 2D свертка
+    с единичной высотой входа, ядра, шага и расширения.
+
+--*/
+{
+    MM_CONV_GEOMETRY Geometry;
+
+    if (Parameters->Dimensions == 1) {
+        Geometry.InputHeight = 1;
+        Geometry.InputWidth = Parameters->InShape[0];
+        Geometry.OutputWidth = Parameters->OutShape[0];
+        Geometry.KernelHeight = 1;
+        Geometry.KernelWidth = Parameters->KernelShape[0];
+        Geometry.StrideHeight = 1;
+        Geometry.StrideWidth = Parameters->StrideShape[0];
+        Geometry.DilationHeight = 1;
+        Geometry.DilationWidth = Parameters->DilationShape[0];
+        Geometry.PaddingTop = 0;
+        Geometry.PaddingLeft = Parameters->Padding[0];
+    } else {
+        Geometry.InputHeight = Parameters->InShape[0];
+        Geometry.InputWidth = Parameters->InShape[1];
+        Geometry.OutputWidth = Parameters->OutShape[1];
+        Geometry.KernelHeight = Parameters->KernelShape[0];
+        Geometry.KernelWidth = Parameters->KernelShape[1];
+        Geometry.StrideHeight = Parameters->StrideShape[0];
+        Geometry.StrideWidth = Parameters->StrideShape[1];
+        Geometry.DilationHeight = Parameters->DilationShape[0];
+        Geometry.DilationWidth = Parameters->DilationShape[1];
+        Geometry.PaddingTop = Parameters->Padding[0];
+        Geometry.PaddingLeft = Parameters->Padding[1];
+    }
+
+    return Geometry;
+}
+
+size_t
+MmConvBackwardColumnCount(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    size_t CountN = MM_CONV_BACKWARD_COLUMN_ELEMENTS / Parameters->K;
+
+    if (CountN == 0) {
+        CountN = 1;
+    }
+
+    if (CountN > Parameters->OutSize) {
+        CountN = Parameters->OutSize;
+    }
+
+    return CountN;
+}
+
+size_t
+MmConvBackwardBufferSize(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    return Parameters->K * MmConvBackwardColumnCount(Parameters);
+}
+
+void
+MmConvCol2Im(
+        const MM_CONV_PARAMS* Parameters,
+        const float* ColumnBuffer,
+        float* InputGrad,
+        size_t n,
+        size_t CountN
+)
+/*++
+
+Описание процедуры:
+
+    Операция, обратная Im2Col: прибавляет столбцы [n, n + CountN) матрицы
+    размера K x CountN к градиенту входа одной группы. Точки, попадающие в
+    заполнение, отбрасываются. При шаге 1 и 2 строка столбцов суммируется
+    со строкой входа векторно.
+
+--*/
+{
+    const MM_CONV_GEOMETRY Geometry = MmConvGeometry(Parameters);
+    const size_t InputSize = Parameters->InSize;
+    const size_t KernelSize = Geometry.KernelHeight * Geometry.KernelWidth;
+
+    for (size_t k = 0; k < Parameters->K; ++k) {
+
+        const size_t c = k / KernelSize;
+        const size_t ky = (k / Geometry.KernelWidth) % Geometry.KernelHeight;
+        const size_t kx = k % Geometry.KernelWidth;
+
+        float* InputChannel = InputGrad + c * InputSize;
+        const float* Column = ColumnBuffer + k * CountN;
+
+        size_t Position = n;
+        size_t RemainingN = CountN;
+
+        while (RemainingN > 0) {
+
+            const size_t oy = Position / Geometry.OutputWidth;
+            const size_t ox = Position % Geometry.OutputWidth;
+
+            size_t CountX = Geometry.OutputWidth - ox;
+
+            if (CountX > RemainingN) {
+                CountX = RemainingN;
+            }
+
+            const size_t InputY = oy * Geometry.StrideHeight + ky * Geometry.DilationHeight - Geometry.PaddingTop;
+
+            if (InputY < Geometry.InputHeight) {
+
+                float* InputRow = InputChannel + InputY * Geometry.InputWidth;
+                const ptrdiff_t OriginX = ptrdiff_t(ox * Geometry.StrideWidth + kx * Geometry.DilationWidth) -
+                                          ptrdiff_t(Geometry.PaddingLeft);
+
+                if (Geometry.StrideWidth == 1) {
+
+                    ptrdiff_t Begin = OriginX < 0 ? -OriginX : 0;
+                    ptrdiff_t End = ptrdiff_t(Geometry.InputWidth) - OriginX;
+
+                    if (End > ptrdiff_t(CountX)) {
+                        End = ptrdiff_t(CountX);
+                    }
+
+                    ptrdiff_t j = Begin;
+
+                    for (; j + 4 <= End; j += 4) {
+                        float* Target = InputRow + OriginX + j;
+                        MmStoreFloat32x4<std::false_type>(Target,
+                                MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(Target),
+                                               MmLoadFloat32x4<std::false_type>(Column + j)));
+                    }
+
+                    for (; j < End; ++j) {
+                        InputRow[OriginX + j] += Column[j];
+                    }
+
+                } else if (Geometry.StrideWidth == 2) {
+
+                    //
+                    // Шаг 2: четыре столбца раскладываются через один в восемь точек строки.
+                    //
+
+                    ptrdiff_t Begin = OriginX < 0 ? (1 - OriginX) / 2 : 0;
+                    ptrdiff_t End = (ptrdiff_t(Geometry.InputWidth) - OriginX + 1) / 2;
+
+                    if (End > ptrdiff_t(CountX)) {
+                        End = ptrdiff_t(CountX);
+                    }
+
+                    ptrdiff_t j = Begin;
+                    const Mm_Float32x4 ZeroFloat32x4 = MmSetZeroFloat32x4();
+
+                    for (; j + 4 <= End && OriginX + 2 * j + 8 <= ptrdiff_t(Geometry.InputWidth); j += 4) {
+                        float* Target = InputRow + OriginX + 2 * j;
+                        const Mm_Float32x4 Values = MmLoadFloat32x4<std::false_type>(Column + j);
+
+                        MmStoreFloat32x4<std::false_type>(Target,
+                                MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(Target),
+                                               MmUnpackInterleaveLowFloat32x4(Values, ZeroFloat32x4)));
+                        MmStoreFloat32x4<std::false_type>(Target + 4,
+                                MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(Target + 4),
+                                               MmUnpackInterleaveHighFloat32x4(Values, ZeroFloat32x4)));
+                    }
+
+                    for (; j < End; ++j) {
+                        InputRow[OriginX + 2 * j] += Column[j];
+                    }
+
+                } else {
+
+                    size_t InputX = size_t(OriginX);
+
+                    for (size_t j = 0; j < CountX; ++j) {
+                        if (InputX < Geometry.InputWidth) {
+                            InputRow[InputX] += Column[j];
+                        }
+                        InputX += Geometry.StrideWidth;
+                    }
+                }
+            }
+
+            Column += CountX;
+            Position += CountX;
+            RemainingN -= CountX;
+        }
+    }
+}
+
+float
+MmConvReduceSum(
+        const float* Buffer,
+        size_t N
+)
+{
+    Mm_Float32x4 Accumulator0 = MmSetZeroFloat32x4();
+    Mm_Float32x4 Accumulator1 = MmSetZeroFloat32x4();
+
+    size_t i = 0;
+
+    for (; i + 8 <= N; i += 8) {
+        Accumulator0 = MmAddFloat32x4(Accumulator0, MmLoadFloat32x4<std::false_type>(Buffer + i));
+        Accumulator1 = MmAddFloat32x4(Accumulator1, MmLoadFloat32x4<std::false_type>(Buffer + i + 4));
+    }
+
+    alignas(16) float Lanes[4];
+    MmStoreFloat32x4<std::true_type>(Lanes, MmAddFloat32x4(Accumulator0, Accumulator1));
+
+    float Sum = (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+
+    for (; i < N; ++i) {
+        Sum += Buffer[i];
+    }
+
+    return Sum;
+}
+
+void
+MmConvBackwardDataOp(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Weight,
+        const float* OutputGrad,
+        float* InputGrad,
+        float* TemporaryBuffer
+)
+/*++
+
+Описание процедуры:
+
+    dX += Col2Im(W^T * dY) для одной группы. Это же прямой проход транспонированной свертки.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutSize;
+    const size_t K = Parameters->K;
+    const size_t StrideN = MmConvBackwardColumnCount(Parameters);
+
+    for (size_t n = 0; n < OutputSize; n += StrideN) {
+
+        size_t CountN = OutputSize - n;
+
+        if (CountN > StrideN) {
+            CountN = StrideN;
+        }
+
+        MmGemm(CblasTrans, CblasNoTrans, K, CountN, FilterCount, 1.0f,
+               Weight, K, OutputGrad + n, OutputSize, 0.0f,
+               TemporaryBuffer, CountN);
+
+        MmConvCol2Im(Parameters, TemporaryBuffer, InputGrad, n, CountN);
+    }
+}
+
+void
+MmConvBackwardFilterOp(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* OutputGrad,
+        float* WeightGrad,
+        float* TemporaryBuffer
+)
+/*++
+
+Описание процедуры:
+
+    dW += dY * Im2Col(X)^T для одной группы.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutSize;
+    const size_t K = Parameters->K;
+    const size_t StrideN = MmConvBackwardColumnCount(Parameters);
+
+    for (size_t n = 0; n < OutputSize; n += StrideN) {
+
+        size_t CountN = OutputSize - n;
+
+        if (CountN > StrideN) {
+            CountN = StrideN;
+        }
+
+        if (Parameters->Dimensions == 1) {
+            MmConvIm2Col1D(Parameters, Input, TemporaryBuffer, 0, K, n, CountN);
+        } else {
+            MmConvIm2Col(Parameters, Input, TemporaryBuffer, 0, K, n, CountN);
+        }
+
+        MmGemm(CblasNoTrans, CblasTrans, FilterCount, K, CountN, 1.0f,
+               OutputGrad + n, OutputSize, TemporaryBuffer, CountN, 1.0f,
+               WeightGrad, K);
+    }
+}
+
+void
+MmConvBackward(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weight,
+        const float* OutputGrad,
+        float* InputGrad,
+        float* WeightGrad,
+        float* BiasGrad,
+        float* TemporaryBuffer,
+        size_t Group
+)
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutSize;
+    const size_t K = Parameters->K;
+
+    const size_t InputGroupOffset = Group * Parameters->InChannel * Parameters->InSize;
+    const size_t OutputGroupOffset = Group * FilterCount * OutputSize;
+    const size_t FilterGroupOffset = Group * FilterCount * K;
+
+    OutputGrad += OutputGroupOffset;
+
+    if (BiasGrad != nullptr) {
+        BiasGrad += Group * FilterCount;
+
+        for (size_t f = 0; f < FilterCount; ++f) {
+            BiasGrad[f] += MmConvReduceSum(OutputGrad + f * OutputSize, OutputSize);
+        }
+    }
+
+    if (WeightGrad != nullptr) {
+        MmConvBackwardFilterOp(Parameters, Input + InputGroupOffset, OutputGrad,
+                               WeightGrad + FilterGroupOffset, TemporaryBuffer);
+    }
+
+    if (InputGrad != nullptr) {
+        MmConvBackwardDataOp(Parameters, Weight + FilterGroupOffset, OutputGrad,
+                             InputGrad + InputGroupOffset, TemporaryBuffer);
+    }
+}
+
+void
+MmConvTranspose(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Weight,
+        const float* Bias,
+        float* TemporaryBuffer,
+        float* Output
+)
+{
+    const size_t OutputChannel = Parameters->InChannel * Parameters->GroupCount;
+    const size_t OutputSize = Parameters->InSize;
+
+    std::fill_n(Output, OutputChannel * OutputSize, 0.0f);
+
+    for (size_t group = 0; group < Parameters->GroupCount; ++group) {
+        MmConvBackwardDataOp(Parameters,
+                             Weight + group * Parameters->FilterCount * Parameters->K,
+                             Input + group * Parameters->FilterCount * Parameters->OutSize,
+                             Output + group * Parameters->InChannel * OutputSize,
+                             TemporaryBuffer);
+    }
+
+    if (Bias != nullptr) {
+        MmConvAddBias(Bias, Output, OutputChannel, OutputSize, OutputSize);
+    }
+}
+
+}
@@ -0,0 +1,158 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "mmpack_.h"
+#include <algorithm>
+
+namespace mmpack {
+
+size_t
+MmConvPoolRowCount(
+        const MM_CONV_PARAMS* Parameters,
+        const MM_POOL_PARAMS* PoolParameters,
+        size_t PoolRowCount
+)
+/*++
+
+Описание процедуры:
+
+    Возвращает верхнюю границу кол-ва строк выхода свертки, которые покрывают PoolRowCount
+    подряд идущих строк выхода max pooling'а.
+
+--*/
+{
+    const size_t RowCount = (PoolRowCount - 1) * PoolParameters->StrideShape[0] + PoolParameters->KernelShape[0];
+    return std::min(RowCount, Parameters->OutShape[0]);
+}
+
+size_t
+MmConvPoolRowRange(
+        const MM_POOL_PARAMS* PoolParameters,
+        size_t StartY,
+        size_t CountY,
+        size_t* StartRow
+)
+/*++
+
+Описание процедуры:
+
+    Возвращает кол-во и первую строку (StartRow) выхода свертки, которые читают окна строк
+    [StartY, StartY + CountY) выхода max pooling'а с учетом заполнения.
+
+--*/
+{
+    const ptrdiff_t Begin = ptrdiff_t(StartY * PoolParameters->StrideShape[0]) - ptrdiff_t(PoolParameters->Padding[0]);
+    const ptrdiff_t End = ptrdiff_t((StartY + CountY - 1) * PoolParameters->StrideShape[0] + PoolParameters->KernelShape[0]) -
+                          ptrdiff_t(PoolParameters->Padding[0]);
+
+    *StartRow = size_t(std::max<ptrdiff_t>(Begin, 0));
+    return size_t(std::min<ptrdiff_t>(End, ptrdiff_t(PoolParameters->InShape[0]))) - *StartRow;
+}
+
+size_t
+MmConvPoolTileRows(
+        const MM_CONV_PARAMS* Parameters,
+        const MM_POOL_PARAMS* PoolParameters
+)
+/*++
+
+Описание процедуры:
+
+    Выбирает кол-во строк выхода max pooling'а в одном тайле так, чтобы тайл выхода
+    свертки по всем каналам помещался в MM_CONV_POOL_TILE_ELEMENTS. Тайл содержит
+    хотя бы одну строку.
+
+--*/
+{
+    const size_t RowElements = Parameters->GroupCount * Parameters->FilterCount * Parameters->OutShape[1];
+    const size_t PoolHeight = PoolParameters->OutShape[0];
+
+    size_t TileRows = 1;
+
+    while (TileRows < PoolHeight &&
+           MmConvPoolRowCount(Parameters, PoolParameters, TileRows + 1) * RowElements <= MM_CONV_POOL_TILE_ELEMENTS) {
+        TileRows++;
+    }
+
+    return TileRows;
+}
+
+size_t
+MmConvPoolBufferSize(
+        const MM_CONV_PARAMS* Parameters,
+        const MM_POOL_PARAMS* PoolParameters
+)
+{
+    const size_t RowElements = Parameters->GroupCount * Parameters->FilterCount * Parameters->OutShape[1];
+    const size_t TileRows = MmConvPoolTileRows(Parameters, PoolParameters);
+
+    return MM_SGEMM_STRIDE_N * MM_SGEMM_STRIDE_K +
+           MmConvPoolRowCount(Parameters, PoolParameters, TileRows) * RowElements;
+}
+
+void
+MmConvPool(
+        const MM_CONV_PARAMS* Parameters,
+        const MM_POOL_PARAMS* PoolParameters,
+        MmActivationHolder* Activations,
+        size_t ActivationCount,
+        const float* Input,
+        const float* Weight,
+        const float* Bias,
+        float* TemporaryBuffer,
+        float* Output
+)
+{
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t ChannelCount = GroupCount * FilterCount;
+    const size_t OutputWidth = Parameters->OutShape[1];
+
+    const size_t PoolHeight = PoolParameters->OutShape[0];
+    const size_t PoolWidth = PoolParameters->OutShape[1];
+    const size_t PoolSize = PoolHeight * PoolWidth;
+
+    const size_t SpatialInputGroupSize = Parameters->InChannel * Parameters->InSize;
+    const size_t FilterGroupSize = FilterCount * Parameters->K;
+
+    float* ColumnBuffer = TemporaryBuffer;
+    float* Tile = TemporaryBuffer + MM_SGEMM_STRIDE_N * MM_SGEMM_STRIDE_K;
+
+    const size_t TileRows = MmConvPoolTileRows(Parameters, PoolParameters);
+
+    for (size_t py = 0; py < PoolHeight; py += TileRows) {
+
+        const size_t CountY = std::min(TileRows, PoolHeight - py);
+        size_t StartRow;
+        const size_t RowCount = MmConvPoolRowRange(PoolParameters, py, CountY, &StartRow);
+        const size_t TileSize = RowCount * OutputWidth;
+
+        /*
+         * Строки [StartRow, StartRow + RowCount) выхода свертки всех групп: [Cout][RowCount][Wout].
+         */
+        for (size_t group = 0; group < GroupCount; ++group) {
+            MmConvOp(Parameters,
+                     Input + group * SpatialInputGroupSize,
+                     Weight + group * FilterGroupSize,
+                     Bias != nullptr ? Bias + group * FilterCount : nullptr,
+                     ColumnBuffer,
+                     Tile + group * FilterCount * TileSize,
+                     TileSize,
+                     StartRow * OutputWidth,
+                     TileSize);
+        }
+
+        for (size_t i = 0; i < ActivationCount; ++i) {
+            MmActivation(&Activations[i], Tile, ChannelCount, TileSize, TileSize);
+        }
+
+        for (size_t c = 0; c < ChannelCount; ++c) {
+            MmMaxPoolRows(PoolParameters, Tile + c * TileSize, StartRow,
+                          Output + c * PoolSize + py * PoolWidth, py, CountY);
+        }
+    }
+}
+
+} // mmpack
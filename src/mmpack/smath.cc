@@ -0,0 +1,90 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "smath_.h"
+#include <cstring>
+
+namespace mmpack {
+
+#if defined(MM_USE_SSE)
+
+template<Mm_Float32x4 (*Function)(const Mm_Float32x4&)>
+void
+MmMathKernel(
+        const float* Input,
+        float* Output,
+        size_t N
+)
+{
+    while (N >= 4) {
+        MmStoreFloat32x4<std::false_type>(Output, Function(MmLoadFloat32x4<std::false_type>(Input)));
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    // Хвост считается тем же векторным ядром, чтобы результат не зависел от позиции элемента
+    if (N > 0) {
+        float Buffer[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        memcpy(Buffer, Input, N * sizeof(float));
+        MmStoreFloat32x4<std::false_type>(Buffer, Function(MmLoadFloat32x4<std::false_type>(Buffer)));
+        memcpy(Output, Buffer, N * sizeof(float));
+    }
+}
+
+#endif
+
+#if defined(MM_USE_SSE)
+#define MM_MATH_ROUTINE(Kernel, Scalar)                     \
+    MmMathKernel<Kernel>(Input, Output, N);
+#else
+#define MM_MATH_ROUTINE(Kernel, Scalar)                     \
+    for (size_t i = 0; i < N; ++i) {                        \
+        const float x = Input[i];                           \
+        Output[i] = (Scalar);                               \
+    }
+#endif
+
+void
+MmExp(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmExpFloat32x4, std::exp(x))
+}
+
+void
+MmLog(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmLogFloat32x4, std::log(x))
+}
+
+void
+MmTanh(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmTanhFloat32x4, std::tanh(x))
+}
+
+void
+MmSigmoid(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmSigmoidFloat32x4, 1.0f / (1.0f + std::exp(-x)))
+}
+
+void
+MmErf(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmErfFloat32x4, std::erf(x))
+}
+
+void
+MmAcos(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmAcosFloat32x4, std::acos(x))
+}
+
+void
+MmSqrt(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmSqrtFloat32x4, std::sqrt(x))
+}
+
+void
+MmRsqrt(const float* Input, float* Output, size_t N) {
+    MM_MATH_ROUTINE(MmRsqrtFloat32x4, 1.0f / std::sqrt(x))
+}
+
+} // mmpack
@@ -0,0 +1,214 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_SMATH__H
+#define XSDNN_SMATH__H
+
+#include "mmpack_.h"
+#include <cmath>
+
+namespace mmpack {
+
+#if defined(MM_USE_SSE)
+
+/*
+ * Векторные ядра элементарных функций. Полиномы - cephes (exp, log, tanh, acos) и
+ * минимаксные приближения erf; оценки точности приведены в mmpack.h. Файлы, которые
+ * используют ядра, собираются без -ffast-math (см. xsdnn_mmpack.cmake).
+ */
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmAbsFloat32x4(const Mm_Float32x4& Vector) {
+    return MmAndNotFloat32x4(MmBroadcastFloat32x4(-0.0f), Vector);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmExpFloat32x4(const Mm_Float32x4& Input) {
+    Mm_Float32x4 Vector;
+
+    // exp(x) = 2^n * exp(r), n = round(x / ln2), r = x - n * ln2 (ln2 разбит на две части)
+    Vector = MmMinimumFloat32x4(Input, MmBroadcastFloat32x4(88.7228394f));
+    Vector = MmMaximumFloat32x4(Vector, MmBroadcastFloat32x4(-103.972076f));
+
+    const Mm_Int32x4 N = MmConvertFloat32x4ToInt32x4(MmMultiplyFloat32x4(Vector, MmBroadcastFloat32x4(1.44269504088896341f)));
+    const Mm_Float32x4 Nf = MmConvertInt32x4ToFloat32x4(N);
+
+    Mm_Float32x4 R = MmSubtractFloat32x4(Vector, MmMultiplyFloat32x4(Nf, MmBroadcastFloat32x4(0.693359375f)));
+    R = MmSubtractFloat32x4(R, MmMultiplyFloat32x4(Nf, MmBroadcastFloat32x4(-2.12194440e-4f)));
+
+    Mm_Float32x4 P = MmBroadcastFloat32x4(1.9875691500E-4f);
+    P = MmMultiplyAddFloat32x4(P, R, MmBroadcastFloat32x4(1.3981999507E-3f));
+    P = MmMultiplyAddFloat32x4(P, R, MmBroadcastFloat32x4(8.3334519073E-3f));
+    P = MmMultiplyAddFloat32x4(P, R, MmBroadcastFloat32x4(4.1665795894E-2f));
+    P = MmMultiplyAddFloat32x4(P, R, MmBroadcastFloat32x4(1.6666665459E-1f));
+    P = MmMultiplyAddFloat32x4(P, R, MmBroadcastFloat32x4(5.0000001201E-1f));
+    P = MmMultiplyAddFloat32x4(P, MmMultiplyFloat32x4(R, R), MmAddFloat32x4(R, MmBroadcastFloat32x4(1.0f)));
+
+    // 2^n собирается из двух множителей, чтобы n из [-150, 128] не выходил за поле порядка
+    const Mm_Int32x4 N1 = MmShiftRightInt32x4<1>(N);
+    const Mm_Int32x4 N2 = MmSubtractInt32x4(N, N1);
+    const Mm_Int32x4 Bias = MmBroadcastInt32x4(127);
+    P = MmMultiplyFloat32x4(P, MmCastToFloat32x4(MmShiftLeftInt32x4<23>(MmAddInt32x4(N1, Bias))));
+    P = MmMultiplyFloat32x4(P, MmCastToFloat32x4(MmShiftLeftInt32x4<23>(MmAddInt32x4(N2, Bias))));
+
+    P = MmBlendFloat32x4(P, MmBroadcastFloat32x4(INFINITY),
+                         MmGreaterThanFloat32x4(Input, MmBroadcastFloat32x4(88.7228394f)));
+    P = MmAndNotFloat32x4(MmLessThanFloat32x4(Input, MmBroadcastFloat32x4(-103.972076f)), P);
+    return MmBlendFloat32x4(P, Input, MmUnorderedFloat32x4(Input, Input));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmLogFloat32x4(const Mm_Float32x4& Input) {
+    // Денормализованные числа нормализуются умножением на 2^23
+    const Mm_Float32x4 Denormal = MmLessThanFloat32x4(Input, MmBroadcastFloat32x4(1.17549435e-38f));
+    const Mm_Float32x4 Vector = MmBlendFloat32x4(Input, MmMultiplyFloat32x4(Input, MmBroadcastFloat32x4(8388608.0f)), Denormal);
+
+    // x = m * 2^e, m из [0.5, 1)
+    const Mm_Int32x4 Bits = MmCastToInt32x4(Vector);
+    Mm_Float32x4 E = MmConvertInt32x4ToFloat32x4(
+            MmSubtractInt32x4(MmShiftRightInt32x4<23>(Bits), MmBroadcastInt32x4(126)));
+    E = MmSubtractFloat32x4(E, MmAndFloat32x4(Denormal, MmBroadcastFloat32x4(23.0f)));
+    Mm_Float32x4 M = MmCastToFloat32x4(MmOrInt32x4(MmAndInt32x4(Bits, MmBroadcastInt32x4(0x007fffff)),
+                                                   MmBroadcastInt32x4(0x3f000000)));
+
+    // m < sqrt(1/2): m = 2m - 1, e = e - 1; иначе m = m - 1
+    const Mm_Float32x4 Small = MmLessThanFloat32x4(M, MmBroadcastFloat32x4(0.707106781186547524f));
+    const Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+    E = MmSubtractFloat32x4(E, MmAndFloat32x4(Small, One));
+    M = MmSubtractFloat32x4(MmAddFloat32x4(M, MmAndFloat32x4(Small, M)), One);
+
+    const Mm_Float32x4 Z = MmMultiplyFloat32x4(M, M);
+    Mm_Float32x4 Y = MmBroadcastFloat32x4(7.0376836292E-2f);
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(-1.1514610310E-1f));
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(1.1676998740E-1f));
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(-1.2420140846E-1f));
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(1.4249322787E-1f));
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(-1.6668057665E-1f));
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(2.0000714765E-1f));
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(-2.4999993993E-1f));
+    Y = MmMultiplyAddFloat32x4(Y, M, MmBroadcastFloat32x4(3.3333331174E-1f));
+    Y = MmMultiplyFloat32x4(MmMultiplyFloat32x4(Y, M), Z);
+
+    Y = MmMultiplyAddFloat32x4(E, MmBroadcastFloat32x4(-2.12194440e-4f), Y);
+    Y = MmMultiplyAddFloat32x4(Z, MmBroadcastFloat32x4(-0.5f), Y);
+    Mm_Float32x4 Result = MmAddFloat32x4(M, Y);
+    Result = MmMultiplyAddFloat32x4(E, MmBroadcastFloat32x4(0.693359375f), Result);
+
+    // log(0) = -inf, log(+inf) = +inf, log(x < 0) = NaN
+    const Mm_Float32x4 Zero = MmSetZeroFloat32x4();
+    Result = MmBlendFloat32x4(Result, MmBroadcastFloat32x4(-INFINITY), MmEqualFloat32x4(Input, Zero));
+    Result = MmBlendFloat32x4(Result, Input, MmEqualFloat32x4(Input, MmBroadcastFloat32x4(INFINITY)));
+    Result = MmBlendFloat32x4(Result, MmBroadcastFloat32x4(NAN), MmLessThanFloat32x4(Input, Zero));
+    return MmBlendFloat32x4(Result, Input, MmUnorderedFloat32x4(Input, Input));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmTanhFloat32x4(const Mm_Float32x4& Vector) {
+    const Mm_Float32x4 Sign = MmAndFloat32x4(Vector, MmBroadcastFloat32x4(-0.0f));
+    const Mm_Float32x4 Abs = MmAbsFloat32x4(Vector);
+
+    // |x| < 0.625: x + x^3 * P(x^2)
+    const Mm_Float32x4 Z = MmMultiplyFloat32x4(Vector, Vector);
+    Mm_Float32x4 P = MmBroadcastFloat32x4(-5.70498872745E-3f);
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(2.06390887954E-2f));
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(-5.37397155531E-2f));
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(1.33314422036E-1f));
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(-3.33332819422E-1f));
+    const Mm_Float32x4 Small = MmMultiplyAddFloat32x4(MmMultiplyFloat32x4(P, Z), Vector, Vector);
+
+    // Иначе 1 - 2 / (exp(2|x|) + 1) со знаком x
+    const Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+    const Mm_Float32x4 Exp = MmExpFloat32x4(MmAddFloat32x4(Abs, Abs));
+    Mm_Float32x4 Large = MmSubtractFloat32x4(One, MmDivideFloat32x4(MmBroadcastFloat32x4(2.0f), MmAddFloat32x4(Exp, One)));
+    Large = MmOrFloat32x4(Large, Sign);
+
+    return MmBlendFloat32x4(Large, Small, MmLessThanFloat32x4(Abs, MmBroadcastFloat32x4(0.625f)));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmSigmoidFloat32x4(const Mm_Float32x4& Vector) {
+    const Mm_Float32x4 One = MmBroadcastFloat32x4(1.0f);
+    const Mm_Float32x4 Exp = MmExpFloat32x4(MmXorFloat32x4(Vector, MmBroadcastFloat32x4(-0.0f)));
+    return MmDivideFloat32x4(One, MmAddFloat32x4(One, Exp));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmErfFloat32x4(const Mm_Float32x4& Vector) {
+    const Mm_Float32x4 Sign = MmAndFloat32x4(Vector, MmBroadcastFloat32x4(-0.0f));
+    const Mm_Float32x4 Abs = MmAbsFloat32x4(Vector);
+    const Mm_Float32x4 Square = MmMultiplyFloat32x4(Vector, Vector);
+
+    // |x| <= 0.927734375: x + x * P(x^2)
+    Mm_Float32x4 P = MmBroadcastFloat32x4(-5.96761703e-4f);
+    P = MmMultiplyAddFloat32x4(P, Square, MmBroadcastFloat32x4(4.99119423e-3f));
+    P = MmMultiplyAddFloat32x4(P, Square, MmBroadcastFloat32x4(-2.67681349e-2f));
+    P = MmMultiplyAddFloat32x4(P, Square, MmBroadcastFloat32x4(1.12819925e-1f));
+    P = MmMultiplyAddFloat32x4(P, Square, MmBroadcastFloat32x4(-3.76125336e-1f));
+    P = MmMultiplyAddFloat32x4(P, Square, MmBroadcastFloat32x4(1.28379166e-1f));
+    const Mm_Float32x4 Small = MmMultiplyAddFloat32x4(P, Vector, Vector);
+
+    // Иначе 1 - exp(Q(|x|)) со знаком x
+    Mm_Float32x4 Q = MmMultiplyAddFloat32x4(MmBroadcastFloat32x4(-1.72853470e-5f), Abs, MmBroadcastFloat32x4(3.83197126e-4f));
+    const Mm_Float32x4 U = MmMultiplyAddFloat32x4(MmBroadcastFloat32x4(-3.88396438e-3f), Abs, MmBroadcastFloat32x4(2.42546219e-2f));
+    Q = MmMultiplyAddFloat32x4(Q, Square, U);
+    Q = MmMultiplyAddFloat32x4(Q, Abs, MmBroadcastFloat32x4(-1.06777877e-1f));
+    Q = MmMultiplyAddFloat32x4(Q, Abs, MmBroadcastFloat32x4(-6.34846687e-1f));
+    Q = MmMultiplyAddFloat32x4(Q, Abs, MmBroadcastFloat32x4(-1.28717512e-1f));
+    Q = MmSubtractFloat32x4(MmMultiplyFloat32x4(Q, Abs), Abs);
+    Mm_Float32x4 Large = MmSubtractFloat32x4(MmBroadcastFloat32x4(1.0f), MmExpFloat32x4(Q));
+    Large = MmOrFloat32x4(Large, Sign);
+
+    const Mm_Float32x4 Result = MmBlendFloat32x4(Large, Small,
+                                                 MmGreaterThanFloat32x4(MmBroadcastFloat32x4(0.927734375f), Abs));
+    return MmBlendFloat32x4(Result, Vector, MmUnorderedFloat32x4(Vector, Vector));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmAcosFloat32x4(const Mm_Float32x4& Vector) {
+    const Mm_Float32x4 Abs = MmAbsFloat32x4(Vector);
+    const Mm_Float32x4 Half = MmBroadcastFloat32x4(0.5f);
+    const Mm_Float32x4 Large = MmGreaterThanFloat32x4(Abs, Half);
+
+    // |x| > 0.5: asin считается от s = sqrt((1 - |x|) / 2), иначе от x
+    const Mm_Float32x4 ZLarge = MmMultiplyFloat32x4(Half, MmSubtractFloat32x4(MmBroadcastFloat32x4(1.0f), Abs));
+    const Mm_Float32x4 Z = MmBlendFloat32x4(MmMultiplyFloat32x4(Vector, Vector), ZLarge, Large);
+    const Mm_Float32x4 S = MmBlendFloat32x4(Vector, MmSqrtFloat32x4(ZLarge), Large);
+
+    Mm_Float32x4 P = MmBroadcastFloat32x4(4.2163199048E-2f);
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(2.4181311049E-2f));
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(4.5470025998E-2f));
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(7.4953002686E-2f));
+    P = MmMultiplyAddFloat32x4(P, Z, MmBroadcastFloat32x4(1.6666752422E-1f));
+    const Mm_Float32x4 Asin = MmMultiplyAddFloat32x4(MmMultiplyFloat32x4(P, Z), S, S);
+
+    // acos(x) = pi/2 - asin(x); при |x| > 0.5: 2 * asin(s) для x > 0 и pi - 2 * asin(s) для x < 0
+    const Mm_Float32x4 Twice = MmAddFloat32x4(Asin, Asin);
+    const Mm_Float32x4 Negative = MmLessThanFloat32x4(Vector, MmSetZeroFloat32x4());
+    const Mm_Float32x4 ResultLarge = MmBlendFloat32x4(Twice,
+                                                      MmSubtractFloat32x4(MmBroadcastFloat32x4(3.14159265358979f), Twice),
+                                                      Negative);
+    const Mm_Float32x4 ResultSmall = MmSubtractFloat32x4(MmBroadcastFloat32x4(1.57079632679490f), Asin);
+
+    return MmBlendFloat32x4(ResultSmall, ResultLarge, Large);
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmRsqrtFloat32x4(const Mm_Float32x4& Vector) {
+    return MmDivideFloat32x4(MmBroadcastFloat32x4(1.0f), MmSqrtFloat32x4(Vector));
+}
+
+#endif // MM_USE_SSE
+
+} // mmpack
+
+#endif //XSDNN_SMATH__H
@@ -0,0 +1,454 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "mmpack_.h"
+
+namespace mmpack {
+
+size_t
+MmNchwcGetBlockSize()
+{
+    return MM_NCHWC_BLOCK_SIZE;
+}
+
+size_t
+MmNchwcBlockedChannels(
+        size_t Channels
+)
+{
+    return (Channels + MM_NCHWC_BLOCK_SIZE - 1) & ~size_t(MM_NCHWC_BLOCK_SIZE - 1);
+}
+
+void
+MmReorderInputNchw(
+        const float* Source,
+        float* Destination,
+        size_t Channels,
+        size_t Size
+)
+{
+    constexpr size_t BlockSize = MM_NCHWC_BLOCK_SIZE;
+
+    for (size_t c = 0; c < Channels; c += BlockSize) {
+
+        const size_t CountC = (Channels - c) < BlockSize ? (Channels - c) : BlockSize;
+
+        const float* s = Source + c * Size;
+        size_t i = 0;
+
+        if (CountC == BlockSize) {
+
+            //
+            // Полный блок: читаем по 4 точки из 4 каналов и транспонируем.
+            //
+
+            for (; i + 4 <= Size; i += 4) {
+                Mm_Float32x4 Row0 = MmLoadFloat32x4<std::false_type>(s + 0 * Size + i);
+                Mm_Float32x4 Row1 = MmLoadFloat32x4<std::false_type>(s + 1 * Size + i);
+                Mm_Float32x4 Row2 = MmLoadFloat32x4<std::false_type>(s + 2 * Size + i);
+                Mm_Float32x4 Row3 = MmLoadFloat32x4<std::false_type>(s + 3 * Size + i);
+
+                MmTransposeFloat32x4x4(Row0, Row1, Row2, Row3);
+
+                MmStoreFloat32x4<std::false_type>(Destination + 0, Row0);
+                MmStoreFloat32x4<std::false_type>(Destination + 4, Row1);
+                MmStoreFloat32x4<std::false_type>(Destination + 8, Row2);
+                MmStoreFloat32x4<std::false_type>(Destination + 12, Row3);
+
+                Destination += 4 * BlockSize;
+            }
+        }
+
+        for (; i < Size; i++) {
+            size_t bc = 0;
+
+            for (; bc < CountC; bc++) {
+                Destination[bc] = s[bc * Size + i];
+            }
+
+            for (; bc < BlockSize; bc++) {
+                Destination[bc] = 0.0f;
+            }
+
+            Destination += BlockSize;
+        }
+    }
+}
+
+void
+MmReorderOutputNchw(
+        const float* Source,
+        float* Destination,
+        size_t Channels,
+        size_t Size
+)
+{
+    constexpr size_t BlockSize = MM_NCHWC_BLOCK_SIZE;
+
+    for (size_t c = 0; c < Channels; c += BlockSize) {
+
+        const size_t CountC = (Channels - c) < BlockSize ? (Channels - c) : BlockSize;
+
+        float* d = Destination + c * Size;
+        size_t i = 0;
+
+        if (CountC == BlockSize) {
+
+            for (; i + 4 <= Size; i += 4) {
+                Mm_Float32x4 Row0 = MmLoadFloat32x4<std::false_type>(Source + 0);
+                Mm_Float32x4 Row1 = MmLoadFloat32x4<std::false_type>(Source + 4);
+                Mm_Float32x4 Row2 = MmLoadFloat32x4<std::false_type>(Source + 8);
+                Mm_Float32x4 Row3 = MmLoadFloat32x4<std::false_type>(Source + 12);
+
+                MmTransposeFloat32x4x4(Row0, Row1, Row2, Row3);
+
+                MmStoreFloat32x4<std::false_type>(d + 0 * Size + i, Row0);
+                MmStoreFloat32x4<std::false_type>(d + 1 * Size + i, Row1);
+                MmStoreFloat32x4<std::false_type>(d + 2 * Size + i, Row2);
+                MmStoreFloat32x4<std::false_type>(d + 3 * Size + i, Row3);
+
+                Source += 4 * BlockSize;
+            }
+        }
+
+        for (; i < Size; i++) {
+            for (size_t bc = 0; bc < CountC; bc++) {
+                d[bc * Size + i] = Source[bc];
+            }
+
+            Source += BlockSize;
+        }
+    }
+}
+
+void
+MmReorderFilterNchwc(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Filter,
+        float* Destination
+)
+{
+    constexpr size_t BlockSize = MM_NCHWC_BLOCK_SIZE;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InChannel;
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+
+    const size_t BlockedFilterCount = MmNchwcBlockedChannels(FilterCount);
+    const size_t BlockedInputChannels = MmNchwcBlockedChannels(InputChannels);
+
+    for (size_t ob = 0; ob < BlockedFilterCount; ob += BlockSize) {
+        for (size_t ib = 0; ib < BlockedInputChannels; ib += BlockSize) {
+            for (size_t kpos = 0; kpos < KernelSize; kpos++) {
+                for (size_t ic = ib; ic < ib + BlockSize; ic++) {
+                    for (size_t oc = ob; oc < ob + BlockSize; oc++) {
+                        if (oc < FilterCount && ic < InputChannels) {
+                            *Destination++ = Filter[(oc * InputChannels + ic) * KernelSize + kpos];
+                        } else {
+                            *Destination++ = 0.0f;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<size_t PixelCount>
+void
+MmConvNchwcKernel(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Filter,
+        const Mm_Float32x4& Bias,
+        float* Output,
+        size_t oy,
+        size_t ox
+)
+/*++
+
+Описание процедуры:
+
+    Прямая свертка в формате NCHWc: вычисляет PixelCount соседних выходных
+    точек строки oy для одного блока выходных каналов. Вектор аккумулятора
+    соответствует блоку выходных каналов, поэтому умножение не требует
+    сбора данных между каналами.
+
+--*/
+{
+    constexpr size_t BlockSize = MM_NCHWC_BLOCK_SIZE;
+
+    const size_t InputHeight = Parameters->InShape[0];
+    const size_t InputWidth = Parameters->InShape[1];
+    const size_t InputSize = Parameters->InSize;
+
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+
+    const size_t BlockedInputChannels = MmNchwcBlockedChannels(Parameters->InChannel);
+
+    Mm_Float32x4 Accumulators[PixelCount];
+    size_t OriginInputX[PixelCount];
+
+    for (size_t t = 0; t < PixelCount; t++) {
+        Accumulators[t] = Bias;
+        OriginInputX[t] = (ox + t) * Parameters->StrideShape[1] - Parameters->Padding[1];
+    }
+
+    const size_t OriginInputY = oy * Parameters->StrideShape[0] - Parameters->Padding[0];
+
+    for (size_t ib = 0; ib < BlockedInputChannels; ib += BlockSize) {
+
+        const float* InputBlock = Input + ib * InputSize;
+
+        for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+            const size_t InputY = OriginInputY + ky * Parameters->DilationShape[0];
+
+            if (InputY >= InputHeight) {
+                Filter += KernelWidth * BlockSize * BlockSize;
+                continue;
+            }
+
+            const float* InputRow = InputBlock + InputY * InputWidth * BlockSize;
+
+            for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                Mm_Float32x4 F0 = MmLoadFloat32x4<std::false_type>(Filter + 0);
+                Mm_Float32x4 F1 = MmLoadFloat32x4<std::false_type>(Filter + 4);
+                Mm_Float32x4 F2 = MmLoadFloat32x4<std::false_type>(Filter + 8);
+                Mm_Float32x4 F3 = MmLoadFloat32x4<std::false_type>(Filter + 12);
+
+                const size_t KernelOffsetX = kx * Parameters->DilationShape[1];
+
+                for (size_t t = 0; t < PixelCount; t++) {
+
+                    const size_t InputX = OriginInputX[t] + KernelOffsetX;
+
+                    if (InputX >= InputWidth) {
+                        continue;
+                    }
+
+                    const float* Pixel = InputRow + InputX * BlockSize;
+
+                    Accumulators[t] = MmMultiplyAddFloat32x4(MmBroadcastFloat32x4(Pixel[0]), F0, Accumulators[t]);
+                    Accumulators[t] = MmMultiplyAddFloat32x4(MmBroadcastFloat32x4(Pixel[1]), F1, Accumulators[t]);
+                    Accumulators[t] = MmMultiplyAddFloat32x4(MmBroadcastFloat32x4(Pixel[2]), F2, Accumulators[t]);
+                    Accumulators[t] = MmMultiplyAddFloat32x4(MmBroadcastFloat32x4(Pixel[3]), F3, Accumulators[t]);
+                }
+
+                Filter += BlockSize * BlockSize;
+            }
+        }
+    }
+
+    for (size_t t = 0; t < PixelCount; t++) {
+        MmStoreFloat32x4<std::false_type>(Output + t * BlockSize, Accumulators[t]);
+    }
+}
+
+void
+MmConvNchwc(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Output
+)
+{
+    constexpr size_t BlockSize = MM_NCHWC_BLOCK_SIZE;
+    constexpr size_t PixelBlock = 4;
+
+    const size_t OutputHeight = Parameters->OutShape[0];
+    const size_t OutputWidth = Parameters->OutShape[1];
+    const size_t OutputSize = Parameters->OutSize;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t BlockedFilterCount = MmNchwcBlockedChannels(FilterCount);
+    const size_t FilterChannelSize = MmNchwcBlockedChannels(Parameters->InChannel) *
+                                     Parameters->KernelShape[0] * Parameters->KernelShape[1];
+
+    for (size_t ob = 0; ob < BlockedFilterCount; ob += BlockSize) {
+
+        MM_MAKE_ALIGN(float BiasBlock[BlockSize], 16) = { 0.0f };
+
+        if (Bias != nullptr) {
+            for (size_t bc = 0; bc < BlockSize && ob + bc < FilterCount; bc++) {
+                BiasBlock[bc] = Bias[ob + bc];
+            }
+        }
+
+        const Mm_Float32x4 BiasVector = MmLoadFloat32x4<std::true_type>(BiasBlock);
+        const float* FilterBlock = Filter + ob * FilterChannelSize;
+        float* OutputBlock = Output + ob * OutputSize;
+
+        for (size_t oy = 0; oy < OutputHeight; oy++) {
+
+            float* OutputRow = OutputBlock + oy * OutputWidth * BlockSize;
+            size_t ox = 0;
+
+            for (; ox + PixelBlock <= OutputWidth; ox += PixelBlock) {
+                MmConvNchwcKernel<PixelBlock>(Parameters, Input, FilterBlock, BiasVector,
+                                              OutputRow + ox * BlockSize, oy, ox);
+            }
+
+            for (; ox < OutputWidth; ox++) {
+                MmConvNchwcKernel<1>(Parameters, Input, FilterBlock, BiasVector,
+                                     OutputRow + ox * BlockSize, oy, ox);
+            }
+        }
+    }
+}
+
+size_t
+MmConvNchwcBufferSize(
+        const MM_CONV_PARAMS* Parameters
+)
+{
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+    const size_t BlockedInputChannels = MmNchwcBlockedChannels(Parameters->InChannel);
+    const size_t BlockedFilterCount = MmNchwcBlockedChannels(Parameters->FilterCount);
+
+    return BlockedInputChannels * Parameters->InSize +
+           BlockedFilterCount * BlockedInputChannels * KernelSize +
+           BlockedFilterCount * Parameters->OutSize;
+}
+
+void
+MmConvNchwcGroup(
+        const MM_CONV_PARAMS* Parameters,
+        bool InputBlocked,
+        bool OutputBlocked,
+        const float* Input,
+        const float* Filter,
+        const float* PackedFilter,
+        const float* Bias,
+        float* Buffer,
+        float* Output
+)
+/*++
+
+Описание процедуры:
+
+    Выполняет свертку одной группы через блочный формат NCHWc. Во временный буфер
+    переупорядочиваются только данные, которые пришли не в NCHWc: вход при
+    InputBlocked = false, фильтры при PackedFilter = nullptr, а при OutputBlocked = false
+    результат прямой свертки возвращается из буфера в формат NCHW.
+
+--*/
+{
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+    const size_t BlockedInputChannels = MmNchwcBlockedChannels(Parameters->InChannel);
+    const size_t BlockedFilterCount = MmNchwcBlockedChannels(Parameters->FilterCount);
+
+    const float* BlockedInput = Input;
+    float* BlockedOutput = Output;
+
+    if (!InputBlocked) {
+        MmReorderInputNchw(Input, Buffer, Parameters->InChannel, Parameters->InSize);
+        BlockedInput = Buffer;
+        Buffer += BlockedInputChannels * Parameters->InSize;
+    }
+
+    if (PackedFilter == nullptr) {
+        MmReorderFilterNchwc(Parameters, Filter, Buffer);
+        PackedFilter = Buffer;
+        Buffer += BlockedFilterCount * BlockedInputChannels * KernelSize;
+    }
+
+    if (!OutputBlocked) {
+        BlockedOutput = Buffer;
+    }
+
+    MmConvNchwc(Parameters, BlockedInput, PackedFilter, Bias, BlockedOutput);
+
+    if (!OutputBlocked) {
+        MmReorderOutputNchw(BlockedOutput, Output, Parameters->FilterCount, Parameters->OutSize);
+    }
+}
+
+void
+MmConvNchwcOp(
+        const MM_CONV_PARAMS* Parameters,
+        const float* Input,
+        const float* Filter,
+        const float* PackedFilter,
+        const float* Bias,
+        float* Buffer,
+        float* Output
+)
+/*++
+
+Описание процедуры:
+
+    Выполняет свертку одной группы в формате NCHW через блочный формат NCHWc:
+    вход переупорядочивается при каждом вызове, поэтому алгоритм NchwcDirect
+    выгоден только для тяжелых сверток. Цепочки сверток работают в NCHWc без
+    промежуточных переупорядочиваний через MmConvNchwcLayout.
+
+--*/
+{
+    MmConvNchwcGroup(Parameters, false, false, Input, Filter, PackedFilter, Bias, Buffer, Output);
+}
+
+size_t
+MmConvNchwcLayoutBufferSize(
+        const MM_CONV_PARAMS* Parameters,
+        bool InputBlocked,
+        bool OutputBlocked
+)
+{
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+    const size_t BlockedInputChannels = MmNchwcBlockedChannels(Parameters->InChannel);
+    const size_t BlockedFilterCount = MmNchwcBlockedChannels(Parameters->FilterCount);
+
+    size_t BufferSize = BlockedFilterCount * BlockedInputChannels * KernelSize;
+
+    if (!InputBlocked) {
+        BufferSize += BlockedInputChannels * Parameters->InSize;
+    }
+    if (!OutputBlocked) {
+        BufferSize += BlockedFilterCount * Parameters->OutSize;
+    }
+
+    return BufferSize;
+}
+
+void
+MmConvNchwcLayout(
+        const MM_CONV_PARAMS* Parameters,
+        bool InputBlocked,
+        bool OutputBlocked,
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Buffer,
+        float* Output
+)
+{
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+    const size_t PackedGroupSize = MmNchwcBlockedChannels(Parameters->FilterCount) *
+                                   MmNchwcBlockedChannels(Parameters->InChannel) * KernelSize;
+    const float* PackedFilter = Parameters->PackedFilter;
+
+    for (size_t group = 0; group < Parameters->GroupCount; ++group) {
+        MmConvNchwcGroup(Parameters, InputBlocked, OutputBlocked,
+                         Input, Filter, PackedFilter, Bias, Buffer, Output);
+
+        if (Bias != nullptr) {
+            Bias += Parameters->FilterCount;
+        }
+        if (PackedFilter != nullptr) {
+            PackedFilter += PackedGroupSize;
+        }
+
+        // Блочная группа занимает столько же, сколько в NCHW: кол-во каналов кратно блоку
+        Filter += Parameters->FilterCount * Parameters->K;
+        Input += Parameters->InChannel * Parameters->InSize;
+        Output += Parameters->FilterCount * Parameters->OutSize;
+    }
+}
+
+}
@@ -0,0 +1,263 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "mmpack_.h"
+#include <algorithm>
+
+namespace mmpack {
+
+/*
+ * Размер части данных, которая читается дважды (сумма, затем квадраты отклонений),
+ * пока лежит в L1 кэше.
+ */
+#define MM_MOMENTS_BLOCK_ELEMENTS 2048
+
+void
+MmMomentsBlock(
+        const float* Input,
+        size_t Count,
+        float* Mean,
+        float* SumSquares
+)
+/*++
+
+Описание процедуры:
+
+    Среднее и сумма квадратов отклонений от него для небольшого блока данных.
+
+--*/
+{
+    size_t i = 0;
+    float Sum = 0.0f;
+
+#if defined(MM_USE_SSE)
+    Mm_Float32x4 Sum0 = MmSetZeroFloat32x4();
+    Mm_Float32x4 Sum1 = MmSetZeroFloat32x4();
+
+    for (; i + 8 <= Count; i += 8) {
+        Sum0 = MmAddFloat32x4(Sum0, MmLoadFloat32x4<std::false_type>(Input + i));
+        Sum1 = MmAddFloat32x4(Sum1, MmLoadFloat32x4<std::false_type>(Input + i + 4));
+    }
+    Sum = MmUnpackValue(MmAddFloat32x4(Sum0, Sum1));
+#endif
+
+    for (; i < Count; ++i) {
+        Sum += Input[i];
+    }
+
+    const float BlockMean = Sum / float(Count);
+    float Squares = 0.0f;
+    i = 0;
+
+#if defined(MM_USE_SSE)
+    const Mm_Float32x4 MeanVector = MmBroadcastFloat32x4(BlockMean);
+    Mm_Float32x4 Squares0 = MmSetZeroFloat32x4();
+    Mm_Float32x4 Squares1 = MmSetZeroFloat32x4();
+
+    for (; i + 8 <= Count; i += 8) {
+        const Mm_Float32x4 Diff0 = MmSubtractFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i), MeanVector);
+        const Mm_Float32x4 Diff1 = MmSubtractFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i + 4), MeanVector);
+        Squares0 = MmMultiplyAddFloat32x4(Diff0, Diff0, Squares0);
+        Squares1 = MmMultiplyAddFloat32x4(Diff1, Diff1, Squares1);
+    }
+    Squares = MmUnpackValue(MmAddFloat32x4(Squares0, Squares1));
+#endif
+
+    for (; i < Count; ++i) {
+        const float Diff = Input[i] - BlockMean;
+        Squares += Diff * Diff;
+    }
+
+    *Mean = BlockMean;
+    *SumSquares = Squares;
+}
+
+void
+MmMomentsMerge(
+        size_t* Count,
+        float* Mean,
+        float* SumSquares,
+        size_t OtherCount,
+        float OtherMean,
+        float OtherSumSquares
+)
+{
+    if (OtherCount == 0) {
+        return;
+    }
+
+    // Формула Чана для объединения статистик двух непересекающихся наборов
+    const size_t Total = *Count + OtherCount;
+    const float Delta = OtherMean - *Mean;
+    const float Weight = float(OtherCount) / float(Total);
+
+    *SumSquares += OtherSumSquares + Delta * Delta * float(*Count) * Weight;
+    *Mean += Delta * Weight;
+    *Count = Total;
+}
+
+void
+MmMoments(
+        const float* Input,
+        size_t Count,
+        size_t* AccumulatedCount,
+        float* Mean,
+        float* SumSquares
+)
+{
+    for (size_t i = 0; i < Count; i += MM_MOMENTS_BLOCK_ELEMENTS) {
+        const size_t BlockCount = std::min<size_t>(MM_MOMENTS_BLOCK_ELEMENTS, Count - i);
+
+        float BlockMean;
+        float BlockSumSquares;
+        MmMomentsBlock(Input + i, BlockCount, &BlockMean, &BlockSumSquares);
+
+        MmMomentsMerge(AccumulatedCount, Mean, SumSquares, BlockCount, BlockMean, BlockSumSquares);
+    }
+}
+
+void
+MmBatchNormBackwardReduce(
+        const float* OutputGrad,
+        const float* Input,
+        size_t Count,
+        float Mean,
+        float* SumGrad,
+        float* SumGradCentered
+)
+{
+    size_t i = 0;
+    float Sum = 0.0f;
+    float SumCentered = 0.0f;
+
+#if defined(MM_USE_SSE)
+    const Mm_Float32x4 MeanVector = MmBroadcastFloat32x4(Mean);
+    Mm_Float32x4 Sum0 = MmSetZeroFloat32x4();
+    Mm_Float32x4 Sum1 = MmSetZeroFloat32x4();
+    Mm_Float32x4 SumCentered0 = MmSetZeroFloat32x4();
+    Mm_Float32x4 SumCentered1 = MmSetZeroFloat32x4();
+
+    for (; i + 8 <= Count; i += 8) {
+        const Mm_Float32x4 Grad0 = MmLoadFloat32x4<std::false_type>(OutputGrad + i);
+        const Mm_Float32x4 Grad1 = MmLoadFloat32x4<std::false_type>(OutputGrad + i + 4);
+        const Mm_Float32x4 Diff0 = MmSubtractFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i), MeanVector);
+        const Mm_Float32x4 Diff1 = MmSubtractFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i + 4), MeanVector);
+
+        Sum0 = MmAddFloat32x4(Sum0, Grad0);
+        Sum1 = MmAddFloat32x4(Sum1, Grad1);
+        SumCentered0 = MmMultiplyAddFloat32x4(Grad0, Diff0, SumCentered0);
+        SumCentered1 = MmMultiplyAddFloat32x4(Grad1, Diff1, SumCentered1);
+    }
+    Sum = MmUnpackValue(MmAddFloat32x4(Sum0, Sum1));
+    SumCentered = MmUnpackValue(MmAddFloat32x4(SumCentered0, SumCentered1));
+#endif
+
+    for (; i < Count; ++i) {
+        Sum += OutputGrad[i];
+        SumCentered += OutputGrad[i] * (Input[i] - Mean);
+    }
+
+    *SumGrad = Sum;
+    *SumGradCentered = SumCentered;
+}
+
+void
+MmBatchNormBackwardApply(
+        const float* OutputGrad,
+        const float* Input,
+        float* InputGrad,
+        size_t Count,
+        float GradScale,
+        float InputScale,
+        float Shift
+)
+{
+    size_t i = 0;
+
+#if defined(MM_USE_SSE)
+    const Mm_Float32x4 GradScaleVector = MmBroadcastFloat32x4(GradScale);
+    const Mm_Float32x4 InputScaleVector = MmBroadcastFloat32x4(InputScale);
+    const Mm_Float32x4 ShiftVector = MmBroadcastFloat32x4(Shift);
+
+    for (; i + 4 <= Count; i += 4) {
+        Mm_Float32x4 Vector = MmMultiplyAddFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i),
+                                                     InputScaleVector, ShiftVector);
+        Vector = MmMultiplyAddFloat32x4(MmLoadFloat32x4<std::false_type>(OutputGrad + i),
+                                        GradScaleVector, Vector);
+        MmStoreFloat32x4<std::false_type>(InputGrad + i, Vector);
+    }
+#endif
+
+    for (; i < Count; ++i) {
+        InputGrad[i] = GradScale * OutputGrad[i] + InputScale * Input[i] + Shift;
+    }
+}
+
+void
+MmScaleShift(
+        const float* Input,
+        float* Output,
+        size_t Count,
+        float Scale,
+        float Shift
+)
+{
+    size_t i = 0;
+
+#if defined(MM_USE_SSE)
+    const Mm_Float32x4 ScaleVector = MmBroadcastFloat32x4(Scale);
+    const Mm_Float32x4 ShiftVector = MmBroadcastFloat32x4(Shift);
+
+    for (; i + 8 <= Count; i += 8) {
+        const Mm_Float32x4 Vector0 = MmLoadFloat32x4<std::false_type>(Input + i);
+        const Mm_Float32x4 Vector1 = MmLoadFloat32x4<std::false_type>(Input + i + 4);
+        MmStoreFloat32x4<std::false_type>(Output + i, MmMultiplyAddFloat32x4(Vector0, ScaleVector, ShiftVector));
+        MmStoreFloat32x4<std::false_type>(Output + i + 4, MmMultiplyAddFloat32x4(Vector1, ScaleVector, ShiftVector));
+    }
+
+    for (; i + 4 <= Count; i += 4) {
+        const Mm_Float32x4 Vector = MmLoadFloat32x4<std::false_type>(Input + i);
+        MmStoreFloat32x4<std::false_type>(Output + i, MmMultiplyAddFloat32x4(Vector, ScaleVector, ShiftVector));
+    }
+#endif
+
+    for (; i < Count; ++i) {
+        Output[i] = Input[i] * Scale + Shift;
+    }
+}
+
+void
+MmScaleShiftNhwc(
+        const float* Input,
+        float* Output,
+        const float* Scale,
+        const float* Shift,
+        size_t ChannelCount,
+        size_t SpatialSize
+)
+{
+    for (size_t d = 0; d < SpatialSize; ++d) {
+        size_t c = 0;
+
+#if defined(MM_USE_SSE)
+        for (; c + 4 <= ChannelCount; c += 4) {
+            const Mm_Float32x4 Vector = MmLoadFloat32x4<std::false_type>(Input + c);
+            MmStoreFloat32x4<std::false_type>(Output + c,
+                                              MmMultiplyAddFloat32x4(Vector,
+                                                                     MmLoadFloat32x4<std::false_type>(Scale + c),
+                                                                     MmLoadFloat32x4<std::false_type>(Shift + c)));
+        }
+#endif
+
+        for (; c < ChannelCount; ++c) {
+            Output[c] = Input[c] * Scale[c] + Shift[c];
+        }
+
+        Input += ChannelCount;
+        Output += ChannelCount;
+    }
+}
+
+} // mmpack
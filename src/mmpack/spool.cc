@@ -0,0 +1,602 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "mmpack_.h"
+#include <algorithm>
+#include <limits>
+
+namespace mmpack {
+
+float
+MmMaxPoolWindow(
+        const MM_POOL_PARAMS* Parameters,
+        const float* Rows,
+        size_t RowCount,
+        size_t x
+)
+/*++
+
+Описание процедуры:
+
+    Скалярно считает максимум окна столбца x выхода по RowCount строкам входа,
+    начиная с Rows. Столбцы окна обрезаются по границе входа.
+
+--*/
+{
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InShape[1]);
+    const ptrdiff_t OriginX = ptrdiff_t(x * Parameters->StrideShape[1]) - ptrdiff_t(Parameters->Padding[1]);
+    const ptrdiff_t ColumnBegin = std::max<ptrdiff_t>(OriginX, 0);
+    const ptrdiff_t ColumnEnd = std::min<ptrdiff_t>(OriginX + ptrdiff_t(Parameters->KernelShape[1]), InputWidth);
+
+    float MaxValue = std::numeric_limits<float>::lowest();
+
+    for (size_t r = 0; r < RowCount; ++r) {
+        const float* Row = Rows + r * InputWidth;
+        for (ptrdiff_t ix = ColumnBegin; ix < ColumnEnd; ++ix) {
+            MaxValue = std::max(MaxValue, Row[ix]);
+        }
+    }
+
+    return MaxValue;
+}
+
+#if defined(MM_USE_SSE)
+
+/*
+ * Ядра считают 4 соседние точки выхода, окна которых начинаются со столбца Base
+ * и целиком лежат во входе.
+ */
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmMaxPoolKernel2x2S2(
+        const float* Rows,
+        size_t RowCount,
+        size_t InputWidth,
+        size_t Base
+)
+{
+    Mm_Float32x4 Low = MmBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+    Mm_Float32x4 High = Low;
+
+    for (size_t r = 0; r < RowCount; ++r) {
+        const float* Row = Rows + r * InputWidth + Base;
+        Low = MmMaximumFloat32x4(Low, MmLoadFloat32x4<std::false_type>(Row));
+        High = MmMaximumFloat32x4(High, MmLoadFloat32x4<std::false_type>(Row + 4));
+    }
+
+    return MmMaximumFloat32x4(MmPackEvenFloat32x4(Low, High), MmPackOddFloat32x4(Low, High));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmMaxPoolKernel3x3S2(
+        const float* Rows,
+        size_t RowCount,
+        size_t InputWidth,
+        size_t Base
+)
+{
+    Mm_Float32x4 Low = MmBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+    Mm_Float32x4 High = Low;
+    Mm_Float32x4 ShiftedLow = Low;
+    Mm_Float32x4 ShiftedHigh = Low;
+
+    for (size_t r = 0; r < RowCount; ++r) {
+        const float* Row = Rows + r * InputWidth + Base;
+        Low = MmMaximumFloat32x4(Low, MmLoadFloat32x4<std::false_type>(Row));
+        High = MmMaximumFloat32x4(High, MmLoadFloat32x4<std::false_type>(Row + 4));
+        ShiftedLow = MmMaximumFloat32x4(ShiftedLow, MmLoadFloat32x4<std::false_type>(Row + 2));
+        ShiftedHigh = MmMaximumFloat32x4(ShiftedHigh, MmLoadFloat32x4<std::false_type>(Row + 6));
+    }
+
+    // Столбцы окна: 2x (четные Low/High), 2x + 1 (нечетные), 2x + 2 (четные ShiftedLow/ShiftedHigh)
+    return MmMaximumFloat32x4(MmMaximumFloat32x4(MmPackEvenFloat32x4(Low, High), MmPackOddFloat32x4(Low, High)),
+                              MmPackEvenFloat32x4(ShiftedLow, ShiftedHigh));
+}
+
+MM_STRONG_INLINE
+Mm_Float32x4
+MmMaxPoolKernelS1(
+        const float* Rows,
+        size_t RowCount,
+        size_t InputWidth,
+        size_t KernelWidth,
+        size_t Base
+)
+{
+    Mm_Float32x4 Accumulator = MmBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+
+    for (size_t r = 0; r < RowCount; ++r) {
+        const float* Row = Rows + r * InputWidth + Base;
+        for (size_t dx = 0; dx < KernelWidth; ++dx) {
+            Accumulator = MmMaximumFloat32x4(Accumulator, MmLoadFloat32x4<std::false_type>(Row + dx));
+        }
+    }
+
+    return Accumulator;
+}
+
+#endif // MM_USE_SSE
+
+void
+MmMaxPoolRows(
+        const MM_POOL_PARAMS* Parameters,
+        const float* Input,
+        size_t InputStartRow,
+        float* Output,
+        size_t StartY,
+        size_t CountY
+)
+/*++
+
+Описание процедуры:
+
+    Считает строки [StartY, StartY + CountY) выхода max pooling'а одного канала.
+
+Аргументы:
+
+    Parameters - параметры max pooling'а.
+
+    Input - строка InputStartRow входа канала; строки окон выхода не выходят за
+        пределы доступной части входа.
+
+    InputStartRow - номер первой доступной строки входа.
+
+    Output - строка StartY выхода канала.
+
+    StartY - первая строка выхода.
+
+    CountY - кол-во строк выхода.
+
+--*/
+{
+    const size_t InputHeight = Parameters->InShape[0];
+    const size_t InputWidth = Parameters->InShape[1];
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t OutputWidth = Parameters->OutShape[1];
+
+#if defined(MM_USE_SSE)
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+    const size_t PaddingLeft = Parameters->Padding[1];
+
+    const bool Is2x2S2 = KernelWidth == 2 && StrideWidth == 2;
+    const bool Is3x3S2 = KernelWidth == 3 && StrideWidth == 2;
+    const bool IsS1 = StrideWidth == 1;
+
+    // Сколько столбцов входа от начала окна читают векторные загрузки ядра
+    const size_t Reach = Is2x2S2 ? 8 : Is3x3S2 ? 10 : KernelWidth + 3;
+
+    // Первый столбец выхода, окно которого не задевает левое заполнение
+    const size_t VectorBeginX = std::min((PaddingLeft + StrideWidth - 1) / StrideWidth, OutputWidth);
+#else
+    const size_t VectorBeginX = OutputWidth;
+#endif
+
+    for (size_t y = StartY; y < StartY + CountY; ++y) {
+        const ptrdiff_t OriginY = ptrdiff_t(y * StrideHeight) - ptrdiff_t(PaddingTop);
+        const size_t RowBegin = size_t(std::max<ptrdiff_t>(OriginY, 0));
+        const size_t RowEnd = size_t(std::min<ptrdiff_t>(OriginY + ptrdiff_t(KernelHeight), ptrdiff_t(InputHeight)));
+        const size_t RowCount = RowEnd - RowBegin;
+        const float* Rows = Input + (RowBegin - InputStartRow) * InputWidth;
+
+        size_t x = 0;
+
+        for (; x < VectorBeginX; ++x) {
+            Output[x] = MmMaxPoolWindow(Parameters, Rows, RowCount, x);
+        }
+
+#if defined(MM_USE_SSE)
+        if (Is2x2S2 || Is3x3S2 || IsS1) {
+            for (; x + 4 <= OutputWidth; x += 4) {
+                const size_t Base = x * StrideWidth - PaddingLeft;
+                if (Base + Reach > InputWidth) {
+                    break;
+                }
+
+                Mm_Float32x4 Result;
+                if (Is2x2S2) {
+                    Result = MmMaxPoolKernel2x2S2(Rows, RowCount, InputWidth, Base);
+                } else if (Is3x3S2) {
+                    Result = MmMaxPoolKernel3x3S2(Rows, RowCount, InputWidth, Base);
+                } else {
+                    Result = MmMaxPoolKernelS1(Rows, RowCount, InputWidth, KernelWidth, Base);
+                }
+
+                MmStoreFloat32x4<std::false_type>(Output + x, Result);
+            }
+        }
+#endif
+
+        for (; x < OutputWidth; ++x) {
+            Output[x] = MmMaxPoolWindow(Parameters, Rows, RowCount, x);
+        }
+
+        Output += OutputWidth;
+    }
+}
+
+void
+MmMaxPool(
+        const MM_POOL_PARAMS* Parameters,
+        const float* Input,
+        float* Output,
+        size_t ChannelCount
+)
+{
+    const size_t InputSize = Parameters->InShape[0] * Parameters->InShape[1];
+    const size_t OutputSize = Parameters->OutShape[0] * Parameters->OutShape[1];
+
+    for (size_t c = 0; c < ChannelCount; ++c) {
+        MmMaxPoolRows(Parameters, Input, 0, Output, 0, Parameters->OutShape[0]);
+
+        Input += InputSize;
+        Output += OutputSize;
+    }
+}
+
+void
+MmMaxPoolArgmax(
+        const MM_POOL_PARAMS* Parameters,
+        const float* Input,
+        float* Output,
+        uint8_t* Argmax,
+        size_t ChannelCount
+)
+{
+    const ptrdiff_t InputHeight = ptrdiff_t(Parameters->InShape[0]);
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InShape[1]);
+    const ptrdiff_t KernelHeight = ptrdiff_t(Parameters->KernelShape[0]);
+    const ptrdiff_t KernelWidth = ptrdiff_t(Parameters->KernelShape[1]);
+    const size_t OutputHeight = Parameters->OutShape[0];
+    const size_t OutputWidth = Parameters->OutShape[1];
+
+    for (size_t c = 0; c < ChannelCount; ++c) {
+        for (size_t y = 0; y < OutputHeight; ++y) {
+            const ptrdiff_t OriginY = ptrdiff_t(y * Parameters->StrideShape[0]) - ptrdiff_t(Parameters->Padding[0]);
+            const ptrdiff_t RowBegin = std::max<ptrdiff_t>(OriginY, 0);
+            const ptrdiff_t RowEnd = std::min<ptrdiff_t>(OriginY + KernelHeight, InputHeight);
+
+            for (size_t x = 0; x < OutputWidth; ++x) {
+                const ptrdiff_t OriginX = ptrdiff_t(x * Parameters->StrideShape[1]) - ptrdiff_t(Parameters->Padding[1]);
+                const ptrdiff_t ColumnBegin = std::max<ptrdiff_t>(OriginX, 0);
+                const ptrdiff_t ColumnEnd = std::min<ptrdiff_t>(OriginX + KernelWidth, InputWidth);
+
+                float MaxValue = std::numeric_limits<float>::lowest();
+                ptrdiff_t MaxOffset = (RowBegin - OriginY) * KernelWidth + (ColumnBegin - OriginX);
+
+                for (ptrdiff_t iy = RowBegin; iy < RowEnd; ++iy) {
+                    const float* Row = Input + iy * InputWidth;
+                    for (ptrdiff_t ix = ColumnBegin; ix < ColumnEnd; ++ix) {
+                        if (Row[ix] > MaxValue) {
+                            MaxValue = Row[ix];
+                            MaxOffset = (iy - OriginY) * KernelWidth + (ix - OriginX);
+                        }
+                    }
+                }
+
+                *Output++ = MaxValue;
+                *Argmax++ = uint8_t(MaxOffset);
+            }
+        }
+
+        Input += InputHeight * InputWidth;
+    }
+}
+
+void
+MmMaxPoolBackward(
+        const MM_POOL_PARAMS* Parameters,
+        const float* OutputGrad,
+        const uint8_t* Argmax,
+        float* InputGrad,
+        size_t ChannelCount
+)
+{
+    const size_t InputSize = Parameters->InShape[0] * Parameters->InShape[1];
+    const size_t InputWidth = Parameters->InShape[1];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t OutputHeight = Parameters->OutShape[0];
+    const size_t OutputWidth = Parameters->OutShape[1];
+
+    std::fill_n(InputGrad, InputSize * ChannelCount, 0.0f);
+
+    for (size_t c = 0; c < ChannelCount; ++c) {
+        for (size_t y = 0; y < OutputHeight; ++y) {
+            const ptrdiff_t OriginY = ptrdiff_t(y * Parameters->StrideShape[0]) - ptrdiff_t(Parameters->Padding[0]);
+
+            for (size_t x = 0; x < OutputWidth; ++x) {
+                const ptrdiff_t OriginX = ptrdiff_t(x * Parameters->StrideShape[1]) - ptrdiff_t(Parameters->Padding[1]);
+                const size_t Offset = *Argmax++;
+                const size_t iy = size_t(OriginY + ptrdiff_t(Offset / KernelWidth));
+                const size_t ix = size_t(OriginX + ptrdiff_t(Offset % KernelWidth));
+
+                // Перекрывающиеся окна могут выбрать одну и ту же точку входа
+                InputGrad[iy * InputWidth + ix] += *OutputGrad++;
+            }
+        }
+
+        InputGrad += InputSize;
+    }
+}
+
+size_t
+MmAveragePoolDivisor(
+        const MM_POOL_PARAMS* Parameters,
+        bool CountIncludePad,
+        size_t Dimension,
+        ptrdiff_t Origin
+)
+/*++
+
+Описание процедуры:
+
+    Возвращает кол-во точек окна вдоль оси Dimension (0 - H, 1 - W), которое начинается в
+    Origin: только точки входа или, при CountIncludePad, также точки заполнения.
+
+--*/
+{
+    const ptrdiff_t Kernel = ptrdiff_t(Parameters->KernelShape[Dimension]);
+    const ptrdiff_t Size = ptrdiff_t(Parameters->InShape[Dimension]);
+    const ptrdiff_t Begin = CountIncludePad ? Origin : std::max<ptrdiff_t>(Origin, 0);
+    const ptrdiff_t End = std::min<ptrdiff_t>(Origin + Kernel,
+                                              CountIncludePad ? Size + ptrdiff_t(Parameters->Padding[Dimension + 2]) : Size);
+    return size_t(End - Begin);
+}
+
+float
+MmAveragePoolWindow(
+        const MM_POOL_PARAMS* Parameters,
+        bool CountIncludePad,
+        const float* ColumnSum,
+        size_t RowDivisor,
+        size_t x
+)
+/*++
+
+Описание процедуры:
+
+    Скалярно считает среднее окна столбца x выхода по суммам столбцов ColumnSum
+    строк окна. RowDivisor - кол-во учитываемых строк окна.
+
+--*/
+{
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InShape[1]);
+    const ptrdiff_t OriginX = ptrdiff_t(x * Parameters->StrideShape[1]) - ptrdiff_t(Parameters->Padding[1]);
+    const ptrdiff_t ColumnBegin = std::max<ptrdiff_t>(OriginX, 0);
+    const ptrdiff_t ColumnEnd = std::min<ptrdiff_t>(OriginX + ptrdiff_t(Parameters->KernelShape[1]), InputWidth);
+
+    float Sum = 0.0f;
+    for (ptrdiff_t ix = ColumnBegin; ix < ColumnEnd; ++ix) {
+        Sum += ColumnSum[ix];
+    }
+
+    return Sum / float(RowDivisor * MmAveragePoolDivisor(Parameters, CountIncludePad, 1, OriginX));
+}
+
+void
+MmAveragePool(
+        const MM_POOL_PARAMS* Parameters,
+        bool CountIncludePad,
+        const float* Input,
+        float* Output,
+        size_t ChannelCount,
+        float* TemporaryBuffer
+)
+{
+    const size_t InputHeight = Parameters->InShape[0];
+    const size_t InputWidth = Parameters->InShape[1];
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t OutputHeight = Parameters->OutShape[0];
+    const size_t OutputWidth = Parameters->OutShape[1];
+
+    float* ColumnSum = TemporaryBuffer;
+
+#if defined(MM_USE_SSE)
+    const bool Is2x2S2 = KernelWidth == 2 && StrideWidth == 2;
+    const bool IsS1 = StrideWidth == 1;
+    const size_t Reach = Is2x2S2 ? 8 : KernelWidth + 3;
+    const size_t VectorBeginX = std::min((PaddingLeft + StrideWidth - 1) / StrideWidth, OutputWidth);
+#else
+    const size_t VectorBeginX = OutputWidth;
+#endif
+
+    for (size_t c = 0; c < ChannelCount; ++c) {
+        for (size_t y = 0; y < OutputHeight; ++y) {
+            const ptrdiff_t OriginY = ptrdiff_t(y * StrideHeight) - ptrdiff_t(Parameters->Padding[0]);
+            const size_t RowBegin = size_t(std::max<ptrdiff_t>(OriginY, 0));
+            const size_t RowEnd = size_t(std::min<ptrdiff_t>(OriginY + ptrdiff_t(KernelHeight), ptrdiff_t(InputHeight)));
+            const size_t RowDivisor = MmAveragePoolDivisor(Parameters, CountIncludePad, 0, OriginY);
+
+            /*
+             * Суммы столбцов по строкам окна, дальше окно скользит по ним вдоль строки.
+             */
+            std::fill_n(ColumnSum, InputWidth, 0.0f);
+
+            for (size_t iy = RowBegin; iy < RowEnd; ++iy) {
+                const float* Row = Input + iy * InputWidth;
+                size_t ix = 0;
+#if defined(MM_USE_SSE)
+                for (; ix + 4 <= InputWidth; ix += 4) {
+                    MmStoreFloat32x4<std::false_type>(ColumnSum + ix,
+                            MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(ColumnSum + ix),
+                                           MmLoadFloat32x4<std::false_type>(Row + ix)));
+                }
+#endif
+                for (; ix < InputWidth; ++ix) {
+                    ColumnSum[ix] += Row[ix];
+                }
+            }
+
+            size_t x = 0;
+
+            for (; x < VectorBeginX; ++x) {
+                Output[x] = MmAveragePoolWindow(Parameters, CountIncludePad, ColumnSum, RowDivisor, x);
+            }
+
+#if defined(MM_USE_SSE)
+            if (Is2x2S2 || IsS1) {
+                // Окна внутри входа содержат ровно KW столбцов
+                const Mm_Float32x4 Scale = MmBroadcastFloat32x4(1.0f / float(RowDivisor * KernelWidth));
+
+                for (; x + 4 <= OutputWidth; x += 4) {
+                    const size_t Base = x * StrideWidth - PaddingLeft;
+                    if (Base + Reach > InputWidth) {
+                        break;
+                    }
+
+                    Mm_Float32x4 Sum;
+                    if (Is2x2S2) {
+                        const Mm_Float32x4 Low = MmLoadFloat32x4<std::false_type>(ColumnSum + Base);
+                        const Mm_Float32x4 High = MmLoadFloat32x4<std::false_type>(ColumnSum + Base + 4);
+                        Sum = MmAddFloat32x4(MmPackEvenFloat32x4(Low, High), MmPackOddFloat32x4(Low, High));
+                    } else {
+                        Sum = MmSetZeroFloat32x4();
+                        for (size_t dx = 0; dx < KernelWidth; ++dx) {
+                            Sum = MmAddFloat32x4(Sum, MmLoadFloat32x4<std::false_type>(ColumnSum + Base + dx));
+                        }
+                    }
+
+                    MmStoreFloat32x4<std::false_type>(Output + x, MmMultiplyFloat32x4(Sum, Scale));
+                }
+            }
+#endif
+
+            for (; x < OutputWidth; ++x) {
+                Output[x] = MmAveragePoolWindow(Parameters, CountIncludePad, ColumnSum, RowDivisor, x);
+            }
+
+            Output += OutputWidth;
+        }
+
+        Input += InputHeight * InputWidth;
+    }
+}
+
+void
+MmAveragePoolBackward(
+        const MM_POOL_PARAMS* Parameters,
+        bool CountIncludePad,
+        const float* OutputGrad,
+        float* InputGrad,
+        size_t ChannelCount
+)
+{
+    const ptrdiff_t InputHeight = ptrdiff_t(Parameters->InShape[0]);
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InShape[1]);
+    const ptrdiff_t KernelHeight = ptrdiff_t(Parameters->KernelShape[0]);
+    const ptrdiff_t KernelWidth = ptrdiff_t(Parameters->KernelShape[1]);
+    const size_t OutputHeight = Parameters->OutShape[0];
+    const size_t OutputWidth = Parameters->OutShape[1];
+
+    std::fill_n(InputGrad, size_t(InputHeight * InputWidth) * ChannelCount, 0.0f);
+
+    for (size_t c = 0; c < ChannelCount; ++c) {
+        for (size_t y = 0; y < OutputHeight; ++y) {
+            const ptrdiff_t OriginY = ptrdiff_t(y * Parameters->StrideShape[0]) - ptrdiff_t(Parameters->Padding[0]);
+            const ptrdiff_t RowBegin = std::max<ptrdiff_t>(OriginY, 0);
+            const ptrdiff_t RowEnd = std::min<ptrdiff_t>(OriginY + KernelHeight, InputHeight);
+            const size_t RowDivisor = MmAveragePoolDivisor(Parameters, CountIncludePad, 0, OriginY);
+
+            for (size_t x = 0; x < OutputWidth; ++x) {
+                const ptrdiff_t OriginX = ptrdiff_t(x * Parameters->StrideShape[1]) - ptrdiff_t(Parameters->Padding[1]);
+                const ptrdiff_t ColumnBegin = std::max<ptrdiff_t>(OriginX, 0);
+                const ptrdiff_t ColumnEnd = std::min<ptrdiff_t>(OriginX + KernelWidth, InputWidth);
+                const float Grad = *OutputGrad++ /
+                        float(RowDivisor * MmAveragePoolDivisor(Parameters, CountIncludePad, 1, OriginX));
+
+                for (ptrdiff_t iy = RowBegin; iy < RowEnd; ++iy) {
+                    float* Row = InputGrad + iy * InputWidth;
+                    for (ptrdiff_t ix = ColumnBegin; ix < ColumnEnd; ++ix) {
+                        Row[ix] += Grad;
+                    }
+                }
+            }
+        }
+
+        InputGrad += InputHeight * InputWidth;
+    }
+}
+
+void
+MmGlobalAveragePool(
+        const float* Input,
+        float* Output,
+        size_t ChannelCount,
+        size_t SpatialSize
+)
+{
+    const float Scale = 1.0f / float(SpatialSize);
+
+    for (size_t c = 0; c < ChannelCount; ++c) {
+        size_t i = 0;
+        float Sum = 0.0f;
+
+#if defined(MM_USE_SSE)
+        // Два независимых аккумулятора скрывают задержку сложения
+        Mm_Float32x4 Sum0 = MmSetZeroFloat32x4();
+        Mm_Float32x4 Sum1 = MmSetZeroFloat32x4();
+
+        for (; i + 8 <= SpatialSize; i += 8) {
+            Sum0 = MmAddFloat32x4(Sum0, MmLoadFloat32x4<std::false_type>(Input + i));
+            Sum1 = MmAddFloat32x4(Sum1, MmLoadFloat32x4<std::false_type>(Input + i + 4));
+        }
+        for (; i + 4 <= SpatialSize; i += 4) {
+            Sum0 = MmAddFloat32x4(Sum0, MmLoadFloat32x4<std::false_type>(Input + i));
+        }
+
+        Sum = MmUnpackValue(MmAddFloat32x4(Sum0, Sum1));
+#endif
+
+        for (; i < SpatialSize; ++i) {
+            Sum += Input[i];
+        }
+
+        Output[c] = Sum * Scale;
+        Input += SpatialSize;
+    }
+}
+
+void
+MmGlobalAveragePoolNhwc(
+        const float* Input,
+        float* Output,
+        size_t ChannelCount,
+        size_t SpatialSize
+)
+{
+    const float Scale = 1.0f / float(SpatialSize);
+
+    std::fill_n(Output, ChannelCount, 0.0f);
+
+    // В NHWC точка - непрерывный вектор каналов, суммы копятся сразу в Output
+    for (size_t i = 0; i < SpatialSize; ++i) {
+        size_t c = 0;
+#if defined(MM_USE_SSE)
+        for (; c + 4 <= ChannelCount; c += 4) {
+            MmStoreFloat32x4<std::false_type>(Output + c,
+                    MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(Output + c),
+                                   MmLoadFloat32x4<std::false_type>(Input + c)));
+        }
+#endif
+        for (; c < ChannelCount; ++c) {
+            Output[c] += Input[c];
+        }
+        Input += ChannelCount;
+    }
+
+    for (size_t c = 0; c < ChannelCount; ++c) {
+        Output[c] *= Scale;
+    }
+}
+
+} // mmpack
@@ -0,0 +1,249 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "smath_.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace mmpack {
+
+static
+float
+MmReduceMaximum(
+        const float* Input,
+        size_t N
+)
+{
+    size_t i = 0;
+    float Maximum = -std::numeric_limits<float>::infinity();
+
+#if defined(MM_USE_SSE)
+    Mm_Float32x4 Maximum0 = MmBroadcastFloat32x4(Maximum);
+    Mm_Float32x4 Maximum1 = Maximum0;
+
+    for (; i + 8 <= N; i += 8) {
+        Maximum0 = MmMaximumFloat32x4(Maximum0, MmLoadFloat32x4<std::false_type>(Input + i));
+        Maximum1 = MmMaximumFloat32x4(Maximum1, MmLoadFloat32x4<std::false_type>(Input + i + 4));
+    }
+    Maximum = MmReduceMaximumFloat32x4(MmMaximumFloat32x4(Maximum0, Maximum1));
+#endif
+
+    for (; i < N; ++i) {
+        Maximum = std::max(Maximum, Input[i]);
+    }
+
+    return Maximum;
+}
+
+static
+float
+MmSumExp(
+        const float* Input,
+        size_t N,
+        float Shift
+)
+/*++
+
+Описание процедуры:
+
+    Возвращает sum(exp(Input[i] + Shift)).
+
+--*/
+{
+    size_t i = 0;
+    float Sum = 0.0f;
+
+#if defined(MM_USE_SSE)
+    const Mm_Float32x4 ShiftVector = MmBroadcastFloat32x4(Shift);
+    Mm_Float32x4 Sum0 = MmSetZeroFloat32x4();
+    Mm_Float32x4 Sum1 = MmSetZeroFloat32x4();
+
+    for (; i + 8 <= N; i += 8) {
+        Sum0 = MmAddFloat32x4(Sum0, MmExpFloat32x4(MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i), ShiftVector)));
+        Sum1 = MmAddFloat32x4(Sum1, MmExpFloat32x4(MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i + 4), ShiftVector)));
+    }
+    Sum = MmUnpackValue(MmAddFloat32x4(Sum0, Sum1));
+#endif
+
+    for (; i < N; ++i) {
+        Sum += std::exp(Input[i] + Shift);
+    }
+
+    return Sum;
+}
+
+static
+void
+MmExpShift(
+        const float* Input,
+        float* Output,
+        size_t N,
+        float Shift
+)
+/*++
+
+Описание процедуры:
+
+    Output[i] = exp(Input[i] + Shift).
+
+--*/
+{
+    size_t i = 0;
+
+#if defined(MM_USE_SSE)
+    const Mm_Float32x4 ShiftVector = MmBroadcastFloat32x4(Shift);
+
+    for (; i + 4 <= N; i += 4) {
+        MmStoreFloat32x4<std::false_type>(Output + i,
+            MmExpFloat32x4(MmAddFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i), ShiftVector)));
+    }
+#endif
+
+    for (; i < N; ++i) {
+        Output[i] = std::exp(Input[i] + Shift);
+    }
+}
+
+static
+float
+MmLogSumExp(
+        const float* Input,
+        size_t N
+)
+/*++
+
+Описание процедуры:
+
+    log(sum(exp(x))) = max + log(sum(exp(x - max))): все экспоненты не больше 1, поэтому
+    сумма не переполняется.
+
+--*/
+{
+    const float Maximum = MmReduceMaximum(Input, N);
+    return Maximum + std::log(MmSumExp(Input, N, -Maximum));
+}
+
+float
+MmSoftmaxCrossEntropy(
+        const float* Input,
+        size_t Label,
+        size_t N,
+        float* Gradient
+)
+{
+    /*
+     * Вход читается дважды, а градиент пишется одним проходом exp(x - logsumexp)
+     * без промежуточного буфера.
+     */
+    const float LogSumExp = MmLogSumExp(Input, N);
+
+    if (Gradient != nullptr) {
+        MmExpShift(Input, Gradient, N, -LogSumExp);
+        Gradient[Label] -= 1.0f;
+    }
+
+    return LogSumExp - Input[Label];
+}
+
+void
+MmSoftmax(
+        const float* Input,
+        float* Output,
+        size_t N
+)
+{
+    MmExpShift(Input, Output, N, -MmLogSumExp(Input, N));
+}
+
+size_t
+MmTopK(
+        const float* Input,
+        size_t N,
+        size_t K,
+        size_t* Indices,
+        float* Values
+)
+{
+    K = std::min(K, N);
+    if (K == 0) {
+        return 0;
+    }
+
+    /*
+     * Куча из K лучших элементов, в вершине - худший из них. Элемент лучше, если его значение
+     * больше, а при равенстве - меньше индекс. Вход просматривается слева направо, поэтому
+     * равный вершине элемент всегда хуже нее и достаточно строгого сравнения значений.
+     */
+    typedef std::pair<float, size_t> Entry;
+    auto Better = [](const Entry& a, const Entry& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+
+    std::vector<Entry> Heap(K);
+    for (size_t i = 0; i < K; ++i) {
+        Heap[i] = {Input[i], i};
+    }
+    std::make_heap(Heap.begin(), Heap.end(), Better);
+
+    auto Push = [&](size_t i) {
+        if (Input[i] > Heap.front().first) {
+            std::pop_heap(Heap.begin(), Heap.end(), Better);
+            Heap.back() = {Input[i], i};
+            std::push_heap(Heap.begin(), Heap.end(), Better);
+        }
+    };
+
+    size_t i = K;
+
+#if defined(MM_USE_SSE)
+    // Для K << N почти все блоки отбрасываются одним сравнением с порогом
+    for (; i + 4 <= N; i += 4) {
+        const Mm_Float32x4 Threshold = MmBroadcastFloat32x4(Heap.front().first);
+        const int Mask = MmMoveMaskFloat32x4(
+            MmGreaterThanFloat32x4(MmLoadFloat32x4<std::false_type>(Input + i), Threshold));
+
+        if (Mask != 0) {
+            for (size_t Lane = 0; Lane < 4; ++Lane) {
+                Push(i + Lane);
+            }
+        }
+    }
+#endif
+
+    for (; i < N; ++i) {
+        Push(i);
+    }
+
+    std::sort_heap(Heap.begin(), Heap.end(), Better);
+    for (size_t k = 0; k < K; ++k) {
+        Values[k] = Heap[k].first;
+        Indices[k] = Heap[k].second;
+    }
+
+    return K;
+}
+
+size_t
+MmSoftmaxTopK(
+        const float* Input,
+        size_t N,
+        size_t K,
+        size_t* Indices,
+        float* Probabilities
+)
+{
+    // softmax монотонен: K лучших логитов - это K лучших вероятностей
+    K = MmTopK(Input, N, K, Indices, Probabilities);
+
+    const float LogSumExp = MmLogSumExp(Input, N);
+    for (size_t k = 0; k < K; ++k) {
+        Probabilities[k] = std::exp(Probabilities[k] - LogSumExp);
+    }
+
+    return K;
+}
+
+} // mmpack
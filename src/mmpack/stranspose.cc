@@ -0,0 +1,60 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "mmpack_.h"
+
+namespace mmpack {
+
+void
+MmTranspose(
+        const float* A,
+        float* B,
+        size_t M,
+        size_t N
+)
+{
+    //
+    // Матрица обрабатывается полосами по 4 строки. Внутри полосы блоки 4x4
+    // транспонируются в регистрах, хвосты копируются поэлементно.
+    //
+
+    size_t m = 0;
+
+    for (; m + 4 <= M; m += 4) {
+
+        const float* a = A + m * N;
+        float* b = B + m;
+        size_t n = 0;
+
+        for (; n + 4 <= N; n += 4) {
+            Mm_Float32x4 Row0 = MmLoadFloat32x4<std::false_type>(a + 0 * N + n);
+            Mm_Float32x4 Row1 = MmLoadFloat32x4<std::false_type>(a + 1 * N + n);
+            Mm_Float32x4 Row2 = MmLoadFloat32x4<std::false_type>(a + 2 * N + n);
+            Mm_Float32x4 Row3 = MmLoadFloat32x4<std::false_type>(a + 3 * N + n);
+
+            MmTransposeFloat32x4x4(Row0, Row1, Row2, Row3);
+
+            MmStoreFloat32x4<std::false_type>(b + (n + 0) * M, Row0);
+            MmStoreFloat32x4<std::false_type>(b + (n + 1) * M, Row1);
+            MmStoreFloat32x4<std::false_type>(b + (n + 2) * M, Row2);
+            MmStoreFloat32x4<std::false_type>(b + (n + 3) * M, Row3);
+        }
+
+        for (; n < N; n++) {
+            b[n * M + 0] = a[0 * N + n];
+            b[n * M + 1] = a[1 * N + n];
+            b[n * M + 2] = a[2 * N + n];
+            b[n * M + 3] = a[3 * N + n];
+        }
+    }
+
+    for (; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+            B[n * M + m] = A[m * N + n];
+        }
+    }
+}
+
+}
@@ -10,7 +10,9 @@ namespace xsdnn {
     std::ostream& operator<<(std::ostream& out, const InfOptions& opt) {
         out << "Inf Options: " << std::endl;
         out << "\tNumThreads : " << opt.num_threads_ << std::endl;
-        out << "\tBatchSize  : " << opt.batch_size_;
+        out << "\tBatchSize  : " << opt.batch_size_ << std::endl;
+        out << "\tLayout     : " << (opt.layout_ == tensor_layout::nhwc ? "NHWC" : "NCHW") << std::endl;
+        out << "\tTopK       : " << opt.top_k_;
         return out;
     }
 
@@ -4,6 +4,9 @@
 //
 
 #include <session/inference_session.h>
+#include <layers/batch_normalization.h>
+#include <layers/activations/softmax.h>
+#include <unordered_set>
 
 namespace xsdnn {
 
@@ -12,6 +15,166 @@ namespace xsdnn {
     void InfSession::Load(std::string model_path) {
         net_.reset(new network<graph>);
         net_->load(model_path); // TODO: Verify this
+        fold_batch_norm();
+
+        if (opt_.layout_ != tensor_layout::nchw) {
+            apply_layout();
+        }
+    }
+
+    void InfSession::apply_layout() {
+        if (opt_.layout_ == tensor_layout::nchwc) {
+            apply_nchwc_layout();
+            return;
+        }
+
+        /*
+         * Переключаем слои в заданный формат. Слой, который не умеет работать
+         * в этом формате, допустим только если он поэлементный или его вход
+         * не зависит от порядка хранения (H * W == 1 или C == 1).
+         */
+        for (layer* l : net_->net_) {
+            if (l->set_layout(opt_.layout_) || !l->layout_sensitive()) {
+                continue;
+            }
+
+            for (const shape3d& shape : l->in_data_shape()) {
+                if (shape.area() > 1 && shape.C > 1) {
+                    throw xs_error("[InfSession] layer " + l->layer_type() +
+                                   " doesn't support requested data layout");
+                }
+            }
+        }
+
+        // Слияние зависит от формата слоев
+        net_->net_.invalidate_fusion();
+    }
+
+    void InfSession::apply_nchwc_layout() {
+        /*
+         * Ребро данных становится блочным, если его можно передать без переупорядочивания:
+         * у него больше одной точки (иначе форматы совпадают), кол-во каналов кратно блоку,
+         * и это не выход модели. Слой, который не принимает текущее сочетание форматов своих
+         * ребер, возвращает их в NCHW, пока все сочетания не станут допустимыми. Вход модели
+         * остается в NCHW, а границы блочных цепочек переупорядочивает свертка.
+         */
+        graph& g = net_->net_;
+        const size_t block = mmpack::MmNchwcGetBlockSize();
+        std::unordered_set<const edge*> blocked;
+
+        for (layer* l : g) {
+            if (std::find(g.output_layers_.begin(), g.output_layers_.end(), l) != g.output_layers_.end()) {
+                continue;
+            }
+            for (const edgeptr_t& e : l->next()) {
+                if (e && e->ttype() == tensor_type::data && e->shape().area() > 1 && e->shape().C % block == 0) {
+                    blocked.insert(e.get());
+                }
+            }
+        }
+
+        auto data_edges = [](const std::vector<edgeptr_t>& edges) {
+            std::vector<const edge*> data;
+            for (const edgeptr_t& e : edges) {
+                if (e && e->ttype() == tensor_type::data) {
+                    data.push_back(e.get());
+                }
+            }
+            return data;
+        };
+
+        // Общий формат ребер или false, если форматы различаются
+        auto common_layout = [&](const std::vector<const edge*>& edges, tensor_layout& layout) {
+            layout = tensor_layout::nchw;
+            for (size_t i = 0; i < edges.size(); ++i) {
+                const tensor_layout current = blocked.count(edges[i]) ? tensor_layout::nchwc : tensor_layout::nchw;
+                if (i > 0 && current != layout) {
+                    return false;
+                }
+                layout = current;
+            }
+            return true;
+        };
+
+        auto configure = [&](layer* l) {
+            tensor_layout in_layout, out_layout;
+            if (!common_layout(data_edges(l->prev()), in_layout) ||
+                !common_layout(data_edges(l->next()), out_layout)) {
+                return false;
+            }
+            return l->set_io_layout(in_layout, out_layout) ||
+                   (in_layout == out_layout && !l->layout_sensitive());
+        };
+
+        // Последний проход без изменений оставляет каждый слой в формате его ребер
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (layer* l : g) {
+                if (configure(l)) {
+                    continue;
+                }
+                for (const std::vector<edgeptr_t>* edges : {&l->prev(), &l->next()}) {
+                    for (const edge* e : data_edges(*edges)) {
+                        changed |= blocked.erase(e) > 0;
+                    }
+                }
+            }
+        }
+
+        // Слияние зависит от формата слоев
+        g.invalidate_fusion();
+    }
+
+    void InfSession::fold_batch_norm() {
+        graph& g = net_->net_;
+        std::vector<layer*> folded;
+
+        for (layer* l : g.nodes_) {
+            auto* bn = dynamic_cast<batch_norm*>(l);
+            if (bn == nullptr ||
+                std::find(g.input_layers_.begin(), g.input_layers_.end(), l) != g.input_layers_.end() ||
+                std::find(g.output_layers_.begin(), g.output_layers_.end(), l) != g.output_layers_.end()) {
+                continue;
+            }
+
+            // Выход предыдущего слоя не должен читать никто, кроме batch_norm
+            edgeptr_t in_edge = bn->prev()[0];
+            if (!in_edge || in_edge->next().size() != 1) {
+                continue;
+            }
+
+            auto* producer = dynamic_cast<layer*>(in_edge->prev());
+            mat_t scale, shift;
+            if (producer == nullptr || !bn->inference_scale_shift(scale, shift) ||
+                !producer->fold_scale_shift(scale, shift)) {
+                continue;
+            }
+
+            // Потребители batch_norm теперь читают выход предыдущего слоя напрямую
+            edgeptr_t out_edge = bn->next()[0];
+            in_edge->remove_next_node(bn);
+            if (out_edge) {
+                for (node* consumer : out_edge->next()) {
+                    for (edgeptr_t& e : consumer->prev()) {
+                        if (e == out_edge) {
+                            e = in_edge;
+                        }
+                    }
+                    in_edge->add_next_node(consumer);
+                }
+            }
+            folded.push_back(bn);
+        }
+
+        auto is_folded = [&](const layer* l) {
+            return std::find(folded.begin(), folded.end(), l) != folded.end();
+        };
+        g.nodes_.erase(std::remove_if(g.nodes_.begin(), g.nodes_.end(), is_folded), g.nodes_.end());
+        g.owner_nodes_.erase(std::remove_if(g.owner_nodes_.begin(), g.owner_nodes_.end(),
+                                            [&](const std::shared_ptr<layer>& l) { return is_folded(l.get()); }),
+                             g.owner_nodes_.end());
+        g.invalidate_fusion();
     }
 
     void InfSession::Run(const std::vector<tensor_t> &input,
@@ -21,6 +184,96 @@ namespace xsdnn {
         output = net_->predict(input);
     }
 
+    softmax* InfSession::output_softmax() {
+        return dynamic_cast<softmax*>(net_->net_.output_layers_[0]);
+    }
+
+    void InfSession::Run(const std::vector<tensor_t> &input,
+                         std::vector<InfTopK> &output) {
+        if (opt_.top_k_ == 0) {
+            throw xs_error("[InfSession] top-k isn't set, use InfOptions::SetTopK");
+        }
+        if (net_->net_.output_layers_.size() != 1) {
+            throw xs_error("[InfSession] top-k requires a model with a single output");
+        }
+
+        graph& g = net_->net_;
+        g.update_fusion();
+
+        /*
+         * Выход-softmax не вычисляется: классы выбираются прямо по его входу,
+         * поэтому состояние слоев между вызовами Run не меняется.
+         */
+        softmax* head = output_softmax();
+        std::vector<tensor_t> scores;
+        std::vector<const mat_t*> rows;
+
+        if (head != nullptr) {
+            g.forward_until(input, head);
+            for (const mat_t& logits : *head->prev()[0]->get_data()) {
+                rows.push_back(&logits);
+            }
+        } else {
+            scores = g.forward(input);
+            for (const tensor_t& sample : scores) {
+                rows.push_back(&sample[0]);
+            }
+        }
+
+        std::vector<size_t> indices(opt_.top_k_);
+        mat_t values(opt_.top_k_);
+        output.resize(rows.size());
+
+        for (size_t sample = 0; sample < rows.size(); ++sample) {
+            const mat_t& s = *rows[sample];
+            const size_t k = head != nullptr
+                ? mmpack::MmSoftmaxTopK(s.data(), s.size(), opt_.top_k_, indices.data(), values.data())
+                : mmpack::MmTopK(s.data(), s.size(), opt_.top_k_, indices.data(), values.data());
+
+            output[sample].resize(k);
+            for (size_t i = 0; i < k; ++i) {
+                output[sample][i] = {indices[i], values[i]};
+            }
+        }
+    }
+
+    InfStream InfSession::CreateStream() {
+        for (layer* l : net_->net_) {
+            if (!l->streamable()) {
+                throw xs_error("[InfSession] layer " + l->layer_type() +
+                               " doesn't support streaming");
+            }
+        }
+
+        InfStream stream = std::make_shared<InfStreamState>();
+        stream->layers_.resize(net_->net_.size());
+        return stream;
+    }
+
+    void InfSession::Run(const std::vector<tensor_t> &input,
+                         std::vector<tensor_t> &output,
+                         InfStream &stream) {
+        assert(stream != nullptr && stream->layers_.size() == net_->net_.size());
+
+        size_t idx = 0;
+        for (layer* l : net_->net_) {
+            l->set_stream_state(&stream->layers_[idx++]);
+        }
+
+        try {
+            Run(input, output);
+        } catch (...) {
+            for (layer* l : net_->net_) {
+                l->set_stream_state(nullptr);
+            }
+            throw;
+        }
+
+        for (layer* l : net_->net_) {
+            l->set_stream_state(nullptr);
+        }
+    }
+
     network<graph> InfSession::GetModel() {
         return *net_.get();
     }
@@ -102,21 +102,26 @@ std::vector<size_t> broadcaster::shape2vector(xsdnn::shape3d s) {
     return {s.C, s.H, s.W};
 }
 
-size_t broadcaster::num_dimensions(std::vector<size_t> v) {
-    return 3 - std::count(v.begin(), v.end(), 1);
+broadcaster::broadcaster(xsdnn::shape3d s1, xsdnn::shape3d s2)
+    : broadcaster(shape2vector(s1), shape2vector(s2)) {
+    output_shape_.reshape(output_dims_[0], output_dims_[1], output_dims_[2]);
 }
 
-broadcaster::broadcaster(xsdnn::shape3d s1, xsdnn::shape3d s2) {
-    std::vector<size_t> shape1 = shape2vector(s1);
-    std::vector<size_t> shape2 = shape2vector(s2);
-    std::vector<size_t> out_shape(dimension_size);
+broadcaster::broadcaster(std::vector<size_t> shape1, std::vector<size_t> shape2) {
+    const size_t rank = std::max<size_t>(std::max(shape1.size(), shape2.size()), 1);
+    shape1.insert(shape1.begin(), rank - shape1.size(), 1);
+    shape2.insert(shape2.begin(), rank - shape2.size(), 1);
+    output_dims_.resize(rank);
+
+    it1_.reserve(static_cast<std::ptrdiff_t>(rank));
+    it2_.reserve(static_cast<std::ptrdiff_t>(rank));
 
     auto iter1 = shape1.end();
     auto iter2 = shape2.end();
-    auto output_shape = out_shape.end();
+    auto output_shape = output_dims_.end();
 
     size_t index = 0;
-    for (; index < dimension_size; index++) {
+    for (; index < rank; index++) {
         ptrdiff_t axis1 = static_cast<ptrdiff_t>(*--iter1);
         ptrdiff_t axis2 = static_cast<ptrdiff_t>(*--iter2);
 
@@ -134,7 +139,7 @@ broadcaster::broadcaster(xsdnn::shape3d s1, xsdnn::shape3d s2) {
         *--output_shape = dim_to_use;
 
         // if both 1, or a 1 and 0, and there are more dims, we can let the next iteration do the Init
-        if (dim_to_use <= 1 && index + 1 < dimension_size)
+        if (dim_to_use <= 1 && index + 1 < rank)
             continue;
 
         it1_.init(axis1, dim_to_use);
@@ -143,7 +148,7 @@ broadcaster::broadcaster(xsdnn::shape3d s1, xsdnn::shape3d s2) {
         break;
     }
 
-    for (; index < dimension_size; index++) {
+    for (; index < rank; index++) {
         ptrdiff_t axis1 = static_cast<ptrdiff_t>(*--iter1);
         ptrdiff_t axis2 = static_cast<ptrdiff_t>(*--iter2);
 
@@ -167,23 +172,6 @@ broadcaster::broadcaster(xsdnn::shape3d s1, xsdnn::shape3d s2) {
         it2_.append(axis2, dim_to_use);
     }
 
-    // If one shape is bigger than another we need to broadcast the smaller onto the bigger from this point on
-    for (; index < dimension_size; index++) {
-        if (dimension_size == shape2.size()) {
-            ptrdiff_t axis = static_cast<ptrdiff_t>(*--iter2);
-            it1_.append(1, axis);
-            it2_.append(axis, axis);
-            *--output_shape = axis;
-        } else {
-            ptrdiff_t axis = static_cast<ptrdiff_t>(*--iter1);
-            it1_.append(axis, axis);
-            it2_.append(1, axis);
-            *--output_shape = axis;
-        }
-    }
-
-    output_shape_.reshape(output_shape[0], output_shape[1], output_shape[2]);
-
     it1_.allocate_counters();
     it2_.allocate_counters();
 }
@@ -309,4 +297,168 @@ void BroadcastKernelLoop(broadcast& bc, BroadcastFuncHolder func_holder) {
     }
 }
 
+broadcast_plan::broadcast_plan(xsdnn::shape3d shape0, xsdnn::shape3d shape1)
+    : broadcast_plan(std::vector<size_t>{shape0.C, shape0.H, shape0.W},
+                     std::vector<size_t>{shape1.C, shape1.H, shape1.W}) {}
+
+broadcast_plan::broadcast_plan(const std::vector<size_t>& shape0, const std::vector<size_t>& shape1)
+    : kind_(kind::general), rows_(0), row_size_(0), row_scalar0_(false), row_scalar1_(false), rows_per_task_(1) {
+    const size_t rank = std::max(shape0.size(), shape1.size());
+    output_dims_.resize(rank);
+
+    // Склеенные оси от внешней к внутренней и идут ли вдоль них входы подряд
+    std::vector<size_t> dims;
+    std::vector<bool> full0, full1;
+
+    for (size_t i = 0; i < rank; ++i) {
+        const size_t d0 = i + shape0.size() < rank ? 1 : shape0[i + shape0.size() - rank];
+        const size_t d1 = i + shape1.size() < rank ? 1 : shape1[i + shape1.size() - rank];
+        if (d0 != d1 && d0 != 1 && d1 != 1) {
+            throw xs_error("[broadcast_plan] Attempting to broadcast an axis by a dimension other than 1. "
+                           + std::to_string(d0) + " by " + std::to_string(d1));
+        }
+
+        const size_t d = d0 == 1 ? d1 : d0;
+        output_dims_[i] = d;
+        if (d == 1) {
+            continue;
+        }
+
+        const bool f0 = d0 == d;
+        const bool f1 = d1 == d;
+        if (!dims.empty() && full0.back() == f0 && full1.back() == f1) {
+            dims.back() *= d;
+        } else {
+            dims.push_back(d);
+            full0.push_back(f0);
+            full1.push_back(f1);
+        }
+    }
+
+    if (output_size() == 0) {
+        return;
+    }
+
+    if (dims.empty()) {
+        dims.push_back(1);
+        full0.push_back(true);
+        full1.push_back(true);
+    }
+
+    row_size_ = dims.back();
+    row_scalar0_ = !full0.back();
+    row_scalar1_ = !full1.back();
+
+    outer_dims_.assign(dims.begin(), dims.end() - 1);
+    outer_strides0_.resize(outer_dims_.size());
+    outer_strides1_.resize(outer_dims_.size());
+
+    size_t stride0 = row_scalar0_ ? 1 : row_size_;
+    size_t stride1 = row_scalar1_ ? 1 : row_size_;
+    rows_ = 1;
+    for (size_t k = outer_dims_.size(); k-- > 0;) {
+        outer_strides0_[k] = full0[k] ? stride0 : 0;
+        outer_strides1_[k] = full1[k] ? stride1 : 0;
+        stride0 *= full0[k] ? outer_dims_[k] : 1;
+        stride1 *= full1[k] ? outer_dims_[k] : 1;
+        rows_ *= outer_dims_[k];
+    }
+
+    if (dims.size() == 1) {
+        kind_ = row_scalar0_ || row_scalar1_ ? kind::scalar : kind::same_shape;
+    } else if (row_scalar0_ || row_scalar1_) {
+        kind_ = kind::channel;
+    } else {
+        kind_ = dims.size() == 2 ? kind::trailing_row : kind::general;
+    }
+
+    rows_per_task_ = std::max<size_t>(1, task_size / row_size_);
+}
+
+broadcast_plan::kind broadcast_plan::get_kind() const {
+    return kind_;
+}
+
+const std::vector<size_t>& broadcast_plan::output_dims() const {
+    return output_dims_;
+}
+
+size_t broadcast_plan::output_size() const {
+    size_t size = 1;
+    for (size_t d : output_dims_) {
+        size *= d;
+    }
+    return size;
+}
+
+size_t broadcast_plan::rows() const {
+    return rows_;
+}
+
+size_t broadcast_plan::row_size() const {
+    return row_size_;
+}
+
+bool broadcast_plan::row_scalar0() const {
+    return row_scalar0_;
+}
+
+bool broadcast_plan::row_scalar1() const {
+    return row_scalar1_;
+}
+
+size_t broadcast_plan::row_offset(const std::vector<size_t>& strides, size_t row) const {
+    size_t offset = 0;
+    for (size_t k = outer_dims_.size(); k-- > 0;) {
+        offset += (row % outer_dims_[k]) * strides[k];
+        row /= outer_dims_[k];
+    }
+    return offset;
+}
+
+size_t broadcast_plan::row_offset0(size_t row) const {
+    return row_offset(outer_strides0_, row);
+}
+
+size_t broadcast_plan::row_offset1(size_t row) const {
+    return row_offset(outer_strides1_, row);
+}
+
+size_t broadcast_plan::task_count() const {
+    if (rows_ == 1) {
+        return (row_size_ + task_size - 1) / task_size;
+    }
+    return (rows_ + rows_per_task_ - 1) / rows_per_task_;
+}
+
+void broadcast_plan::run(mmpack::MmBinaryOpType op,
+                         const mm_scalar* in0,
+                         const mm_scalar* in1,
+                         mm_scalar* out,
+                         size_t task) const {
+    auto run_row = [&](const mm_scalar* a, const mm_scalar* b, mm_scalar* c, size_t n) {
+        if (row_scalar0_) {
+            mmpack::MmBinaryScalarA(op, *a, b, c, n);
+        } else if (row_scalar1_) {
+            mmpack::MmBinaryScalarB(op, a, *b, c, n);
+        } else {
+            mmpack::MmBinary(op, a, b, c, n);
+        }
+    };
+
+    // Единственная строка (same_shape, scalar) делится на отрезки
+    if (rows_ == 1) {
+        const size_t begin = task * task_size;
+        const size_t n = std::min(task_size, row_size_ - begin);
+        run_row(in0 + (row_scalar0_ ? 0 : begin), in1 + (row_scalar1_ ? 0 : begin), out + begin, n);
+        return;
+    }
+
+    const size_t begin = task * rows_per_task_;
+    const size_t end = std::min(rows_, begin + rows_per_task_);
+    for (size_t row = begin; row < end; ++row) {
+        run_row(in0 + row_offset0(row), in1 + row_offset1(row), out + row * row_size_, row_size_);
+    }
+}
+
 } // xsdnn
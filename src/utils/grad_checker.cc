@@ -35,6 +35,8 @@ GradChecker::GradChecker(const GradChecker &) = default;
 GradChecker& GradChecker::operator=(const xsdnn::GradChecker &) = default;
 
 GradChecker::status GradChecker::run() {
+    l_ptr_->set_training(true);
+
     size_t in_concept = l_ptr_->in_concept();
     size_t out_concept = l_ptr_->out_concept();
 
@@ -102,10 +104,13 @@ mm_scalar GradChecker::numeric_gradient(layer *l_ptr, std::vector<tensor_t> in_d
     std::vector<tensor_t*> out_ = internal::tensor2ptr(out_data);
     for (auto &tensor : out_data) tensorize::fill(tensor, 0.0f);
     mm_scalar prev_value = (*in_[in_concept_idx])[0][in_position_idx];
+    // Веса передаются в forward напрямую, поэтому кэши слоя, построенные по весам, сбрасываются
     (*in_[in_concept_idx])[0][in_position_idx] = prev_value + h;
+    l_ptr_->weights_changed();
     l_ptr_->forward_propagation(in_, out_);
     mm_scalar out_1 = (*out_[out_concept_idx])[0][out_position_idx];
     (*in_[in_concept_idx])[0][in_position_idx] = prev_value - h;
+    l_ptr_->weights_changed();
     l_ptr_->forward_propagation(in_, out_);
     mm_scalar out_2 = (*out_[out_concept_idx])[0][out_position_idx];
     return (out_1 - out_2) / (2 * h);
@@ -123,6 +128,7 @@ mm_scalar GradChecker::analytical_gradient(layer *l_ptr, std::vector<tensor_t> i
     for (auto &tensor : out_data) tensorize::fill(tensor, 0.0f);
     std::vector<tensor_t *> out_grads_ = internal::tensor2ptr(out_grad);
     out_grad[out_concept_idx][0][out_position_idx]    = 1.0f;  // set target grad to 1.
+    l_ptr->weights_changed();
     l_ptr->forward_propagation(in_data_, out_data_);
     l_ptr->back_propagation(in_data_, out_data_, out_grads_, in_grads_);
     return in_grad[in_concept_idx][0][in_position_idx];
@@ -94,12 +94,25 @@ size_t calc_pool_shape(size_t in_size,
     return (ceil ? std::ceil(ir_out_size) : std::floor(ir_out_size));
 }
 
+void calc_pool_padding(size_t in_size,
+                       size_t out_size,
+                       size_t kernel,
+                       size_t stride,
+                       padding_mode pad_type,
+                       size_t* pad_begin,
+                       size_t* pad_end) {
+    const size_t need = (out_size - 1) * stride + kernel;
+    const size_t total = need > in_size ? need - in_size : 0;
+    *pad_begin = pad_type == padding_mode::same ? total / 2 : 0;
+    *pad_end = total - *pad_begin;
+}
+
 bool is_1D_tensor(shape3d in) {
-    return in.C == 1 && in.H == 1 && in.W > 1;
+    return in.H == 1 && in.W > 1;
 }
 
 bool is_2D_tensor(shape3d in) {
-    return in.C > 1 && in.H > 1 && in.W > 1;
+    return in.H > 1 && in.W > 1;
 }
 
 std::string convert_pad_to_string(padding_mode mode) {
@@ -0,0 +1,180 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <functional>
+#include "../include/utils/grad_checker.h"
+#include "test_utils.h"
+using namespace xsdnn;
+
+namespace {
+
+/*
+ * Прямой проход слоя на сетке [-6, 6] против double эталона. Размер 37 не кратен
+ * ширине вектора, поэтому проверяется и хвост.
+ */
+void check_forward(activation_layer& act, const std::function<double(double)>& reference) {
+    const size_t size = 37;
+    mat_t in(size);
+    for (size_t i = 0; i < size; ++i) {
+        in[i] = -6.0f + 12.0f * float(i) / float(size - 1);
+    }
+
+    act.set_in_shape(shape3d(1, 1, size));
+    act.setup(false);
+    act.set_parallelize(false);
+    act.set_in_data({{ in }});
+    act.forward();
+
+    const mat_t out = act.output()[0][0];
+    for (size_t i = 0; i < size; ++i) {
+        const double ex = reference(in[i]);
+        ASSERT_NEAR(out[i], ex, 1e-6 * std::max(1.0, std::abs(ex))) << act.layer_type() << " x = " << in[i];
+    }
+}
+
+void check_backward(activation_layer& act) {
+    act.set_in_shape(shape3d(1, 1, 263));
+    act.set_parallelize(false);
+    GradChecker checker(&act, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok) << act.layer_type();
+}
+
+double sigmoid_ref(double x) {
+    return 1.0 / (1.0 + std::exp(-x));
+}
+
+} // namespace
+
+TEST(activation, forward) {
+    xsdnn::sigmoid sg;
+    xsdnn::tanh th;
+    gelu gl;
+    silu sl;
+    leaky_relu lr(0.1f);
+    elu el(0.7f);
+
+    check_forward(sg, sigmoid_ref);
+    check_forward(th, [](double x) { return std::tanh(x); });
+    check_forward(gl, [](double x) { return 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0))); });
+    check_forward(sl, [](double x) { return x * sigmoid_ref(x); });
+    check_forward(lr, [](double x) { return x < 0.0 ? 0.1 * x : x; });
+    check_forward(el, [](double x) { return x < 0.0 ? 0.7 * (std::exp(x) - 1.0) : x; });
+}
+
+TEST(activation, backward) {
+    xsdnn::sigmoid sg;
+    xsdnn::tanh th;
+    gelu gl;
+    silu sl;
+    leaky_relu lr(0.1f);
+    elu el(0.7f);
+    hard_sigmoid hs;
+
+    check_backward(sg);
+    check_backward(th);
+    check_backward(gl);
+    check_backward(sl);
+    check_backward(lr);
+    check_backward(el);
+    check_backward(hs);
+}
+
+TEST(activation, fused_fc_backward) {
+    for (MmActivationType type : {MmActivationType::Sigmoid, MmActivationType::Tanh, MmActivationType::Gelu,
+                                  MmActivationType::Silu, MmActivationType::LeakyRelu, MmActivationType::Elu}) {
+        fully_connected fc(30, 21, true, type);
+        GradChecker checker(&fc, GradChecker::mode::random);
+        ASSERT_EQ(checker.run(), GradChecker::status::ok) << type;
+    }
+}
+
+TEST(activation, fused_conv_backward) {
+    for (MmActivationType type : {MmActivationType::Gelu, MmActivationType::Silu, MmActivationType::Elu}) {
+        conv c(shape3d(3, 7, 9), 4, {3, 3}, 1, true, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1}, type);
+        c.set_parallelize(false);
+        GradChecker checker(&c, GradChecker::mode::random);
+        ASSERT_EQ(checker.run(), GradChecker::status::ok) << type;
+    }
+}
+
+TEST(activation, fused_conv_pool_predict) {
+    network<sequential> net;
+    net << conv(shape3d(3, 20, 20), 8, {3, 3}, 1, true, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1})
+        << gelu()
+        << leaky_relu(0.2f)
+        << max_pooling(shape3d(8, 20, 20), 2, 2);
+    net.init_weight();
+
+    std::vector<tensor_t> X(2, tensor_t(1, mat_t(3 * 20 * 20)));
+    for (auto& x : X) {
+        utils::random_init(x[0].data(), x[0].size());
+    }
+
+    const std::vector<tensor_t> Fused = net.predict(X);
+    ASSERT_TRUE(net[1]->absorbed() && net[2]->absorbed() && net[3]->absorbed());
+
+    net.set_layer_fusion(false);
+    const std::vector<tensor_t> Expected = net.predict(X);
+
+    for (size_t sample = 0; sample < X.size(); ++sample) {
+        const mat_t& E = Expected[sample][0];
+        const mat_t& A = Fused[sample][0];
+        for (size_t i = 0; i < E.size(); ++i) {
+            ASSERT_NEAR(E[i], A[i], 1e-4f * std::max(1.0f, std::abs(E[i])));
+        }
+    }
+}
+
+TEST(activation, cerial) {
+    xsdnn::sigmoid sg(size_t(16));
+    xsdnn::tanh th(size_t(16));
+    gelu gl(size_t(16));
+    silu sl(size_t(16));
+    ASSERT_TRUE(utils::cerial_testing(sg));
+    ASSERT_TRUE(utils::cerial_testing(th));
+    ASSERT_TRUE(utils::cerial_testing(gl));
+    ASSERT_TRUE(utils::cerial_testing(sl));
+
+    network<sequential> saver;
+    saver << fully_connected(8, 6) << leaky_relu(0.3f) << fully_connected(6, 5) << elu(0.5f);
+    saver.init_weight();
+    saver.save("activation_model.xs");
+
+    network<sequential> loader;
+    loader.load("activation_model.xs");
+    ASSERT_EQ(loader[1]->layer_type(), "leaky_relu");
+    ASSERT_EQ(loader[3]->layer_type(), "elu");
+
+    mat_t in(8);
+    utils::random_init(in.data(), in.size());
+    const mat_t exp = saver.predict(in);
+    const mat_t out = loader.predict(in);
+    ASSERT_EQ(out.size(), exp.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_FLOAT_EQ(out[i], exp[i]);
+    }
+    // Встроенная активация свертки сохраняется вместе со слоем
+    network<sequential> conv_saver;
+    conv_saver << xsdnn::conv(shape3d(2, 5, 5), 3, {3, 3}, 1, true, {1, 1}, {1, 1},
+                              padding_mode::notset, {1, 1, 1, 1}, MmActivationType::Gelu);
+    conv_saver.init_weight();
+    conv_saver.save("conv_activation_model.xs");
+
+    network<sequential> conv_loader;
+    conv_loader.load("conv_activation_model.xs");
+    ASSERT_EQ(dynamic_cast<xsdnn::conv*>(conv_loader[0])->get_params().activation_type_, MmActivationType::Gelu);
+
+    mat_t conv_in(2 * 5 * 5);
+    utils::random_init(conv_in.data(), conv_in.size());
+    const mat_t conv_exp = conv_saver.predict(conv_in);
+    const mat_t conv_out = conv_loader.predict(conv_in);
+    ASSERT_EQ(conv_out.size(), conv_exp.size());
+    for (size_t i = 0; i < conv_out.size(); ++i) {
+        ASSERT_FLOAT_EQ(conv_out[i], conv_exp[i]);
+    }
+}
@@ -0,0 +1,142 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "../include/utils/grad_checker.h"
+using namespace xsdnn;
+
+/*
+ * Наивный average pooling с заполнением в формате (y_begin, x_begin, y_end, x_end).
+ */
+static mat_t reference_avg_pool(const mat_t& in, const params::avg_pool& p) {
+    shape3d is = p.in_shape_;
+    shape3d os = p.out_shape_;
+    const ptrdiff_t H = is.H, W = is.W;
+    mat_t out(os.size());
+
+    for (size_t c = 0; c < os.C; ++c) {
+        for (size_t y = 0; y < os.H; ++y) {
+            for (size_t x = 0; x < os.W; ++x) {
+                mm_scalar sum = 0;
+                size_t count = 0;
+                for (size_t ky = 0; ky < p.kernel_y_; ++ky) {
+                    for (size_t kx = 0; kx < p.kernel_x_; ++kx) {
+                        const ptrdiff_t iy = ptrdiff_t(y * p.stride_y_ + ky) - ptrdiff_t(p._.Padding[0]);
+                        const ptrdiff_t ix = ptrdiff_t(x * p.stride_x_ + kx) - ptrdiff_t(p._.Padding[1]);
+                        const bool inside = iy >= 0 && ix >= 0 && iy < H && ix < W;
+                        const bool padded = iy < H + ptrdiff_t(p._.Padding[2]) && ix < W + ptrdiff_t(p._.Padding[3]);
+                        if (inside) sum += in[is(c, size_t(iy), size_t(ix))];
+                        if (inside || (p.count_include_pad_ && padded)) ++count;
+                    }
+                }
+                out[os(c, y, x)] = sum / count;
+            }
+        }
+    }
+    return out;
+}
+
+TEST(average_pooling, forward) {
+    shape3d in_shape(1, 4, 4);
+    average_pooling pool(in_shape, 2, 2);
+    mat_t in_data = {1, 2, 6, 3,
+                     3, 5, 2, 1,
+                     1, 2, 2, 1,
+                     7, 3, 4, 8};
+    pool.setup(false);
+    pool.set_parallelize(false);
+    pool.set_in_data({{ in_data }});
+    pool.forward();
+
+    const auto out = pool.output()[0][0];
+    mat_t exp = {2.75f, 3.0f, 3.25f, 3.75f};
+    ASSERT_EQ(out.size(), exp.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_FLOAT_EQ(out[i], exp[i]);
+    }
+}
+
+TEST(average_pooling, count_include_pad) {
+    shape3d in_shape(1, 1, 4);
+    average_pooling exclude(in_shape, 3, 1, 1, 1, padding_mode::same, false);
+    average_pooling include(in_shape, 3, 1, 1, 1, padding_mode::same, true);
+    mat_t in_data = {3, 6, 9, 12};
+
+    for (auto* pool : {&exclude, &include}) {
+        pool->setup(false);
+        pool->set_parallelize(false);
+        pool->set_in_data({{ in_data }});
+        pool->forward();
+    }
+
+    mat_t exp_exclude = {4.5f, 6.0f, 9.0f, 10.5f};
+    mat_t exp_include = {3.0f, 6.0f, 9.0f, 7.0f};
+    for (size_t i = 0; i < in_data.size(); ++i) {
+        ASSERT_FLOAT_EQ(exclude.output()[0][0][i], exp_exclude[i]);
+        ASSERT_FLOAT_EQ(include.output()[0][0][i], exp_include[i]);
+    }
+}
+
+TEST(average_pooling, forward_vs_reference) {
+    struct pool_case { size_t kernel; size_t stride; padding_mode pad; bool include_pad; };
+    const pool_case cases[] = {
+            {2, 2, padding_mode::valid, false}, {2, 2, padding_mode::same, true},
+            {3, 2, padding_mode::same, false},  {3, 2, padding_mode::same, true},
+            {3, 1, padding_mode::valid, false}, {3, 1, padding_mode::same, false},
+            {5, 1, padding_mode::same, true},   {4, 3, padding_mode::same, false}
+    };
+
+    for (const auto& pc : cases) {
+        for (size_t width : {6, 16, 21, 35}) {
+            shape3d in_shape(3, 8, width);
+            average_pooling pool(in_shape, pc.kernel, pc.stride, pc.pad, pc.include_pad);
+            mat_t in_data(in_shape.size());
+            utils::random_init(in_data.data(), in_data.size());
+
+            pool.setup(false);
+            pool.set_parallelize(false);
+            pool.set_in_data({{ in_data }});
+            pool.forward();
+
+            const auto out = pool.output()[0][0];
+            const auto exp = reference_avg_pool(in_data, pool.get_params());
+            ASSERT_EQ(out.size(), exp.size());
+            for (size_t i = 0; i < out.size(); ++i) {
+                ASSERT_NEAR(out[i], exp[i], 1e-5f) << "kernel " << pc.kernel << " stride " << pc.stride
+                                                   << " width " << width << " at " << i;
+            }
+        }
+    }
+}
+
+TEST(average_pooling, backward) {
+    average_pooling pool(shape3d(3, 8, 8), 2, 2);
+    pool.set_parallelize(false);
+    GradChecker checker(&pool, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(average_pooling, backward_overlapping_padding_same) {
+    average_pooling pool(shape3d(2, 7, 9), 3, 2, padding_mode::same, true);
+    pool.set_parallelize(false);
+    GradChecker checker(&pool, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(average_pooling, cerial) {
+    shape3d in_shape(3, 32, 32);
+    average_pooling pool(in_shape, 3, 2, padding_mode::same, true);
+    ASSERT_TRUE(utils::cerial_testing(pool));
+
+    network<sequential> loader;
+    loader.load("./layer_cerial_tmp_directory/average_pooling");
+    const auto* loaded = dynamic_cast<const average_pooling*>(loader[0]);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->get_params().pad_type_, padding_mode::same);
+    ASSERT_TRUE(loaded->get_params().count_include_pad_);
+    ASSERT_EQ(loaded->out_shape()[0].size(), pool.out_shape()[0].size());
+}
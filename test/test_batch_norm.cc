@@ -5,6 +5,8 @@
 
 #include "xsdnn.h"
 #include <gtest/gtest.h>
+#include "test_utils.h"
+#include "../include/utils/grad_checker.h"
 
 TEST(batch_norm, simple_forward) {
     xsdnn::batch_norm bn;
@@ -27,4 +29,147 @@ TEST(batch_norm, simple_forward) {
         ASSERT_FLOAT_EQ(out[i], ex[i]);
 #endif
     }
-}
\ No newline at end of file
+}
+
+TEST(batch_norm, forward_nhwc) {
+    const xsdnn::shape3d shape(3, 2, 4);
+    xsdnn::batch_norm nchw, nhwc;
+    ASSERT_TRUE(nhwc.set_layout(xsdnn::tensor_layout::nhwc));
+
+    xsdnn::mat_t in_data(shape.size()), in_data_nhwc(shape.size());
+    utils::random_init(in_data.data(), in_data.size());
+    mmpack::MmTranspose(in_data.data(), in_data_nhwc.data(), shape.C, shape.area());
+
+    for (auto* bn : {&nchw, &nhwc}) {
+        bn->set_in_shape(shape);
+        bn->setup(false);
+        bn->set_parallelize(false);
+    }
+    nchw.set_in_data({{ in_data }});
+    nhwc.set_in_data({{ in_data_nhwc }});
+    nchw.forward();
+    nhwc.forward();
+
+    const xsdnn::mat_t out = nchw.output()[0][0];
+    const xsdnn::mat_t out_nhwc = nhwc.output()[0][0];
+    xsdnn::mat_t out_back(out.size());
+    mmpack::MmTranspose(out_nhwc.data(), out_back.data(), shape.area(), shape.C);
+
+    for (size_t i = 0; i < out.size(); ++i) {
+#ifdef MM_USE_DOUBLE
+#error NotImplementedYet
+#else
+        ASSERT_NEAR(out[i], out_back[i], 1e-5f);
+#endif
+    }
+}
+
+TEST(batch_norm, cerial) {
+    xsdnn::batch_norm bn(0.9f, 1e-3f, xsdnn::op_mode::inference);
+    bn.set_in_shape(xsdnn::shape3d(3, 2, 2));
+    bn.set_statistics({0.5f, -1.0f, 2.0f}, {1.0f, 2.0f, 0.5f});
+    ASSERT_TRUE(utils::cerial_testing(bn));
+}
+
+TEST(batch_norm, train_statistics_vs_reference) {
+    const xsdnn::shape3d shape(5, 7, 9);
+    const size_t samples = 4;
+    const size_t spatial = shape.H * shape.W;
+
+    // Большое смещение проверяет точность дисперсии, повторный forward - что статистики не накапливаются
+    xsdnn::tensor_t in(samples, xsdnn::mat_t(shape.size()));
+    for (auto& sample : in) {
+        utils::random_init(sample.data(), sample.size());
+        for (auto& v : sample) {
+            v += 1000.0f;
+        }
+    }
+
+    xsdnn::batch_norm bn;
+    bn.set_in_shape(shape);
+    bn.set_in_data({ in });
+    bn.setup(false);
+    bn.forward();
+    bn.forward();
+
+    const xsdnn::tensor_t out = bn.output()[0];
+    for (size_t c = 0; c < shape.C; ++c) {
+        double mean = 0.0, var = 0.0;
+        for (const auto& sample : in) {
+            for (size_t i = 0; i < spatial; ++i) {
+                mean += sample[c * spatial + i];
+            }
+        }
+        mean /= double(samples * spatial);
+        for (const auto& sample : in) {
+            for (size_t i = 0; i < spatial; ++i) {
+                var += (sample[c * spatial + i] - mean) * (sample[c * spatial + i] - mean);
+            }
+        }
+        var /= double(samples * spatial - 1);
+
+        for (size_t s = 0; s < samples; ++s) {
+            for (size_t i = 0; i < spatial; ++i) {
+                const double ex = (in[s][c * spatial + i] - mean) / std::sqrt(var + 1e-5);
+                ASSERT_NEAR(out[s][c * spatial + i], ex, 1e-3);
+            }
+        }
+    }
+}
+
+TEST(batch_norm, backward) {
+    xsdnn::batch_norm bn;
+    bn.set_in_shape(xsdnn::shape3d(3, 5, 6));
+    bn.set_parallelize(false);
+    xsdnn::GradChecker checker(&bn, xsdnn::GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), xsdnn::GradChecker::status::ok);
+}
+
+TEST(batch_norm, backward_nhwc) {
+    xsdnn::batch_norm bn;
+    ASSERT_TRUE(bn.set_layout(xsdnn::tensor_layout::nhwc));
+    bn.set_in_shape(xsdnn::shape3d(4, 3, 5));
+    xsdnn::GradChecker checker(&bn, xsdnn::GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), xsdnn::GradChecker::status::ok);
+}
+
+TEST(batch_norm, backward_inference) {
+    xsdnn::batch_norm bn(0.9f, 1e-5f, xsdnn::op_mode::inference);
+    bn.set_in_shape(xsdnn::shape3d(3, 4, 4));
+    bn.set_statistics({0.5f, -1.0f, 0.1f}, {1.5f, 2.0f, 0.5f});
+    xsdnn::GradChecker checker(&bn, xsdnn::GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), xsdnn::GradChecker::status::ok);
+}
+
+TEST(batch_norm, inference_follows_statistics_and_weights) {
+    const xsdnn::shape3d shape(3, 3, 7);
+    xsdnn::mat_t in_data(shape.size());
+    utils::random_init(in_data.data(), in_data.size());
+
+    xsdnn::batch_norm bn(0.9f, 1e-5f, xsdnn::op_mode::inference);
+    bn.set_in_shape(shape);
+    bn.set_in_data({{ in_data }});
+    bn.setup(false);
+    bn.set_statistics({0.5f, -1.0f, 0.1f}, {1.5f, 2.0f, 0.5f});
+    bn.forward();
+
+    // Кэш scale / shift должен пересчитываться после смены статистик и весов
+    const xsdnn::mat_t mean = {-0.2f, 0.3f, 1.0f};
+    const xsdnn::mat_t stddev = {0.7f, 1.1f, 3.0f};
+    bn.set_statistics(mean, stddev);
+    xsdnn::mat_t& gamma = *bn.weights()[0];
+    xsdnn::mat_t& beta = *bn.weights()[1];
+    gamma = {2.0f, -1.0f, 0.5f};
+    beta = {0.1f, 0.2f, -0.3f};
+    bn.weights_changed();
+    bn.forward();
+
+    const xsdnn::mat_t out = bn.output()[0][0];
+    const size_t spatial = shape.H * shape.W;
+    for (size_t c = 0; c < shape.C; ++c) {
+        for (size_t i = 0; i < spatial; ++i) {
+            const float ex = gamma[c] * (in_data[c * spatial + i] - mean[c]) / stddev[c] + beta[c];
+            ASSERT_NEAR(out[c * spatial + i], ex, 1e-5f);
+        }
+    }
+}
@@ -0,0 +1,353 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../include/utils/broadcaster.h"
+#include "../include/utils/grad_checker.h"
+#include "test_utils.h"
+using namespace xsdnn;
+
+namespace {
+
+float apply(mmpack::MmBinaryOpType op, float a, float b) {
+    switch (op) {
+        case (mmpack::MmBinaryAdd): return a + b;
+        case (mmpack::MmBinarySub): return a - b;
+        case (mmpack::MmBinaryMul): return a * b;
+        case (mmpack::MmBinaryDiv): return a / b;
+        case (mmpack::MmBinaryMin): return b < a ? b : a;
+        case (mmpack::MmBinaryMax): return b > a ? b : a;
+        case (mmpack::MmBinaryPow): return std::pow(a, b);
+    }
+    return 0.0f;
+}
+
+/*
+ * Смещение элемента выхода с индексом out_index во входе формы shape (выравнивание по последним осям).
+ */
+size_t input_offset(const std::vector<size_t>& out_dims, size_t out_index, const std::vector<size_t>& shape) {
+    size_t offset = 0;
+    size_t stride = 1;
+    for (size_t k = out_dims.size(); k-- > 0;) {
+        const size_t coord = out_index % out_dims[k];
+        out_index /= out_dims[k];
+
+        const size_t rank_diff = out_dims.size() - shape.size();
+        if (k < rank_diff) {
+            continue;
+        }
+        const size_t dim = shape[k - rank_diff];
+        offset += (dim == 1 ? 0 : coord) * stride;
+        stride *= dim;
+    }
+    return offset;
+}
+
+mat_t reference(mmpack::MmBinaryOpType op, const broadcast_plan& plan,
+                const mat_t& in0, const std::vector<size_t>& shape0,
+                const mat_t& in1, const std::vector<size_t>& shape1) {
+    mat_t out(plan.output_size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = apply(op, in0[input_offset(plan.output_dims(), i, shape0)],
+                       in1[input_offset(plan.output_dims(), i, shape1)]);
+    }
+    return out;
+}
+
+size_t shape_size(const std::vector<size_t>& shape) {
+    size_t size = 1;
+    for (size_t d : shape) {
+        size *= d;
+    }
+    return size;
+}
+
+void uniform_positive(mat_t& x) {
+    utils::random_init(x.data(), x.size());
+    for (auto& v : x) {
+        v = 1.0f + 0.5f * v;
+    }
+}
+
+const std::vector<mmpack::MmBinaryOpType> all_ops = {
+    mmpack::MmBinaryAdd, mmpack::MmBinarySub, mmpack::MmBinaryMul, mmpack::MmBinaryDiv,
+    mmpack::MmBinaryMin, mmpack::MmBinaryMax, mmpack::MmBinaryPow
+};
+
+/*
+ * Положительные значения из сетки offset + 0.5 * k: при разных offset входы min / max
+ * не сближаются настолько, чтобы численная производная попала на излом.
+ */
+void grid_positive(mat_t& x, float offset) {
+    utils::random_init(x.data(), x.size());
+    for (auto& v : x) {
+        v = 1.0f + offset + 0.5f * std::floor(4.0f * v);
+    }
+}
+
+/*
+ * Численная проверка градиента по обоим входам для положительных входов (нужны div и pow).
+ * separated - входы на разных сетках (нужно min и max).
+ */
+void check_gradient(binary_layer& l, bool separated = false) {
+    const std::vector<shape3d> shapes = l.in_shape();
+    mat_t in0(shapes[0].size()), in1(shapes[1].size());
+    if (separated) {
+        grid_positive(in0, 0.0f);
+        grid_positive(in1, 0.25f);
+    } else {
+        uniform_positive(in0);
+        uniform_positive(in1);
+    }
+
+    const size_t out_size = l.out_shape()[0].size();
+    mat_t weight(out_size);
+    utils::random_init(weight.data(), weight.size());
+
+    // loss = <weight, out>
+    auto loss = [&](const mat_t& x0, const mat_t& x1) {
+        tensor_t a = {x0}, b = {x1}, y = {mat_t(out_size)};
+        std::vector<tensor_t*> in = {&a, &b};
+        std::vector<tensor_t*> out = {&y};
+        l.forward_propagation(in, out);
+        double s = 0.0;
+        for (size_t i = 0; i < out_size; ++i) {
+            s += double(weight[i]) * y[0][i];
+        }
+        return s;
+    };
+
+    tensor_t a = {in0}, b = {in1}, y = {mat_t(out_size)}, dy = {weight};
+    tensor_t da = {mat_t(in0.size())}, db = {mat_t(in1.size())};
+    std::vector<tensor_t*> in = {&a, &b}, out = {&y}, out_grad = {&dy}, in_grad = {&da, &db};
+    l.forward_propagation(in, out);
+    l.back_propagation(in, out, out_grad, in_grad);
+
+    const float eps = 1e-2f;
+    for (size_t input = 0; input < 2; ++input) {
+        mat_t& x = input == 0 ? in0 : in1;
+        const mat_t& analytic = input == 0 ? da[0] : db[0];
+        for (size_t i = 0; i < x.size(); i += 7) {
+            const float saved = x[i];
+            x[i] = saved + eps;
+            const double plus = loss(in0, in1);
+            x[i] = saved - eps;
+            const double minus = loss(in0, in1);
+            x[i] = saved;
+
+            const double numeric = (plus - minus) / (2.0 * eps);
+            ASSERT_NEAR(analytic[i], numeric, 1e-2 * std::max(1.0, std::abs(numeric)))
+                << l.layer_type() << " input " << input << " i = " << i;
+        }
+    }
+}
+
+} // namespace
+
+TEST(binary, plan_kind) {
+    using kind = broadcast_plan::kind;
+    using dims = std::vector<size_t>;
+
+    ASSERT_EQ(broadcast_plan(dims{2, 3, 4}, dims{2, 3, 4}).get_kind(), kind::same_shape);
+    ASSERT_EQ(broadcast_plan(dims{2, 3, 4}, dims{1}).get_kind(), kind::scalar);
+    ASSERT_EQ(broadcast_plan(dims{1, 1, 1}, dims{2, 3, 4}).get_kind(), kind::scalar);
+    ASSERT_EQ(broadcast_plan(dims{8, 16, 32}, dims{32}).get_kind(), kind::trailing_row);
+    ASSERT_EQ(broadcast_plan(dims{8, 16, 32}, dims{1, 16, 32}).get_kind(), kind::trailing_row);
+    ASSERT_EQ(broadcast_plan(dims{8, 16, 32}, dims{8, 1, 1}).get_kind(), kind::channel);
+    ASSERT_EQ(broadcast_plan(dims{2, 8, 16, 32}, dims{1, 8, 1, 1}).get_kind(), kind::channel);
+    ASSERT_EQ(broadcast_plan(dims{2, 8, 16, 32}, dims{2, 1, 16, 32}).get_kind(), kind::general);
+
+    // Оси размера 1 и оси с одинаковым поведением входов склеиваются
+    broadcast_plan plan(dims{4, 1, 6, 5}, dims{1, 3, 6, 5});
+    ASSERT_EQ(plan.output_dims(), dims({4, 3, 6, 5}));
+    ASSERT_EQ(plan.rows(), 12u);
+    ASSERT_EQ(plan.row_size(), 30u);
+
+    ASSERT_THROW(broadcast_plan(dims{2, 3}, dims{3, 3}), xs_error);
+}
+
+TEST(binary, plan_forward) {
+    const std::vector<std::pair<std::vector<size_t>, std::vector<size_t>>> cases = {
+        {{3, 5, 7}, {3, 5, 7}},
+        {{3, 5, 7}, {1}},
+        {{1}, {3, 5, 7}},
+        {{6, 9, 13}, {13}},
+        {{6, 9, 13}, {6, 1, 1}},
+        {{1, 9, 1}, {6, 1, 13}},
+        {{2, 3, 4, 5, 6}, {3, 1, 5, 1}},
+        {{2, 1, 4, 1, 6}, {1, 3, 1, 5, 1}},
+        {{5, 77, 77}, {5, 1, 77}},      // несколько частей выхода по строкам
+        {{40000}, {40000}}              // несколько отрезков одной строки
+    };
+
+    for (const auto& c : cases) {
+        mat_t in0(shape_size(c.first)), in1(shape_size(c.second));
+        uniform_positive(in0);
+        uniform_positive(in1);
+
+        broadcast_plan plan(c.first, c.second);
+        for (mmpack::MmBinaryOpType op : all_ops) {
+            mat_t out(plan.output_size());
+            for (size_t task = 0; task < plan.task_count(); ++task) {
+                plan.run(op, in0.data(), in1.data(), out.data(), task);
+            }
+
+            const mat_t ex = reference(op, plan, in0, c.first, in1, c.second);
+            for (size_t i = 0; i < out.size(); ++i) {
+                ASSERT_NEAR(out[i], ex[i], 1e-6f * std::max(1.0f, std::abs(ex[i])))
+                    << "op = " << op << " i = " << i;
+            }
+        }
+    }
+}
+
+TEST(binary, pow_accuracy) {
+    const size_t size = 1001;
+    mat_t a(size), b(size), c(size);
+    for (size_t i = 0; i < size; ++i) {
+        a[i] = 0.01f + 10.0f * float(i) / float(size);
+        b[i] = -4.0f + 8.0f * float((i * 37) % size) / float(size);
+    }
+    // Нерегулярные основания считаются через libm
+    a[3] = 0.0f;
+    b[3] = 2.0f;
+    a[10] = -2.0f;
+    b[10] = 3.0f;
+
+    mmpack::MmBinary(mmpack::MmBinaryPow, a.data(), b.data(), c.data(), size);
+    for (size_t i = 0; i < size; ++i) {
+        const double ex = std::pow(double(a[i]), double(b[i]));
+        ASSERT_NEAR(c[i], ex, 1e-5 * std::abs(ex)) << a[i] << " ^ " << b[i];
+    }
+}
+
+TEST(binary, layers_forward) {
+    const shape3d shape0(4, 66, 67);
+    const shape3d shape1(4, 1, 1);
+    mat_t in0(shape0.size()), in1(shape1.size());
+    uniform_positive(in0);
+    uniform_positive(in1);
+
+    xsdnn::sub s(shape0, shape1);
+    xsdnn::mul m(shape0, shape1);
+    xsdnn::div d(shape0, shape1);
+    xsdnn::min mn(shape0, shape1);
+    xsdnn::max mx(shape0, shape1);
+    xsdnn::pow p(shape0, shape1);
+    xsdnn::add a(shape0, shape1);
+
+    const broadcast_plan plan(shape0, shape1);
+    const std::vector<std::pair<layer*, mmpack::MmBinaryOpType>> layers = {
+        {&a, mmpack::MmBinaryAdd}, {&s, mmpack::MmBinarySub}, {&m, mmpack::MmBinaryMul},
+        {&d, mmpack::MmBinaryDiv}, {&mn, mmpack::MmBinaryMin}, {&mx, mmpack::MmBinaryMax},
+        {&p, mmpack::MmBinaryPow}
+    };
+
+    for (const auto& l : layers) {
+        shape3d out_shape = l.first->out_shape()[0];
+        ASSERT_TRUE(out_shape == shape0);
+        l.first->set_parallelize(true);
+        l.first->set_num_threads(4);
+        l.first->set_in_data({{ in0 }, { in1 }});
+        l.first->forward();
+
+        const mat_t out = l.first->output()[0][0];
+        const mat_t ex = reference(l.second, plan, in0, {shape0.C, shape0.H, shape0.W},
+                                   in1, {shape1.C, shape1.H, shape1.W});
+        for (size_t i = 0; i < out.size(); ++i) {
+            ASSERT_NEAR(out[i], ex[i], 1e-6f * std::max(1.0f, std::abs(ex[i]))) << l.first->layer_type();
+        }
+    }
+}
+
+TEST(binary, backward) {
+    const std::vector<std::pair<shape3d, shape3d>> shapes = {
+        {shape3d(2, 5, 7), shape3d(2, 5, 7)},
+        {shape3d(2, 5, 7), shape3d(1, 1, 7)},
+        {shape3d(3, 1, 7), shape3d(3, 5, 1)},
+        {shape3d(1, 1, 1), shape3d(2, 5, 7)}
+    };
+
+    for (const auto& s : shapes) {
+        xsdnn::add a(s.first, s.second);
+        xsdnn::sub sb(s.first, s.second);
+        xsdnn::mul m(s.first, s.second);
+        for (layer* l : std::vector<layer*>{&a, &sb, &m}) {
+            l->set_parallelize(false);
+            GradChecker checker(l, GradChecker::mode::random);
+            ASSERT_EQ(checker.run(), GradChecker::status::ok) << l->layer_type();
+        }
+
+        xsdnn::div d(s.first, s.second);
+        xsdnn::pow p(s.first, s.second);
+        xsdnn::mul m2(s.first, s.second);
+        check_gradient(d);
+        check_gradient(p);
+        check_gradient(m2);
+
+        xsdnn::min mn(s.first, s.second);
+        xsdnn::max mx(s.first, s.second);
+        check_gradient(mn, true);
+        check_gradient(mx, true);
+    }
+}
+
+TEST(binary, layout_sensitive) {
+    // Входы одной формы и скаляр не зависят от порядка хранения, остальной broadcasting - зависит
+    xsdnn::add a(2, shape3d(3, 4, 5));
+    xsdnn::add ab(shape3d(3, 4, 5), shape3d(3, 1, 1));
+    xsdnn::mul m(shape3d(3, 4, 5));
+    xsdnn::mul mb(shape3d(3, 4, 5), shape3d(1, 1, 5));
+    xsdnn::sub s(shape3d(1, 1, 1), shape3d(3, 4, 5));
+    xsdnn::div db(shape3d(3, 4, 5), shape3d(3, 4, 1));
+    ASSERT_FALSE(a.layout_sensitive());
+    ASSERT_FALSE(m.layout_sensitive());
+    ASSERT_FALSE(s.layout_sensitive());
+    ASSERT_TRUE(ab.layout_sensitive());
+    ASSERT_TRUE(mb.layout_sensitive());
+    ASSERT_TRUE(db.layout_sensitive());
+}
+
+TEST(binary, cerial) {
+    xsdnn::sub s(shape3d(3, 4, 5), shape3d(3, 1, 1));
+    xsdnn::mul m(shape3d(3, 4, 5));
+    xsdnn::div d(shape3d(1, 1, 5), shape3d(3, 4, 5));
+    xsdnn::min mn(size_t(16));
+    xsdnn::max mx(shape3d(2, 2, 2));
+    xsdnn::pow p(shape3d(3, 4, 5), shape3d(1, 1, 1));
+    ASSERT_TRUE(utils::cerial_testing(s));
+    ASSERT_TRUE(utils::cerial_testing(m));
+    ASSERT_TRUE(utils::cerial_testing(d));
+    ASSERT_TRUE(utils::cerial_testing(mn));
+    ASSERT_TRUE(utils::cerial_testing(mx));
+    ASSERT_TRUE(utils::cerial_testing(p));
+
+    // Формы входов add сохраняются только для broadcasting'а
+    network<graph> saver;
+    Input in0(shape3d(3, 4, 5));
+    Input in1(shape3d(3, 1, 1));
+    xsdnn::add a(shape3d(3, 4, 5), shape3d(3, 1, 1));
+    Output out;
+    connect(&in0, &a, 0, 0);
+    connect(&in1, &a, 0, 1);
+    connect(&a, &out, 0, 0);
+    construct_graph(saver, {&in0, &in1}, {&out});
+    saver.save("broadcast_add_model.xs");
+
+    network<graph> loader;
+    loader.load("broadcast_add_model.xs");
+
+    mat_t x0(60), x1(3);
+    utils::random_init(x0.data(), x0.size());
+    utils::random_init(x1.data(), x1.size());
+    const std::vector<tensor_t> ex = saver.predict(std::vector<tensor_t>{{x0, x1}});
+    const std::vector<tensor_t> res = loader.predict(std::vector<tensor_t>{{x0, x1}});
+    for (size_t i = 0; i < 60; ++i) {
+        ASSERT_FLOAT_EQ(res[0][0][i], ex[0][0][i]);
+        ASSERT_FLOAT_EQ(res[0][0][i], x0[i] + x1[i / 20]);
+    }
+}
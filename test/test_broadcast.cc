@@ -164,6 +164,17 @@ TEST(broadcast, general) {
     }
 }
 
-
-
-
+TEST(broadcast, rank4) {
+    broadcaster bc(std::vector<size_t>{2, 3, 4, 5}, std::vector<size_t>{3, 1, 1});
+    ASSERT_EQ(bc.output_dims_, std::vector<size_t>({2, 3, 4, 5}));
+
+    // Вход 1 повторяется вдоль W и H: на каждом шаге по 20 значений выхода его индекс растет на 1
+    const size_t span = bc.get_span_size();
+    ASSERT_EQ(span, 20u);
+    for (size_t step = 0; step < 6; ++step) {
+        ASSERT_EQ(bc.it1_.current(), step * span);
+        ASSERT_EQ(bc.it2_.current(), step % 3);
+        bc.it1_.advance_by(span);
+        bc.it2_.advance_by(span);
+    }
+}
@@ -7,6 +7,9 @@
 #include <gtest/gtest.h>
 #include <sys/mman.h>
 #include "test_utils.h"
+#include "test_conv_utils.h"
+#include "../include/utils/grad_checker.h"
+#include "../include/core/kernel/conv/conv_bwd_xs_impl.h"
 using namespace xsdnn;
 
 // TODO: проверить этот тест. In Shape для веса выдается некорректно
@@ -285,6 +288,322 @@ TEST(conv, cerial) {
     ASSERT_TRUE(utils::cerial_testing(c));
 }
 
+TEST(conv, indirect_matches_im2col) {
+    const auto shapes = utils::conv_test_shapes({
+            {4, 7, 6, 4, 4, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1},
+            {2, 1, 23, 5, 1, 1, 4, 0, 2, 0, 1, 1, 1, 1, 3},
+    });
+
+    utils::conv_matches_im2col(shapes, [](params::conv& Indirect) {
+        ASSERT_EQ(Indirect._.Algorithm, MM_CONV_PARAMS::Im2ColThenGemm);
+        Indirect.set_algorithm(MM_CONV_PARAMS::Indirect);
+
+        ASSERT_EQ(Indirect._.Algorithm, MM_CONV_PARAMS::Indirect);
+        ASSERT_EQ(Indirect.indirection_.size(),
+                  Indirect._.KernelShape[0] * Indirect._.KernelShape[1] * Indirect._.OutSize);
+        ASSERT_EQ(Indirect._.Indirection, Indirect.indirection_.data());
+    });
+}
+
+TEST(conv, nhwc_matches_nchw) {
+    const auto shapes = utils::conv_test_shapes({
+            {12, 6, 7, 6, 3, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1},
+    });
+
+    utils::conv_matches_im2col(shapes, [](params::conv& Nhwc) {
+        Nhwc.set_layout(tensor_layout::nhwc);
+    });
+}
+
+TEST(conv, packed_filter) {
+    params::conv Reference;
+    Reference._.Dimensions = 2;
+    Reference.infer_output_requirement_shape(shape3d(6, 9, 10), 10, 2, true, {3, 3}, {1, 1}, {1, 1},
+                                             padding_mode::notset, {1, 1, 1, 1}, MmActivationType::NotSet);
+
+    mat_t X(6 * 9 * 10), W(10 * Reference._.K), B(10), Zero(W.size(), 0.0f);
+    utils::random_init(X.data(), X.size());
+    utils::random_init(W.data(), W.size());
+    utils::random_init(B.data(), B.size());
+
+    const size_t OutSize = Reference._.OutSize;
+    mat_t Expected(10 * OutSize), ReferenceBuffer(Reference._.TemproraryBufferSize);
+    MmConv(&Reference._, X.data(), W.data(), B.data(), ReferenceBuffer.data(), Expected.data());
+
+
+    // Упакованные фильтры используются вместо переданных весов
+    params::conv Nchwc = Reference;
+    Nchwc.set_algorithm(MM_CONV_PARAMS::NchwcDirect);
+    Nchwc.pack_filter(W);
+    ASSERT_NE(Nchwc._.PackedFilter, nullptr);
+
+    params::conv Copy = Nchwc;
+    ASSERT_EQ(Copy._.PackedFilter, Copy.packed_filter_.data());
+
+    mat_t Actual(Expected.size()), Buffer(Nchwc._.TemproraryBufferSize);
+    MmConv(&Copy._, X.data(), Zero.data(), B.data(), Buffer.data(), Actual.data());
+    utils::assert_conv_near(Expected, Actual);
+
+    // Смена формата сбрасывает упаковку, NHWC упаковывает фильтры по-своему
+    params::conv Nhwc = Nchwc;
+    Nhwc.set_layout(tensor_layout::nhwc);
+    ASSERT_EQ(Nhwc._.PackedFilter, nullptr);
+    Nhwc.pack_filter(W);
+    ASSERT_NE(Nhwc._.PackedFilter, nullptr);
+
+    mat_t XNhwc(X.size()), ActualNhwc(Expected.size()), NhwcBuffer(Nhwc._.TemproraryBufferSize);
+    MmTranspose(X.data(), XNhwc.data(), 6, 9 * 10);
+    MmConvNhwc(&Nhwc._, XNhwc.data(), Zero.data(), B.data(), NhwcBuffer.data(), ActualNhwc.data());
+    MmTranspose(ActualNhwc.data(), Actual.data(), OutSize, 10);
+    utils::assert_conv_near(Expected, Actual);
+
+    // Im2Col читает веса напрямую и ничего не упаковывает
+    params::conv Im2Col = Reference;
+    Im2Col.pack_filter(W);
+    ASSERT_EQ(Im2Col._.PackedFilter, nullptr);
+}
+
+TEST(conv, packed_filter_follows_weights) {
+    conv c(shape3d(4, 8, 8), /*out_channel=*/ 4, /*kernel_shape=*/ {3, 3},
+           /*group_count=*/ 1, /*has_bias=*/ false,
+           /*stride_shape=*/ {1, 1}, /*dilation_shape=*/ {1, 1},
+           /*pad_type=*/padding_mode::notset, /*pads=*/ {1, 1, 1, 1});
+    c.set_layout(tensor_layout::nhwc);
+    c.set_parallelize(false);
+    c.setup(false);
+
+    mat_t X(4 * 8 * 8);
+    utils::random_init(X.data(), X.size());
+    c.set_in_data({{ X }});
+
+    mat_t& W = *c.weights()[0];
+    utils::random_init(W.data(), W.size());
+    c.forward();
+    const mat_t First = c.output()[0][0];
+
+    for (auto& w : W) w *= 2.0f;
+    c.weights_changed();
+    c.forward();
+    const mat_t Second = c.output()[0][0];
+
+    for (size_t i = 0; i < First.size(); ++i) {
+        ASSERT_NEAR(2.0f * First[i], Second[i], 1e-4f * std::max(1.0f, std::abs(Second[i])));
+    }
+}
+
+TEST(conv, _1D_params_check) {
+    conv c(shape3d(6, 1, 100), /*out_channel=*/ 4, /*kernel_shape=*/ {5},
+           /*group_count=*/ 2, /*has_bias=*/ true,
+           /*stride_shape=*/ {2}, /*dilation_shape=*/ {1},
+           /*pad_type=*/padding_mode::notset, /*pads=*/ {2, 1});
+
+    params::conv P = c.get_params();
+
+    ASSERT_EQ(P._.Dimensions, 1);
+    ASSERT_EQ(P._.InChannel, 3);
+    ASSERT_EQ(P._.InShape[0], 100);
+    ASSERT_EQ(P._.InSize, 100);
+    ASSERT_EQ(P._.OutShape[0], 50);
+    ASSERT_EQ(P._.OutSize, 50);
+    ASSERT_EQ(P._.K, 3 * 5);
+    ASSERT_EQ(P._.Padding[0], 2);
+    ASSERT_EQ(P._.Padding[1], 1);
+    ASSERT_EQ(P._.FilterCount, 2);
+    ASSERT_EQ(P._.Algorithm, P._.Im2ColThenGemm);
+
+    ASSERT_TRUE(c.in_shape()[0] == shape3d(6, 1, 100));
+    ASSERT_TRUE(c.in_shape()[1] == shape3d(4 * 3, 1, 5));
+    ASSERT_TRUE(c.out_shape()[0] == shape3d(4, 1, 50));
+}
+
+TEST(conv, _1D_matches_reference) {
+    struct Shape {
+        size_t C, W, F, G, KW, P0, P1, D, S;
+    };
+
+    const std::vector<Shape> shapes = {
+            {1, 64, 4, 1, 3, 1, 1, 1, 1},
+            {3, 37, 8, 1, 5, 2, 2, 1, 1},
+            {4, 50, 6, 2, 3, 0, 0, 2, 1},
+            {2, 23, 5, 1, 7, 3, 0, 1, 1},
+            {5, 41, 3, 1, 4, 1, 2, 1, 3},
+            {8, 9, 8, 8, 3, 1, 1, 1, 1},
+            {2, 6, 3, 1, 5, 4, 4, 2, 1},
+    };
+
+    for (const auto& s : shapes) {
+        params::conv Im2Col;
+        Im2Col._.Dimensions = 1;
+        Im2Col.infer_output_requirement_shape(shape3d(s.C, 1, s.W), s.F, s.G, true, {s.KW}, {s.S}, {s.D},
+                                              padding_mode::notset, {s.P0, s.P1}, MmActivationType::NotSet);
+        Im2Col.set_algorithm(MM_CONV_PARAMS::Im2ColThenGemm);
+
+        const size_t InC = s.C / s.G;
+        const size_t FilterCount = s.F / s.G;
+        const size_t OutWidth = Im2Col._.OutShape[0];
+
+        mat_t X(s.C * s.W), W(s.F * Im2Col._.K), B(s.F);
+        utils::random_init(X.data(), X.size());
+        utils::random_init(W.data(), W.size());
+        utils::random_init(B.data(), B.size());
+
+        mat_t Expected(s.F * OutWidth);
+        for (size_t g = 0; g < s.G; ++g) {
+            for (size_t f = 0; f < FilterCount; ++f) {
+                const size_t Filter = g * FilterCount + f;
+                for (size_t n = 0; n < OutWidth; ++n) {
+                    float Sum = B[Filter];
+                    for (size_t c = 0; c < InC; ++c) {
+                        for (size_t kx = 0; kx < s.KW; ++kx) {
+                            const long ix = long(n * s.S + kx * s.D) - long(s.P0);
+                            if (ix < 0 || ix >= long(s.W)) continue;
+                            Sum += W[(Filter * InC + c) * s.KW + kx] * X[(g * InC + c) * s.W + ix];
+                        }
+                    }
+                    Expected[Filter * OutWidth + n] = Sum;
+                }
+            }
+        }
+
+        std::vector<params::conv> Candidates = {Im2Col};
+        if (s.S == 1) {
+            params::conv Direct = Im2Col;
+            Direct.set_algorithm(MM_CONV_PARAMS::Direct1D);
+            Candidates.push_back(Direct);
+        }
+
+        for (const auto& P : Candidates) {
+            mat_t Actual(Expected.size()), Buffer(P._.TemproraryBufferSize);
+            MmConv(&P._, X.data(), W.data(), B.data(), Buffer.data(), Actual.data());
+            utils::assert_conv_near(Expected, Actual);
+        }
+    }
+}
+
+TEST(conv, _1D_cerial) {
+    conv c(shape3d(4, 1, 128), /*out_channel=*/ 8, /*kernel_shape=*/ {3},
+           /*group_count=*/ 1, /*has_bias=*/ true,
+           /*stride_shape=*/ {1}, /*dilation_shape=*/ {2},
+           /*pad_type=*/padding_mode::notset, /*pads=*/ {2, 2});
+    ASSERT_TRUE(utils::cerial_testing(c));
+}
+
+TEST(conv, backward) {
+    conv c(shape3d(4, 7, 9), /*out_channel=*/ 6, /*kernel_shape=*/ {3, 2},
+           /*group_count=*/ 2, /*has_bias=*/ true,
+           /*stride_shape=*/ {2, 1}, /*dilation_shape=*/ {1, 2},
+           /*pad_type=*/padding_mode::notset, /*pads=*/ {1, 1, 0, 2});
+    c.set_parallelize(false);
+    GradChecker checker(&c, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(conv, backward_1D_relu) {
+    conv c(shape3d(3, 1, 40), /*out_channel=*/ 5, /*kernel_shape=*/ {4},
+           /*group_count=*/ 1, /*has_bias=*/ true,
+           /*stride_shape=*/ {1}, /*dilation_shape=*/ {2},
+           /*pad_type=*/padding_mode::notset, /*pads=*/ {3, 2}, MmActivationType::Relu);
+    c.set_parallelize(false);
+    GradChecker checker(&c, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(conv, backward_parallel_deterministic) {
+    params::conv P;
+    P._.Dimensions = 2;
+    P.infer_output_requirement_shape(shape3d(6, 12, 11), 8, 2, true, {3, 3}, {1, 1}, {1, 1},
+                                     padding_mode::notset, {1, 1, 1, 1}, MmActivationType::NotSet);
+
+    const size_t SampleCount = 7;
+    const size_t OutputElements = 8 * P._.OutSize;
+    tensor_t X(SampleCount, mat_t(6 * 12 * 11)), Y(SampleCount, mat_t(OutputElements)), dY = Y;
+    mat_t W(8 * P._.K);
+    utils::random_init(W.data(), W.size());
+    for (size_t i = 0; i < SampleCount; ++i) {
+        utils::random_init(X[i].data(), X[i].size());
+        utils::random_init(dY[i].data(), dY[i].size());
+    }
+
+    // Градиенты весов суммируются по батчу в dW[0] и dB[0] (conv::reduces_weight_grads)
+    auto run = [&](bool parallelize, size_t nthreads, tensor_t& dX, tensor_t& dW, tensor_t& dB) {
+        dX.assign(SampleCount, mat_t(X[0].size(), 0));
+        dW.assign(1, mat_t(W.size(), 0));
+        dB.assign(1, mat_t(8, 0));
+        kernel::conv_bwd_xs_impl(X, W, Y, nullptr, dY, dX, dW, &dB, P, parallelize, nthreads);
+    };
+
+    tensor_t dX0, dW0, dB0, dX1, dW1, dB1, dX2, dW2, dB2;
+    run(false, 1, dX0, dW0, dB0);
+    run(true, 4, dX1, dW1, dB1);
+    run(true, 4, dX2, dW2, dB2);
+
+    // dX не зависит от числа потоков, сумма по батчу совпадает с точностью до округления
+    for (size_t i = 0; i < SampleCount; ++i) {
+        ASSERT_TRUE(std::equal(dX0[i].begin(), dX0[i].end(), dX1[i].begin()));
+    }
+    for (size_t i = 0; i < W.size(); ++i) {
+        ASSERT_NEAR(dW0[0][i], dW1[0][i], 1e-4f * std::max(1.0f, std::abs(dW0[0][i])));
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        ASSERT_NEAR(dB0[0][i], dB1[0][i], 1e-4f * std::max(1.0f, std::abs(dB0[0][i])));
+    }
+
+    // При том же числе потоков буферы складываются в том же порядке
+    ASSERT_TRUE(std::equal(dW1[0].begin(), dW1[0].end(), dW2[0].begin()));
+    ASSERT_TRUE(std::equal(dB1[0].begin(), dB1[0].end(), dB2[0].begin()));
+}
+
+TEST(conv, algorithm_selection) {
+    core::ConvAlgorithmSelector& selector = core::ConvAlgorithmSelector::get_instance();
+    selector.clear();
+    selector.set_mode(core::conv_algorithm_mode::measure);
+
+    params::conv P;
+    P._.Dimensions = 2;
+    P.infer_output_requirement_shape(shape3d(8, 20, 20), 8, 1, true, {3, 3}, {1, 1}, {1, 1},
+                                     padding_mode::notset, {1, 1, 1, 1}, MmActivationType::NotSet);
+    params::conv Reference = P;
+
+    P.select_algorithm(2);
+    ASSERT_EQ(selector.size(), 1);
+    const auto Selected = P._.Algorithm;
+    const auto Candidates = P.candidate_algorithms();
+    ASSERT_NE(std::find(Candidates.begin(), Candidates.end(), Selected), Candidates.end());
+
+    // Выбранный алгоритм считает то же, что и эвристический
+    mat_t X(8 * 20 * 20), W(8 * P._.K), B(8), Expected(8 * P._.OutSize), Actual(Expected.size());
+    utils::random_init(X.data(), X.size());
+    utils::random_init(W.data(), W.size());
+    utils::random_init(B.data(), B.size());
+    mat_t ReferenceBuffer(Reference._.TemproraryBufferSize), Buffer(P._.TemproraryBufferSize);
+    MmConv(&Reference._, X.data(), W.data(), B.data(), ReferenceBuffer.data(), Expected.data());
+    MmConv(&P._, X.data(), W.data(), B.data(), Buffer.data(), Actual.data());
+    utils::assert_conv_near(Expected, Actual);
+
+    // Таблица переживает сохранение и загрузку, новая свертка той же формы берет алгоритм из нее
+    selector.save("conv_algorithms.txt");
+    selector.clear();
+    selector.set_mode(core::conv_algorithm_mode::heuristic);
+    selector.load("conv_algorithms.txt");
+
+    params::conv Loaded = Reference;
+    Loaded.select_algorithm(2);
+    ASSERT_EQ(Loaded._.Algorithm, Selected);
+
+    // Другое число потоков - другой ключ, вне режима измерения остается эвристика
+    params::conv OtherThreads = Reference;
+    OtherThreads.select_algorithm(3);
+    ASSERT_EQ(OtherThreads._.Algorithm, Reference._.Algorithm);
+
+    // Явно заданный алгоритм не переопределяется
+    params::conv Fixed = Reference;
+    Fixed.set_algorithm(MM_CONV_PARAMS::NchwcDirect);
+    Fixed.select_algorithm(2);
+    ASSERT_EQ(Fixed._.Algorithm, MM_CONV_PARAMS::NchwcDirect);
+
+    selector.clear();
+}
+
 class SConvTester {
 public:
     void ExecuteLong() {
@@ -581,4 +900,120 @@ int main(int argc, char **argv) {
 
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
+TEST(conv, fused_max_pool_sequential) {
+    // Выход свертки 16 x 40 x 40 не помещается в один тайл, окна пулинга перекрываются на стыке тайлов
+    network<sequential> net;
+    net << conv(shape3d(3, 40, 40), 16, {3, 3}, 1, true, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1})
+        << relu()
+        << max_pooling(shape3d(16, 40, 40), 3, 2)
+        << conv(shape3d(16, 19, 19), 4, {3, 3}, 2, true, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1},
+                MmActivationType::Relu)
+        << hard_sigmoid(0.3f, 0.4f)
+        << max_pooling(shape3d(4, 19, 19), 2, 2, padding_mode::same);
+    net.init_weight();
+
+    std::vector<tensor_t> X(3, tensor_t(1, mat_t(3 * 40 * 40)));
+    for (auto& x : X) {
+        utils::random_init(x[0].data(), x[0].size());
+    }
+
+    const std::vector<tensor_t> Fused = net.predict(X);
+    ASSERT_TRUE(net[1]->absorbed() && net[2]->absorbed() && net[4]->absorbed() && net[5]->absorbed());
+    ASSERT_EQ(Fused.size(), X.size());
+    ASSERT_EQ(Fused[0][0].size(), 4 * 10 * 10);
+
+    net.set_layer_fusion(false);
+    const std::vector<tensor_t> Expected = net.predict(X);
+    ASSERT_FALSE(net[1]->absorbed() || net[2]->absorbed());
+
+    for (size_t sample = 0; sample < X.size(); ++sample) {
+        const mat_t& E = Expected[sample][0];
+        const mat_t& A = Fused[sample][0];
+        for (size_t i = 0; i < E.size(); ++i) {
+            ASSERT_NEAR(E[i], A[i], 1e-4f * std::max(1.0f, std::abs(E[i])));
+        }
+    }
+}
+
+TEST(conv, fused_max_pool_graph) {
+    Input in(shape3d(2, 9, 11));
+    conv c1(shape3d(2, 9, 11), 3, {3, 3}, 1, true, {2, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1});
+    hard_sigmoid act;
+    max_pooling mp(shape3d(3, 5, 11), 2, 2, 2, 1);
+    conv c2(shape3d(2, 9, 11), 2, {1, 1}, 1, false);
+    relu act2;
+    Output out1, out2, out3;
+
+    // c2 читают два слоя, поэтому с ним ничего не сливается
+    connect(&in, &c1, 0, 0);
+    connect(&c1, &act, 0, 0);
+    connect(&act, &mp, 0, 0);
+    connect(&mp, &out1, 0, 0);
+    connect(&in, &c2, 0, 0);
+    connect(&c2, &act2, 0, 0);
+    connect(&act2, &out2, 0, 0);
+    connect(&c2, &out3, 0, 0);
+
+    network<graph> net;
+    construct_graph(net, {&in}, {&out1, &out2, &out3});
+    net.init_weight();
+
+    std::vector<tensor_t> X(2, tensor_t(1, mat_t(2 * 9 * 11)));
+    for (auto& x : X) {
+        utils::random_init(x[0].data(), x[0].size());
+    }
+
+    const std::vector<tensor_t> Fused = net.predict(X);
+    ASSERT_TRUE(act.absorbed() && mp.absorbed());
+    ASSERT_FALSE(act2.absorbed() || out3.absorbed());
+
+    net.set_layer_fusion(false);
+    const std::vector<tensor_t> Expected = net.predict(X);
+
+    for (size_t sample = 0; sample < X.size(); ++sample) {
+        for (size_t o = 0; o < Expected[sample].size(); ++o) {
+            ASSERT_EQ(Expected[sample][o].size(), Fused[sample][o].size());
+            for (size_t i = 0; i < Expected[sample][o].size(); ++i) {
+                ASSERT_NEAR(Expected[sample][o][i], Fused[sample][o][i], 1e-5f);
+            }
+        }
+    }
+}
+
+TEST(conv, fused_max_pool_follows_selected_algorithm) {
+    // Max pooling сливается со сверткой, только если для нее выбран Im2Col
+    core::ConvAlgorithmSelector& selector = core::ConvAlgorithmSelector::get_instance();
+    selector.clear();
+    selector.set_mode(core::conv_algorithm_mode::measure);
+
+    network<sequential> net;
+    net << conv(shape3d(8, 20, 20), 8, {3, 3}, 1, true, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1})
+        << relu()
+        << max_pooling(shape3d(8, 20, 20), 2, 2);
+    net.init_weight();
+
+    std::vector<tensor_t> X(2, tensor_t(1, mat_t(8 * 20 * 20)));
+    for (auto& x : X) {
+        utils::random_init(x[0].data(), x[0].size());
+    }
+
+    const std::vector<tensor_t> Fused = net.predict(X);
+    const auto Selected = dynamic_cast<conv*>(net[0])->get_params()._.Algorithm;
+    ASSERT_EQ(net[2]->absorbed(), Selected == MM_CONV_PARAMS::Im2ColThenGemm);
+    ASSERT_TRUE(net[1]->absorbed());
+
+    net.set_layer_fusion(false);
+    const std::vector<tensor_t> Expected = net.predict(X);
+
+    for (size_t sample = 0; sample < X.size(); ++sample) {
+        const mat_t& E = Expected[sample][0];
+        const mat_t& A = Fused[sample][0];
+        for (size_t i = 0; i < E.size(); ++i) {
+            ASSERT_NEAR(E[i], A[i], 1e-4f * std::max(1.0f, std::abs(E[i])));
+        }
+    }
+
+    selector.set_mode(core::conv_algorithm_mode::heuristic);
+    selector.clear();
+}
@@ -0,0 +1,164 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "test_conv_utils.h"
+#include "../include/utils/grad_checker.h"
+using namespace xsdnn;
+
+namespace {
+
+/*
+ * Геометрия свертки, для которой считается транспонированная, и дополнение выхода (OH, OW).
+ */
+struct Shape : utils::conv_shape {
+    size_t OH, OW;
+};
+
+/*
+ * Наивная транспонированная свертка: каждый входной элемент разносится по окну выхода.
+ */
+mat_t conv_transpose_reference(const Shape& s, const mat_t& X, const mat_t& W, const mat_t& B,
+                               size_t OutH, size_t OutW) {
+    const size_t InC = s.C / s.G;
+    const size_t OutC = s.F / s.G;
+    mat_t Y(s.F * OutH * OutW);
+
+    for (size_t f = 0; f < s.F; ++f) {
+        for (size_t i = 0; i < OutH * OutW; ++i) {
+            Y[f * OutH * OutW + i] = B[f];
+        }
+    }
+
+    for (size_t c = 0; c < s.C; ++c) {
+        const size_t g = c / InC;
+        for (size_t ih = 0; ih < s.H; ++ih) {
+            for (size_t iw = 0; iw < s.W; ++iw) {
+                for (size_t o = 0; o < OutC; ++o) {
+                    for (size_t kh = 0; kh < s.KH; ++kh) {
+                        for (size_t kw = 0; kw < s.KW; ++kw) {
+                            const long oh = long(ih * s.SH + kh * s.DH) - long(s.P0);
+                            const long ow = long(iw * s.SW + kw * s.DW) - long(s.P1);
+                            if (oh < 0 || oh >= long(OutH) || ow < 0 || ow >= long(OutW)) continue;
+                            Y[((g * OutC + o) * OutH + oh) * OutW + ow] +=
+                                    X[(c * s.H + ih) * s.W + iw] * W[((c * OutC + o) * s.KH + kh) * s.KW + kw];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return Y;
+}
+
+} // namespace
+
+TEST(conv_transpose, params_check) {
+    conv_transpose c(shape3d(4, 5, 7), /*out_channel=*/ 6, /*kernel_shape=*/ {3, 3},
+                     /*group_count=*/ 2, /*has_bias=*/ true,
+                     /*stride_shape=*/ {2, 2}, /*dilation_shape=*/ {1, 1},
+                     /*pads=*/ {1, 1, 1, 1}, /*output_padding=*/ {1, 0});
+
+    ASSERT_TRUE(c.in_shape()[0] == shape3d(4, 5, 7));
+    ASSERT_TRUE(c.in_shape()[1] == shape3d(4 * 3, 3, 3));
+    ASSERT_TRUE(c.in_shape()[2] == shape3d(6, 1, 1));
+    ASSERT_TRUE(c.out_shape()[0] == shape3d(6, 10, 13));
+
+    ASSERT_THROW(conv_transpose(shape3d(4, 5, 7), 6, {3, 3}, 1, true, {2, 2}, {1, 1}, {}, {2, 0}), xs_error);
+    ASSERT_THROW(conv_transpose(shape3d(4, 2, 7), 6, {3}, 1, true), xs_error);
+}
+
+TEST(conv_transpose, forward_matches_reference) {
+    const std::vector<Shape> shapes = {
+            {{3, 5, 6, 4, 1, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1}, 0, 0},
+            {{4, 6, 7, 6, 2, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2}, 1, 1},
+            {{2, 4, 9, 3, 1, 2, 4, 0, 1, 0, 2, 1, 1, 2, 2}, 0, 1},
+            {{6, 5, 5, 6, 3, 3, 3, 2, 0, 1, 1, 2, 1, 1, 2}, 0, 1},
+            {{4, 3, 17, 8, 4, 1, 5, 0, 3, 0, 3, 1, 2, 3, 2}, 2, 0},
+            {{5, 1, 23, 4, 1, 1, 4, 0, 1, 0, 1, 1, 1, 1, 2}, 0, 1},
+    };
+
+    for (const auto& s : shapes) {
+        conv_transpose c(shape3d(s.C, s.H, s.W), s.F, {s.KH, s.KW}, s.G, true,
+                         {s.SH, s.SW}, {s.DH, s.DW}, {s.P0, s.P1, s.P2, s.P3}, {s.OH, s.OW});
+        c.set_parallelize(false);
+        c.setup(false);
+
+        const shape3d Out = c.out_shape()[0];
+        mat_t X(s.C * s.H * s.W), W(c.in_shape()[1].size()), B(s.F);
+        utils::random_init(X.data(), X.size());
+        utils::random_init(W.data(), W.size());
+        utils::random_init(B.data(), B.size());
+
+        c.prev()[1]->get_data()->at(0) = W;
+        c.prev()[2]->get_data()->at(0) = B;
+        c.set_in_data({{ X }});
+        c.forward();
+
+        const mat_t Expected = conv_transpose_reference(s, X, W, B, Out.H, Out.W);
+        const mat_t Actual = c.output()[0][0];
+
+        utils::assert_conv_near(Expected, Actual);
+    }
+}
+
+TEST(conv_transpose, _1D_forward_matches_reference) {
+    const Shape s = {{3, 1, 20, 4, 1, 1, 4, 0, 1, 0, 2, 1, 2, 1, 2}, 0, 1};
+
+    conv_transpose c(shape3d(s.C, 1, s.W), s.F, {s.KW}, s.G, true, {s.SW}, {s.DW}, {s.P1, s.P3}, {s.OW});
+    c.set_parallelize(false);
+    c.setup(false);
+
+    const shape3d Out = c.out_shape()[0];
+    ASSERT_EQ(Out.H, 1);
+    ASSERT_EQ(Out.W, (s.W - 1) * s.SW - s.P1 - s.P3 + s.DW * (s.KW - 1) + s.OW + 1);
+
+    mat_t X(s.C * s.W), W(c.in_shape()[1].size()), B(s.F);
+    utils::random_init(X.data(), X.size());
+    utils::random_init(W.data(), W.size());
+    utils::random_init(B.data(), B.size());
+
+    c.prev()[1]->get_data()->at(0) = W;
+    c.prev()[2]->get_data()->at(0) = B;
+    c.set_in_data({{ X }});
+    c.forward();
+
+    const mat_t Expected = conv_transpose_reference(s, X, W, B, 1, Out.W);
+    const mat_t Actual = c.output()[0][0];
+    utils::assert_conv_near(Expected, Actual);
+}
+
+TEST(conv_transpose, backward) {
+    conv_transpose c(shape3d(4, 4, 5), /*out_channel=*/ 6, /*kernel_shape=*/ {3, 2},
+                     /*group_count=*/ 2, /*has_bias=*/ true,
+                     /*stride_shape=*/ {2, 2}, /*dilation_shape=*/ {1, 2},
+                     /*pads=*/ {1, 0, 0, 1}, /*output_padding=*/ {1, 0});
+    c.set_parallelize(false);
+    GradChecker checker(&c, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(conv_transpose, cerial) {
+    conv_transpose c(shape3d(4, 6, 6), /*out_channel=*/ 6, /*kernel_shape=*/ {3, 3},
+                     /*group_count=*/ 2, /*has_bias=*/ true,
+                     /*stride_shape=*/ {2, 2}, /*dilation_shape=*/ {1, 1},
+                     /*pads=*/ {1, 1, 1, 1}, /*output_padding=*/ {1, 1});
+    ASSERT_TRUE(utils::cerial_testing(c));
+}
+
+TEST(conv_transpose, _1D_cerial) {
+    conv_transpose c(shape3d(3, 1, 32), /*out_channel=*/ 2, /*kernel_shape=*/ {4},
+                     /*group_count=*/ 1, /*has_bias=*/ false,
+                     /*stride_shape=*/ {2}, /*dilation_shape=*/ {1},
+                     /*pads=*/ {1, 1}, /*output_padding=*/ {1});
+    ASSERT_TRUE(utils::cerial_testing(c));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
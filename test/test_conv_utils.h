@@ -0,0 +1,109 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#ifndef XSDNN_TEST_CONV_UTILS_H
+#define XSDNN_TEST_CONV_UTILS_H
+
+#include <gtest/gtest.h>
+#include <functional>
+#include "test_utils.h"
+
+namespace utils {
+
+/*
+ * Геометрия 2D свертки: вход C x H x W, F фильтров в G группах, ядро KH x KW,
+ * заполнение (P0, P1) в начале и (P2, P3) в конце осей H и W, dilation и шаг.
+ */
+struct conv_shape {
+    size_t C, H, W, F, G, KH, KW, P0, P1, P2, P3, DH, DW, SH, SW;
+};
+
+/*
+ * Общие формы сравнения сверток: обычная 3x3, шаг с несимметричным заполнением,
+ * группы с dilation и 1x1. extra - формы, важные только для конкретного алгоритма.
+ */
+std::vector<conv_shape> conv_test_shapes(std::initializer_list<conv_shape> extra = {}) {
+    std::vector<conv_shape> shapes = {
+            {3, 17, 19, 8, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1},
+            {4, 11, 11, 7, 1, 5, 3, 2, 1, 0, 1, 1, 1, 2, 1},
+            {6, 9, 13, 6, 2, 3, 3, 1, 1, 1, 1, 2, 2, 1, 2},
+            {8, 5, 5, 9, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1},
+    };
+    shapes.insert(shapes.end(), extra);
+    return shapes;
+}
+
+params::conv conv_test_params(const conv_shape& s) {
+    params::conv p;
+    p._.Dimensions = 2;
+    p.infer_output_requirement_shape(shape3d(s.C, s.H, s.W), s.F, s.G, true, {s.KH, s.KW},
+                                     {s.SH, s.SW}, {s.DH, s.DW}, padding_mode::notset,
+                                     {s.P0, s.P1, s.P2, s.P3}, MmActivationType::NotSet);
+    return p;
+}
+
+void assert_conv_near(const mat_t& Expected, const mat_t& Actual) {
+    ASSERT_EQ(Expected.size(), Actual.size());
+    for (size_t i = 0; i < Expected.size(); ++i) {
+        ASSERT_NEAR(Expected[i], Actual[i], 1e-4f * std::max(1.0f, std::abs(Expected[i]))) << "i = " << i;
+    }
+}
+
+/*
+ * Для каждой формы сравнивает с Im2Col свертку, параметры которой получены из Im2Col
+ * вызовом configure (алгоритм или формат). Вход и выход NHWC свертки переставляются
+ * вокруг MmConvNhwc, блочные вход и выход NCHWc свертки - вокруг MmConvNchwcLayout
+ * с упакованными фильтрами, остальные алгоритмы считаются MmConv.
+ */
+void conv_matches_im2col(const std::vector<conv_shape>& shapes,
+                         const std::function<void(params::conv&)>& configure) {
+    for (const auto& s : shapes) {
+        const params::conv Im2Col = conv_test_params(s);
+        params::conv Tested = Im2Col;
+        configure(Tested);
+
+        const size_t InSize = s.H * s.W;
+        const size_t OutSize = Im2Col._.OutSize;
+
+        mat_t X(s.C * InSize), W(s.F * Im2Col._.K), B(s.F);
+        random_init(X.data(), X.size());
+        random_init(W.data(), W.size());
+        random_init(B.data(), B.size());
+
+        mat_t Expected(s.F * OutSize), Actual(s.F * OutSize);
+        mat_t Im2ColBuffer(Im2Col._.TemproraryBufferSize), Buffer(Tested._.TemproraryBufferSize);
+        MmConv(&Im2Col._, X.data(), W.data(), B.data(), Im2ColBuffer.data(), Expected.data());
+
+        if (Tested.layout_ == tensor_layout::nhwc) {
+            mat_t XNhwc(X.size()), ActualNhwc(Actual.size());
+            MmTranspose(X.data(), XNhwc.data(), s.C, InSize);
+            MmConvNhwc(&Tested._, XNhwc.data(), W.data(), B.data(), Buffer.data(), ActualNhwc.data());
+            MmTranspose(ActualNhwc.data(), Actual.data(), OutSize, s.F);
+        } else if (Tested.nchwc()) {
+            const bool InputBlocked = Tested.layout_ == tensor_layout::nchwc;
+            const bool OutputBlocked = Tested.out_layout_ == tensor_layout::nchwc;
+            mat_t XBlocked(X.size()), ActualBlocked(Actual.size());
+
+            if (InputBlocked) {
+                MmReorderInputNchw(X.data(), XBlocked.data(), s.C, InSize);
+            }
+            Tested.pack_filter(W);
+            MmConvNchwcLayout(&Tested._, InputBlocked, OutputBlocked,
+                              InputBlocked ? XBlocked.data() : X.data(), W.data(), B.data(), Buffer.data(),
+                              OutputBlocked ? ActualBlocked.data() : Actual.data());
+            if (OutputBlocked) {
+                MmReorderOutputNchw(ActualBlocked.data(), Actual.data(), s.F, OutSize);
+            }
+        } else {
+            MmConv(&Tested._, X.data(), W.data(), B.data(), Buffer.data(), Actual.data());
+        }
+
+        assert_conv_near(Expected, Actual);
+    }
+}
+
+} // utils
+
+#endif //XSDNN_TEST_CONV_UTILS_H
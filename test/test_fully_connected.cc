@@ -158,4 +158,165 @@ TEST(fc, backward_parallel) {
 TEST(fc, cerial) {
     fully_connected fc(50, 100);
     ASSERT_TRUE(utils::cerial_testing(fc));
-}
\ No newline at end of file
+}
+TEST(fc, forward_batch_vs_reference) {
+    const size_t in_size = 37, out_size = 53, batch = 9;
+
+    tensor_t in(batch, mat_t(in_size));
+    for (auto& sample : in) {
+        utils::random_init(sample.data(), sample.size());
+    }
+
+    for (bool parallel : {false, true}) {
+        fully_connected fc(in_size, out_size);
+        fc.set_parallelize(parallel);
+        fc.set_num_threads(4);
+        fc.setup(false);
+        utils::random_init(fc.weights()[1]->data(), out_size);
+        fc.set_in_data({ in });
+        fc.forward();
+
+        const mat_t& W = *fc.weights()[0];
+        const mat_t& b = *fc.weights()[1];
+        const tensor_t out = fc.output()[0];
+        ASSERT_EQ(out.size(), batch);
+
+        for (size_t sample = 0; sample < batch; ++sample) {
+            for (size_t j = 0; j < out_size; ++j) {
+                mm_scalar ex = b[j];
+                for (size_t i = 0; i < in_size; ++i) {
+                    ex += in[sample][i] * W[i * out_size + j];
+                }
+                ASSERT_NEAR(out[sample][j], ex, 1e-4f) << "sample " << sample << " out " << j;
+            }
+        }
+    }
+}
+
+TEST(fc, backward_batch_vs_reference) {
+    const size_t in_size = 29, out_size = 41, batch = 7;
+
+    tensor_t in(batch, mat_t(in_size));
+    tensor_t out_grad(batch, mat_t(out_size));
+    for (size_t s = 0; s < batch; ++s) {
+        utils::random_init(in[s].data(), in_size);
+        utils::random_init(out_grad[s].data(), out_size);
+    }
+
+    for (bool parallel : {false, true}) {
+        fully_connected fc(in_size, out_size);
+        fc.set_parallelize(parallel);
+        fc.set_num_threads(3);
+        fc.setup(false);
+        fc.set_in_data({ in });
+        fc.forward();
+        fc.set_out_grads({ out_grad });
+        fc.backward();
+
+        const mat_t& W = *fc.weights()[0];
+        const std::vector<tensor_t*> grads = fc.weights_grads();
+        const tensor_t& dW = *grads[0];
+        const tensor_t& db = *grads[1];
+
+        // Градиенты весов уже просуммированы по батчу и хранятся в одном экземпляре
+        ASSERT_EQ(dW.size(), 1u);
+        ASSERT_EQ(db.size(), 1u);
+
+        for (size_t i = 0; i < in_size; ++i) {
+            for (size_t j = 0; j < out_size; ++j) {
+                mm_scalar ex = 0;
+                for (size_t s = 0; s < batch; ++s) {
+                    ex += in[s][i] * out_grad[s][j];
+                }
+                ASSERT_NEAR(dW[0][i * out_size + j], ex, 1e-4f);
+            }
+        }
+        for (size_t j = 0; j < out_size; ++j) {
+            mm_scalar ex = 0;
+            for (size_t s = 0; s < batch; ++s) {
+                ex += out_grad[s][j];
+            }
+            ASSERT_NEAR(db[0][j], ex, 1e-4f);
+        }
+
+        const tensor_t& dx = *fc.inputs()[0]->get_gradient();
+        for (size_t s = 0; s < batch; ++s) {
+            for (size_t i = 0; i < in_size; ++i) {
+                mm_scalar ex = 0;
+                for (size_t j = 0; j < out_size; ++j) {
+                    ex += out_grad[s][j] * W[i * out_size + j];
+                }
+                ASSERT_NEAR(dx[s][i], ex, 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(fc, forward_fused_activation) {
+    const size_t in_size = 19, out_size = 23, batch = 5;
+
+    tensor_t in(batch, mat_t(in_size));
+    for (auto& sample : in) {
+        utils::random_init(sample.data(), sample.size());
+    }
+
+    for (MmActivationType type : {MmActivationType::Relu, MmActivationType::HardSigmoid}) {
+        fully_connected plain(in_size, out_size);
+        fully_connected fused(in_size, out_size, true, type);
+        plain.setup(false);
+        fused.setup(false);
+        *fused.weights()[0] = *plain.weights()[0];
+        utils::random_init(plain.weights()[1]->data(), out_size);
+        *fused.weights()[1] = *plain.weights()[1];
+
+        plain.set_in_data({ in });
+        fused.set_in_data({ in });
+        plain.forward();
+        fused.forward();
+
+        MmActivationHolder holder;
+        holder.ActivationType = type;
+        MmSetDefaultActivationParameters(&holder);
+
+        for (size_t s = 0; s < batch; ++s) {
+            mat_t ex = plain.output()[0][s];
+            MmActivation(&holder, ex.data(), 1, ex.size(), ex.size());
+            const mat_t out = fused.output()[0][s];
+            for (size_t j = 0; j < out_size; ++j) {
+                ASSERT_NEAR(out[j], ex[j], 1e-5f);
+            }
+        }
+    }
+}
+
+TEST(fc, backward_fused_relu) {
+    fully_connected fc(30, 40, true, MmActivationType::Relu);
+    GradChecker checker(&fc, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(fc, backward_fused_hard_sigmoid) {
+    fully_connected fc(30, 40, true, MmActivationType::HardSigmoid);
+    GradChecker checker(&fc, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(fc, cerial_keeps_activation) {
+    network<sequential> saver;
+    saver << fully_connected(8, 6, true, MmActivationType::Relu);
+    saver.init_weight();
+    saver.save("fc_relu_model.xs");
+
+    network<sequential> loader;
+    loader.load("fc_relu_model.xs");
+
+    mat_t in(8);
+    utils::random_init(in.data(), in.size());
+    const mat_t exp = saver.predict(in);
+    const mat_t out = loader.predict(in);
+    ASSERT_EQ(out.size(), exp.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_GE(out[i], 0.0f);
+        ASSERT_FLOAT_EQ(out[i], exp[i]);
+    }
+}
@@ -6,6 +6,7 @@
 #include "xsdnn.h"
 #include <gtest/gtest.h>
 #include "test_utils.h"
+#include "../include/utils/grad_checker.h"
 using namespace xsdnn;
 
 TEST(global_average_pooling, forward) {
@@ -55,8 +56,59 @@ TEST(global_average_pooling, forward_two_channels) {
 #endif
 }
 
+TEST(global_average_pooling, forward_nhwc) {
+    shape3d in_shape(2, 2, 2);
+    global_average_pooling pool(in_shape);
+    ASSERT_TRUE(pool.set_layout(tensor_layout::nhwc));
+
+    // [H][W][C]: канал 0 - {1, 2, 3, 4}, канал 1 - {10, 20, 30, 40}
+    mat_t in_data = {1, 10, 2, 20, 3, 30, 4, 40};
+    pool.setup(false);
+    pool.set_parallelize(false);
+    pool.set_in_data({{ in_data }});
+    pool.forward();
+
+    const auto out = pool.output()[0][0];
+#ifdef MM_USE_DOUBLE
+#error NotImpl
+#else
+    ASSERT_FLOAT_EQ(out[0], 2.5f);
+    ASSERT_FLOAT_EQ(out[1], 25.0f);
+#endif
+}
+
 TEST(global_average_pooling, cerial) {
     shape3d in_shape(3, 224, 224);
     global_average_pooling pool(in_shape);
     ASSERT_TRUE(utils::cerial_testing(pool));
-}
\ No newline at end of file
+}
+TEST(global_average_pooling, forward_overwrites_output) {
+    shape3d in_shape(5, 3, 7);
+    global_average_pooling pool(in_shape);
+    mat_t in_data(in_shape.size());
+    utils::random_init(in_data.data(), in_data.size());
+
+    pool.setup(false);
+    pool.set_parallelize(false);
+    pool.set_in_data({{ in_data }});
+    pool.forward();
+    const auto first = pool.output()[0][0];
+    pool.forward();
+    const auto second = pool.output()[0][0];
+
+    for (size_t c = 0; c < in_shape.C; ++c) {
+        mm_scalar sum = 0;
+        for (size_t i = 0; i < in_shape.area(); ++i) {
+            sum += in_data[c * in_shape.area() + i];
+        }
+        ASSERT_NEAR(first[c], sum / in_shape.area(), 1e-5f);
+    }
+    ASSERT_EQ(first, second);
+}
+
+TEST(global_average_pooling, backward) {
+    global_average_pooling pool(shape3d(3, 5, 6));
+    pool.set_parallelize(false);
+    GradChecker checker(&pool, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
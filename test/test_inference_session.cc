@@ -0,0 +1,260 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include "test_utils.h"
+using namespace xsdnn;
+
+namespace {
+
+/*
+ * Причинная 1D модель: conv(k = 3) -> relu -> conv(k = 2, d = 2) -> max_pool(2, 2)
+ */
+void build_causal_model(network<graph>& net, size_t width,
+                        const std::vector<mat_t>& weights,
+                        std::vector<std::shared_ptr<layer>>& owner) {
+    auto in = std::make_shared<Input>(shape3d(2, 1, width));
+    auto c1 = std::make_shared<conv>(shape3d(2, 1, width), 4, std::vector<size_t>{3}, 1, true,
+                                     std::vector<size_t>{1}, std::vector<size_t>{1},
+                                     padding_mode::notset, std::vector<size_t>{2, 0});
+    auto act = std::make_shared<relu>();
+    auto c2 = std::make_shared<conv>(shape3d(4, 1, width), 3, std::vector<size_t>{2}, 1, true,
+                                     std::vector<size_t>{1}, std::vector<size_t>{2},
+                                     padding_mode::notset, std::vector<size_t>{2, 0});
+    auto mp = std::make_shared<max_pooling>(shape3d(3, 1, width), 2, 1, 2, 1);
+    auto out = std::make_shared<Output>();
+
+    connect(in.get(), c1.get(), 0, 0);
+    connect(c1.get(), act.get(), 0, 0);
+    connect(act.get(), c2.get(), 0, 0);
+    connect(c2.get(), mp.get(), 0, 0);
+    connect(mp.get(), out.get(), 0, 0);
+    construct_graph(net, {in.get()}, {out.get()});
+    net.init_weight();
+
+    size_t idx = 0;
+    for (layer* l : {static_cast<layer*>(c1.get()), static_cast<layer*>(c2.get())}) {
+        for (mat_t* w : l->weights()) {
+            *w = weights[idx++];
+        }
+    }
+
+    owner = {in, c1, act, c2, mp, out};
+}
+
+} // namespace
+
+TEST(inference_session, streaming_matches_offline) {
+    const size_t Chunk = 8;
+    const size_t ChunkCount = 5;
+    const size_t Length = Chunk * ChunkCount;
+
+    std::vector<mat_t> weights = {mat_t(4 * 2 * 3), mat_t(4), mat_t(3 * 4 * 2), mat_t(3)};
+    for (auto& w : weights) {
+        utils::random_init(w.data(), w.size());
+    }
+
+    std::vector<std::shared_ptr<layer>> chunk_owner, full_owner;
+    network<graph> chunk_net, full_net;
+    build_causal_model(chunk_net, Chunk, weights, chunk_owner);
+    build_causal_model(full_net, Length, weights, full_owner);
+    chunk_net.save("streaming_model.xs");
+
+    mat_t sequence(2 * Length);
+    utils::random_init(sequence.data(), sequence.size());
+    const mat_t expected = full_net.predict(sequence);
+    ASSERT_EQ(expected.size(), 3 * Length / 2);
+
+    InfOptions opt;
+    opt.SetNetType(net_type::graph);
+    InfSession session(opt);
+    session.Load("streaming_model.xs");
+
+    InfStream stream = session.CreateStream();
+
+    for (size_t part = 0; part < ChunkCount; ++part) {
+        mat_t chunk(2 * Chunk);
+        for (size_t c = 0; c < 2; ++c) {
+            std::copy_n(sequence.data() + c * Length + part * Chunk, Chunk, chunk.data() + c * Chunk);
+        }
+
+        std::vector<tensor_t> output(1);
+        session.Run({{chunk}}, output, stream);
+        const mat_t& result = output[0][0];
+        ASSERT_EQ(result.size(), 3 * Chunk / 2);
+
+        for (size_t c = 0; c < 3; ++c) {
+            for (size_t t = 0; t < Chunk / 2; ++t) {
+                ASSERT_NEAR(result[c * Chunk / 2 + t], expected[c * Length / 2 + part * Chunk / 2 + t], 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(inference_session, streaming_rejects_non_causal) {
+    network<graph> net;
+    Input in(shape3d(2, 1, 8));
+    conv c(shape3d(2, 1, 8), 2, {3}, 1, true, {1}, {1}, padding_mode::notset, {1, 1});
+    Output out;
+    connect(&in, &c, 0, 0);
+    connect(&c, &out, 0, 0);
+    construct_graph(net, {&in}, {&out});
+    net.init_weight();
+    net.save("non_causal_model.xs");
+
+    InfOptions opt;
+    opt.SetNetType(net_type::graph);
+    InfSession session(opt);
+    session.Load("non_causal_model.xs");
+    ASSERT_THROW(session.CreateStream(), xs_error);
+}
+
+TEST(inference_session, streaming_rejects_softmax) {
+    network<graph> net;
+    Input in(shape3d(2, 1, 8));
+    conv c(shape3d(2, 1, 8), 2, {3}, 1, true, {1}, {1}, padding_mode::notset, {2, 0});
+    softmax sm;
+    Output out;
+    connect(&in, &c, 0, 0);
+    connect(&c, &sm, 0, 0);
+    connect(&sm, &out, 0, 0);
+    construct_graph(net, {&in}, {&out});
+    net.init_weight();
+    net.save("softmax_stream_model.xs");
+
+    InfOptions opt;
+    opt.SetNetType(net_type::graph);
+    InfSession session(opt);
+    session.Load("softmax_stream_model.xs");
+    ASSERT_THROW(session.CreateStream(), xs_error);
+}
+
+TEST(inference_session, folds_batch_norm) {
+    Input in(shape3d(3, 6, 6));
+    conv c(shape3d(3, 6, 6), 4, {3, 3}, 1, /*has_bias=*/ false, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1});
+    batch_norm bn1(0.9f, 1e-5f, op_mode::inference);
+    relu act;
+    fully_connected fc(4 * 6 * 6, 5);
+    batch_norm bn2(0.9f, 1e-5f, op_mode::inference);
+    Output out;
+
+    connect(&in, &c, 0, 0);
+    connect(&c, &bn1, 0, 0);
+    connect(&bn1, &act, 0, 0);
+    connect(&act, &fc, 0, 0);
+    connect(&fc, &bn2, 0, 0);
+    connect(&bn2, &out, 0, 0);
+
+    network<graph> net;
+    construct_graph(net, {&in}, {&out});
+    net.init_weight();
+
+    for (batch_norm* bn : {&bn1, &bn2}) {
+        const size_t C = bn->in_shape()[0].C;
+        mat_t mean(C), stddev(C);
+        utils::random_init(mean.data(), C);
+        utils::random_init(stddev.data(), C);
+        for (auto& s : stddev) s = 0.5f + std::abs(s);
+        for (mat_t* w : bn->weights()) {
+            utils::random_init(w->data(), w->size());
+        }
+        bn->set_statistics(mean, stddev);
+    }
+
+    std::vector<tensor_t> X(1, tensor_t(1, mat_t(3 * 6 * 6)));
+    for (auto& x : X) {
+        utils::random_init(x[0].data(), x[0].size());
+    }
+    const std::vector<tensor_t> expected = net.predict(X);
+    net.save("batch_norm_model.xs");
+
+    InfOptions opt;
+    opt.SetNetType(net_type::graph);
+    InfSession session(opt);
+    session.Load("batch_norm_model.xs");
+
+    // batch_norm удалены из графа: in -> conv -> relu -> fully_connected -> out
+    network<graph> model = session.GetModel();
+    ASSERT_EQ(model[1]->layer_type(), "conv");
+    ASSERT_EQ(model[2]->layer_type(), "relu");
+    ASSERT_EQ(model[3]->layer_type(), "fully_connected");
+    ASSERT_EQ(model[4]->layer_type(), "Output");
+
+    std::vector<tensor_t> output(1);
+    session.Run(X, output);
+    for (size_t sample = 0; sample < X.size(); ++sample) {
+        for (size_t i = 0; i < expected[sample][0].size(); ++i) {
+            ASSERT_NEAR(output[sample][0][i], expected[sample][0][i], 1e-4f);
+        }
+    }
+}
+
+TEST(inference_session, nchwc_matches_nchw) {
+    /*
+     * in -> conv -> relu -> max_pool -> batch_norm -> conv -> relu -> gap -> fc -> out:
+     * вход с 3 каналами переупорядочивает первая свертка, дальше до gap тензоры блочные.
+     */
+    Input in(shape3d(3, 12, 12));
+    conv c1(shape3d(3, 12, 12), 8, {3, 3}, 1, true, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1});
+    relu act1;
+    max_pooling mp(shape3d(8, 12, 12), 2, 2);
+    batch_norm bn(0.9f, 1e-5f, op_mode::inference);
+    conv c2(shape3d(8, 6, 6), 8, {3, 3}, 1, true, {1, 1}, {1, 1}, padding_mode::notset, {1, 1, 1, 1});
+    relu act2;
+    global_average_pooling gap(shape3d(8, 6, 6));
+    fully_connected fc(8, 5);
+    Output out;
+
+    connect(&in, &c1, 0, 0);
+    connect(&c1, &act1, 0, 0);
+    connect(&act1, &mp, 0, 0);
+    connect(&mp, &bn, 0, 0);
+    connect(&bn, &c2, 0, 0);
+    connect(&c2, &act2, 0, 0);
+    connect(&act2, &gap, 0, 0);
+    connect(&gap, &fc, 0, 0);
+    connect(&fc, &out, 0, 0);
+
+    network<graph> net;
+    construct_graph(net, {&in}, {&out});
+    net.init_weight();
+
+    mat_t mean(8), stddev(8);
+    utils::random_init(mean.data(), mean.size());
+    utils::random_init(stddev.data(), stddev.size());
+    for (auto& s : stddev) s = 0.5f + std::abs(s);
+    bn.set_statistics(mean, stddev);
+
+    std::vector<tensor_t> X(1, tensor_t(1, mat_t(3 * 12 * 12)));
+    for (auto& x : X) {
+        utils::random_init(x[0].data(), x[0].size());
+    }
+    const std::vector<tensor_t> expected = net.predict(X);
+    net.save("nchwc_model.xs");
+
+    InfOptions opt;
+    opt.SetNetType(net_type::graph);
+    opt.SetLayout(tensor_layout::nchwc);
+    InfSession session(opt);
+    session.Load("nchwc_model.xs");
+
+    network<graph> model = session.GetModel();
+    const params::conv first = dynamic_cast<conv*>(model[1])->get_params();
+    const params::conv second = dynamic_cast<conv*>(model[5])->get_params();
+    ASSERT_EQ(first.layout_, tensor_layout::nchw);
+    ASSERT_EQ(first.out_layout_, tensor_layout::nchwc);
+    ASSERT_EQ(dynamic_cast<max_pooling*>(model[3])->get_params().layout_, tensor_layout::nchwc);
+    ASSERT_EQ(second.layout_, tensor_layout::nchwc);
+    ASSERT_EQ(second.out_layout_, tensor_layout::nchwc);
+
+    std::vector<tensor_t> output(1);
+    session.Run(X, output);
+    for (size_t sample = 0; sample < X.size(); ++sample) {
+        for (size_t i = 0; i < expected[sample][0].size(); ++i) {
+            ASSERT_NEAR(output[sample][0][i], expected[sample][0][i], 1e-4f);
+        }
+    }
+}
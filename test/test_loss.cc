@@ -0,0 +1,129 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include "test_utils.h"
+using namespace xsdnn;
+
+TEST(softmax_cross_entropy, value_and_gradient_vs_reference) {
+    // Большое смещение логитов проверяет сдвиг на максимум, размер не кратен ширине вектора
+    const size_t classes = 10007, label = 4321;
+    mat_t y(classes);
+    utils::random_init(y.data(), y.size());
+    for (auto& v : y) {
+        v = v * 20.0f + 1000.0f;
+    }
+
+    double maximum = y[0];
+    for (float v : y) {
+        maximum = std::max(maximum, double(v));
+    }
+    double sum = 0.0;
+    for (float v : y) {
+        sum += std::exp(double(v) - maximum);
+    }
+    const double lse = maximum + std::log(sum);
+
+    softmax_cross_entropy_loss l;
+    const mat_t a = { mm_scalar(label) };
+    ASSERT_NEAR(l.f(y, a), lse - y[label], 1e-3);
+
+    mat_t dst(classes);
+    l.df(y, a, dst);
+    double grad_sum = 0.0;
+    for (size_t i = 0; i < classes; ++i) {
+        const double ex = std::exp(double(y[i]) - lse) - (i == label ? 1.0 : 0.0);
+        ASSERT_NEAR(dst[i], ex, 1e-5 + 1e-4 * std::abs(ex)) << i;
+        grad_sum += dst[i];
+    }
+    ASSERT_NEAR(grad_sum, 0.0, 1e-4);
+}
+
+TEST(softmax_cross_entropy, parallel_gradient_matches_serial) {
+    const size_t batch = 9, classes = 13;
+    std::vector<tensor_t> y(batch, tensor_t(1, mat_t(classes)));
+    std::vector<tensor_t> a(batch, tensor_t(1, mat_t(1)));
+    for (size_t i = 0; i < batch; ++i) {
+        utils::random_init(y[i][0].data(), classes);
+        a[i][0][0] = mm_scalar(i % classes);
+    }
+
+    softmax_cross_entropy_loss l;
+    std::vector<tensor_t> serial(batch), parallel(batch);
+    gradient(&l, y, a, serial);
+    gradient(&l, y, a, parallel, true, 4);
+
+    for (size_t i = 0; i < batch; ++i) {
+        ASSERT_EQ(serial[i][0], parallel[i][0]);
+    }
+}
+
+TEST(softmax_cross_entropy, rejects_bad_label) {
+    softmax_cross_entropy_loss l;
+    mat_t y(5, 0.0f), dst(5);
+    ASSERT_THROW(l.df(y, { 5.0f }, dst), xs_error);
+    ASSERT_THROW(l.f(y, { 1.0f, 2.0f }), xs_error);
+    ASSERT_THROW(l.f(y, { 2.5f }), xs_error);
+}
+
+TEST(softmax_cross_entropy, parallel_gradient_rejects_bad_label) {
+    const size_t batch = 8, classes = 5;
+    softmax_cross_entropy_loss l;
+
+    for (const mat_t& bad : {mat_t{5.0f}, mat_t{1.0f, 2.0f}, mat_t{2.5f}}) {
+        std::vector<tensor_t> y(batch, tensor_t(1, mat_t(classes, 0.0f)));
+        std::vector<tensor_t> a(batch, tensor_t(1, mat_t{1.0f}));
+        a[batch - 1][0] = bad;
+
+        std::vector<tensor_t> dst(batch);
+        ASSERT_THROW(gradient(&l, y, a, dst, true, 4), xs_error);
+    }
+}
+
+TEST(softmax_cross_entropy, train_with_index_labels) {
+    // Три линейно разделимых класса: метка - номер наибольшей из трех первых координат
+    const size_t samples = 96, in_size = 6, classes = 3;
+    tensor_t X(samples, mat_t(in_size));
+    std::vector<size_t> labels(samples);
+    for (size_t s = 0; s < samples; ++s) {
+        utils::random_init(X[s].data(), in_size);
+        labels[s] = std::max_element(X[s].begin(), X[s].begin() + classes) - X[s].begin();
+    }
+
+    network<sequential> net;
+    net << fully_connected(in_size, 16) << relu() << fully_connected(16, classes);
+    net.set_num_threads(2);
+    net.init_weight();
+
+    softmax_cross_entropy_loss l;
+    auto total_loss = [&]() {
+        double res = 0.0;
+        for (size_t s = 0; s < samples; ++s) {
+            res += l.f(net.predict(X[s]), { mm_scalar(labels[s]) });
+        }
+        return res / samples;
+    };
+
+    const double before = total_loss();
+    sgd opt(0.05f, 0.0f);
+    net.train(&l, &opt, X, labels, 8, 20);
+    const double after = total_loss();
+
+    ASSERT_LT(after, before * 0.5);
+}
+
+TEST(softmax_cross_entropy, train_rejects_out_of_range_label) {
+    network<sequential> net;
+    net << fully_connected(4, 3);
+    net.init_weight();
+
+    tensor_t X(2, mat_t(4, 0.5f));
+    std::vector<size_t> labels = { 1, 3 };
+    softmax_cross_entropy_loss l;
+    sgd opt(0.05f, 0.0f);
+    ASSERT_THROW(net.train(&l, &opt, X, labels, 2, 1), xs_error);
+}
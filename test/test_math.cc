@@ -0,0 +1,134 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+
+using MathRoutine = void (*)(const float*, float*, size_t);
+
+/*
+ * Величина ULP для значения x одинарной точности.
+ */
+double ulp(double x) {
+    x = std::fabs(x);
+    if (x < std::numeric_limits<float>::min()) {
+        return std::ldexp(1.0, -149);
+    }
+    int e;
+    std::frexp(x, &e);
+    return std::ldexp(1.0, e - 24);
+}
+
+/*
+ * Максимальная ошибка в ULP на равномерной сетке [lo, hi] из count точек.
+ */
+double max_ulp_error(MathRoutine routine, const std::function<double(double)>& reference,
+                     float lo, float hi, size_t count) {
+    std::vector<float> in(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        in[i] = lo + (hi - lo) * float(i) / float(count - 1);
+    }
+    routine(in.data(), out.data(), count);
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const double ex = reference(double(in[i]));
+        // Тесты собираются с -ffast-math, поэтому переполнение проверяется сравнением, а не std::isinf
+        if (std::fabs(ex) > std::numeric_limits<float>::max() || ex == 0.0) {
+            continue;
+        }
+        max_error = std::max(max_error, std::fabs(double(out[i]) - ex) / ulp(ex));
+    }
+    return max_error;
+}
+
+} // namespace
+
+TEST(math, exp) {
+    EXPECT_LE(max_ulp_error(mmpack::MmExp, [](double x) { return std::exp(x); }, -87.3f, 88.7f, 1000003), 1.5);
+    EXPECT_LE(max_ulp_error(mmpack::MmExp, [](double x) { return std::exp(x); }, -1.0f, 1.0f, 100003), 1.5);
+}
+
+TEST(math, log) {
+    EXPECT_LE(max_ulp_error(mmpack::MmLog, [](double x) { return std::log(x); }, 1e-30f, 1e30f, 1000003), 1.0);
+    EXPECT_LE(max_ulp_error(mmpack::MmLog, [](double x) { return std::log(x); }, 0.5f, 2.0f, 100003), 1.0);
+}
+
+TEST(math, tanh) {
+    EXPECT_LE(max_ulp_error(mmpack::MmTanh, [](double x) { return std::tanh(x); }, -10.0f, 10.0f, 1000003), 1.5);
+}
+
+TEST(math, sigmoid) {
+    EXPECT_LE(max_ulp_error(mmpack::MmSigmoid, [](double x) { return 1.0 / (1.0 + std::exp(-x)); },
+                            -80.0f, 20.0f, 1000003), 3.5);
+}
+
+TEST(math, erf) {
+    EXPECT_LE(max_ulp_error(mmpack::MmErf, [](double x) { return std::erf(x); }, -5.0f, 5.0f, 1000003), 1.5);
+    EXPECT_LE(max_ulp_error(mmpack::MmErf, [](double x) { return std::erf(x); }, -1e-3f, 1e-3f, 10003), 1.5);
+}
+
+TEST(math, acos) {
+    EXPECT_LE(max_ulp_error(mmpack::MmAcos, [](double x) { return std::acos(x); }, -1.0f, 1.0f, 1000003), 1.5);
+}
+
+TEST(math, sqrt_rsqrt) {
+    EXPECT_LE(max_ulp_error(mmpack::MmSqrt, [](double x) { return std::sqrt(x); }, 1e-30f, 1e30f, 100003), 0.501);
+    EXPECT_LE(max_ulp_error(mmpack::MmRsqrt, [](double x) { return 1.0 / std::sqrt(x); }, 1e-30f, 1e30f, 100003), 1.5);
+}
+
+TEST(math, special_values) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float in[] = {0.0f, -1.0f, inf, -inf, 1.0f, 100.0f, -200.0f};
+    float out[7];
+
+    mmpack::MmExp(in, out, 7);
+    EXPECT_EQ(out[0], 1.0f);
+    EXPECT_EQ(out[2], inf);
+    EXPECT_EQ(out[3], 0.0f);
+    EXPECT_EQ(out[5], inf);
+    EXPECT_EQ(out[6], 0.0f);
+
+    mmpack::MmLog(in, out, 7);
+    EXPECT_EQ(out[0], -inf);
+    EXPECT_EQ(out[2], inf);
+    EXPECT_EQ(out[4], 0.0f);
+
+    mmpack::MmTanh(in, out, 7);
+    EXPECT_EQ(out[2], 1.0f);
+    EXPECT_EQ(out[3], -1.0f);
+    EXPECT_EQ(out[5], 1.0f);
+
+    mmpack::MmSigmoid(in, out, 7);
+    EXPECT_EQ(out[0], 0.5f);
+    EXPECT_EQ(out[2], 1.0f);
+    EXPECT_EQ(out[3], 0.0f);
+
+    mmpack::MmErf(in, out, 7);
+    EXPECT_EQ(out[0], 0.0f);
+    EXPECT_EQ(out[2], 1.0f);
+    EXPECT_EQ(out[3], -1.0f);
+}
+
+TEST(math, tail_matches_blocks) {
+    std::vector<float> in(11), out(11), single(1);
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = -2.0f + 0.37f * float(i);
+    }
+
+    const MathRoutine routines[] = {mmpack::MmExp, mmpack::MmTanh, mmpack::MmSigmoid, mmpack::MmErf};
+    for (MathRoutine routine : routines) {
+        routine(in.data(), out.data(), in.size());
+        for (size_t i = 0; i < in.size(); ++i) {
+            routine(&in[i], single.data(), 1);
+            EXPECT_EQ(out[i], single[0]);
+        }
+    }
+}
@@ -6,6 +6,7 @@
 #include "xsdnn.h"
 #include <gtest/gtest.h>
 #include "test_utils.h"
+#include "../include/utils/grad_checker.h"
 using namespace xsdnn;
 
 
@@ -33,6 +34,33 @@ TEST(max_pool, forward) {
     }
 }
 
+TEST(max_pool, forward_nhwc) {
+    shape3d in_shape(3, 5, 7);
+    max_pooling nchw(in_shape, 2, 2);
+    max_pooling nhwc(in_shape, 2, 2);
+    ASSERT_TRUE(nhwc.set_layout(tensor_layout::nhwc));
+
+    mat_t in_data(in_shape.size()), in_data_nhwc(in_shape.size());
+    utils::random_init(in_data.data(), in_data.size());
+    mmpack::MmTranspose(in_data.data(), in_data_nhwc.data(), in_shape.C, in_shape.area());
+
+    for (auto* pool : {&nchw, &nhwc}) {
+        pool->setup(false);
+        pool->set_parallelize(false);
+    }
+    nchw.set_in_data({{ in_data }});
+    nhwc.set_in_data({{ in_data_nhwc }});
+    nchw.forward();
+    nhwc.forward();
+
+    const shape3d out_shape = nchw.out_shape()[0];
+    const auto out = nchw.output()[0][0];
+    const auto out_nhwc = nhwc.output()[0][0];
+    mat_t out_back(out.size());
+    mmpack::MmTranspose(out_nhwc.data(), out_back.data(), out_shape.area(), out_shape.C);
+    ASSERT_EQ(out, out_back);
+}
+
 TEST(max_pool, forward_stride_x) {
     shape3d in_shape(1, 4, 4);
     max_pooling pool(in_shape, 2, 2, 1, 2);
@@ -258,3 +286,117 @@ TEST(max_pool, cerial) {
 
 
 
+
+/*
+ * Наивный max pooling с заполнением в формате (y_begin, x_begin) для сверки с MmMaxPool.
+ */
+static mat_t reference_max_pool(const mat_t& in, const params::max_pool& p) {
+    shape3d is = p.in_shape_;
+    shape3d os = p.out_shape_;
+    mat_t out(os.size(), std::numeric_limits<mm_scalar>::lowest());
+
+    for (size_t c = 0; c < os.C; ++c) {
+        for (size_t y = 0; y < os.H; ++y) {
+            for (size_t x = 0; x < os.W; ++x) {
+                for (size_t ky = 0; ky < p.kernel_y_; ++ky) {
+                    for (size_t kx = 0; kx < p.kernel_x_; ++kx) {
+                        const ptrdiff_t iy = ptrdiff_t(y * p.stride_y_ + ky) - ptrdiff_t(p._.Padding[0]);
+                        const ptrdiff_t ix = ptrdiff_t(x * p.stride_x_ + kx) - ptrdiff_t(p._.Padding[1]);
+                        if (iy < 0 || ix < 0 || iy >= ptrdiff_t(is.H) || ix >= ptrdiff_t(is.W)) continue;
+                        out[os(c, y, x)] = std::max(out[os(c, y, x)], in[is(c, size_t(iy), size_t(ix))]);
+                    }
+                }
+            }
+        }
+    }
+    return out;
+}
+
+TEST(max_pool, sliding_window_vs_reference) {
+    struct pool_case { size_t kernel; size_t stride; padding_mode pad; };
+    const pool_case cases[] = {
+            {2, 2, padding_mode::valid}, {2, 2, padding_mode::same},
+            {3, 2, padding_mode::valid}, {3, 2, padding_mode::same},
+            {3, 1, padding_mode::valid}, {3, 1, padding_mode::same},
+            {4, 3, padding_mode::same},  {5, 1, padding_mode::same}
+    };
+
+    for (const auto& pc : cases) {
+        for (size_t width : {7, 16, 23, 33}) {
+            shape3d in_shape(3, 9, width);
+            max_pooling pool(in_shape, pc.kernel, pc.stride, pc.pad);
+            mat_t in_data(in_shape.size());
+            utils::random_init(in_data.data(), in_data.size());
+
+            pool.setup(false);
+            pool.set_parallelize(false);
+            pool.set_in_data({{ in_data }});
+            pool.forward();
+
+            ASSERT_EQ(pool.output()[0][0], reference_max_pool(in_data, pool.get_params()))
+                << "kernel " << pc.kernel << " stride " << pc.stride << " width " << width;
+        }
+    }
+}
+
+TEST(max_pool, padding_same_centers_window) {
+    shape3d in_shape(1, 1, 5);
+    max_pooling pool(in_shape, 3, 1, 1, 1, padding_mode::same);
+    mat_t in_data = {9, 1, 2, 3, 7};
+    pool.setup(false);
+    pool.set_parallelize(false);
+    pool.set_in_data({{ in_data }});
+    pool.forward();
+
+    mat_t exp = {9, 9, 3, 7, 7};
+    ASSERT_EQ(pool.output()[0][0], exp);
+}
+
+TEST(max_pool, cerial_keeps_padding_mode) {
+    shape3d in_shape(2, 6, 6);
+    network<sequential> saver;
+    saver << max_pooling(in_shape, 3, 3, 1, 1, padding_mode::same);
+    saver.save("max_pool_same_model.xs");
+
+    network<sequential> loader;
+    loader.load("max_pool_same_model.xs");
+    ASSERT_EQ(loader[0]->out_shape()[0].size(), in_shape.size());
+}
+
+TEST(max_pool, backward_scatters_to_argmax) {
+    shape3d in_shape(1, 4, 4);
+    max_pooling pool(in_shape, 2, 2);
+    std::vector<tensor_t> in = {{{1, 2, 6, 3,
+                                  3, 5, 2, 1,
+                                  1, 2, 2, 1,
+                                  7, 3, 4, 8}}};
+    std::vector<tensor_t> out = {{mat_t(4)}};
+    std::vector<tensor_t> out_grad = {{{1, 2, 3, 4}}};
+    std::vector<tensor_t> in_grad = {{mat_t(16, -1.0f)}};
+    std::vector<tensor_t*> in_ = {&in[0]}, out_ = {&out[0]}, out_grad_ = {&out_grad[0]}, in_grad_ = {&in_grad[0]};
+
+    pool.set_parallelize(false);
+    pool.set_training(true);
+    pool.forward_propagation(in_, out_);
+    pool.back_propagation(in_, out_, out_grad_, in_grad_);
+
+    mat_t exp = {0, 0, 2, 0,
+                 0, 1, 0, 0,
+                 0, 0, 0, 0,
+                 3, 0, 0, 4};
+    ASSERT_EQ(in_grad[0][0], exp);
+}
+
+TEST(max_pool, backward) {
+    max_pooling pool(shape3d(3, 8, 8), 2, 2);
+    pool.set_parallelize(false);
+    GradChecker checker(&pool, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(max_pool, backward_overlapping_padding_same) {
+    max_pooling pool(shape3d(2, 7, 9), 3, 2, padding_mode::same);
+    pool.set_parallelize(false);
+    GradChecker checker(&pool, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
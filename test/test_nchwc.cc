@@ -0,0 +1,74 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "test_conv_utils.h"
+using namespace xsdnn;
+
+TEST(nchwc, reorder_round_trip) {
+    for (size_t Channels : {1, 3, 4, 7, 8, 13}) {
+        for (size_t Size : {1, 5, 16, 37}) {
+            mat_t Source(Channels * Size);
+            utils::random_init(Source.data(), Source.size());
+
+            mat_t Blocked(mmpack::MmNchwcBlockedChannels(Channels) * Size, -1.0f);
+            mat_t Restored(Channels * Size);
+
+            mmpack::MmReorderInputNchw(Source.data(), Blocked.data(), Channels, Size);
+
+            const size_t BlockSize = mmpack::MmNchwcGetBlockSize();
+            for (size_t c = 0; c < mmpack::MmNchwcBlockedChannels(Channels); ++c) {
+                for (size_t i = 0; i < Size; ++i) {
+                    const float expected = c < Channels ? Source[c * Size + i] : 0.0f;
+                    ASSERT_EQ(Blocked[((c / BlockSize) * Size + i) * BlockSize + c % BlockSize], expected);
+                }
+            }
+
+            mmpack::MmReorderOutputNchw(Blocked.data(), Restored.data(), Channels, Size);
+            ASSERT_EQ(Source, Restored);
+        }
+    }
+}
+
+TEST(nchwc, conv_matches_im2col) {
+    const auto shapes = utils::conv_test_shapes({
+            {16, 8, 8, 16, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2},
+    });
+
+    utils::conv_matches_im2col(shapes, [](params::conv& Nchwc) {
+        Nchwc.set_algorithm(MM_CONV_PARAMS::NchwcDirect);
+    });
+}
+
+TEST(nchwc, layout_matches_im2col) {
+    const auto shapes = utils::conv_test_shapes({
+            {16, 8, 8, 16, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2},
+            {8, 7, 9, 8, 2, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1},
+    });
+    const size_t BlockSize = mmpack::MmNchwcGetBlockSize();
+
+    for (tensor_layout In : {tensor_layout::nchw, tensor_layout::nchwc}) {
+        for (tensor_layout Out : {tensor_layout::nchw, tensor_layout::nchwc}) {
+            if (In == tensor_layout::nchw && Out == tensor_layout::nchw) {
+                continue;
+            }
+
+            // Блочный тензор требует кол-ва каналов группы, кратного блоку
+            std::vector<utils::conv_shape> supported;
+            for (const auto& s : shapes) {
+                if ((In == tensor_layout::nchw || (s.C / s.G) % BlockSize == 0) &&
+                    (Out == tensor_layout::nchw || (s.F / s.G) % BlockSize == 0)) {
+                    supported.push_back(s);
+                }
+            }
+
+            utils::conv_matches_im2col(supported, [&](params::conv& Nchwc) {
+                Nchwc.set_layout(In, Out);
+            });
+        }
+    }
+}
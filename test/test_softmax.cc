@@ -0,0 +1,166 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "../include/utils/grad_checker.h"
+#include "test_utils.h"
+using namespace xsdnn;
+
+namespace {
+
+/*
+ * Эталон top-k: полная сортировка индексов по убыванию значения, при равенстве - по индексу.
+ */
+std::vector<size_t> top_k_reference(const mat_t& x, size_t k) {
+    std::vector<size_t> idx(x.size());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::stable_sort(idx.begin(), idx.end(), [&](size_t a, size_t b) { return x[a] > x[b]; });
+    idx.resize(std::min(k, x.size()));
+    return idx;
+}
+
+/*
+ * Input -> fully_connected -> softmax -> Output
+ */
+void build_classifier(network<graph>& net, size_t in_size, size_t classes,
+                      std::vector<std::shared_ptr<layer>>& owner) {
+    auto in = std::make_shared<Input>(shape3d(1, 1, in_size));
+    auto fc = std::make_shared<fully_connected>(in_size, classes);
+    auto sm = std::make_shared<xsdnn::softmax>();
+    auto out = std::make_shared<Output>();
+
+    connect(in.get(), fc.get(), 0, 0);
+    connect(fc.get(), sm.get(), 0, 0);
+    connect(sm.get(), out.get(), 0, 0);
+    construct_graph(net, {in.get()}, {out.get()});
+    net.init_weight();
+
+    owner = {in, fc, sm, out};
+}
+
+} // namespace
+
+TEST(softmax, forward) {
+    const size_t size = 37;
+    mat_t in(size);
+    for (size_t i = 0; i < size; ++i) {
+        in[i] = -40.0f + 90.0f * float(i) / float(size - 1);
+    }
+
+    xsdnn::softmax sm;
+    sm.set_in_shape(shape3d(1, 1, size));
+    sm.setup(false);
+    sm.set_parallelize(false);
+    sm.set_in_data({{ in }});
+    sm.forward();
+
+    double shift = *std::max_element(in.begin(), in.end());
+    double sum = 0.0;
+    for (float x : in) {
+        sum += std::exp(double(x) - shift);
+    }
+
+    const mat_t out = sm.output()[0][0];
+    for (size_t i = 0; i < size; ++i) {
+        const double ex = std::exp(double(in[i]) - shift) / sum;
+        ASSERT_NEAR(out[i], ex, 1e-6 * std::max(1e-6, ex)) << "x = " << in[i];
+    }
+}
+
+TEST(softmax, backward) {
+    xsdnn::softmax sm;
+    sm.set_in_shape(shape3d(1, 1, 263));
+    sm.set_parallelize(false);
+    GradChecker checker(&sm, GradChecker::mode::random);
+    ASSERT_EQ(checker.run(), GradChecker::status::ok);
+}
+
+TEST(softmax, top_k) {
+    for (size_t size : {1, 3, 8, 37, 1000}) {
+        mat_t x(size);
+        utils::random_init(x.data(), x.size());
+        // Повторы значений: порядок равных определяется индексом
+        for (size_t i = 0; i < size; i += 5) {
+            x[i] = 0.25f;
+        }
+
+        for (size_t k : {1, 2, 5, 64}) {
+            std::vector<size_t> indices(k);
+            mat_t values(k);
+            const size_t count = mmpack::MmTopK(x.data(), size, k, indices.data(), values.data());
+
+            const std::vector<size_t> ex = top_k_reference(x, k);
+            ASSERT_EQ(count, ex.size());
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(indices[i], ex[i]) << "size = " << size << " k = " << k << " i = " << i;
+                ASSERT_EQ(values[i], x[ex[i]]);
+            }
+
+            mat_t probabilities(size);
+            mmpack::MmSoftmax(x.data(), probabilities.data(), size);
+            mmpack::MmSoftmaxTopK(x.data(), size, k, indices.data(), values.data());
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(indices[i], ex[i]);
+                ASSERT_NEAR(values[i], probabilities[ex[i]], 1e-6f);
+            }
+        }
+    }
+}
+
+TEST(softmax, inference_session_top_k) {
+    const size_t Classes = 1000;
+    const size_t K = 5;
+
+    std::vector<std::shared_ptr<layer>> owner;
+    network<graph> net;
+    build_classifier(net, 16, Classes, owner);
+    net.save("softmax_model.xs");
+
+    std::vector<tensor_t> X(3, tensor_t(1, mat_t(16)));
+    for (auto& x : X) {
+        utils::random_init(x[0].data(), x[0].size());
+    }
+
+    InfOptions opt;
+    opt.SetNetType(net_type::graph);
+    opt.SetTopK(K);
+    InfSession session(opt);
+    session.Load("softmax_model.xs");
+
+    const std::vector<tensor_t> probabilities = net.predict(X);
+
+    std::vector<InfTopK> top;
+    session.Run(X, top);
+    ASSERT_EQ(top.size(), X.size());
+
+    for (size_t sample = 0; sample < X.size(); ++sample) {
+        const mat_t& p = probabilities[sample][0];
+        ASSERT_EQ(p.size(), Classes);
+        ASSERT_NEAR(std::accumulate(p.begin(), p.end(), 0.0), 1.0, 1e-4);
+
+        const std::vector<size_t> ex = top_k_reference(p, K);
+        ASSERT_EQ(top[sample].size(), K);
+        for (size_t i = 0; i < K; ++i) {
+            ASSERT_EQ(top[sample][i].first, ex[i]);
+            ASSERT_NEAR(top[sample][i].second, p[ex[i]], 1e-6f);
+        }
+    }
+
+    // После top-k обычный Run снова возвращает вероятности
+    std::vector<tensor_t> again(1);
+    session.Run({X[0]}, again);
+    for (size_t i = 0; i < Classes; ++i) {
+        ASSERT_FLOAT_EQ(again[0][0][i], probabilities[0][0][i]);
+    }
+}
+
+TEST(softmax, cerial) {
+    xsdnn::softmax sm(size_t(16));
+    ASSERT_TRUE(utils::cerial_testing(sm));
+}
@@ -0,0 +1,28 @@
+//
+// Created by agent on 19.10.2026.
+// Copyright (c) 2021-2023 xsdnn. All rights reserved.
+//
+
+#include "xsdnn.h"
+#include <gtest/gtest.h>
+#include "test_utils.h"
+using namespace xsdnn;
+
+TEST(transpose, matrix) {
+    for (size_t M : {1, 3, 4, 9, 16}) {
+        for (size_t N : {1, 2, 4, 7, 33}) {
+            mat_t A(M * N), B(M * N), C(M * N);
+            utils::random_init(A.data(), A.size());
+
+            mmpack::MmTranspose(A.data(), B.data(), M, N);
+            for (size_t m = 0; m < M; ++m) {
+                for (size_t n = 0; n < N; ++n) {
+                    ASSERT_EQ(B[n * M + m], A[m * N + n]);
+                }
+            }
+
+            mmpack::MmTranspose(B.data(), C.data(), N, M);
+            ASSERT_EQ(A, C);
+        }
+    }
+}